@@ -0,0 +1,91 @@
+/**
+ * @file arena.c
+ * @brief Implementação das arenas e do pool de arenas de cada thread.
+ */
+
+#include <stdlib.h>
+
+#include "arena.h"
+#include "metricas.h"
+
+// Pool de arenas livres e contadores da thread
+static __thread struct Arena *PoolArenas = NULL;
+static __thread int TamanhoPool = 0;
+static __thread struct EstatisticasArena EstatisticasLocais;
+
+/**
+ * @brief Função para obter uma arena vazia com pelo menos 'capacidade' bytes
+ * @note Usa a menor arena do pool que couber, para as grandes ficarem para
+ *       as partidas grandes; só chama malloc se nenhuma couber.
+ * @param capacidade Bytes necessários (somar tamanhoNaArena de cada reserva)
+ * @return Arena vazia ou NULL se faltou memória
+ */
+struct Arena *obterArena(size_t capacidade) {
+    EstatisticasLocais.obtidas++;
+    struct Arena **melhor = NULL; // Ligação que aponta para a menor arena que cabe
+    for (struct Arena **anterior = &PoolArenas; *anterior != NULL; anterior = &(*anterior)->proxima) {
+        size_t disponivel = (*anterior)->capacidade;
+        if (disponivel < capacidade || (melhor != NULL && disponivel >= (*melhor)->capacidade)) continue;
+        melhor = anterior;
+        if (disponivel == capacidade) break;
+    }
+    if (melhor != NULL) {
+        struct Arena *arena = *melhor;
+        *melhor = arena->proxima;
+        TamanhoPool--;
+        arena->usado = 0;
+        arena->proxima = NULL;
+        EstatisticasLocais.reaproveitadas++;
+        return arena;
+    }
+
+    struct Arena *arena = (struct Arena *) malloc(sizeof(struct Arena) + capacidade);
+    EstatisticasLocais.chamadasAlocador++;
+    METRICA_CONTAR(METRICA_ALOCACOES);
+    if (arena == NULL) return NULL;
+    arena->capacidade = capacidade;
+    arena->usado = 0;
+    arena->proxima = NULL;
+    return arena;
+}
+
+/**
+ * @brief Função para devolver uma arena ao pool da thread
+ * @note Com o pool cheio, a arena é liberada. Pode ser chamada por outra
+ *       thread que não a que obteve a arena: ela vai para o pool de quem devolve.
+ * @param arena Arena obtida por obterArena (NULL é ignorado)
+ */
+void devolverArena(struct Arena *arena) {
+    if (arena == NULL) return;
+    if (TamanhoPool >= ARENA_MAX_POOL) {
+        free(arena);
+        EstatisticasLocais.chamadasAlocador++;
+        return;
+    }
+    arena->usado = 0;
+    arena->proxima = PoolArenas;
+    PoolArenas = arena;
+    TamanhoPool++;
+}
+
+/**
+ * @brief Função para liberar as arenas livres da thread
+ * @note Deve ser chamada por toda thread que cria partidas, antes de terminar.
+ */
+void liberarPoolArenas(void) {
+    while (PoolArenas != NULL) {
+        struct Arena *arena = PoolArenas;
+        PoolArenas = arena->proxima;
+        free(arena);
+        EstatisticasLocais.chamadasAlocador++;
+    }
+    TamanhoPool = 0;
+}
+
+/**
+ * @brief Função para consultar os contadores de arenas da thread atual
+ * @param estatisticas Recebe os contadores
+ */
+void lerEstatisticasArena(struct EstatisticasArena *estatisticas) {
+    *estatisticas = EstatisticasLocais;
+}
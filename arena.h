@@ -0,0 +1,64 @@
+/**
+ * @file arena.h
+ * @brief Arenas de memória para partidas de vida curta.
+ *
+ * Uma arena é um único bloco obtido do malloc do qual as partes de uma
+ * partida (tropas, donos, jogadores e conjuntos de posse, ver alocarJogo)
+ * ou o espaço de trabalho de uma busca (os nós do MCTS) são recortadas
+ * avançando um ponteiro. Ao terminar, a arena volta ao pool da thread que a
+ * devolveu, e a próxima partida do mesmo tamanho (ou menor) a reaproveita
+ * (a menor arena do pool em que caiba): criar uma partida custa tirar a
+ * arena do pool e avançar o ponteiro, e destruí-la custa devolver a arena,
+ * sem nenhuma chamada ao alocador.
+ *
+ * O pool é por thread (sem travas) e guarda até ARENA_MAX_POOL arenas; cada
+ * thread que cria partidas chama liberarPoolArenas() antes de terminar.
+ */
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+#define ARENA_ALINHAMENTO 16 // Alinhamento de cada reserva (o mesmo do malloc)
+#define ARENA_MAX_POOL 16    // Arenas livres guardadas no pool de cada thread
+
+// Arena: o cabeçalho fica no início do próprio bloco, seguido da memória
+struct Arena {
+    size_t capacidade;     // Bytes disponíveis depois do cabeçalho
+    size_t usado;          // Bytes já reservados
+    struct Arena *proxima; // Próxima arena livre do pool
+    size_t preenchimento;  // Cabeçalho múltiplo de ARENA_ALINHAMENTO: a memória começa alinhada como o bloco
+};
+
+// Chamadas ao alocador e reaproveitamentos da thread atual
+struct EstatisticasArena {
+    long chamadasAlocador; // malloc e free de arenas
+    long obtidas;          // Arenas entregues por obterArena
+    long reaproveitadas;   // Arenas entregues a partir do pool
+};
+
+/**
+ * @brief Reserva 'tamanho' bytes da arena, alinhados a ARENA_ALINHAMENTO.
+ * @return Ponteiro para a memória (não zerada) ou NULL se a arena não tem espaço
+ */
+static inline void *reservarNaArena(struct Arena *arena, size_t tamanho) {
+    size_t inicio = (arena->usado + ARENA_ALINHAMENTO - 1) & ~(size_t) (ARENA_ALINHAMENTO - 1);
+    if (inicio > arena->capacidade || tamanho > arena->capacidade - inicio) return NULL;
+    arena->usado = inicio + tamanho;
+    return (char *) (arena + 1) + inicio;
+}
+
+/**
+ * @brief Bytes que uma reserva ocupa na arena, com o alinhamento.
+ */
+static inline size_t tamanhoNaArena(size_t tamanho) {
+    return (tamanho + ARENA_ALINHAMENTO - 1) & ~(size_t) (ARENA_ALINHAMENTO - 1);
+}
+
+// --- Protótipos das Funções ---
+struct Arena *obterArena(size_t capacidade); // Função para obter uma arena vazia do pool da thread (ou do malloc)
+void devolverArena(struct Arena *arena);     // Função para devolver uma arena ao pool da thread
+void liberarPoolArenas(void);                // Função para liberar as arenas livres da thread
+void lerEstatisticasArena(struct EstatisticasArena *estatisticas); // Função para consultar os contadores da thread
+
+#endif // ARENA_H
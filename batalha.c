@@ -0,0 +1,283 @@
+/**
+ * @file batalha.c
+ * @brief Tabela de resultados finais de batalhas e amostragem pelo método de alias.
+ *
+ * Estados finais de uma batalha que começa em (a, d):
+ * - o atacante fica com 1 tropa e o defensor com d' tropas (1 <= d' <= d);
+ * - o defensor é eliminado e o atacante fica com a' tropas (2 <= a' <= a).
+ * São, portanto, d + a - 1 resultados possíveis, numerados nessa ordem.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <math.h>
+
+#include "batalha.h"
+#include "metricas.h"
+
+// Tabela de resultados, construída por inicializarTabelaBatalhas()
+static uint32_t inicioTabela[BATALHA_MAX_TROPAS + 1][BATALHA_MAX_TROPAS + 1]; // Posição do par (a, d) nos vetores abaixo
+static float chanceVitoria[BATALHA_MAX_TROPAS + 1][BATALHA_MAX_TROPAS + 1];   // Probabilidade de conquista do par (a, d)
+static float custoVitoria[BATALHA_MAX_TROPAS + 1][BATALHA_MAX_TROPAS + 1];    // -log da chance de conquista (peso do planejador)
+static float sobraVitoria[BATALHA_MAX_TROPAS + 1][BATALHA_MAX_TROPAS + 1];    // Tropas esperadas do atacante quando conquista
+static float *aliasProb = NULL;      // Probabilidade de ficar na própria coluna
+static uint16_t *aliasIndice = NULL; // Coluna alternativa (alias)
+static int tabelaConstruida = 0;
+
+/**
+ * @brief Calcula a distribuição de perdas do atacante em uma rodada de dados.
+ * @note Enumera todas as 6^(na+nd) combinações; empates favorecem a defesa.
+ * @param na Dados do atacante (1 a 3)
+ * @param nd Dados do defensor (1 a 3)
+ * @param prob Recebe prob[l] = chance de o atacante perder l tropas
+ */
+static void distribuicaoRodada(int na, int nd, double prob[4]) {
+    int total = na + nd;
+    int combinacoes = 1;
+    for (int i = 0; i < total; i++) combinacoes *= 6;
+
+    int comparacoes = (na < nd) ? na : nd;
+    for (int l = 0; l < 4; l++) prob[l] = 0.0;
+
+    for (int c = 0; c < combinacoes; c++) {
+        int dadosAtaque[3] = {0, 0, 0};
+        int dadosDefesa[3] = {0, 0, 0};
+        int resto = c;
+        for (int i = 0; i < na; i++) { dadosAtaque[i] = resto % 6 + 1; resto /= 6; }
+        for (int i = 0; i < nd; i++) { dadosDefesa[i] = resto % 6 + 1; resto /= 6; }
+
+        // Ordena em ordem decrescente (no máximo 3 elementos)
+        for (int i = 0; i < 2; i++) {
+            for (int j = 0; j < 2 - i; j++) {
+                if (dadosAtaque[j] < dadosAtaque[j + 1]) { int t = dadosAtaque[j]; dadosAtaque[j] = dadosAtaque[j + 1]; dadosAtaque[j + 1] = t; }
+                if (dadosDefesa[j] < dadosDefesa[j + 1]) { int t = dadosDefesa[j]; dadosDefesa[j] = dadosDefesa[j + 1]; dadosDefesa[j + 1] = t; }
+            }
+        }
+
+        int perdas = 0;
+        for (int i = 0; i < comparacoes; i++) {
+            if (dadosAtaque[i] <= dadosDefesa[i]) perdas++;
+        }
+        prob[perdas] += 1.0;
+    }
+
+    for (int l = 0; l < 4; l++) prob[l] /= combinacoes;
+}
+
+/**
+ * @brief Converte um estado final em sua posição na lista de resultados de (a, d).
+ */
+static int indiceResultado(int d, int aFinal, int dFinal) {
+    return (aFinal == 1) ? dFinal - 1 : d + aFinal - 2;
+}
+
+/**
+ * @brief Monta a tabela de alias de Vose para uma distribuição.
+ * @param dist Distribuição de probabilidades (soma 1)
+ * @param n Número de resultados
+ * @param prob Recebe a probabilidade de cada coluna
+ * @param alias Recebe o alias de cada coluna
+ * @param pilhaPequenos Memória auxiliar com n posições
+ * @param pilhaGrandes Memória auxiliar com n posições
+ * @param escalado Memória auxiliar com n posições
+ */
+static void montarAlias(const double *dist, int n, float *prob, uint16_t *alias,
+                        int *pilhaPequenos, int *pilhaGrandes, double *escalado) {
+    int numPequenos = 0, numGrandes = 0;
+
+    for (int i = 0; i < n; i++) {
+        escalado[i] = dist[i] * n;
+        alias[i] = (uint16_t) i;
+        if (escalado[i] < 1.0) pilhaPequenos[numPequenos++] = i;
+        else pilhaGrandes[numGrandes++] = i;
+    }
+
+    while (numPequenos > 0 && numGrandes > 0) {
+        int pequeno = pilhaPequenos[--numPequenos];
+        int grande = pilhaGrandes[--numGrandes];
+
+        prob[pequeno] = (float) escalado[pequeno];
+        alias[pequeno] = (uint16_t) grande;
+
+        escalado[grande] = (escalado[grande] + escalado[pequeno]) - 1.0;
+        if (escalado[grande] < 1.0) pilhaPequenos[numPequenos++] = grande;
+        else pilhaGrandes[numGrandes++] = grande;
+    }
+
+    // Sobras (erros de arredondamento) ficam com probabilidade 1
+    while (numGrandes > 0) prob[pilhaGrandes[--numGrandes]] = 1.0f;
+    while (numPequenos > 0) prob[pilhaPequenos[--numPequenos]] = 1.0f;
+}
+
+/**
+ * @brief Calcula a distribuição dos estados finais de todas as batalhas até
+ *        BATALHA_MAX_TROPAS e monta as tabelas de alias.
+ * @note Programação dinâmica: o resultado de (a, d) é a média dos resultados
+ *       dos estados alcançáveis em uma rodada, que já foram calculados.
+ * @return 0 em caso de sucesso, 1 se faltar memória
+ */
+int inicializarTabelaBatalhas(void) {
+    if (tabelaConstruida) return 0;
+
+    // Distribuição de uma rodada para cada combinação de dados
+    double rodada[4][4][4];
+    for (int na = 1; na <= 3; na++) {
+        for (int nd = 1; nd <= 3; nd++) {
+            distribuicaoRodada(na, nd, rodada[na][nd]);
+        }
+    }
+
+    // Posição de cada par (a, d) nos vetores da tabela
+    uint32_t total = 0;
+    for (int a = 2; a <= BATALHA_MAX_TROPAS; a++) {
+        for (int d = 1; d <= BATALHA_MAX_TROPAS; d++) {
+            inicioTabela[a][d] = total;
+            total += (uint32_t) (d + a - 1);
+        }
+    }
+
+    const int maxResultados = 2 * BATALHA_MAX_TROPAS;
+    double *dist = (double *) calloc(total, sizeof(double));
+    double *escalado = (double *) malloc(maxResultados * sizeof(double));
+    int *pilhaPequenos = (int *) malloc(maxResultados * sizeof(int));
+    int *pilhaGrandes = (int *) malloc(maxResultados * sizeof(int));
+    aliasProb = (float *) malloc(total * sizeof(float));
+    aliasIndice = (uint16_t *) malloc(total * sizeof(uint16_t));
+
+    if (!dist || !escalado || !pilhaPequenos || !pilhaGrandes || !aliasProb || !aliasIndice) {
+        free(dist); free(escalado); free(pilhaPequenos); free(pilhaGrandes);
+        liberarTabelaBatalhas();
+        return 1;
+    }
+
+    for (int a = 2; a <= BATALHA_MAX_TROPAS; a++) {
+        for (int d = 1; d <= BATALHA_MAX_TROPAS; d++) {
+            double *resultado = &dist[inicioTabela[a][d]];
+            int na = (a - 1 > 3) ? 3 : a - 1;
+            int nd = (d > 3) ? 3 : d;
+            int comparacoes = (na < nd) ? na : nd;
+
+            for (int perdasAtaque = 0; perdasAtaque <= comparacoes; perdasAtaque++) {
+                double p = rodada[na][nd][perdasAtaque];
+                if (p == 0.0) continue;
+
+                int a2 = a - perdasAtaque;
+                int d2 = d - (comparacoes - perdasAtaque);
+
+                if (a2 < 2 || d2 == 0) {
+                    // A rodada já encerra a batalha
+                    resultado[indiceResultado(d, a2, d2)] += p;
+                } else {
+                    // Herda a distribuição final do estado alcançado
+                    const double *filho = &dist[inicioTabela[a2][d2]];
+                    for (int j = 0; j < d2 + a2 - 1; j++) {
+                        int aFinal = (j < d2) ? 1 : j - d2 + 2;
+                        int dFinal = (j < d2) ? j + 1 : 0;
+                        resultado[indiceResultado(d, aFinal, dFinal)] += p * filho[j];
+                    }
+                }
+            }
+
+            // Chance de conquista: soma dos estados com o defensor eliminado
+            double vitoria = 0.0, sobra = 0.0;
+            for (int j = d; j < d + a - 1; j++) {
+                vitoria += resultado[j];
+                sobra += resultado[j] * (j - d + 2);
+            }
+            chanceVitoria[a][d] = (float) vitoria;
+            custoVitoria[a][d] = (vitoria > 0.0) ? (float) -log(vitoria) : INFINITY;
+            sobraVitoria[a][d] = (vitoria > 0.0) ? (float) (sobra / vitoria) : 1.0f;
+
+            montarAlias(resultado, d + a - 1, &aliasProb[inicioTabela[a][d]], &aliasIndice[inicioTabela[a][d]],
+                        pilhaPequenos, pilhaGrandes, escalado);
+        }
+    }
+
+    free(dist);
+    free(escalado);
+    free(pilhaPequenos);
+    free(pilhaGrandes);
+    tabelaConstruida = 1;
+    return 0;
+}
+
+/**
+ * @brief Libera a memória das tabelas de alias.
+ */
+void liberarTabelaBatalhas(void) {
+    free(aliasProb);
+    free(aliasIndice);
+    aliasProb = NULL;
+    aliasIndice = NULL;
+    tabelaConstruida = 0;
+}
+
+/**
+ * @brief Informa se uma batalha pode ser resolvida pela tabela.
+ * @param tropasAtaque Tropas do território atacante
+ * @param tropasDefesa Tropas do território defensor
+ * @return 1 se a tabela foi construída e cobre o par, 0 caso contrário
+ */
+int batalhaNaTabela(int tropasAtaque, int tropasDefesa) {
+    return tabelaConstruida
+        && tropasAtaque >= 2 && tropasAtaque <= BATALHA_MAX_TROPAS
+        && tropasDefesa >= 1 && tropasDefesa <= BATALHA_MAX_TROPAS;
+}
+
+/**
+ * @brief Sorteia o resultado final de uma batalha com dados máximos até o fim.
+ * @note Custa uma consulta à tabela e um único número aleatório.
+ * @note O par de tropas deve estar coberto pela tabela (ver batalhaNaTabela()).
+ * @param rng Gerador de números aleatórios da partida
+ * @param tropasAtaque Tropas do atacante; recebe as tropas finais
+ * @param tropasDefesa Tropas do defensor; recebe as tropas finais
+ */
+void resolverBatalha(struct Rng *rng, int *tropasAtaque, int *tropasDefesa) {
+    int a = *tropasAtaque;
+    int d = *tropasDefesa;
+    int n = d + a - 1;
+    uint32_t inicio = inicioTabela[a][d];
+    METRICA_CONTAR(METRICA_BATALHAS_TABELA);
+
+    // Um sorteio uniforme escolhe a coluna e decide entre ela e o seu alias
+    double u = rngUniforme(rng) * n;
+    int coluna = (int) u;
+    int resultado = ((u - coluna) < aliasProb[inicio + coluna]) ? coluna : aliasIndice[inicio + coluna];
+
+    if (resultado < d) {
+        *tropasAtaque = 1;
+        *tropasDefesa = resultado + 1;
+    } else {
+        *tropasAtaque = resultado - d + 2;
+        *tropasDefesa = 0;
+    }
+}
+
+/**
+ * @brief Consulta a probabilidade de o atacante conquistar o território.
+ * @param tropasAtaque Tropas do território atacante
+ * @param tropasDefesa Tropas do território defensor
+ * @return Probabilidade entre 0 e 1, ou -1 se o par não estiver na tabela
+ */
+double probabilidadeVitoria(int tropasAtaque, int tropasDefesa) {
+    if (!batalhaNaTabela(tropasAtaque, tropasDefesa)) return -1.0;
+    return chanceVitoria[tropasAtaque][tropasDefesa];
+}
+
+/**
+ * @brief Consulta o custo e o saldo de uma conquista, para a busca de caminhos.
+ * @note O custo é -log da chance de conquista: somar custos ao longo de uma
+ *       sequência de ataques equivale a multiplicar as chances.
+ * @param tropasAtaque Tropas do território atacante
+ * @param tropasDefesa Tropas do território defensor
+ * @param custo Recebe -log P(conquista) (infinito se a conquista é impossível)
+ * @param sobra Recebe as tropas esperadas do atacante dado que conquistou
+ * @return 1 se o par está na tabela, 0 caso contrário (nada é escrito)
+ */
+int custoConquista(int tropasAtaque, int tropasDefesa, float *custo, float *sobra) {
+    if (!batalhaNaTabela(tropasAtaque, tropasDefesa)) return 0;
+    *custo = custoVitoria[tropasAtaque][tropasDefesa];
+    *sobra = sobraVitoria[tropasAtaque][tropasDefesa];
+    return 1;
+}
@@ -0,0 +1,31 @@
+/**
+ * @file batalha.h
+ * @brief Resolução "blitz" de batalhas a partir de uma tabela de Markov.
+ *
+ * Uma batalha em que os dois lados sempre rolam o máximo de dados e o
+ * atacante só para quando não pode mais atacar é uma cadeia de Markov
+ * absorvente sobre o par (tropas do atacante, tropas do defensor). A
+ * distribuição dos estados finais de cada par inicial é calculada uma única
+ * vez e guardada em tabelas de alias (método de Vose), de modo que o
+ * resultado completo de uma batalha custa uma consulta e um sorteio.
+ */
+#ifndef BATALHA_H
+#define BATALHA_H
+
+#include "rng.h"
+
+// Maior número de tropas (de cada lado) coberto pela tabela.
+// Pode ser alterado na compilação: make CFLAGS+=-DBATALHA_MAX_TROPAS=128
+#ifndef BATALHA_MAX_TROPAS
+#define BATALHA_MAX_TROPAS 64
+#endif
+
+// --- Protótipos das Funções ---
+int inicializarTabelaBatalhas(void);   // Função para calcular a tabela de resultados (retorna 0 em caso de sucesso)
+void liberarTabelaBatalhas(void);      // Função para liberar a memória da tabela
+int batalhaNaTabela(int tropasAtaque, int tropasDefesa);              // Função para saber se o par de tropas está na tabela
+void resolverBatalha(struct Rng *rng, int *tropasAtaque, int *tropasDefesa); // Função para sortear o resultado final de uma batalha
+double probabilidadeVitoria(int tropasAtaque, int tropasDefesa);     // Função para consultar a chance de conquista do atacante
+int custoConquista(int tropasAtaque, int tropasDefesa, float *custo, float *sobra); // Função para consultar -log da chance de conquista e as tropas que sobram
+
+#endif // BATALHA_H
@@ -0,0 +1,1051 @@
+/**
+ * @file bench.c
+ * @brief Microbenchmarks das funções mais quentes do jogo.
+ * @note Cada medição guarda uma soma de verificação dos resultados para que o
+ *       compilador não descarte o trabalho medido.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <unistd.h>
+#include <time.h>
+
+#include "bench.h"
+#include "jogo.h"
+#include "simulacao.h"
+#include "mapa.h"
+#include "missao.h"
+#include "batalha.h"
+#include "mcts.h"
+#include "torneio.h"
+#include "arena.h"
+#include "lote.h"
+#include "planejador.h"
+#include "historico.h"
+#include "eventos.h"
+#include "vista.h"
+
+#define BENCH_CONSULTAS 1024 // Nomes distintos sorteados para as buscas (reaproveitados em ciclo)
+#define BENCH_DECISOES_MCTS 5 // Decisões do jogador automático medidas em cada configuração
+#define BENCH_BATALHAS_LOTE 4096 // Batalhas de cada lote medido pelos núcleos SIMD
+#define BENCH_TROPAS_LOTE 20 // Maior número de tropas de cada lado nas batalhas do lote
+#define BENCH_CONSULTAS_PLANO 200 // Consultas ao planejador de ataques em cada medição
+#define BENCH_CHAMADAS_LEGADAS 8 // Chamadas ao alocador por partida em alocarJogoLegado (4 alocações e 4 free)
+#define BENCH_RAMOS 2000 // Ramos de busca jogados e desfeitos em cada medição do histórico
+#define BENCH_ATAQUES_RAMO 16 // Ataques sorteados de cada ramo
+#define BENCH_RODADAS_DIARIO 201 // Rodadas curtas alternadas sem e com o diário de eventos (vale a mediana das razões)
+#define BENCH_RODADAS_MOTOR 5 // Rodadas alternadas do motor genérico e do compacto (vale a melhor de cada)
+#define BENCH_CONSULTAS_VISTA 1000 // Páginas das visões do mapa consultadas em cada medição
+
+// Território como era guardado antes dos vetores paralelos de struct Jogo
+// (nome, cor e tropas lado a lado, 116 bytes por território)
+struct TerritorioLegado {
+    char nome[TAM_STRING];
+    char cor[10];
+    int tropas;
+};
+
+/**
+ * @brief Rodada de dados como era feita em atacar() antes do núcleo sem alocação.
+ * @note Mantida apenas como referência de desempenho: malloc por rodada e bubble sort.
+ * @return Tropas perdidas pelo atacante
+ */
+static int rodadaLegada(int numDadosAtaque, int numDadosDefesa) {
+    int *dadosAtaque = (int *) malloc(numDadosAtaque * sizeof(int));
+    int *dadosDefesa = (int *) malloc(numDadosDefesa * sizeof(int));
+    for (int i = 0; i < numDadosAtaque; i++) dadosAtaque[i] = (rand() % 6) + 1;
+    for (int i = 0; i < numDadosDefesa; i++) dadosDefesa[i] = (rand() % 6) + 1;
+
+    // Bubble sort em ordem decrescente
+    int *vetores[2] = {dadosAtaque, dadosDefesa};
+    int tamanhos[2] = {numDadosAtaque, numDadosDefesa};
+    for (int v = 0; v < 2; v++) {
+        for (int i = 0; i < tamanhos[v] - 1; i++) {
+            for (int j = 0; j < tamanhos[v] - i - 1; j++) {
+                if (vetores[v][j] < vetores[v][j + 1]) {
+                    int temp = vetores[v][j];
+                    vetores[v][j] = vetores[v][j + 1];
+                    vetores[v][j + 1] = temp;
+                }
+            }
+        }
+    }
+
+    int perdas = 0;
+    int comparacoes = (numDadosAtaque < numDadosDefesa) ? numDadosAtaque : numDadosDefesa;
+    for (int i = 0; i < comparacoes; i++) {
+        if (dadosAtaque[i] <= dadosDefesa[i]) perdas++;
+    }
+
+    free(dadosAtaque);
+    free(dadosDefesa);
+    return perdas;
+}
+
+/**
+ * @brief Busca por nome como buscarTerritorioPorNome() fazia antes do índice do mapa.
+ * @note Mantida apenas como referência de desempenho: strcmp em todos os territórios.
+ * @return Índice do território ou -1 se não encontrado
+ */
+static int buscaLinear(const struct TerritorioLegado *pais, int numTerritorios, const char *nome) {
+    for (int i = 0; i < numTerritorios; i++) {
+        if (strcmp(pais[i].nome, nome) == 0) return i;
+    }
+    return -1;
+}
+
+/**
+ * @brief Mede buscas por nome/s num mapa: busca linear contra o índice do mapa
+ *        (exata, sem diferenciar maiúsculas e por prefixo).
+ * @note A busca linear roda menos vezes nos mapas grandes (no máximo ~5e7
+ *       comparações) para que a medição termine em tempo razoável.
+ * @param numTerritorios Tamanho do mapa (TERRITORIOS_CLASSICO usa o mapa clássico)
+ * @param buscas Número de buscas medidas no índice
+ * @param rng Gerador usado para sortear os nomes buscados
+ */
+static void medirBuscasNomes(int numTerritorios, long buscas, struct Rng *rng) {
+    struct Mapa *mapa = numTerritorios == TERRITORIOS_CLASSICO ? criarMapaClassico() : criarMapaGrade(numTerritorios);
+    struct TerritorioLegado *pais = mapa ? (struct TerritorioLegado *) calloc(mapa->numTerritorios, sizeof(struct TerritorioLegado)) : NULL;
+    if (pais == NULL) {
+        printf("| %-11d | %-50s |\n", numTerritorios, "sem memória para o mapa");
+        liberarMapa(mapa);
+        return;
+    }
+    for (int t = 0; t < mapa->numTerritorios; t++) strcpy(pais[t].nome, nomeTerritorio(mapa, t));
+
+    // Nomes buscados: exatos, em minúsculas e sem o último caractere (prefixo)
+    static char exatos[BENCH_CONSULTAS][MAPA_TAM_NOME];
+    static char minusculos[BENCH_CONSULTAS][MAPA_TAM_NOME];
+    static char prefixos[BENCH_CONSULTAS][MAPA_TAM_NOME];
+    for (int k = 0; k < BENCH_CONSULTAS; k++) {
+        strcpy(exatos[k], nomeTerritorio(mapa, (int) rngLimitado(rng, (uint32_t) mapa->numTerritorios)));
+        size_t tamanho = strlen(exatos[k]);
+        for (size_t c = 0; c <= tamanho; c++) minusculos[k][c] = (char) tolower((unsigned char) exatos[k][c]);
+        memcpy(prefixos[k], exatos[k], tamanho);
+        prefixos[k][tamanho > 1 ? tamanho - 1 : tamanho] = '\0';
+    }
+
+    long buscasLineares = 50000000L / mapa->numTerritorios;
+    if (buscasLineares > buscas) buscasLineares = buscas;
+    if (buscasLineares < 1) buscasLineares = 1;
+
+    long soma = 0;
+    double inicio = relogioSegundos();
+    for (long i = 0; i < buscasLineares; i++) soma += buscaLinear(pais, mapa->numTerritorios, exatos[i % BENCH_CONSULTAS]);
+    double tempoLinear = relogioSegundos() - inicio;
+
+    inicio = relogioSegundos();
+    for (long i = 0; i < buscas; i++) soma += buscarNomeNoMapa(mapa, exatos[i % BENCH_CONSULTAS]);
+    double tempoHash = relogioSegundos() - inicio;
+
+    inicio = relogioSegundos();
+    for (long i = 0; i < buscas; i++) soma += buscarNomeSemCaixa(mapa, minusculos[i % BENCH_CONSULTAS]);
+    double tempoSemCaixa = relogioSegundos() - inicio;
+
+    int primeiro;
+    inicio = relogioSegundos();
+    for (long i = 0; i < buscas; i++) soma += buscarPrefixoNoMapa(mapa, prefixos[i % BENCH_CONSULTAS], &primeiro);
+    double tempoPrefixo = relogioSegundos() - inicio;
+
+    double taxaLinear = tempoLinear > 0 ? buscasLineares / tempoLinear : 0.0;
+    double taxaHash = tempoHash > 0 ? buscas / tempoHash : 0.0;
+    printf("| %-11d | %12.0f | %12.0f | %12.0f | %12.0f | %8.2fx | %ld\n", mapa->numTerritorios,
+           taxaLinear, taxaHash,
+           tempoSemCaixa > 0 ? buscas / tempoSemCaixa : 0.0,
+           tempoPrefixo > 0 ? buscas / tempoPrefixo : 0.0,
+           taxaLinear > 0 ? taxaHash / taxaLinear : 0.0, soma);
+
+    free(pais);
+    liberarMapa(mapa);
+}
+
+/**
+ * @brief Mede a soma das tropas do mapa inteiro no formato antigo (vetor de
+ *        structs com o nome junto) e no vetor de tropas de struct Jogo.
+ * @param numTerritorios Tamanho do mapa
+ * @param repeticoes Número de somas medidas em cada formato
+ */
+static void medirSomaTropas(int numTerritorios, int repeticoes) {
+    struct TerritorioLegado *pais = (struct TerritorioLegado *) calloc(numTerritorios, sizeof(struct TerritorioLegado));
+    int32_t *tropas = (int32_t *) malloc(numTerritorios * sizeof(int32_t));
+    if (pais == NULL || tropas == NULL) {
+        printf("| %-11d | %-50s |\n", numTerritorios, "sem memória para o mapa");
+        free(pais);
+        free(tropas);
+        return;
+    }
+    for (int t = 0; t < numTerritorios; t++) {
+        pais[t].tropas = t % 7 + 1;
+        tropas[t] = t % 7 + 1;
+    }
+
+    long somaLegada = 0;
+    double inicio = relogioSegundos();
+    for (int r = 0; r < repeticoes; r++) {
+        for (int t = 0; t < numTerritorios; t++) somaLegada += pais[t].tropas;
+    }
+    double tempoLegado = relogioSegundos() - inicio;
+
+    long somaNova = 0;
+    inicio = relogioSegundos();
+    for (int r = 0; r < repeticoes; r++) {
+        for (int t = 0; t < numTerritorios; t++) somaNova += tropas[t];
+    }
+    double tempoNovo = relogioSegundos() - inicio;
+
+    double territorios = (double) numTerritorios * repeticoes;
+    printf("| %-11d | %12.0f | %12.0f | %8.2fx | %ld\n", numTerritorios,
+           tempoLegado > 0 ? territorios / tempoLegado : 0.0,
+           tempoNovo > 0 ? territorios / tempoNovo : 0.0,
+           tempoNovo > 0 ? tempoLegado / tempoNovo : 0.0, somaLegada + somaNova);
+
+    free(pais);
+    free(tropas);
+}
+
+/**
+ * @brief Aloca uma partida como alocarJogo fazia antes das arenas.
+ * @note Mantida apenas como referência de desempenho: quatro chamadas ao
+ *       alocador por partida criada e quatro free ao destruí-la.
+ * @return 0 em caso de sucesso, 1 se faltou memória
+ */
+static int alocarJogoLegado(struct Jogo *jogo, const struct Mapa *mapa) {
+    jogo->mapa = mapa;
+    jogo->arena = NULL;
+    jogo->mapeamento = NULL;
+    jogo->numTerritorios = mapa->numTerritorios;
+    jogo->numCores = CORES_CLASSICAS;
+    jogo->palavrasPosse = (mapa->numTerritorios + 63) / 64;
+    jogo->tropas = (int32_t *) calloc((size_t) mapa->numTerritorios, sizeof(int32_t));
+    jogo->dono = (int8_t *) malloc((size_t) mapa->numTerritorios);
+    jogo->jogadores = alocarMemoriaJogadores();
+    jogo->posse = (uint64_t *) calloc((size_t) CORES_CLASSICAS * jogo->palavrasPosse, sizeof(uint64_t));
+    if (jogo->tropas == NULL || jogo->dono == NULL || jogo->jogadores == NULL || jogo->posse == NULL) {
+        liberarJogo(jogo);
+        return 1;
+    }
+    memset(jogo->dono, SEM_COR, (size_t) mapa->numTerritorios);
+    reiniciarPosse(jogo);
+    return 0;
+}
+
+/**
+ * @brief Mede as partidas criadas, preparadas e destruídas por segundo com o
+ *        alocador direto (como era) e com o pool de arenas.
+ * @note Cada ciclo é o de uma partida de vida curta (uma nova partida do
+ *       servidor, a cópia de uma decisão do MCTS): alocar, sortear cores,
+ *       missões e territórios e liberar. Também conta as chamadas ao alocador
+ *       por partida; com as arenas só a primeira partida da thread chama.
+ * @param numTerritorios Tamanho do mapa (TERRITORIOS_CLASSICO = mapa clássico)
+ * @param numPartidas Número de partidas de cada versão
+ * @param semente Semente dos sorteios
+ */
+static void medirCicloPartidas(int numTerritorios, long numPartidas, uint64_t semente) {
+    struct Mapa *mapa = (numTerritorios == TERRITORIOS_CLASSICO) ? criarMapaClassico() : criarMapaGrade(numTerritorios);
+    if (mapa == NULL) {
+        printf("| %-11d | %-50s |\n", numTerritorios, "sem memória para o mapa");
+        return;
+    }
+
+    long soma = 0;
+    double inicio = relogioSegundos();
+    for (long p = 0; p < numPartidas; p++) {
+        struct Jogo jogo = {0};
+        if (alocarJogoLegado(&jogo, mapa) != 0) break;
+        jogo.numJogadores = JOGADORES_CLASSICO;
+        rngSemearFluxo(&jogo.rng, semente, (uint64_t) p);
+        soma += prepararPartida(&jogo, &politicaGulosa);
+        liberarJogo(&jogo);
+    }
+    double tempoLegado = relogioSegundos() - inicio;
+
+    struct EstatisticasArena antes, depois;
+    lerEstatisticasArena(&antes);
+    inicio = relogioSegundos();
+    for (long p = 0; p < numPartidas; p++) {
+        struct Jogo jogo = {0};
+        if (alocarJogo(&jogo, mapa) != 0) break;
+        jogo.numJogadores = JOGADORES_CLASSICO;
+        rngSemearFluxo(&jogo.rng, semente, (uint64_t) p);
+        soma += prepararPartida(&jogo, &politicaGulosa);
+        liberarJogo(&jogo);
+    }
+    double tempoArena = relogioSegundos() - inicio;
+    lerEstatisticasArena(&depois);
+    liberarPoolArenas();
+
+    printf("| %-11d | %12.0f | %12.0f | %8.2fx | %11.1f | %11.4f | %ld\n", numTerritorios,
+           tempoLegado > 0 ? numPartidas / tempoLegado : 0.0,
+           tempoArena > 0 ? numPartidas / tempoArena : 0.0,
+           tempoArena > 0 ? tempoLegado / tempoArena : 0.0, (double) BENCH_CHAMADAS_LEGADAS,
+           (double) (depois.chamadasAlocador - antes.chamadasAlocador) / numPartidas, soma);
+
+    liberarMapa(mapa);
+}
+
+/**
+ * @brief Mede as batalhas blitz/s de cada núcleo das rodadas em lote.
+ * @note Todos os núcleos partem da mesma semente, então sorteiam os mesmos
+ *       dados e devem chegar às mesmas tropas finais que o escalar. A taxa de
+ *       conquistas é comparada com a chance exata da tabela de Markov.
+ * @param rodadas Tamanho da medição (o mesmo --bench das rodadas de dados)
+ * @param semente Semente das tropas iniciais e dos dados
+ */
+static void medirBatalhasEmLote(long rodadas, uint64_t semente) {
+    size_t bytes = BENCH_BATALHAS_LOTE * sizeof(int32_t);
+    int32_t *iniciaisAtaque = (int32_t *) malloc(bytes);
+    int32_t *iniciaisDefesa = (int32_t *) malloc(bytes);
+    int32_t *ataque = (int32_t *) malloc(bytes);
+    int32_t *defesa = (int32_t *) malloc(bytes);
+    int32_t *referenciaAtaque = (int32_t *) malloc(bytes);
+    int32_t *referenciaDefesa = (int32_t *) malloc(bytes);
+    if (iniciaisAtaque == NULL || iniciaisDefesa == NULL || ataque == NULL || defesa == NULL ||
+        referenciaAtaque == NULL || referenciaDefesa == NULL || inicializarTabelaBatalhas() != 0) {
+        printf("| %-11s | %-50s |\n", "lote", "sem memória para as batalhas");
+        free(iniciaisAtaque); free(iniciaisDefesa); free(ataque); free(defesa);
+        free(referenciaAtaque); free(referenciaDefesa);
+        return;
+    }
+
+    struct Rng rng;
+    rngSemear(&rng, semente);
+    double esperado = 0.0;
+    for (int i = 0; i < BENCH_BATALHAS_LOTE; i++) {
+        iniciaisAtaque[i] = 2 + (int32_t) rngLimitado(&rng, BENCH_TROPAS_LOTE - 1);
+        iniciaisDefesa[i] = 1 + (int32_t) rngLimitado(&rng, BENCH_TROPAS_LOTE);
+        esperado += probabilidadeVitoria(iniciaisAtaque[i], iniciaisDefesa[i]);
+    }
+    long repeticoes = rodadas / (10L * BENCH_BATALHAS_LOTE);
+    if (repeticoes < 1) repeticoes = 1;
+    double batalhas = (double) repeticoes * BENCH_BATALHAS_LOTE;
+
+    double tempoEscalar = 0.0;
+    for (int nucleo = LOTE_ESCALAR; nucleo < TOTAL_NUCLEOS_LOTE; nucleo++) {
+        if (!nucleoLoteDisponivel((enum NucleoLote) nucleo)) {
+            printf("| %-8s | %-50s |\n", nomeNucleoLote((enum NucleoLote) nucleo), "indisponível neste processador");
+            continue;
+        }
+        rngSemear(&rng, semente);
+        long resolvidas = 0, conquistas = 0;
+        double inicio = relogioSegundos();
+        for (long r = 0; r < repeticoes; r++) {
+            memcpy(ataque, iniciaisAtaque, bytes);
+            memcpy(defesa, iniciaisDefesa, bytes);
+            resolvidas += batalhasEmLote(&rng, ataque, defesa, BENCH_BATALHAS_LOTE, (enum NucleoLote) nucleo);
+            for (int i = 0; i < BENCH_BATALHAS_LOTE; i++) conquistas += (defesa[i] == 0);
+        }
+        double tempo = relogioSegundos() - inicio;
+
+        // A última repetição de cada núcleo é comparada com a do escalar
+        int iguais = 1;
+        if (nucleo == LOTE_ESCALAR) {
+            tempoEscalar = tempo;
+            memcpy(referenciaAtaque, ataque, bytes);
+            memcpy(referenciaDefesa, defesa, bytes);
+        } else {
+            iguais = memcmp(referenciaAtaque, ataque, bytes) == 0 && memcmp(referenciaDefesa, defesa, bytes) == 0;
+        }
+        printf("| %-8s | %12.0f | %12.0f | %8.2fx | %8.2f%% | %8.2f%% | %s\n", nomeNucleoLote((enum NucleoLote) nucleo),
+               tempo > 0 ? batalhas / tempo : 0.0, tempo > 0 ? resolvidas / tempo : 0.0,
+               tempo > 0 ? tempoEscalar / tempo : 0.0, 100.0 * conquistas / batalhas,
+               100.0 * esperado / BENCH_BATALHAS_LOTE, iguais ? "sim" : "NÃO");
+    }
+
+    free(iniciaisAtaque); free(iniciaisDefesa); free(ataque); free(defesa);
+    free(referenciaAtaque); free(referenciaDefesa);
+}
+
+/**
+ * @brief Mede o tempo de uma consulta ao planejador de ataques.
+ * @note Três jogadores, cada um caçando a cor do seguinte. Mede a busca
+ *       completa (plano esquecido antes de cada consulta), a consulta sem
+ *       nenhuma mudança (plano memorizado) e a consulta depois de mudar as
+ *       tropas de um território sorteado, que só refaz a busca se ele foi
+ *       lido pela anterior. Com alvoUnico, a cor caçada pelo primeiro jogador
+ *       fica só com o último território: a busca percorre o mapa inteiro.
+ * @param numTerritorios Tamanho do mapa (TERRITORIOS_CLASSICO = mapa clássico)
+ * @param alvoUnico 1 para o cenário de alvo único e distante
+ * @param semente Semente da partida e dos territórios alterados
+ */
+static void medirPlanejador(int numTerritorios, int alvoUnico, uint64_t semente) {
+    struct Mapa *mapa = (numTerritorios == TERRITORIOS_CLASSICO) ? criarMapaClassico() : criarMapaGrade(numTerritorios);
+    struct Jogo jogo = {0};
+    struct Planejador planejador;
+    if (mapa == NULL || alocarJogo(&jogo, mapa) != 0 || criarPlanejador(&planejador, mapa->numTerritorios) != 0) {
+        printf("| %-11d | %-50s |\n", numTerritorios, "sem memória para o mapa");
+        liberarJogo(&jogo);
+        liberarMapa(mapa);
+        return;
+    }
+
+    rngSemear(&jogo.rng, semente);
+    jogo.numJogadores = JOGADORES_CLASSICO;
+    for (int i = 0; i < JOGADORES_CLASSICO; i++) definirCorJogador(&jogo, i, i);
+    for (int i = 0; i < JOGADORES_CLASSICO; i++) {
+        jogo.jogadores[i].missao = missaoDestruirCor(jogo.jogadores[(i + 1) % JOGADORES_CLASSICO].cor);
+        registrarAlvoMissao(&jogo, i);
+    }
+    distribuirTerritorios(&jogo);
+    if (alvoUnico) {
+        // O último território muda primeiro para a cor caçada nunca ficar vazia
+        int ultimo = jogo.numTerritorios - 1;
+        definirDono(&jogo, ultimo, jogo.jogadores[1].cor);
+        for (int t = 0; t < ultimo; t++) {
+            if (jogo.dono[t] == jogo.jogadores[1].cor) definirDono(&jogo, t, jogo.jogadores[2].cor);
+        }
+    }
+
+    // Busca completa a cada consulta (a primeira, fora da medição, traz a memória para o cache)
+    long passos = planejarAtaque(&planejador, &jogo, 0)->numPassos;
+    double pior = 0.0;
+    double inicio = relogioSegundos();
+    for (int c = 0; c < BENCH_CONSULTAS_PLANO; c++) {
+        double antes = relogioSegundos();
+        esquecerPlano(&planejador);
+        passos += planejarAtaque(&planejador, &jogo, 0)->numPassos;
+        double duracao = relogioSegundos() - antes;
+        if (duracao > pior) pior = duracao;
+    }
+    double tempoBusca = relogioSegundos() - inicio;
+
+    // Mesma partida: o plano memorizado é conferido e devolvido
+    inicio = relogioSegundos();
+    for (int c = 0; c < BENCH_CONSULTAS_PLANO; c++) passos += planejarAtaque(&planejador, &jogo, 0)->numPassos;
+    double tempoMemo = relogioSegundos() - inicio;
+
+    // Uma tropa a mais num território sorteado antes de cada consulta
+    struct Rng rng;
+    rngSemear(&rng, semente ^ 0x9e3779b97f4a7c15ULL);
+    long reaproveitadasAntes = planejador.reaproveitadas;
+    inicio = relogioSegundos();
+    for (int c = 0; c < BENCH_CONSULTAS_PLANO; c++) {
+        jogo.tropas[rngLimitado(&rng, (uint32_t) jogo.numTerritorios)]++;
+        passos += planejarAtaque(&planejador, &jogo, 0)->numPassos;
+    }
+    double tempoAlterado = relogioSegundos() - inicio;
+    long reaproveitadas = planejador.reaproveitadas - reaproveitadasAntes;
+
+    // "único" tem um caractere de 2 bytes: a largura em bytes compensa
+    printf("| %-11d | %-*s | %10.2f | %10.2f | %10.2f | %10.2f | %9.1f%% | %ld\n", numTerritorios,
+           alvoUnico ? 12 : 11, alvoUnico ? "alvo único" : "sorteado", tempoBusca * 1e6 / BENCH_CONSULTAS_PLANO, pior * 1e6,
+           tempoMemo * 1e6 / BENCH_CONSULTAS_PLANO, tempoAlterado * 1e6 / BENCH_CONSULTAS_PLANO,
+           100.0 * reaproveitadas / BENCH_CONSULTAS_PLANO, passos);
+
+    liberarPlanejador(&planejador);
+    liberarJogo(&jogo);
+    liberarMapa(mapa);
+}
+
+/**
+ * @brief Copia tropas, donos, posse e o estado pequeno de uma partida para
+ *        outra sobre o mesmo mapa (o que uma busca sem histórico faz por ramo).
+ */
+static void copiarEstado(struct Jogo *destino, const struct Jogo *origem) {
+    size_t n = (size_t) origem->numTerritorios;
+    memcpy(destino->tropas, origem->tropas, n * sizeof(int32_t));
+    memcpy(destino->dono, origem->dono, n);
+    memcpy(destino->posse, origem->posse, (size_t) origem->numCores * origem->palavrasPosse * sizeof(uint64_t));
+    memcpy(destino->jogadores, origem->jogadores, (size_t) origem->numJogadores * sizeof(struct Jogador));
+    memcpy(destino->territoriosCor, origem->territoriosCor, (size_t) origem->numCores * sizeof(int));
+    destino->vencedor = origem->vencedor;
+}
+
+/**
+ * @brief Joga um ramo de BENCH_ATAQUES_RAMO ataques sorteados (território
+ *        com 2 ou mais tropas contra um vizinho de outra cor).
+ * @note O ramo para quando alguém cumpre a missão: a conquista que venceu
+ *       a partida deixa o território sem tropas.
+ * @return Soma das tropas finais dos territórios atacados (verificação)
+ */
+static long jogarRamo(struct Jogo *jogo, struct Rng *rng) {
+    const struct Mapa *mapa = jogo->mapa;
+    long soma = 0;
+    for (int k = 0; k < BENCH_ATAQUES_RAMO && jogo->vencedor < 0; k++) {
+        int a = (int) rngLimitado(rng, (uint32_t) jogo->numTerritorios);
+        int grau = mapa->inicioVizinhos[a + 1] - mapa->inicioVizinhos[a];
+        if (jogo->tropas[a] < 2 || grau == 0) continue;
+        int d = mapa->vizinhos[mapa->inicioVizinhos[a] + (int) rngLimitado(rng, (uint32_t) grau)];
+        if (jogo->dono[d] == jogo->dono[a]) continue;
+        atacar(jogo, a, d, buscarJogadorPorCor(jogo, jogo->dono[a]));
+        soma += jogo->tropas[d];
+    }
+    return soma;
+}
+
+/**
+ * @brief Mede os ramos de busca por segundo voltando ao estado de partida
+ *        por cópia completa e pelo histórico de versões (historico.h).
+ * @note Os dois modos partem das mesmas sementes: se o histórico restaura a
+ *       partida corretamente, os ramos e as somas são iguais. A memória da
+ *       versão de um ramo é comparada com a de uma cópia completa.
+ * @param numTerritorios Tamanho do mapa (TERRITORIOS_CLASSICO = mapa clássico)
+ * @param semente Semente da partida e dos ataques
+ */
+static void medirHistorico(int numTerritorios, uint64_t semente) {
+    struct Mapa *mapa = (numTerritorios == TERRITORIOS_CLASSICO) ? criarMapaClassico() : criarMapaGrade(numTerritorios);
+    struct Jogo raiz = {0};
+    struct Jogo jogo = {0};
+    struct Historico historico = {0};
+    if (mapa == NULL || alocarJogo(&raiz, mapa) != 0 || alocarJogo(&jogo, mapa) != 0) {
+        printf("| %-11d | %-50s |\n", numTerritorios, "sem memória para o mapa");
+        liberarJogo(&jogo);
+        liberarJogo(&raiz);
+        liberarMapa(mapa);
+        return;
+    }
+
+    rngSemear(&raiz.rng, semente);
+    raiz.numJogadores = JOGADORES_CLASSICO;
+    for (int i = 0; i < JOGADORES_CLASSICO; i++) {
+        definirCorJogador(&raiz, i, i);
+        raiz.jogadores[i].politica = &politicaGulosa;
+    }
+    for (int i = 0; i < JOGADORES_CLASSICO; i++) {
+        raiz.jogadores[i].missao = missaoDestruirCor(raiz.jogadores[(i + 1) % JOGADORES_CLASSICO].cor);
+        registrarAlvoMissao(&raiz, i);
+    }
+    distribuirTerritorios(&raiz);
+    for (int t = 0; t < raiz.numTerritorios; t++) raiz.tropas[t] += t % 5; // Mais ataques possíveis
+
+    // A partida de trabalho herda as cores e missões da raiz
+    jogo.numJogadores = raiz.numJogadores;
+    memcpy(jogo.jogadorDaCor, raiz.jogadorDaCor, sizeof(raiz.jogadorDaCor));
+    memcpy(jogo.cacadorDaCor, raiz.cacadorDaCor, sizeof(raiz.cacadorDaCor));
+    copiarEstado(&jogo, &raiz);
+
+    // Cópia completa depois de cada ramo
+    struct Rng rng;
+    rngSemear(&rng, semente ^ 0x9e3779b97f4a7c15ULL);
+    rngSemear(&jogo.rng, semente);
+    long somaCopia = 0;
+    double inicio = relogioSegundos();
+    for (int r = 0; r < BENCH_RAMOS; r++) {
+        somaCopia += jogarRamo(&jogo, &rng);
+        copiarEstado(&jogo, &raiz);
+    }
+    double tempoCopia = relogioSegundos() - inicio;
+
+    // Histórico: marca 0 na raiz e volta a ela depois de cada ramo
+    long somaHistorico = 0;
+    size_t bytesVersoes = 0;
+    double tempoHistorico = 0.0;
+    int criado = criarHistorico(&historico, &jogo) == 0;
+    if (criado) {
+        rngSemear(&rng, semente ^ 0x9e3779b97f4a7c15ULL);
+        rngSemear(&jogo.rng, semente);
+        inicio = relogioSegundos();
+        for (int r = 0; r < BENCH_RAMOS; r++) {
+            somaHistorico += jogarRamo(&jogo, &rng);
+            marcarVersao(&historico);
+            bytesVersoes += bytesHistorico(&historico);
+            voltarParaVersao(&historico, 0);
+        }
+        tempoHistorico = relogioSegundos() - inicio;
+    }
+    int igual = criado && somaHistorico == somaCopia && memcmp(jogo.tropas, raiz.tropas, (size_t) raiz.numTerritorios * sizeof(int32_t)) == 0 &&
+                memcmp(jogo.posse, raiz.posse, (size_t) raiz.numCores * raiz.palavrasPosse * sizeof(uint64_t)) == 0;
+
+    size_t bytesCopia = (size_t) raiz.numTerritorios * (sizeof(int32_t) + 1) +
+                        (size_t) raiz.numCores * raiz.palavrasPosse * sizeof(uint64_t) +
+                        (size_t) raiz.numJogadores * sizeof(struct Jogador) + (size_t) raiz.numCores * sizeof(int) + sizeof(int);
+    printf("| %-11d | %12.0f | %12.0f | %8.2fx | %12zu | %12.0f | %s\n", numTerritorios,
+           tempoCopia > 0 ? BENCH_RAMOS / tempoCopia : 0.0, tempoHistorico > 0 ? BENCH_RAMOS / tempoHistorico : 0.0,
+           tempoHistorico > 0 ? tempoCopia / tempoHistorico : 0.0, bytesCopia, (double) bytesVersoes / BENCH_RAMOS,
+           igual ? "sim" : "NÃO");
+
+    liberarHistorico(&historico);
+    liberarJogo(&jogo);
+    liberarJogo(&raiz);
+    liberarMapa(mapa);
+}
+
+/**
+ * @brief Tempo de CPU da thread atual em segundos.
+ */
+static double cpuDaThread(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &t);
+    return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+/**
+ * @brief Ordem crescente de doubles (qsort).
+ */
+static int compararRazoes(const void *a, const void *b) {
+    double x = *(const double *) a, y = *(const double *) b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Mede as partidas/s de uma simulação com uma thread sem e com o diário de eventos.
+ * @note As rodadas são curtas e se alternam (cada par começa por um lado);
+ *       o custo é a mediana das razões com/sem do tempo de CPU da thread do
+ *       jogo, que descarta as rodadas em que a máquina oscilou, mais o tempo
+ *       de CPU da thread gravadora sobre o tempo sem diário (com um só
+ *       núcleo, ele sai da simulação). O diário vai para um arquivo
+ *       temporário de verdade.
+ * @param politica Política de todos os jogadores (gulosa = blitz, aleatoria = dados)
+ * @param numPartidas Partidas de cada rodada
+ * @param semente Semente do lote
+ */
+static void medirDiario(const struct Politica *politica, long numPartidas, uint64_t semente) {
+    struct Mapa *mapa = criarMapaClassico();
+    struct EstatisticasSimulacao *est = (struct EstatisticasSimulacao *) calloc(1, sizeof(struct EstatisticasSimulacao));
+    char caminho[] = "/tmp/war-diario-XXXXXX";
+    int fd = -1;
+    struct Jogo jogo = {0};
+    if (mapa == NULL || est == NULL || (fd = mkstemp(caminho)) < 0 ||
+        alocarJogoComCores(&jogo, mapa, coresParaJogadores(JOGADORES_CLASSICO)) != 0) {
+        printf("| %-10s | %-50s |\n", politica->nome, "sem memória ou arquivo temporário");
+        if (fd >= 0) {
+            close(fd);
+            remove(caminho);
+        }
+        free(est);
+        liberarMapa(mapa);
+        return;
+    }
+    close(fd);
+    jogo.numJogadores = JOGADORES_CLASSICO;
+    if (abrirDiario(caminho, mapa) != 0) {
+        remove(caminho);
+        liberarJogo(&jogo);
+        free(est);
+        liberarMapa(mapa);
+        return;
+    }
+
+    double razoes[BENCH_RODADAS_DIARIO];
+    double total[2] = {0.0, 0.0};
+    for (int r = 0; r < BENCH_RODADAS_DIARIO; r++) {
+        double tempo[2];
+        for (int i = 0; i < 2; i++) {
+            int comDiario = (r + i) & 1;
+            jogo.diario = comDiario;
+            double inicio = cpuDaThread();
+            for (long p = 0; p < numPartidas; p++) jogarPartida(&jogo, politica, semente, p, est);
+            tempo[comDiario] = cpuDaThread() - inicio;
+            total[comDiario] += tempo[comDiario];
+        }
+        razoes[r] = tempo[0] > 0 ? tempo[1] / tempo[0] : 1.0;
+    }
+    struct ResumoDiario resumo;
+    int erro = fecharDiario(&resumo);
+    remove(caminho);
+
+    qsort(razoes, BENCH_RODADAS_DIARIO, sizeof(double), compararRazoes);
+    double custo = razoes[BENCH_RODADAS_DIARIO / 2] - 1.0 + (total[0] > 0 ? resumo.segundosCpu / total[0] : 0.0);
+    double semDiario = total[0] > 0 ? numPartidas * BENCH_RODADAS_DIARIO / total[0] : 0.0;
+    printf("| %-10s | %12.0f | %12.0f | %7.2f%% | %9.1f | %11.1f | %7ld | %s\n", politica->nome, semDiario,
+           semDiario / (1.0 + custo), custo * 100.0, (double) resumo.bytes / (numPartidas * BENCH_RODADAS_DIARIO),
+           resumo.segundosCpu * 1000.0, resumo.esperas, erro ? "erro" : "ok");
+
+    liberarJogo(&jogo);
+    free(est);
+    liberarMapa(mapa);
+}
+
+/**
+ * @brief Mede as partidas/s de uma simulação com uma thread no motor genérico e no compacto.
+ * @note As mesmas partidas são jogadas nos dois motores, em rodadas
+ *       alternadas (vale a melhor de cada); as estatísticas de cada motor são
+ *       comparadas no fim e devem ser idênticas.
+ * @param politica Política de todos os jogadores
+ * @param numPartidas Partidas de cada rodada
+ * @param semente Semente do lote
+ */
+static void medirMotores(const struct Politica *politica, long numPartidas, uint64_t semente) {
+    struct Mapa *mapa = criarMapaClassico();
+    struct EstatisticasSimulacao *est = (struct EstatisticasSimulacao *) calloc(TOTAL_MOTORES, sizeof(struct EstatisticasSimulacao));
+    struct Jogo jogo = {0};
+    if (mapa == NULL || est == NULL || alocarJogoComCores(&jogo, mapa, coresParaJogadores(JOGADORES_CLASSICO)) != 0) {
+        printf("| %-10s | %-50s |\n", politica->nome, "sem memória para o mapa");
+        free(est);
+        liberarMapa(mapa);
+        return;
+    }
+    jogo.numJogadores = JOGADORES_CLASSICO;
+
+    double melhor[TOTAL_MOTORES] = {0.0};
+    for (int r = 0; r < BENCH_RODADAS_MOTOR; r++) {
+        for (int motor = 0; motor < TOTAL_MOTORES; motor++) {
+            definirMotor(&jogo, motor);
+            double inicio = relogioSegundos();
+            for (long p = 0; p < numPartidas; p++) jogarPartida(&jogo, politica, semente, p, &est[motor]);
+            double tempo = relogioSegundos() - inicio;
+            if (r == 0 || tempo < melhor[motor]) melhor[motor] = tempo;
+        }
+    }
+
+    double generico = melhor[MOTOR_GENERICO] > 0 ? numPartidas / melhor[MOTOR_GENERICO] : 0.0;
+    double compacto = melhor[MOTOR_COMPACTO] > 0 ? numPartidas / melhor[MOTOR_COMPACTO] : 0.0;
+    int igual = memcmp(&est[MOTOR_GENERICO], &est[MOTOR_COMPACTO], sizeof(struct EstatisticasSimulacao)) == 0;
+    printf("| %-10s | %12.0f | %12.0f | %8.2fx | %s\n", politica->nome, generico, compacto,
+           generico > 0 ? compacto / generico : 0.0, igual ? "sim" : "NÃO");
+
+    liberarJogo(&jogo);
+    free(est);
+    liberarMapa(mapa);
+}
+
+/**
+ * @brief Mede as simulações/s do jogador automático (MCTS) com o orçamento padrão.
+ * @note Três jogadores com missões de destruição (as de territórios já estariam
+ *       cumpridas num mapa grande); cada decisão escolhida é jogada antes da próxima.
+ * @param numTerritorios Tamanho do mapa (TERRITORIOS_CLASSICO = mapa clássico)
+ * @param numThreads Threads da busca
+ * @param semente Semente da partida e das simulações
+ */
+static void medirMcts(int numTerritorios, int numThreads, uint64_t semente) {
+    struct Mapa *mapa = (numTerritorios == TERRITORIOS_CLASSICO) ? criarMapaClassico() : criarMapaGrade(numTerritorios);
+    struct Jogo jogo = {0};
+    struct ContextoMcts contexto;
+    if (mapa == NULL || alocarJogo(&jogo, mapa) != 0 ||
+        iniciarContextoMcts(&contexto, MCTS_ORCAMENTO_PADRAO_MS, numThreads, semente) != 0) {
+        printf("| %-11d | %-50s |\n", numTerritorios, "sem memória para o mapa");
+        liberarJogo(&jogo); // Nada a liberar se alocarJogo falhou
+        liberarMapa(mapa);
+        return;
+    }
+
+    // Cada jogador caça a cor do seguinte
+    rngSemear(&jogo.rng, semente);
+    jogo.numJogadores = JOGADORES_CLASSICO;
+    for (int i = 0; i < JOGADORES_CLASSICO; i++) {
+        definirCorJogador(&jogo, i, i);
+        jogo.jogadores[i].politica = &politicaMcts;
+    }
+    for (int i = 0; i < JOGADORES_CLASSICO; i++) {
+        jogo.jogadores[i].missao = missaoDestruirCor(jogo.jogadores[(i + 1) % JOGADORES_CLASSICO].cor);
+        registrarAlvoMissao(&jogo, i);
+    }
+    distribuirTerritorios(&jogo);
+    jogo.contexto = &contexto;
+
+    for (int k = 0; k < BENCH_DECISOES_MCTS && jogo.vencedor < 0; k++) {
+        struct Jogador *jogador = &jogo.jogadores[k % JOGADORES_CLASSICO];
+        int ataque, defesa;
+        if (politicaMcts.escolherAtaque(&jogo, jogador, &ataque, &defesa)) atacar(&jogo, ataque, defesa, jogador);
+    }
+
+    printf("| %-11d | %7d | %14.0f | %14.1f | %10.1f\n", numTerritorios, numThreads,
+           contexto.segundos > 0 ? contexto.simulacoes / contexto.segundos : 0.0,
+           contexto.decisoes > 0 ? (double) contexto.simulacoes / contexto.decisoes : 0.0,
+           contexto.decisoes > 0 ? contexto.segundos * 1000.0 / contexto.decisoes : 0.0);
+
+    liberarJogo(&jogo);
+    liberarMapa(mapa);
+}
+
+// Território e chave de uma visão montada por varredura (referência de medirVistas)
+struct ItemVarredura {
+    int32_t valor;
+    int territorio;
+};
+
+/**
+ * @brief Ordem das visões: maior valor primeiro; no empate, o menor território.
+ */
+static int compararItensVarredura(const void *a, const void *b) {
+    const struct ItemVarredura *x = (const struct ItemVarredura *) a;
+    const struct ItemVarredura *y = (const struct ItemVarredura *) b;
+    if (x->valor != y->valor) return x->valor < y->valor ? 1 : -1;
+    return (x->territorio > y->territorio) - (x->territorio < y->territorio);
+}
+
+/**
+ * @brief Monta uma visão inteira do jeito ingênuo: varre o mapa, filtra e ordena com qsort.
+ * @note É o que o desenho de uma página custaria sem os índices de vista.h.
+ * @return Territórios escritos em itens
+ */
+static int varrerVista(const struct Jogo *jogo, int tipo, int cor, struct ItemVarredura *itens) {
+    const struct Mapa *mapa = jogo->mapa;
+    int n = 0;
+    for (int t = 0; t < jogo->numTerritorios; t++) {
+        if (tipo == VISTA_TROPAS || (tipo == VISTA_COR && jogo->dono[t] == cor)) {
+            itens[n].valor = jogo->tropas[t];
+            itens[n++].territorio = t;
+        } else if (tipo == VISTA_AMEACADOS && jogo->dono[t] == cor) {
+            int32_t maior = 0;
+            for (int k = mapa->inicioVizinhos[t]; k < mapa->inicioVizinhos[t + 1]; k++) {
+                int d = mapa->vizinhos[k];
+                if (jogo->dono[d] != SEM_COR && jogo->dono[d] != cor && jogo->tropas[d] > maior) maior = jogo->tropas[d];
+            }
+            if (maior < 2 || maior <= jogo->tropas[t]) continue;
+            itens[n].valor = maior - jogo->tropas[t];
+            itens[n++].territorio = t;
+        }
+    }
+    qsort(itens, (size_t) n, sizeof(itens[0]), compararItensVarredura);
+    return n;
+}
+
+/**
+ * @brief Mede as visões ordenadas do mapa (vista.h): o tempo de uma página
+ *        servida pelos índices contra a varredura com qsort e o custo de
+ *        manter os índices a cada ataque.
+ * @note Duas cópias da partida jogam os mesmos ramos, uma sem e outra com
+ *       as visões; a diferença de tempo dividida pelas atualizações é o custo
+ *       de cada uma. No fim, cada visão de cada cor é comparada inteira com a
+ *       varredura.
+ * @param numTerritorios Tamanho do mapa (TERRITORIOS_CLASSICO = mapa clássico)
+ * @param semente Semente da partida, dos ataques e das consultas
+ */
+static void medirVistas(int numTerritorios, uint64_t semente) {
+    struct Mapa *mapa = (numTerritorios == TERRITORIOS_CLASSICO) ? criarMapaClassico() : criarMapaGrade(numTerritorios);
+    struct Jogo raiz = {0};
+    struct Jogo jogos[2] = {{0}};
+    struct VistaMapa vistas = {0};
+    size_t n = mapa != NULL ? (size_t) mapa->numTerritorios : 0;
+    struct ItemVarredura *itens = (struct ItemVarredura *) malloc(n * sizeof(struct ItemVarredura));
+    int *pagina = (int *) malloc(n * sizeof(int));
+    if (mapa == NULL || itens == NULL || pagina == NULL || alocarJogo(&raiz, mapa) != 0 || alocarJogo(&jogos[0], mapa) != 0 ||
+        alocarJogo(&jogos[1], mapa) != 0 || criarVistas(&vistas, &jogos[1]) != 0) {
+        printf("| %-11d | %-50s |\n", numTerritorios, "sem memória para o mapa");
+        liberarVistas(&vistas);
+        free(pagina);
+        free(itens);
+        liberarJogo(&jogos[1]);
+        liberarJogo(&jogos[0]);
+        liberarJogo(&raiz);
+        liberarMapa(mapa);
+        return;
+    }
+
+    rngSemear(&raiz.rng, semente);
+    raiz.numJogadores = JOGADORES_CLASSICO;
+    for (int i = 0; i < JOGADORES_CLASSICO; i++) {
+        definirCorJogador(&raiz, i, i);
+        raiz.jogadores[i].politica = &politicaGulosa;
+    }
+    for (int i = 0; i < JOGADORES_CLASSICO; i++) {
+        raiz.jogadores[i].missao = missaoDestruirCor(raiz.jogadores[(i + 1) % JOGADORES_CLASSICO].cor);
+        registrarAlvoMissao(&raiz, i);
+    }
+    distribuirTerritorios(&raiz);
+    for (int t = 0; t < raiz.numTerritorios; t++) raiz.tropas[t] += t % 5; // Mais ataques possíveis
+    for (int j = 0; j < 2; j++) {
+        jogos[j].numJogadores = raiz.numJogadores;
+        memcpy(jogos[j].jogadorDaCor, raiz.jogadorDaCor, sizeof(raiz.jogadorDaCor));
+        memcpy(jogos[j].cacadorDaCor, raiz.cacadorDaCor, sizeof(raiz.cacadorDaCor));
+        copiarEstado(&jogos[j], &raiz);
+    }
+    for (int t = 0; t < raiz.numTerritorios; t++) depoisDeAlterar(&jogos[1], t); // Índices da partida distribuída
+
+    // Os mesmos ramos sem e com as visões; uma partida que termina recomeça da raiz
+    double tempoAtaques[2];
+    long indexados = vistas.atualizacoes;
+    for (int j = 0; j < 2; j++) {
+        struct Rng rng;
+        rngSemear(&rng, semente ^ 0x9e3779b97f4a7c15ULL);
+        rngSemear(&jogos[j].rng, semente);
+        double inicio = relogioSegundos();
+        for (int r = 0; r < BENCH_RAMOS; r++) {
+            jogarRamo(&jogos[j], &rng);
+            if (jogos[j].vencedor < 0) continue;
+            copiarEstado(&jogos[j], &raiz);
+            for (int t = 0; t < raiz.numTerritorios; t++) depoisDeAlterar(&jogos[j], t);
+        }
+        tempoAtaques[j] = relogioSegundos() - inicio;
+    }
+    long atualizacoes = vistas.atualizacoes - indexados;
+
+    // Páginas de VISTA_PAGINA territórios: visão, cor e página sorteadas. A
+    // varredura custa O(n log n) por página: menos consultas nos mapas grandes
+    // (as primeiras de cada modo são as mesmas e devem dar a mesma soma)
+    int consultasVarredura = BENCH_CONSULTAS_VISTA * 1000 / (numTerritorios > 1000 ? numTerritorios : 1000);
+    if (consultasVarredura < 10) consultasVarredura = 10;
+    struct Rng rng;
+    rngSemear(&rng, semente ^ 0x2545f4914f6cdd1dULL);
+    long somaConsulta = 0;
+    double inicio = relogioSegundos();
+    for (int c = 0; c < BENCH_CONSULTAS_VISTA; c++) {
+        int tipo = (int) rngLimitado(&rng, TOTAL_VISTAS);
+        int cor = (int) rngLimitado(&rng, JOGADORES_CLASSICO);
+        int total = totalVista(&vistas, tipo, cor);
+        int inicioPagina = total > 0 ? (int) rngLimitado(&rng, (uint32_t) total) / VISTA_PAGINA * VISTA_PAGINA : 0;
+        int escritos = consultarVista(&vistas, tipo, cor, inicioPagina, VISTA_PAGINA, pagina);
+        for (int i = 0; i < escritos && c < consultasVarredura; i++) somaConsulta += pagina[i];
+    }
+    double tempoConsulta = (relogioSegundos() - inicio) / BENCH_CONSULTAS_VISTA;
+
+    long somaVarredura = 0;
+    rngSemear(&rng, semente ^ 0x2545f4914f6cdd1dULL);
+    inicio = relogioSegundos();
+    for (int c = 0; c < consultasVarredura; c++) {
+        int tipo = (int) rngLimitado(&rng, TOTAL_VISTAS);
+        int cor = (int) rngLimitado(&rng, JOGADORES_CLASSICO);
+        int total = varrerVista(&jogos[0], tipo, cor, itens);
+        int inicioPagina = total > 0 ? (int) rngLimitado(&rng, (uint32_t) total) / VISTA_PAGINA * VISTA_PAGINA : 0;
+        for (int i = inicioPagina; i < total && i < inicioPagina + VISTA_PAGINA; i++) somaVarredura += itens[i].territorio;
+    }
+    double tempoVarredura = (relogioSegundos() - inicio) / consultasVarredura;
+
+    // Cada visão de cada cor, inteira, contra a varredura da partida sem visões
+    int igual = somaConsulta == somaVarredura && memcmp(jogos[0].tropas, jogos[1].tropas, (size_t) raiz.numTerritorios * sizeof(int32_t)) == 0 &&
+                memcmp(jogos[0].dono, jogos[1].dono, (size_t) raiz.numTerritorios) == 0;
+    for (int tipo = 0; tipo < TOTAL_VISTAS && igual; tipo++) {
+        for (int cor = 0; cor < JOGADORES_CLASSICO && igual; cor++) {
+            int total = varrerVista(&jogos[0], tipo, cor, itens);
+            int escritos = consultarVista(&vistas, tipo, cor, 0, raiz.numTerritorios, pagina);
+            igual = escritos == total && totalVista(&vistas, tipo, cor) == total;
+            for (int i = 0; i < escritos && igual; i++) igual = pagina[i] == itens[i].territorio;
+        }
+    }
+
+    printf("| %-11d | %13.2f | %14.2f | %8.0fx | %13.3f | %7.2f%% | %s\n", numTerritorios, tempoConsulta * 1e6,
+           tempoVarredura * 1e6, tempoConsulta > 0 ? tempoVarredura / tempoConsulta : 0.0,
+           atualizacoes > 0 ? (tempoAtaques[1] - tempoAtaques[0]) * 1e6 / atualizacoes : 0.0,
+           tempoAtaques[0] > 0 ? (tempoAtaques[1] / tempoAtaques[0] - 1.0) * 100.0 : 0.0, igual ? "sim" : "NÃO");
+
+    liberarVistas(&vistas);
+    free(pagina);
+    free(itens);
+    liberarJogo(&jogos[1]);
+    liberarJogo(&jogos[0]);
+    liberarJogo(&raiz);
+    liberarMapa(mapa);
+}
+
+/**
+ * @brief Mede as rodadas de dados por segundo antes e depois do núcleo sem
+ *        alocação, e os dados sorteados por segundo com rand() e com o xoshiro256**.
+ * @note As combinações de dados (1 a 3 de cada lado) se alternam a cada rodada.
+ * @param rodadas Número de rodadas medidas em cada versão
+ * @param semente Semente do gerador de números aleatórios
+ * @return 0 em caso de sucesso
+ */
+int executarBenchmarks(long rodadas, uint64_t semente) {
+    long somaLegada = 0;
+    long somaNova = 0;
+    struct Rng rng;
+
+    srand((unsigned int) semente);
+    double inicio = relogioSegundos();
+    for (long r = 0; r < rodadas; r++) {
+        somaLegada += rodadaLegada((int) (r % 3) + 1, (int) ((r / 3) % 3) + 1);
+    }
+    double tempoLegado = relogioSegundos() - inicio;
+
+    rngSemear(&rng, semente);
+    inicio = relogioSegundos();
+    for (long r = 0; r < rodadas; r++) {
+        int dadosAtaque[3];
+        int dadosDefesa[3];
+        somaNova += rodadaDeDados(&rng, (int) (r % 3) + 1, (int) ((r / 3) % 3) + 1, dadosAtaque, dadosDefesa);
+    }
+    double tempoNovo = relogioSegundos() - inicio;
+
+    printf("========================================\n");
+    printf("======  MICROBENCHMARK - RODADAS  ======\n");
+    printf("========================================\n");
+    printf("| %-32s | %-14s | %-12s |\n", "Versão", "Rodadas/s", "Perdas");
+    printf("| %-31s | %14.0f | %12ld |\n", "malloc + bubble sort + rand()", tempoLegado > 0 ? rodadas / tempoLegado : 0.0, somaLegada);
+    printf("| %-33s | %14.0f | %12ld |\n", "pilha + rede de ordenação + rng", tempoNovo > 0 ? rodadas / tempoNovo : 0.0, somaNova);
+    printf("Ganho: %.2fx\n", tempoNovo > 0 ? tempoLegado / tempoNovo : 0.0);
+
+    // Dados sorteados por segundo com cada gerador (6 por rodada)
+    long numDados = rodadas * 6;
+    int lote[6];
+    long somaRand = 0, somaDado = 0, somaLote = 0;
+
+    inicio = relogioSegundos();
+    for (long i = 0; i < numDados; i++) somaRand += (rand() % 6) + 1;
+    double tempoRand = relogioSegundos() - inicio;
+
+    inicio = relogioSegundos();
+    for (long i = 0; i < numDados; i++) somaDado += rngDado(&rng);
+    double tempoDado = relogioSegundos() - inicio;
+
+    inicio = relogioSegundos();
+    for (long i = 0; i < numDados; i += 6) {
+        rngDados(&rng, lote, 6);
+        somaLote += lote[0] + lote[1] + lote[2] + lote[3] + lote[4] + lote[5];
+    }
+    double tempoLote = relogioSegundos() - inicio;
+
+    printf("\n| %-32s | %-14s | %-12s |\n", "Gerador", "Dados/s", "Média");
+    printf("| %-32s | %14.0f | %12.4f |\n", "rand() % 6 (com viés)", tempoRand > 0 ? numDados / tempoRand : 0.0, (double) somaRand / numDados);
+    printf("| %-32s | %14.0f | %12.4f |\n", "rngDado (Lemire)", tempoDado > 0 ? numDados / tempoDado : 0.0, (double) somaDado / numDados);
+    printf("| %-32s | %14.0f | %12.4f |\n", "rngDados (lote de 6)", tempoLote > 0 ? numDados / tempoLote : 0.0, (double) somaLote / numDados);
+
+    // Buscas por nome/s em mapas de tamanhos diferentes
+    const int tamanhosMapa[] = {TERRITORIOS_CLASSICO, 1000, 1000000};
+    long buscas = rodadas / 5 > 0 ? rodadas / 5 : 1;
+    printf("\n| %-11s | %-12s | %-12s | %-12s | %-12s | %-9s | %s\n",
+           "Territórios", "Linear/s", "Hash/s", "Sem caixa/s", "Prefixo/s", "Ganho", "Soma");
+    for (size_t m = 0; m < sizeof(tamanhosMapa) / sizeof(tamanhosMapa[0]); m++) {
+        medirBuscasNomes(tamanhosMapa[m], buscas, &rng);
+    }
+
+    // Territórios somados/s: vetor de structs antigo contra o vetor de tropas
+    printf("\n| %-11s | %-12s | %-12s | %-9s | %s\n", "Territórios", "Structs/s", "Vetor/s", "Ganho", "Soma");
+    for (size_t m = 0; m < sizeof(tamanhosMapa) / sizeof(tamanhosMapa[0]); m++) {
+        int repeticoes = (int) (rodadas * 10 / tamanhosMapa[m]);
+        medirSomaTropas(tamanhosMapa[m], repeticoes > 0 ? repeticoes : 1);
+    }
+
+    // Batalhas blitz/s resolvidas em lote por cada núcleo (escalar, SSE4.1 e AVX2)
+    printf("\n| %-9s | %-12s | %-12s | %-9s | %-9s | %-9s | %s\n",
+           "Núcleo", "Batalhas/s", "Rodadas/s", "Ganho", "Conquista", "Esperado", "Igual");
+    medirBatalhasEmLote(rodadas, semente);
+
+    // Partidas de vida curta/s: alocador direto contra o pool de arenas
+    const int tamanhosCiclo[] = {TERRITORIOS_CLASSICO, 1000};
+    printf("\n| %-11s | %-12s | %-12s | %-9s | %-11s | %-11s | %s\n",
+           "Territórios", "Alocador/s", "Arenas/s", "Ganho", "Chamadas", "Ch. arena", "Soma");
+    for (size_t m = 0; m < sizeof(tamanhosCiclo) / sizeof(tamanhosCiclo[0]); m++) {
+        long partidas = rodadas / 10 / tamanhosCiclo[m];
+        medirCicloPartidas(tamanhosCiclo[m], partidas > 0 ? partidas : 1, semente);
+    }
+
+    // Microssegundos por consulta ao planejador de ataques, até 10 mil territórios
+    const int tamanhosPlano[] = {TERRITORIOS_CLASSICO, 1000, 10000};
+    printf("\n| %-12s | %-12s | %-11s | %-12s | %-11s | %-11s | %-10s | %s\n", "Territórios", "Cenário",
+           "Busca (µs)", "Máx. (µs)", "Memo (µs)", "Alter.(µs)", "Reaprov.", "Passos");
+    for (size_t m = 0; m < sizeof(tamanhosPlano) / sizeof(tamanhosPlano[0]); m++) {
+        medirPlanejador(tamanhosPlano[m], 0, semente);
+        medirPlanejador(tamanhosPlano[m], 1, semente);
+    }
+
+    // Ramos de busca/s: cópia completa contra o histórico de versões, até 100 mil territórios
+    const int tamanhosHistorico[] = {TERRITORIOS_CLASSICO, 1000, 10000, 100000};
+    printf("\n| %-12s | %-13s | %-13s | %-9s | %-12s | %-13s | %s\n",
+           "Territórios", "Cópia/s", "Histórico/s", "Ganho", "Bytes cópia", "Bytes versão", "Igual");
+    for (size_t m = 0; m < sizeof(tamanhosHistorico) / sizeof(tamanhosHistorico[0]); m++) {
+        medirHistorico(tamanhosHistorico[m], semente);
+    }
+
+    // Partidas/s sem e com o diário binário de eventos (o custo deve ficar abaixo de 5%)
+    long partidasDiario = rodadas / 5000 > 0 ? rodadas / 5000 : 1;
+    printf("\n| %-10s | %-12s | %-12s | %-8s | %-9s | %-11s | %-7s | %s\n",
+           "Política", "Sem diário/s", "Com diário/s", "Custo", "Bytes/p.", "Gravad.(ms)", "Esperas", "Arquivo");
+    medirDiario(&politicaGulosa, partidasDiario, semente);
+    medirDiario(&politicaAleatoria, partidasDiario, semente);
+
+    // Partidas/s no mapa clássico: motor genérico contra o especializado em 5 territórios
+    long partidasMotor = rodadas / 25 > 0 ? rodadas / 25 : 1;
+    printf("\n| %-10s | %-12s | %-12s | %-9s | %s\n", "Política", "Genérico/s", "Compacto/s", "Ganho", "Igual");
+    medirMotores(&politicaGulosa, partidasMotor, semente);
+    medirMotores(&politicaAleatoria, partidasMotor, semente);
+
+    // Microssegundos por página das visões do mapa: índices contra varredura com qsort, até 100 mil territórios
+    const int tamanhosVista[] = {TERRITORIOS_CLASSICO, 1000, 100000};
+    printf("\n| %-12s | %-15s | %-15s | %-9s | %-14s | %-8s | %s\n",
+           "Territórios", "Página (µs)", "Varredura (µs)", "Ganho", "Atualiz. (µs)", "Custo", "Igual");
+    for (size_t m = 0; m < sizeof(tamanhosVista) / sizeof(tamanhosVista[0]); m++) {
+        medirVistas(tamanhosVista[m], semente);
+    }
+
+    // Simulações/s do jogador automático, com uma thread e com todos os núcleos
+    const int tamanhosMcts[] = {TERRITORIOS_CLASSICO, 1000, 10000};
+    printf("\n| %-11s | %-7s | %-14s | %-14s | %s\n", "Territórios", "Threads", "Simulações/s", "Sim./decisão", "ms/decisão");
+    for (size_t m = 0; m < sizeof(tamanhosMcts) / sizeof(tamanhosMcts[0]); m++) {
+        medirMcts(tamanhosMcts[m], 1, semente);
+        if (numeroDeNucleos() > 1) medirMcts(tamanhosMcts[m], numeroDeNucleos(), semente);
+    }
+    liberarTabelaBatalhas();
+    return 0;
+}
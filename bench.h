@@ -0,0 +1,29 @@
+/**
+ * @file bench.h
+ * @brief Microbenchmarks das funções mais quentes do jogo.
+ *
+ * Mede rodadas de dados/s, dados sorteados/s e buscas de território por
+ * nome/s em mapas de 5, 1 mil e 1 milhão de territórios, as batalhas/s de
+ * cada núcleo das rodadas em lote (escalar, SSE4.1 e AVX2), as partidas de vida
+ * curta criadas e destruídas por segundo (alocador direto contra o pool de
+ * arenas, ver arena.h), o tempo de uma consulta ao planejador de ataques em
+ * mapas de até 10 mil territórios (busca completa, plano memorizado e plano
+ * depois de uma alteração), os ramos de busca/s desfeitos por cópia completa
+ * e pelo histórico de versões (historico.h), com a memória de cada versão, as
+ * partidas/s com e sem o diário binário de eventos (eventos.h), as
+ * partidas/s no motor genérico e no compacto (mapa clássico), o tempo de
+ * uma página das visões ordenadas do mapa (vista.h) contra a varredura com
+ * qsort e o custo de manter os índices a cada ataque, e as simulações/s
+ * do jogador automático (MCTS) para acompanhar regressões do motor.
+ */
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdint.h>
+
+#define BENCH_RODADAS_PADRAO 5000000L // Rodadas de dados medidas por padrão
+
+// --- Protótipos das Funções ---
+int executarBenchmarks(long rodadas, uint64_t semente); // Função para medir e reportar as rodadas/s
+
+#endif // BENCH_H
@@ -0,0 +1,349 @@
+/**
+ * @file carga.c
+ * @brief Implementação do cliente de carga do servidor de partidas.
+ * @note Um único laço epoll conduz todas as conexões; os envios são
+ *       agendados em intervalos fixos por partida, começando espalhados pelo
+ *       primeiro intervalo para não chegarem todos juntos.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/epoll.h>
+
+#include "carga.h"
+#include "jogo.h"
+#include "simulacao.h"
+
+// Próximo comando de cada partida
+enum FaseCarga { FASE_NOVA, FASE_JOGADORES, FASE_DISTRIBUIR, FASE_SUGERIR, FASE_ATAQUE, FASE_FIM, FASE_MAPA };
+
+// Uma conexão do cliente de carga e a partida que ela joga
+struct PartidaCarga {
+    int fd;
+    enum FaseCarga fase;              // Próximo comando a enviar
+    double proximoEnvio;              // Quando enviar o próximo comando
+    double enviadoEm;                 // Envio do comando em espera (0 = nenhum)
+    int vencedor;                     // 1 se a resposta em leitura anunciou um vencedor
+    int ataquesTurno;                 // Ataques do jogador da vez
+    int turnos;                       // Turnos da partida
+    char sugestao[2 * 128];           // "ORIGEM DESTINO" da última sugestão
+    char resposta[CARGA_TAM_RESPOSTA]; // Bytes recebidos e ainda não tratados
+    size_t usado;
+};
+
+// Latências medidas (segundos), num vetor que cresce
+struct Latencias {
+    double *valores;
+    long total;
+    long capacidade;
+};
+
+/**
+ * @brief Conecta ao socket do servidor (bloqueante).
+ * @return Descritor ou -1 em caso de erro
+ */
+static int conectar(const char *caminho) {
+    struct sockaddr_un endereco = {0};
+    if (strlen(caminho) >= sizeof(endereco.sun_path)) return -1;
+    endereco.sun_family = AF_UNIX;
+    strcpy(endereco.sun_path, caminho);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+    if (connect(fd, (const struct sockaddr *) &endereco, sizeof(endereco)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/**
+ * @brief Envia um comando inteiro, repetindo escritas parciais.
+ * @return 0 em caso de sucesso, 1 em caso de erro
+ */
+static int enviarTudo(int fd, const char *texto, size_t tamanho) {
+    while (tamanho > 0) {
+        ssize_t n = send(fd, texto, tamanho, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return 1;
+        }
+        texto += n;
+        tamanho -= (size_t) n;
+    }
+    return 0;
+}
+
+/**
+ * @brief Lê o tempo de CPU do servidor pelo comando 'estatisticas'.
+ * @param fd Conexão de controle (bloqueante)
+ * @return Segundos de CPU do processo servidor, ou -1 em caso de erro
+ */
+static double cpuServidor(int fd) {
+    static const char comando[] = "estatisticas\n";
+    if (enviarTudo(fd, comando, sizeof(comando) - 1) != 0) return -1.0;
+
+    char linha[512];
+    size_t usado = 0;
+    while (usado < sizeof(linha) - 1) {
+        ssize_t n = read(fd, linha + usado, sizeof(linha) - 1 - usado);
+        if (n <= 0) return -1.0;
+        usado += (size_t) n;
+        if (memchr(linha, '\n', usado) != NULL) break;
+    }
+    linha[usado] = '\0';
+    const char *cpu = strstr(linha, "cpu_ns ");
+    return cpu ? strtod(cpu + 7, NULL) / 1e9 : -1.0;
+}
+
+/**
+ * @brief Guarda uma latência.
+ * @return 0 em caso de sucesso, 1 se faltou memória
+ */
+static int registrarLatencia(struct Latencias *latencias, double segundos) {
+    if (latencias->total == latencias->capacidade) {
+        long capacidade = latencias->capacidade ? latencias->capacidade * 2 : 65536;
+        double *valores = (double *) realloc(latencias->valores, (size_t) capacidade * sizeof(double));
+        if (valores == NULL) return 1;
+        latencias->valores = valores;
+        latencias->capacidade = capacidade;
+    }
+    latencias->valores[latencias->total++] = segundos;
+    return 0;
+}
+
+static int compararDouble(const void *a, const void *b) {
+    double x = *(const double *) a;
+    double y = *(const double *) b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Monta o próximo comando da partida e o envia.
+ * @return 0 em caso de sucesso, 1 se a conexão caiu
+ */
+static int enviarComando(struct PartidaCarga *partida, double agora, uint64_t semente) {
+    char comando[512];
+    int n = 0;
+    switch (partida->fase) {
+        case FASE_NOVA:       n = snprintf(comando, sizeof(comando), "nova %llu\n", (unsigned long long) semente); break;
+        case FASE_JOGADORES:  n = snprintf(comando, sizeof(comando), "jogadores Vermelho Azul Verde\n"); break;
+        case FASE_DISTRIBUIR: n = snprintf(comando, sizeof(comando), "distribuir\n"); break;
+        case FASE_SUGERIR:    n = snprintf(comando, sizeof(comando), "sugerir\n"); break;
+        case FASE_ATAQUE:     n = snprintf(comando, sizeof(comando), "1 %s 3 0 0 3\n", partida->sugestao); break;
+        case FASE_FIM:        n = snprintf(comando, sizeof(comando), "4\n"); break;
+        case FASE_MAPA:       n = snprintf(comando, sizeof(comando), "2\n"); break;
+    }
+    partida->enviadoEm = agora;
+    partida->vencedor = 0;
+    return enviarTudo(partida->fd, comando, (size_t) n);
+}
+
+/**
+ * @brief Escolhe o próximo comando a partir da linha final da resposta.
+ * @param final Linha "ok ..." ou "erro ..."
+ * @return 1 se uma partida terminou
+ */
+static int avancarFase(struct PartidaCarga *partida, const char *final) {
+    int erro = strncmp(final, "erro", 4) == 0;
+    switch (partida->fase) {
+        case FASE_NOVA:
+            partida->fase = FASE_JOGADORES;
+            partida->turnos = 0;
+            return 0;
+        case FASE_JOGADORES:
+            partida->fase = erro ? FASE_NOVA : FASE_DISTRIBUIR;
+            return 0;
+        case FASE_DISTRIBUIR:
+            partida->fase = partida->vencedor ? FASE_NOVA : FASE_SUGERIR;
+            partida->ataquesTurno = 0;
+            return partida->vencedor;
+        case FASE_SUGERIR:
+            if (erro || strcmp(final, "ok nenhum") == 0 || partida->ataquesTurno >= SIM_MAX_ATAQUES_TURNO) {
+                partida->fase = FASE_FIM;
+            } else {
+                snprintf(partida->sugestao, sizeof(partida->sugestao), "%s", final + 3);
+                partida->fase = FASE_ATAQUE;
+            }
+            return 0;
+        case FASE_ATAQUE:
+            partida->ataquesTurno++;
+            partida->fase = partida->vencedor ? FASE_NOVA : (erro ? FASE_FIM : FASE_SUGERIR);
+            return partida->vencedor;
+        case FASE_FIM:
+            // Partida travada: recomeça
+            partida->fase = (++partida->turnos >= SIM_MAX_TURNOS) ? FASE_NOVA : FASE_MAPA;
+            partida->ataquesTurno = 0;
+            return 0;
+        case FASE_MAPA:
+            partida->fase = FASE_SUGERIR;
+            return 0;
+    }
+    return 0;
+}
+
+/**
+ * @brief Função para medir latência e partidas por núcleo do servidor
+ * @param caminho Socket do servidor
+ * @param numPartidas Conexões (partidas simultâneas)
+ * @param taxa Comandos por segundo de cada partida (0 = sem pausa)
+ * @param semente Semente das partidas (a partida p da conexão c usa uma semente derivada)
+ * @return 0 em caso de sucesso, 1 em caso de erro (a mensagem já foi impressa)
+ */
+int executarCarga(const char *caminho, int numPartidas, double taxa, uint64_t semente) {
+    if (numPartidas < 1 || taxa < 0) {
+        printf("Número de partidas deve ser positivo e a taxa não negativa.\n");
+        return 1;
+    }
+
+    struct PartidaCarga *partidas = (struct PartidaCarga *) calloc((size_t) numPartidas, sizeof(struct PartidaCarga));
+    struct Latencias latencias = {0};
+    int controle = conectar(caminho);
+    int epoll = epoll_create1(0);
+    if (partidas == NULL || controle < 0 || epoll < 0) {
+        printf("Erro ao conectar ao servidor em %s.\n", caminho);
+        free(partidas);
+        if (controle >= 0) close(controle);
+        if (epoll >= 0) close(epoll);
+        return 1;
+    }
+
+    int erro = 0;
+    int conectadas = 0;
+    double periodo = taxa > 0 ? 1.0 / taxa : 0.0;
+    double inicio = relogioSegundos();
+    for (; conectadas < numPartidas; conectadas++) {
+        struct PartidaCarga *partida = &partidas[conectadas];
+        partida->fd = conectar(caminho);
+        struct epoll_event evento = {0};
+        evento.events = EPOLLIN;
+        evento.data.ptr = partida;
+        if (partida->fd < 0 || fcntl(partida->fd, F_SETFL, O_NONBLOCK) != 0 ||
+            epoll_ctl(epoll, EPOLL_CTL_ADD, partida->fd, &evento) != 0) {
+            printf("Erro ao abrir a conexão %d ao servidor em %s.\n", conectadas + 1, caminho);
+            if (partida->fd >= 0) close(partida->fd);
+            erro = 1;
+            break;
+        }
+        partida->fase = FASE_NOVA;
+        partida->proximoEnvio = inicio + periodo * conectadas / numPartidas;
+    }
+
+    long comandos = 0, falhas = 0, terminadas = 0, partidasIniciadas = 0;
+    double cpuInicial = cpuServidor(controle);
+    inicio = relogioSegundos();
+    double fim = inicio + CARGA_DURACAO_S;
+    struct epoll_event eventos[256];
+
+    while (!erro) {
+        double agora = relogioSegundos();
+        if (agora >= fim) break;
+
+        // Envia os comandos vencidos e calcula a espera até o próximo
+        double proximo = fim;
+        for (int i = 0; i < conectadas && !erro; i++) {
+            struct PartidaCarga *partida = &partidas[i];
+            if (partida->enviadoEm > 0) continue;
+            if (partida->proximoEnvio <= agora) {
+                uint64_t sementePartida = semente + (uint64_t) i * 1000003u + (uint64_t) partidasIniciadas;
+                if (partida->fase == FASE_NOVA) partidasIniciadas++;
+                if (enviarComando(partida, agora, sementePartida) != 0) {
+                    printf("O servidor fechou a conexão %d.\n", i + 1);
+                    erro = 1;
+                }
+            } else if (partida->proximoEnvio < proximo) {
+                proximo = partida->proximoEnvio;
+            }
+        }
+
+        int espera = (int) ((proximo - agora) * 1000.0);
+        if (espera > 100) espera = 100;
+        int n = epoll_wait(epoll, eventos, 256, espera < 0 ? 0 : espera);
+        if (n < 0 && errno != EINTR) {
+            perror("epoll_wait");
+            erro = 1;
+        }
+        for (int e = 0; e < n && !erro; e++) {
+            struct PartidaCarga *partida = (struct PartidaCarga *) eventos[e].data.ptr;
+            ssize_t lidos = read(partida->fd, partida->resposta + partida->usado, sizeof(partida->resposta) - 1 - partida->usado);
+            if (lidos <= 0) {
+                if (lidos < 0 && (errno == EAGAIN || errno == EINTR)) continue;
+                printf("O servidor fechou uma conexão.\n");
+                erro = 1;
+                break;
+            }
+            partida->usado += (size_t) lidos;
+
+            // Trata as linhas completas; a última de cada resposta é "ok" ou "erro"
+            char *linha = partida->resposta;
+            char *quebra;
+            while ((quebra = (char *) memchr(linha, '\n', partida->usado - (size_t) (linha - partida->resposta))) != NULL) {
+                *quebra = '\0';
+                if (strncmp(linha, "vencedor", 8) == 0) {
+                    partida->vencedor = 1;
+                } else if (strncmp(linha, "ok", 2) == 0 || strncmp(linha, "erro", 4) == 0) {
+                    double chegada = relogioSegundos();
+                    if (registrarLatencia(&latencias, chegada - partida->enviadoEm) != 0) erro = 1;
+                    comandos++;
+                    if (linha[0] == 'e') falhas++;
+                    terminadas += avancarFase(partida, linha);
+                    partida->enviadoEm = 0;
+                    partida->proximoEnvio = periodo > 0 ? partida->proximoEnvio + periodo : chegada;
+                    if (partida->proximoEnvio < chegada - periodo) partida->proximoEnvio = chegada; // Atrasada demais: não tenta compensar
+                }
+                linha = quebra + 1;
+            }
+            size_t restante = partida->usado - (size_t) (linha - partida->resposta);
+            if (restante >= sizeof(partida->resposta) - 1) {
+                printf("Resposta do servidor longa demais.\n");
+                erro = 1;
+            }
+            memmove(partida->resposta, linha, restante);
+            partida->usado = restante;
+        }
+    }
+    double duracao = relogioSegundos() - inicio;
+    double cpuFinal = cpuServidor(controle);
+
+    if (!erro && latencias.total > 0) {
+        qsort(latencias.valores, (size_t) latencias.total, sizeof(double), compararDouble);
+        const double percentis[] = {0.50, 0.90, 0.99, 0.999};
+        double cpu = (cpuInicial >= 0 && cpuFinal >= 0) ? cpuFinal - cpuInicial : -1.0;
+        double uso = cpu >= 0 ? cpu / duracao : 0.0;
+
+        printf("========================================\n");
+        printf("======      CARGA DO SERVIDOR     ======\n");
+        printf("========================================\n");
+        printf("Servidor             : %s\n", caminho);
+        printf("Partidas simultâneas : %d\n", numPartidas);
+        if (taxa > 0) printf("Ritmo por partida    : %.1f comandos/s\n", taxa);
+        else printf("Ritmo por partida    : sem pausa (uma resposta, um comando)\n");
+        printf("Duração              : %.3f s\n", duracao);
+        printf("Comandos             : %ld (%.0f/s), %ld com erro\n", comandos, comandos / duracao, falhas);
+        printf("Partidas terminadas  : %ld\n", terminadas);
+        printf("Latência (µs)        :");
+        for (int p = 0; p < 4; p++) {
+            long k = (long) (percentis[p] * (latencias.total - 1));
+            printf(" p%g %.1f", percentis[p] * 100, latencias.valores[k] * 1e6);
+        }
+        printf(" máx %.1f\n", latencias.valores[latencias.total - 1] * 1e6);
+        if (cpu >= 0) {
+            printf("CPU do servidor      : %.3f s (%.1f%% de um núcleo)\n", cpu, uso * 100.0);
+            if (uso > 0) printf("Partidas por núcleo  : %.0f (neste ritmo)\n", numPartidas / uso);
+            printf("Comandos/s de CPU    : %.0f\n", cpu > 0 ? comandos / cpu : 0.0);
+        }
+    }
+
+    for (int i = 0; i < conectadas; i++) close(partidas[i].fd);
+    close(controle);
+    close(epoll);
+    free(partidas);
+    free(latencias.valores);
+    return erro;
+}
@@ -0,0 +1,30 @@
+/**
+ * @file carga.h
+ * @brief Cliente de carga do servidor de partidas (ver servidor.h).
+ *
+ * Abre N conexões ao socket do servidor, cada uma jogando partidas inteiras
+ * pelo protocolo de linhas: nova, jogadores, distribuir e depois turnos de
+ * sugerir/ataque, fim e mapa, como faria uma interface que redesenha o mapa
+ * a cada turno. Cada partida envia um comando por vez (espera a resposta) no
+ * ritmo de 'taxa' comandos por segundo; com taxa 0, envia o próximo assim
+ * que a resposta chega.
+ *
+ * O relatório traz a latência de cada comando (do envio ao fim da resposta)
+ * nos percentis 50, 90, 99 e 99,9, os comandos por segundo e o tempo de CPU
+ * gasto pelo servidor no período (lido com o comando 'estatisticas'). Desse
+ * tempo sai a estimativa de partidas por núcleo: quantas partidas, neste
+ * ritmo, ocupariam um núcleo inteiro do servidor.
+ */
+#ifndef CARGA_H
+#define CARGA_H
+
+#include <stdint.h>
+
+#define CARGA_DURACAO_S 3.0        // Duração da medição, em segundos
+#define CARGA_TAXA_PADRAO 10.0     // Comandos por segundo de cada partida, por padrão
+#define CARGA_TAM_RESPOSTA 4096    // Bytes de resposta guardados por conexão (as linhas são tratadas ao chegar)
+
+// --- Protótipos das Funções ---
+int executarCarga(const char *caminho, int numPartidas, double taxa, uint64_t semente); // Função para medir latência e partidas por núcleo do servidor
+
+#endif // CARGA_H
@@ -0,0 +1,266 @@
+/**
+ * @file estado.c
+ * @brief Implementação dos arquivos de estado da partida.
+ * @note Na partida retomada, tropas, dono e posse apontam para o mapeamento
+ *       do arquivo (jogo->mapeamento); liberarJogo desfaz o mapeamento em vez
+ *       de liberar esses vetores.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+
+#include "estado.h"
+
+static const char MAGICA_ESTADO[8] = "WARESTD";
+
+#define ESTADO_AMOSTRA_NOMES 64 // Nomes do mapa usados na assinatura
+
+/**
+ * @brief Arredonda uma posição do arquivo para o próximo múltiplo de ESTADO_ALINHAMENTO.
+ */
+static uint64_t alinhar(uint64_t posicao) {
+    return (posicao + ESTADO_ALINHAMENTO - 1) & ~(uint64_t) (ESTADO_ALINHAMENTO - 1);
+}
+
+/**
+ * @brief Calcula a assinatura de um mapa (FNV-1a).
+ * @note Usa o número de territórios e de fronteiras e uma amostra de até
+ *       ESTADO_AMOSTRA_NOMES nomes espalhados pelo mapa: distingue mapas
+ *       diferentes sem percorrer um mapa de milhões de territórios.
+ */
+static uint64_t assinarMapa(const struct Mapa *mapa) {
+    uint64_t hash = 1469598103934665603ULL;
+    uint64_t tamanhos[2] = {(uint64_t) mapa->numTerritorios, (uint64_t) mapa->numFronteiras};
+    for (int i = 0; i < 2; i++) {
+        hash ^= tamanhos[i];
+        hash *= 1099511628211ULL;
+    }
+
+    int passo = mapa->numTerritorios / ESTADO_AMOSTRA_NOMES + 1;
+    for (int t = 0; t < mapa->numTerritorios; t += passo) {
+        for (const unsigned char *c = (const unsigned char *) nomeTerritorio(mapa, t); *c; c++) {
+            hash ^= *c;
+            hash *= 1099511628211ULL;
+        }
+    }
+    return hash;
+}
+
+/**
+ * @brief Preenche as posições dos vetores no arquivo a partir dos tamanhos da partida.
+ */
+static void calcularLayout(struct CabecalhoEstado *cabecalho) {
+    uint64_t n = (uint64_t) cabecalho->numTerritorios;
+    cabecalho->inicioTropas = alinhar(sizeof(struct CabecalhoEstado));
+    cabecalho->inicioPosse = alinhar(cabecalho->inicioTropas + n * sizeof(int32_t));
+    cabecalho->inicioDono = alinhar(cabecalho->inicioPosse +
+                                    (uint64_t) cabecalho->numCores * cabecalho->palavrasPosse * sizeof(uint64_t));
+    cabecalho->tamanhoArquivo = cabecalho->inicioDono + n;
+}
+
+/**
+ * @brief Função para gravar o estado da partida num arquivo
+ * @note O arquivo é gravado com uma única chamada a writev (repetida só se a
+ *       escrita for parcial); os espaços de alinhamento são zeros.
+ * @param jogo Partida a gravar
+ * @param indiceJogador Jogador da vez
+ * @param caminho Arquivo de destino (sobrescrito)
+ * @return 0 em caso de sucesso, 1 em caso de erro (a mensagem já foi impressa)
+ */
+int salvarPartida(const struct Jogo *jogo, int indiceJogador, const char *caminho) {
+    struct CabecalhoEstado cabecalho;
+    memset(&cabecalho, 0, sizeof(cabecalho));
+    memcpy(cabecalho.magica, MAGICA_ESTADO, sizeof(cabecalho.magica));
+    cabecalho.versao = ESTADO_VERSAO;
+    cabecalho.ordemBytes = 0x01020304u;
+    cabecalho.assinaturaMapa = assinarMapa(jogo->mapa);
+    cabecalho.numTerritorios = jogo->numTerritorios;
+    cabecalho.palavrasPosse = jogo->palavrasPosse;
+    cabecalho.numJogadores = jogo->numJogadores;
+    cabecalho.numCores = jogo->numCores;
+    cabecalho.indiceJogador = indiceJogador;
+    cabecalho.vencedor = jogo->vencedor;
+    memcpy(cabecalho.rng, jogo->rng.s, sizeof(cabecalho.rng));
+    for (int c = 0; c < jogo->numCores; c++) cabecalho.territoriosCor[c] = jogo->territoriosCor[c];
+    for (int i = 0; i < jogo->numJogadores; i++) {
+        cabecalho.jogadores[i].cor = jogo->jogadores[i].cor;
+        cabecalho.jogadores[i].missao = jogo->jogadores[i].missao;
+        cabecalho.jogadores[i].missaoCumprida = jogo->jogadores[i].missaoCumprida;
+        cabecalho.jogadores[i].conquistas = jogo->jogadores[i].conquistas;
+    }
+    calcularLayout(&cabecalho);
+
+    // Zeros para os espaços entre os vetores (nunca mais que o alinhamento)
+    static const char zeros[ESTADO_ALINHAMENTO];
+    size_t tamanhoTropas = (size_t) jogo->numTerritorios * sizeof(int32_t);
+    size_t tamanhoPosse = (size_t) jogo->numCores * jogo->palavrasPosse * sizeof(uint64_t);
+    struct iovec pedacos[7] = {
+        {&cabecalho, sizeof(cabecalho)},
+        {(void *) zeros, (size_t) (cabecalho.inicioTropas - sizeof(cabecalho))},
+        {jogo->tropas, tamanhoTropas},
+        {(void *) zeros, (size_t) (cabecalho.inicioPosse - cabecalho.inicioTropas - tamanhoTropas)},
+        {jogo->posse, tamanhoPosse},
+        {(void *) zeros, (size_t) (cabecalho.inicioDono - cabecalho.inicioPosse - tamanhoPosse)},
+        {jogo->dono, (size_t) jogo->numTerritorios}
+    };
+
+    int fd = open(caminho, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        printf("Erro ao criar o arquivo de estado %s: %s\n", caminho, strerror(errno));
+        return 1;
+    }
+
+    // Uma escrita para o arquivo inteiro; se o sistema escrever só uma parte, continua de onde parou
+    struct iovec *pedaco = pedacos;
+    int restantes = 7;
+    while (restantes > 0) {
+        ssize_t escritos = writev(fd, pedaco, restantes);
+        if (escritos < 0 && errno == EINTR) continue;
+        if (escritos <= 0) {
+            printf("Erro ao gravar o arquivo de estado %s: %s\n", caminho, strerror(errno));
+            close(fd);
+            return 1;
+        }
+        while (restantes > 0 && (size_t) escritos >= pedaco->iov_len) {
+            escritos -= (ssize_t) pedaco->iov_len;
+            pedaco++;
+            restantes--;
+        }
+        if (restantes > 0) {
+            pedaco->iov_base = (char *) pedaco->iov_base + escritos;
+            pedaco->iov_len -= (size_t) escritos;
+        }
+    }
+
+    if (close(fd) != 0) {
+        printf("Erro ao gravar o arquivo de estado %s: %s\n", caminho, strerror(errno));
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Função para retomar uma partida de um arquivo
+ * @note O arquivo é mapeado com MAP_PRIVATE: as alterações da partida
+ *       retomada nunca voltam para o arquivo. Os jogadores ficam sem política
+ *       (quem retoma define) e a partida fica silenciosa (verboso = 0).
+ * @param jogo Partida a preencher (não alocada; liberar com liberarJogo)
+ * @param mapa Mapa da partida (o mesmo usado ao salvar)
+ * @param caminho Arquivo gravado por salvarPartida
+ * @param indiceJogador Recebe o jogador da vez
+ * @return 0 em caso de sucesso, 1 em caso de erro (a mensagem já foi impressa e nada fica alocado)
+ */
+int retomarPartida(struct Jogo *jogo, const struct Mapa *mapa, const char *caminho, int *indiceJogador) {
+    int fd = open(caminho, O_RDONLY);
+    if (fd < 0) {
+        printf("Erro ao abrir o arquivo de estado %s: %s\n", caminho, strerror(errno));
+        return 1;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (size_t) info.st_size < sizeof(struct CabecalhoEstado)) {
+        printf("Arquivo de estado %s inválido: tamanho %lld.\n", caminho, (long long) info.st_size);
+        close(fd);
+        return 1;
+    }
+    size_t tamanho = (size_t) info.st_size;
+    void *mapeamento = mmap(NULL, tamanho, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapeamento == MAP_FAILED) {
+        printf("Erro ao mapear o arquivo de estado %s: %s\n", caminho, strerror(errno));
+        return 1;
+    }
+
+    // Confere o cabeçalho antes de confiar em qualquer posição dele
+    const struct CabecalhoEstado *cabecalho = (const struct CabecalhoEstado *) mapeamento;
+    struct CabecalhoEstado esperado;
+    memset(&esperado, 0, sizeof(esperado));
+    esperado.numTerritorios = mapa->numTerritorios;
+    esperado.palavrasPosse = (mapa->numTerritorios + 63) / 64;
+    esperado.numCores = cabecalho->numCores;
+    calcularLayout(&esperado);
+
+    const char *problema = NULL;
+    if (memcmp(cabecalho->magica, MAGICA_ESTADO, sizeof(cabecalho->magica)) != 0) problema = "não é um arquivo de estado";
+    else if (cabecalho->versao != ESTADO_VERSAO) problema = "versão do formato diferente";
+    else if (cabecalho->ordemBytes != 0x01020304u) problema = "gravado numa máquina com outra ordem de bytes";
+    else if (cabecalho->assinaturaMapa != assinarMapa(mapa) || cabecalho->numTerritorios != mapa->numTerritorios) problema = "gravado com outro mapa";
+    else if (cabecalho->numCores < CORES_CLASSICAS || cabecalho->numCores > MAX_CORES) problema = "número de cores inválido";
+    else if (cabecalho->palavrasPosse != esperado.palavrasPosse || cabecalho->inicioTropas != esperado.inicioTropas ||
+             cabecalho->inicioPosse != esperado.inicioPosse || cabecalho->inicioDono != esperado.inicioDono ||
+             cabecalho->tamanhoArquivo != tamanho) problema = "layout ou tamanho incoerente";
+    else if (cabecalho->numJogadores < 1 || cabecalho->numJogadores > cabecalho->numCores ||
+             cabecalho->indiceJogador < 0 || cabecalho->indiceJogador >= cabecalho->numJogadores) problema = "jogadores inválidos";
+    for (int i = 0; problema == NULL && i < cabecalho->numJogadores; i++) {
+        const struct JogadorGravado *gravado = &cabecalho->jogadores[i];
+        if (gravado->cor < 0 || gravado->cor >= cabecalho->numCores || gravado->missao < 0 || gravado->missao >= TOTAL_MISSOES ||
+            Missoes[gravado->missao].cor >= cabecalho->numCores) {
+            problema = "jogadores inválidos";
+        }
+    }
+    if (problema == NULL && (cabecalho->vencedor < -1 || cabecalho->vencedor >= cabecalho->numJogadores)) problema = "vencedor inválido";
+    if (problema == NULL) {
+        // Cada território é de ninguém (antes da distribuição) ou de uma cor de um dos jogadores
+        int corDeJogador[MAX_CORES] = {0};
+        for (int i = 0; i < cabecalho->numJogadores; i++) corDeJogador[cabecalho->jogadores[i].cor] = 1;
+        const int8_t *dono = (const int8_t *) ((const char *) mapeamento + cabecalho->inicioDono);
+        for (int t = 0; t < cabecalho->numTerritorios; t++) {
+            if (dono[t] != SEM_COR && (dono[t] < 0 || dono[t] >= cabecalho->numCores || !corDeJogador[dono[t]])) {
+                problema = "dono de território inválido";
+                break;
+            }
+        }
+    }
+    if (problema != NULL) {
+        printf("Arquivo de estado %s inválido: %s.\n", caminho, problema);
+        munmap(mapeamento, tamanho);
+        return 1;
+    }
+
+    memset(jogo, 0, sizeof(*jogo));
+    jogo->jogadores = alocarMemoriaJogadores();
+    if (jogo->jogadores == NULL) {
+        printf("Erro na alocação de memória para os jogadores.\n");
+        munmap(mapeamento, tamanho);
+        return 1;
+    }
+
+    // Os vetores da partida são as próprias páginas do arquivo
+    char *base = (char *) mapeamento;
+    jogo->mapa = mapa;
+    jogo->numTerritorios = mapa->numTerritorios;
+    jogo->numCores = cabecalho->numCores;
+    jogo->palavrasPosse = cabecalho->palavrasPosse;
+    jogo->tropas = (int32_t *) (void *) (base + cabecalho->inicioTropas);
+    jogo->posse = (uint64_t *) (void *) (base + cabecalho->inicioPosse);
+    jogo->dono = (int8_t *) (base + cabecalho->inicioDono);
+    jogo->mapeamento = mapeamento;
+    jogo->tamanhoMapeamento = tamanho;
+    definirMotor(jogo, escolherMotor(mapa));
+
+    memcpy(jogo->rng.s, cabecalho->rng, sizeof(jogo->rng.s));
+    jogo->numJogadores = cabecalho->numJogadores;
+    jogo->vencedor = cabecalho->vencedor;
+    for (int c = 0; c < jogo->numCores; c++) {
+        jogo->territoriosCor[c] = cabecalho->territoriosCor[c];
+        jogo->jogadorDaCor[c] = -1;
+        jogo->cacadorDaCor[c] = -1;
+    }
+    for (int i = 0; i < jogo->numJogadores; i++) {
+        const struct JogadorGravado *gravado = &cabecalho->jogadores[i];
+        jogo->jogadores[i].cor = gravado->cor;
+        jogo->jogadores[i].missao = gravado->missao;
+        jogo->jogadores[i].missaoCumprida = gravado->missaoCumprida;
+        jogo->jogadores[i].conquistas = gravado->conquistas;
+        jogo->jogadorDaCor[gravado->cor] = i;
+        if (Missoes[gravado->missao].cor != SEM_COR) jogo->cacadorDaCor[Missoes[gravado->missao].cor] = i;
+    }
+    *indiceJogador = cabecalho->indiceJogador;
+    return 0;
+}
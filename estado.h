@@ -0,0 +1,64 @@
+/**
+ * @file estado.h
+ * @brief Arquivos de estado da partida (salvar e retomar).
+ *
+ * O arquivo tem um formato binário fixo e versionado: um cabeçalho com os
+ * jogadores, as missões, o jogador da vez, o vencedor e o estado do gerador
+ * de números aleatórios, seguido dos vetores da partida exatamente como
+ * ficam na memória (tropas, conjuntos de posse e donos), cada um alinhado
+ * em ESTADO_ALINHAMENTO bytes. Os números estão na ordem de bytes da máquina
+ * que gravou (o cabeçalho guarda uma marca para detectar a troca).
+ *
+ * Salvar é uma única escrita sequencial (writev dos quatro pedaços). Retomar
+ * mapeia o arquivo com mmap (MAP_PRIVATE): os vetores da partida passam a
+ * apontar para as páginas do arquivo, sem cópia nem reconstrução, e as
+ * páginas só são copiadas quando o jogo as altera. Uma partida de 1 milhão
+ * de territórios é retomada em milissegundos, contra refazer o cadastro.
+ *
+ * O arquivo vale apenas para o mesmo mapa: o cabeçalho guarda uma assinatura
+ * do mapa (tamanho, fronteiras e uma amostra dos nomes) conferida ao carregar.
+ */
+#ifndef ESTADO_H
+#define ESTADO_H
+
+#include <stdint.h>
+
+#include "jogo.h"
+
+#define ESTADO_VERSAO 2          // Versão do formato; muda a cada alteração do layout
+#define ESTADO_ALINHAMENTO 64    // Alinhamento de cada vetor dentro do arquivo
+
+// Jogador como fica no arquivo (campos de tamanho fixo, sem ponteiros)
+struct JogadorGravado {
+    int32_t cor;
+    int32_t missao;
+    int32_t missaoCumprida;
+    int32_t conquistas;
+};
+
+// Cabeçalho do arquivo de estado
+struct CabecalhoEstado {
+    char magica[8];                  // "WARESTD" + '\0'
+    uint32_t versao;                 // ESTADO_VERSAO
+    uint32_t ordemBytes;             // 0x01020304 gravado na ordem da máquina
+    uint64_t assinaturaMapa;         // Assinatura do mapa da partida
+    int32_t numTerritorios;          // Territórios do mapa
+    int32_t palavrasPosse;           // Palavras de 64 bits de cada conjunto de posse
+    int32_t numJogadores;            // Jogadores da partida
+    int32_t indiceJogador;           // Jogador da vez
+    int32_t vencedor;                // Vencedor (-1 se a partida não terminou)
+    int32_t numCores;                // Cores da partida (tamanho dos conjuntos de posse)
+    uint64_t rng[4];                 // Estado do gerador da partida
+    int32_t territoriosCor[MAX_CORES]; // Territórios de cada cor (só as numCores primeiras são usadas)
+    struct JogadorGravado jogadores[MAX_JOGADORES];
+    uint64_t inicioTropas;           // Posição do vetor de tropas no arquivo
+    uint64_t inicioPosse;            // Posição dos conjuntos de posse
+    uint64_t inicioDono;             // Posição do vetor de donos
+    uint64_t tamanhoArquivo;         // Tamanho total esperado do arquivo
+};
+
+// --- Protótipos das Funções ---
+int salvarPartida(const struct Jogo *jogo, int indiceJogador, const char *caminho); // Função para gravar o estado da partida num arquivo
+int retomarPartida(struct Jogo *jogo, const struct Mapa *mapa, const char *caminho, int *indiceJogador); // Função para retomar uma partida de um arquivo (mmap)
+
+#endif // ESTADO_H
@@ -0,0 +1,760 @@
+/**
+ * @file eventos.c
+ * @brief Implementação do diário binário de eventos: anéis por thread, gravadora e decodificador.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sched.h>
+#include <time.h>
+#include <pthread.h>
+#include <sys/uio.h>
+
+#include "eventos.h"
+
+#define DIARIO_CABECALHO_BLOCO 20 // Maior cabeçalho de bloco (dois varints)
+
+// Estado do diário aberto (um por processo)
+struct Diario {
+    int aberto;                  // 1 entre abrirDiario e fecharDiario
+    int parar;                   // Pedido de parada para a gravadora
+    int fd;                      // Arquivo do diário
+    const char *caminho;
+    pthread_t gravadora;
+    pthread_mutex_t trava;       // Lista de anéis (os anéis em si não usam trava)
+    struct AnelEventos *aneis;   // Anéis ainda não esvaziados de todo
+    int proximoId;
+
+    pthread_mutex_t travaAviso;  // Protege avisado (a gravadora dorme em aviso)
+    pthread_cond_t aviso;
+    int avisado;                 // 1 se algum anel acumulou DIARIO_GRAVACAO bytes desde a última passada
+
+    struct ResumoDiario resumo;  // Resumo impresso ou devolvido por fecharDiario
+    int erro;                    // errno da primeira gravação que falhou (0 se nenhuma)
+};
+
+__thread struct AnelEventos *AnelLocal = NULL;
+unsigned char PosicaoDados[343];
+
+// Dados de cada jogada de EVENTO_DADOS, o inverso de PosicaoDados
+static unsigned char DadosJogada[DADOS_JOGADAS][3];
+
+static struct Diario Diario = {.trava = PTHREAD_MUTEX_INITIALIZER, .travaAviso = PTHREAD_MUTEX_INITIALIZER,
+                                .aviso = PTHREAD_COND_INITIALIZER};
+static pthread_once_t ChaveCriada = PTHREAD_ONCE_INIT;
+static pthread_key_t ChaveAnel;
+
+/**
+ * @brief Marca o anel de uma thread que terminou (a gravadora o libera depois de esvaziá-lo).
+ * @param dados Anel da thread (struct AnelEventos).
+ */
+static void encerrarAnel(void *dados) {
+    struct AnelEventos *anel = (struct AnelEventos *) dados;
+    diarioPublicar(anel);
+    __atomic_store_n(&anel->encerrado, 1, __ATOMIC_RELEASE);
+}
+
+static void criarChave(void) {
+    pthread_key_create(&ChaveAnel, encerrarAnel);
+}
+
+/**
+ * @brief Numera as jogadas de 1 a 3 dados ordenados (decrescentes), na ordem
+ *        1 dado, 2 dados e 3 dados, cada grupo em ordem lexicográfica.
+ * @note Preenche PosicaoDados (usada por diarioDados) e seu inverso.
+ */
+static void numerarJogadas(void) {
+    int jogada = 0;
+    for (int numDados = 1; numDados <= 3; numDados++) {
+        for (int a = 1; a <= 6; a++) {
+            for (int b = numDados >= 2 ? 1 : 0; b <= (numDados >= 2 ? a : 0); b++) {
+                for (int c = numDados == 3 ? 1 : 0; c <= (numDados == 3 ? b : 0); c++) {
+                    PosicaoDados[(a * 7 + b) * 7 + c] = (unsigned char) jogada;
+                    DadosJogada[jogada][0] = (unsigned char) a;
+                    DadosJogada[jogada][1] = (unsigned char) b;
+                    DadosJogada[jogada][2] = (unsigned char) c;
+                    jogada++;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Escreve um varint num buffer.
+ * @return Bytes escritos (1 a 10)
+ */
+static size_t escreverVarint(unsigned char *destino, uint64_t valor) {
+    size_t n = 0;
+    while (valor >= 0x80) {
+        destino[n++] = (unsigned char) (valor | 0x80);
+        valor >>= 7;
+    }
+    destino[n++] = (unsigned char) valor;
+    return n;
+}
+
+/**
+ * @brief Função para escrever um registro com os campos em varint
+ * @note Caminho dos registros em que algum campo não cabe num byte; fica
+ *       fora de linha para não pesar no código de cada chamada.
+ * @param p Onde começa o registro (no anel)
+ * @param tipo Tipo do registro
+ * @param numCampos Número de campos
+ * @param campos Campos (o primeiro vai no byte de tipo, ou no escape e em varint)
+ * @return Posição seguinte ao registro
+ */
+unsigned char *diarioCamposVarint(unsigned char *p, int tipo, int numCampos, const uint64_t *campos) {
+    if (campos[0] < DIARIO_CAMPO_ESCAPE) {
+        *p++ = (unsigned char) (tipo | campos[0] << 3);
+    } else {
+        *p++ = (unsigned char) (tipo | DIARIO_CAMPO_ESCAPE << 3);
+        p += escreverVarint(p, campos[0] - DIARIO_CAMPO_ESCAPE);
+    }
+    for (int i = 1; i < numCampos; i++) p += escreverVarint(p, campos[i]);
+    return p;
+}
+
+/**
+ * @brief Função para trocar o último campo (1 byte) de um registro por um varint
+ * @note Caminho do movimento que não cabe num byte (ver diarioMovimento); o
+ *       registro continua dentro dos DIARIO_MAX_REGISTRO bytes reservados.
+ * @param fim Posição seguinte ao registro (no anel)
+ * @param valor Novo valor do campo
+ * @return Posição seguinte ao registro
+ */
+unsigned char *diarioTrocarCampoFinal(unsigned char *fim, uint64_t valor) {
+    return fim - 1 + escreverVarint(fim - 1, valor);
+}
+
+/**
+ * @brief Grava os trechos no arquivo com writev, até o fim (writev pode gravar menos que o pedido).
+ * @note Depois de um erro, o restante do diário é descartado (o erro aparece no resumo).
+ */
+static void gravarTrechos(struct iovec *trechos, int numTrechos) {
+    size_t total = 0;
+    for (int i = 0; i < numTrechos; i++) total += trechos[i].iov_len;
+    while (Diario.erro == 0 && numTrechos > 0) {
+        ssize_t n = writev(Diario.fd, trechos, numTrechos);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            Diario.erro = errno;
+            break;
+        }
+        // Pula os trechos já gravados e avança dentro do primeiro que faltou
+        while (numTrechos > 0 && (size_t) n >= trechos->iov_len) {
+            n -= (ssize_t) trechos->iov_len;
+            trechos++;
+            numTrechos--;
+        }
+        if (numTrechos > 0) {
+            trechos->iov_base = (char *) trechos->iov_base + n;
+            trechos->iov_len -= (size_t) n;
+        }
+    }
+    if (Diario.erro == 0) {
+        Diario.resumo.bytes += (long long) total;
+        Diario.resumo.gravacoes++;
+    }
+}
+
+/**
+ * @brief Grava, como um bloco, o que o anel acumulou, direto do anel.
+ * @param minimo Menor acúmulo que vale uma gravação (1 para esvaziar o anel)
+ * @return Bytes gravados do anel (0 se ele tinha menos que minimo)
+ */
+static size_t esvaziarAnel(struct AnelEventos *anel, size_t minimo) {
+    uint64_t cauda = anel->cauda;
+    uint64_t cabeca = __atomic_load_n(&anel->cabeca, __ATOMIC_ACQUIRE);
+    size_t pendente = (size_t) (cabeca - cauda);
+    if (pendente == 0 || pendente < minimo) return 0;
+
+    unsigned char cabecalho[DIARIO_CABECALHO_BLOCO];
+    size_t tamanhoCabecalho = escreverVarint(cabecalho, (uint64_t) anel->id);
+    tamanhoCabecalho += escreverVarint(cabecalho + tamanhoCabecalho, (uint64_t) pendente);
+
+    // O trecho pode dar a volta no fim do anel: no máximo duas partes
+    size_t inicio = (size_t) (cauda & (DIARIO_ANEL - 1));
+    size_t primeiro = pendente < DIARIO_ANEL - inicio ? pendente : DIARIO_ANEL - inicio;
+    struct iovec trechos[3] = {
+        {cabecalho, tamanhoCabecalho},
+        {anel->dados + inicio, primeiro},
+        {anel->dados, pendente - primeiro},
+    };
+    gravarTrechos(trechos, primeiro < pendente ? 3 : 2);
+
+    Diario.resumo.blocos++;
+    __atomic_store_n(&anel->cauda, cabeca, __ATOMIC_RELEASE);
+    return pendente;
+}
+
+/**
+ * @brief Grava os anéis que acumularam DIARIO_GRAVACAO bytes e libera os das threads que já terminaram.
+ * @param tudo 1 para gravar também os anéis com menos que DIARIO_GRAVACAO bytes
+ * @return Bytes gravados dos anéis
+ */
+static size_t esvaziarAneis(int tudo) {
+    size_t copiados = 0;
+    pthread_mutex_lock(&Diario.trava);
+    struct AnelEventos **ligacao = &Diario.aneis;
+    while (*ligacao != NULL) {
+        struct AnelEventos *anel = *ligacao;
+        // Lido antes da cabeça: se o anel terminou, a cabeça lida já é a final
+        int encerrado = __atomic_load_n(&anel->encerrado, __ATOMIC_ACQUIRE);
+        copiados += esvaziarAnel(anel, tudo || encerrado ? 1 : DIARIO_GRAVACAO);
+        if (encerrado) {
+            *ligacao = anel->proximo;
+            Diario.resumo.esperas += anel->esperas;
+            free(anel);
+        } else {
+            ligacao = &anel->proximo;
+        }
+    }
+    pthread_mutex_unlock(&Diario.trava);
+    return copiados;
+}
+
+/**
+ * @brief Acorda a gravadora (um anel acumulou DIARIO_GRAVACAO bytes, está cheio ou o diário vai fechar).
+ */
+static void avisarGravadora(void) {
+    pthread_mutex_lock(&Diario.travaAviso);
+    Diario.avisado = 1;
+    pthread_cond_signal(&Diario.aviso);
+    pthread_mutex_unlock(&Diario.travaAviso);
+}
+
+/**
+ * @brief Dorme até um aviso ou por DIARIO_PAUSA_US (o que vier antes).
+ * @note A pausa limitada grava os anéis das threads que já terminaram sem
+ *       chegar a DIARIO_GRAVACAO bytes; os avisos que chegam durante uma
+ *       passada não se perdem (avisado continua 1).
+ */
+static void esperarAviso(void) {
+    struct timespec limite;
+    clock_gettime(CLOCK_REALTIME, &limite);
+    limite.tv_nsec += DIARIO_PAUSA_US * 1000L;
+    limite.tv_sec += limite.tv_nsec / 1000000000L;
+    limite.tv_nsec %= 1000000000L;
+    pthread_mutex_lock(&Diario.travaAviso);
+    while (!Diario.avisado && pthread_cond_timedwait(&Diario.aviso, &Diario.travaAviso, &limite) == 0) {
+    }
+    Diario.avisado = 0;
+    pthread_mutex_unlock(&Diario.travaAviso);
+}
+
+/**
+ * @brief Laço da thread gravadora: grava os anéis em blocos de pelo menos DIARIO_GRAVACAO bytes.
+ * @note Só termina depois de um pedido de parada seguido de uma passada sem dados.
+ */
+static void *executarGravadora(void *arg) {
+    (void) arg;
+    for (;;) {
+        int parar = __atomic_load_n(&Diario.parar, __ATOMIC_ACQUIRE);
+        size_t copiados = esvaziarAneis(parar);
+        if (copiados == 0) {
+            if (parar) break;
+            esperarAviso();
+        }
+    }
+
+    struct timespec cpu;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpu) == 0) Diario.resumo.segundosCpu = cpu.tv_sec + cpu.tv_nsec / 1e9;
+    return NULL;
+}
+
+/**
+ * @brief Função para criar o arquivo e iniciar a thread gravadora
+ * @note O cabeçalho guarda o número de territórios do mapa, conferido pelo
+ *       decodificador. Deve ser chamada antes de qualquer partida com diário.
+ * @param caminho Arquivo a criar (sobrescrito se existir)
+ * @param mapa Mapa das partidas registradas
+ * @return 0 em caso de sucesso, 1 em caso de erro (a mensagem já foi impressa)
+ */
+int abrirDiario(const char *caminho, const struct Mapa *mapa) {
+    pthread_once(&ChaveCriada, criarChave);
+    numerarJogadas();
+    Diario.fd = open(caminho, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (Diario.fd < 0) {
+        printf("Erro ao criar o diário de eventos %s: %s\n", caminho, strerror(errno));
+        return 1;
+    }
+    Diario.caminho = caminho;
+    memset(&Diario.resumo, 0, sizeof(Diario.resumo));
+    Diario.erro = 0;
+    Diario.proximoId = 0;
+    unsigned char cabecalho[8 + DIARIO_CABECALHO_BLOCO];
+    memcpy(cabecalho, MAGICA_DIARIO, 8);
+    struct iovec trecho = {cabecalho, 8 + escreverVarint(cabecalho + 8, (uint64_t) mapa->numTerritorios)};
+    gravarTrechos(&trecho, 1);
+
+    Diario.parar = 0;
+    Diario.avisado = 0;
+    if (pthread_create(&Diario.gravadora, NULL, executarGravadora, NULL) != 0) {
+        printf("Erro ao iniciar a gravação do diário de eventos %s.\n", caminho);
+        close(Diario.fd);
+        return 1;
+    }
+    Diario.aberto = 1;
+    return 0;
+}
+
+/**
+ * @brief Função para gravar o que falta, parar a gravadora e imprimir (ou devolver) o resumo
+ * @note As threads que jogaram já devem ter terminado; o anel da thread atual
+ *       é encerrado aqui. Sem diário aberto, não faz nada.
+ * @param resumo Recebe o resumo em vez de imprimi-lo (NULL para imprimir)
+ * @return 0 em caso de sucesso, 1 se alguma gravação falhou
+ */
+int fecharDiario(struct ResumoDiario *resumo) {
+    if (!Diario.aberto) return 0;
+    if (AnelLocal != NULL) {
+        encerrarAnel(AnelLocal);
+        pthread_setspecific(ChaveAnel, NULL);
+        AnelLocal = NULL;
+    }
+    __atomic_store_n(&Diario.parar, 1, __ATOMIC_RELEASE);
+    avisarGravadora();
+    pthread_join(Diario.gravadora, NULL);
+    Diario.aberto = 0;
+
+    // Anéis de threads que ainda não terminaram (nenhuma deveria): a última passada já os esvaziou
+    while (Diario.aneis != NULL) {
+        struct AnelEventos *anel = Diario.aneis;
+        Diario.aneis = anel->proximo;
+        Diario.resumo.esperas += anel->esperas;
+        free(anel);
+    }
+    if (close(Diario.fd) != 0 && Diario.erro == 0) Diario.erro = errno;
+
+    if (Diario.erro != 0) {
+        printf("Erro ao gravar o diário de eventos %s: %s\n", Diario.caminho, strerror(Diario.erro));
+        return 1;
+    }
+    Diario.resumo.aneis = Diario.proximoId;
+    if (resumo != NULL) {
+        *resumo = Diario.resumo;
+        return 0;
+    }
+    printf("Diário de eventos %s: %lld bytes em %ld blocos (%ld gravações, %d anéis, %ld esperas por anel cheio, %.1f ms de CPU da gravadora)\n",
+           Diario.caminho, Diario.resumo.bytes, Diario.resumo.blocos, Diario.resumo.gravacoes, Diario.resumo.aneis,
+           Diario.resumo.esperas, Diario.resumo.segundosCpu * 1000.0);
+    return 0;
+}
+
+/**
+ * @brief Função para saber se há um diário aberto
+ * @return 1 se as partidas criadas agora devem registrar eventos (jogo->diario)
+ */
+int diarioAberto(void) {
+    return Diario.aberto;
+}
+
+/**
+ * @brief Recalcula anel->limite com a última cauda lida.
+ * @note Um registro pode começar em anel->posicao se ela está antes do fim
+ *       do anel e se os DIARIO_MAX_REGISTRO bytes a partir dela já foram
+ *       gravados na volta anterior. O limite para antes em anel->proximoAviso.
+ * @return 1 se há espaço para um registro em anel->posicao, 0 se o anel está cheio
+ */
+static int recalcularLimite(struct AnelEventos *anel) {
+    int64_t posicao = anel->posicao - anel->dados;
+    int64_t fim = (int64_t) (anel->caudaVista - anel->base) + DIARIO_ANEL - DIARIO_MAX_REGISTRO + 1;
+    if (fim > DIARIO_ANEL) fim = DIARIO_ANEL;
+    if (fim <= posicao) {
+        anel->limite = anel->dados; // O próximo registro volta a abrirEspacoDiario
+        return 0;
+    }
+    // O limite também para no próximo aviso à gravadora
+    int64_t aviso = (int64_t) (anel->proximoAviso - anel->base);
+    anel->limite = anel->dados + (aviso > posicao && aviso < fim ? aviso : fim);
+    return 1;
+}
+
+/**
+ * @brief Função para levar ao começo do anel o registro que passou do fim
+ * @note O registro é escrito sem dar a volta no anel: o que passou do fim
+ *       (na folga de DIARIO_MAX_REGISTRO bytes) é copiado para o começo, e a
+ *       posição passa para a nova volta.
+ * @param anel Anel da thread atual
+ */
+void voltarAnelDiario(struct AnelEventos *anel) {
+    memcpy(anel->dados, anel->dados + DIARIO_ANEL, (size_t) (anel->posicao - (anel->dados + DIARIO_ANEL)));
+    anel->posicao -= DIARIO_ANEL;
+    anel->base += DIARIO_ANEL;
+    recalcularLimite(anel);
+}
+
+/**
+ * @brief Função para voltar ao começo do anel ou esperar a gravadora liberar espaço
+ * @note Chamada quando anel->posicao chega a anel->limite. A cada
+ *       DIARIO_GRAVACAO bytes escritos, publica e acorda a gravadora. Relê a
+ *       cauda; se o anel continua cheio, publica o que foi escrito e cede o
+ *       processador até a gravadora gravá-lo.
+ * @param anel Anel da thread atual
+ */
+void abrirEspacoDiario(struct AnelEventos *anel) {
+    if (anel->posicao >= anel->dados + DIARIO_ANEL) voltarAnelDiario(anel);
+    uint64_t escrita = diarioEscrita(anel);
+    if (escrita >= anel->proximoAviso) {
+        diarioPublicar(anel);
+        avisarGravadora();
+        anel->proximoAviso = escrita + DIARIO_GRAVACAO;
+    }
+    anel->caudaVista = __atomic_load_n(&anel->cauda, __ATOMIC_ACQUIRE);
+    if (recalcularLimite(anel)) return;
+    // A gravadora só libera o que foi publicado
+    diarioPublicar(anel);
+    avisarGravadora();
+    anel->esperas++;
+    do {
+        sched_yield();
+        anel->caudaVista = __atomic_load_n(&anel->cauda, __ATOMIC_ACQUIRE);
+    } while (!recalcularLimite(anel));
+}
+
+/**
+ * @brief Função para criar o anel da thread atual
+ * @note Chamada pelo primeiro registro da thread; o anel é marcado como
+ *       encerrado quando a thread termina.
+ * @return Anel da thread, ou NULL se não há diário aberto ou faltou memória (os eventos da thread são descartados)
+ */
+struct AnelEventos *registrarAnelDiario(void) {
+    if (!Diario.aberto) return NULL;
+    struct AnelEventos *anel = (struct AnelEventos *) calloc(1, sizeof(struct AnelEventos));
+    if (anel == NULL) return NULL;
+
+    anel->posicao = anel->dados;
+    anel->proximoAviso = DIARIO_GRAVACAO;
+    recalcularLimite(anel);
+
+    pthread_mutex_lock(&Diario.trava);
+    anel->id = Diario.proximoId++;
+    anel->proximo = Diario.aneis;
+    Diario.aneis = anel;
+    pthread_mutex_unlock(&Diario.trava);
+
+    pthread_setspecific(ChaveAnel, anel);
+    AnelLocal = anel;
+    return anel;
+}
+
+// --- Decodificação ---
+
+// O que o decodificador sabe de cada anel: a partida e o ataque em curso
+struct LeituraAnel {
+    long long partida; // Partida atual (-1 antes da primeira)
+    int ataque;
+    int defesa;
+    int emPartida;     // 1 do começo de uma partida até o seu EVENTO_FIM
+};
+
+// Campos de cada tipo de registro (o primeiro vem no byte de tipo)
+static const int CamposEvento[] = {
+    [EVENTO_PARTIDA] = 1, [EVENTO_ATAQUE] = 4, [EVENTO_DADOS] = 1, [EVENTO_BATALHA] = 5,
+    [EVENTO_CONQUISTA] = 3, [EVENTO_MISSAO] = 2, [EVENTO_FIM] = 2,
+};
+
+// Nome de cada tipo de registro na coluna 'evento' do CSV
+static const char *const NomesEvento[] = {
+    [EVENTO_PARTIDA] = "partida", [EVENTO_ATAQUE] = "ataque", [EVENTO_DADOS] = "dados",
+    [EVENTO_BATALHA] = "batalha", [EVENTO_CONQUISTA] = "conquista", [EVENTO_MISSAO] = "missao",
+    [EVENTO_FIM] = "fim",
+};
+
+/**
+ * @brief Lê um varint de [*pos, fim).
+ * @return 0 em caso de sucesso, 1 se o varint passa do fim ou de 64 bits
+ */
+static int lerVarint(const unsigned char **pos, const unsigned char *fim, uint64_t *valor) {
+    uint64_t v = 0;
+    for (int deslocamento = 0; deslocamento < 64 && *pos < fim; deslocamento += 7) {
+        unsigned char byte = *(*pos)++;
+        v |= (uint64_t) (byte & 0x7f) << deslocamento;
+        if (!(byte & 0x80)) {
+            *valor = v;
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Nome de um território lido do diário ("?" se fora do mapa).
+ */
+static const char *territorioDiario(const struct Mapa *mapa, uint64_t t) {
+    return t < (uint64_t) mapa->numTerritorios ? nomeTerritorio(mapa, (int) t) : "?";
+}
+
+/**
+ * @brief Nome de uma cor lida do diário ("?" se inválida).
+ */
+static const char *corDiario(uint64_t cor) {
+    return cor < MAX_CORES ? nomeCor((int) cor) : "?";
+}
+
+/**
+ * @brief Imprime uma rodada de dados lida do diário (jogada já validada).
+ * @note As baixas saem da mesma comparação de rodadaDeDados: empates favorecem a defesa.
+ */
+static void imprimirRodada(int anel, long long partida, int csv, const char *nomeAtaque, const char *nomeDefesa,
+                           uint64_t jogada) {
+    const unsigned char *dadosAtaque = DadosJogada[jogada / DADOS_JOGADAS];
+    const unsigned char *dadosDefesa = DadosJogada[jogada % DADOS_JOGADAS];
+    int numDadosAtaque = 0, numDadosDefesa = 0, perdasAtaque = 0, perdasDefesa = 0;
+    for (int i = 0; i < 3; i++) {
+        numDadosAtaque += dadosAtaque[i] != 0;
+        numDadosDefesa += dadosDefesa[i] != 0;
+    }
+    for (int i = 0; i < numDadosAtaque && i < numDadosDefesa; i++) {
+        if (dadosAtaque[i] > dadosDefesa[i]) perdasDefesa++;
+        else perdasAtaque++;
+    }
+
+    if (csv) {
+        printf("%d,%lld,dados,\"%s\",\"%s\",%d,%d,", anel, partida, nomeAtaque, nomeDefesa, perdasAtaque, perdasDefesa);
+        for (int i = 0; i < numDadosAtaque; i++) printf("%d", dadosAtaque[i]);
+        printf("x");
+        for (int i = 0; i < numDadosDefesa; i++) printf("%d", dadosDefesa[i]);
+        printf("\n");
+        return;
+    }
+    printf("[anel %d, partida %lld] dados", anel, partida);
+    for (int i = 0; i < numDadosAtaque; i++) printf(" %d", dadosAtaque[i]);
+    printf(" x");
+    for (int i = 0; i < numDadosDefesa; i++) printf(" %d", dadosDefesa[i]);
+    printf(": atacante perde %d, defesa perde %d\n", perdasAtaque, perdasDefesa);
+}
+
+/**
+ * @brief Decodifica e imprime os registros de um bloco.
+ * @return Número de registros, ou -1 se o bloco está corrompido
+ */
+static long decodificarBloco(const unsigned char *pos, const unsigned char *fim, int anel,
+                             struct LeituraAnel *leitura, const struct Mapa *mapa, int csv) {
+    long registros = 0;
+    while (pos < fim) {
+        int tipo = *pos & 7;
+        uint64_t v[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+        uint64_t jogada = 0;
+        v[0] = *pos++ >> 3;
+        if (tipo == EVENTO_DADOS) {
+            // Tamanho fixo: os 5 bits do byte de tipo e mais um byte
+            if (pos == fim) return -1;
+            jogada = v[0] | (uint64_t) *pos++ << 5;
+        } else if (v[0] == DIARIO_CAMPO_ESCAPE) {
+            if (lerVarint(&pos, fim, &v[0]) != 0) return -1;
+            v[0] += DIARIO_CAMPO_ESCAPE;
+        }
+        int campos = CamposEvento[tipo];
+        for (int i = 1; i < campos; i++) {
+            if (lerVarint(&pos, fim, &v[i]) != 0) return -1;
+            // Batalha com conquista: as cores nova e anterior e o movimento vêm em seguida
+            if (tipo == EVENTO_BATALHA && i == 4 && (v[4] & 1)) campos = 8;
+        }
+        if (tipo == EVENTO_ATAQUE) {
+            // A primeira rodada de dados fecha o registro, em 2 bytes fixos
+            if (fim - pos < 2) return -1;
+            jogada = pos[0] | (uint64_t) pos[1] << 8;
+            pos += 2;
+        }
+        if (jogada >= DADOS_JOGADAS * DADOS_JOGADAS) return -1;
+
+        // Contexto do anel e campos derivados
+        if (tipo == EVENTO_PARTIDA) {
+            int64_t diferenca = (int64_t) (v[0] >> 1) ^ -(int64_t) (v[0] & 1);
+            leitura->partida += 1 + diferenca;
+        } else if (!leitura->emPartida) {
+            // Partida seguinte à anterior do anel, começada sem EVENTO_PARTIDA
+            leitura->partida++;
+            if (csv) printf("%d,%lld,partida,,,,,\n", anel, leitura->partida);
+            else printf("[anel %d, partida %lld] início da partida\n", anel, leitura->partida);
+        }
+        leitura->emPartida = tipo != EVENTO_FIM;
+        if (tipo == EVENTO_ATAQUE || tipo == EVENTO_BATALHA) {
+            leitura->ataque = v[0] < (uint64_t) mapa->numTerritorios ? (int) v[0] : -1;
+            leitura->defesa = v[1] < (uint64_t) mapa->numTerritorios ? (int) v[1] : -1;
+        }
+        uint64_t finalAtaque = 1, finalDefesa = 0;
+        int conquista = tipo == EVENTO_CONQUISTA;
+        uint64_t movidas = v[2];
+        if (tipo == EVENTO_BATALHA) {
+            conquista = (int) (v[4] & 1);
+            if (conquista) finalAtaque = v[4] >> 1;
+            else finalDefesa = v[4] >> 1;
+            // As cores da conquista ficam onde o EVENTO_CONQUISTA as guarda
+            v[0] = v[5];
+            v[1] = v[6];
+            movidas = v[7];
+        }
+        const char *nomeAtaque = territorioDiario(mapa, (uint64_t) leitura->ataque);
+        const char *nomeDefesa = territorioDiario(mapa, (uint64_t) leitura->defesa);
+        registros++;
+
+        if (tipo == EVENTO_DADOS) {
+            imprimirRodada(anel, leitura->partida, csv, nomeAtaque, nomeDefesa, jogada);
+        } else if (csv) {
+            // anel,partida,evento,origem,destino,valor1,valor2,dados
+            printf("%d,%lld,%s,", anel, leitura->partida, NomesEvento[tipo]);
+            switch (tipo) {
+                case EVENTO_PARTIDA:
+                    printf(",,,,\n");
+                    break;
+                case EVENTO_ATAQUE:
+                    printf("\"%s\",\"%s\",%llu,%llu,\n", nomeAtaque, nomeDefesa, (unsigned long long) v[2], (unsigned long long) v[3]);
+                    break;
+                case EVENTO_BATALHA:
+                    printf("\"%s\",\"%s\",%llu,%llu,\n", nomeAtaque, nomeDefesa, (unsigned long long) finalAtaque, (unsigned long long) finalDefesa);
+                    if (conquista) {
+                        printf("%d,%lld,conquista,\"%s\",\"%s\",%s,%s,\n", anel, leitura->partida, nomeAtaque, nomeDefesa,
+                               corDiario(v[0]), corDiario(v[1]));
+                    }
+                    break;
+                case EVENTO_CONQUISTA:
+                    printf("\"%s\",\"%s\",%s,%s,\n", nomeAtaque, nomeDefesa, corDiario(v[0]), corDiario(v[1]));
+                    break;
+                case EVENTO_MISSAO:
+                case EVENTO_FIM:
+                    printf(",,%lld,%llu,\n", (long long) v[0] - (tipo == EVENTO_FIM), (unsigned long long) v[1]);
+                    break;
+            }
+        } else {
+            printf("[anel %d, partida %lld] ", anel, leitura->partida);
+            switch (tipo) {
+                case EVENTO_PARTIDA:
+                    printf("início da partida\n");
+                    break;
+                case EVENTO_ATAQUE:
+                    printf("ataque de %s (%llu tropas) a %s (%llu tropas)\n", nomeAtaque, (unsigned long long) v[2],
+                           nomeDefesa, (unsigned long long) v[3]);
+                    break;
+                case EVENTO_BATALHA:
+                    printf("batalha de %s (%llu tropas) contra %s (%llu tropas) resolvida: atacante com %llu, defesa com %llu\n",
+                           nomeAtaque, (unsigned long long) v[2], nomeDefesa, (unsigned long long) v[3],
+                           (unsigned long long) finalAtaque, (unsigned long long) finalDefesa);
+                    if (conquista) {
+                        printf("[anel %d, partida %lld] %s conquistado por %s (era %s)\n", anel, leitura->partida, nomeDefesa,
+                               corDiario(v[0]), corDiario(v[1]));
+                    }
+                    break;
+                case EVENTO_CONQUISTA:
+                    printf("%s conquistado por %s (era %s)\n", nomeDefesa, corDiario(v[0]), corDiario(v[1]));
+                    break;
+                case EVENTO_MISSAO:
+                    printf("jogador %llu cumpriu a missão: %s\n", (unsigned long long) v[0] + 1,
+                           v[1] < TOTAL_MISSOES ? Missoes[v[1]].descricao : "?");
+                    break;
+                case EVENTO_FIM:
+                    if (v[0] == 0) printf("fim sem vencedor após %llu turnos\n", (unsigned long long) v[1]);
+                    else printf("fim: vitória do jogador %llu após %llu turnos\n", (unsigned long long) v[0], (unsigned long long) v[1]);
+                    break;
+            }
+        }
+        // A primeira rodada de dados do ataque e o movimento da conquista vêm no mesmo registro
+        if (tipo == EVENTO_ATAQUE) imprimirRodada(anel, leitura->partida, csv, nomeAtaque, nomeDefesa, jogada);
+        if (conquista && movidas > 0) {
+            if (csv) {
+                printf("%d,%lld,movimento,\"%s\",\"%s\",%llu,,\n", anel, leitura->partida, nomeAtaque, nomeDefesa,
+                       (unsigned long long) movidas);
+            } else {
+                printf("[anel %d, partida %lld] %llu tropas movidas de %s para %s\n", anel, leitura->partida,
+                       (unsigned long long) movidas, nomeAtaque, nomeDefesa);
+            }
+        }
+    }
+    return registros;
+}
+
+/**
+ * @brief Função para converter um diário em texto ou CSV na saída padrão
+ * @note O resumo (registros, blocos e anéis) vai para a saída de erro, para
+ *       não misturar com o CSV. No CSV, jogadores são índices a partir de 0
+ *       (vencedor -1 = empate); no texto, são numerados a partir de 1.
+ * @param caminho Diário gravado com --event-log
+ * @param mapa Mapa das partidas registradas (dá nome aos territórios)
+ * @param csv 1 para CSV (uma linha por registro, com cabeçalho), 0 para texto
+ * @return 0 em caso de sucesso, 1 em caso de erro (a mensagem já foi impressa)
+ */
+int decodificarDiario(const char *caminho, const struct Mapa *mapa, int csv) {
+    FILE *arquivo = fopen(caminho, "rb");
+    if (arquivo == NULL) {
+        printf("Erro ao abrir o diário de eventos %s.\n", caminho);
+        return 1;
+    }
+    fseek(arquivo, 0, SEEK_END);
+    long tamanho = ftell(arquivo);
+    rewind(arquivo);
+    unsigned char *conteudo = tamanho > 0 ? (unsigned char *) malloc((size_t) tamanho) : NULL;
+    if (conteudo == NULL || fread(conteudo, 1, (size_t) tamanho, arquivo) != (size_t) tamanho) {
+        printf("Erro ao ler o diário de eventos %s.\n", caminho);
+        free(conteudo);
+        fclose(arquivo);
+        return 1;
+    }
+    fclose(arquivo);
+
+    const unsigned char *pos = conteudo;
+    const unsigned char *fim = conteudo + tamanho;
+    uint64_t territorios = 0;
+    int valido = tamanho >= 8 && memcmp(conteudo, MAGICA_DIARIO, 8) == 0;
+    if (valido) {
+        pos += 8;
+        valido = lerVarint(&pos, fim, &territorios) == 0;
+    }
+    if (!valido) {
+        printf("%s não é um diário de eventos.\n", caminho);
+        free(conteudo);
+        return 1;
+    }
+    if (territorios != (uint64_t) mapa->numTerritorios) {
+        printf("O diário %s foi gravado num mapa de %llu territórios (este tem %d; use --map).\n", caminho,
+               (unsigned long long) territorios, mapa->numTerritorios);
+        free(conteudo);
+        return 1;
+    }
+
+    numerarJogadas();
+    if (csv) printf("anel,partida,evento,origem,destino,valor1,valor2,dados\n");
+    struct LeituraAnel *leituras = NULL;
+    long numLeituras = 0, registros = 0, blocos = 0;
+    int erro = 0;
+    while (pos < fim) {
+        uint64_t anel, tamanhoBloco;
+        if (lerVarint(&pos, fim, &anel) != 0 || lerVarint(&pos, fim, &tamanhoBloco) != 0 ||
+            tamanhoBloco > (uint64_t) (fim - pos) || anel > (uint64_t) INT32_MAX) {
+            erro = 1;
+            break;
+        }
+        // Estado de cada anel, criado na primeira vez que ele aparece
+        if ((long) anel >= numLeituras) {
+            long novas = (long) anel + 1;
+            struct LeituraAnel *maiores = (struct LeituraAnel *) realloc(leituras, (size_t) novas * sizeof(struct LeituraAnel));
+            if (maiores == NULL) {
+                erro = 1;
+                break;
+            }
+            leituras = maiores;
+            for (long i = numLeituras; i < novas; i++) leituras[i] = (struct LeituraAnel) {-1, -1, -1, 0};
+            numLeituras = novas;
+        }
+        long n = decodificarBloco(pos, pos + tamanhoBloco, (int) anel, &leituras[anel], mapa, csv);
+        if (n < 0) {
+            erro = 1;
+            break;
+        }
+        registros += n;
+        blocos++;
+        pos += tamanhoBloco;
+    }
+    if (erro) printf("Diário %s corrompido ou truncado perto do byte %ld.\n", caminho, (long) (pos - conteudo));
+    free(leituras);
+    free(conteudo);
+    if (erro) return 1;
+
+    fprintf(stderr, "%s: %ld registros em %ld blocos de %ld anéis\n", caminho, registros, blocos, numLeituras);
+    return 0;
+}
@@ -0,0 +1,337 @@
+/**
+ * @file eventos.h
+ * @brief Diário binário dos eventos das partidas (dados, baixas, conquistas, movimentos e missões).
+ *
+ * Com --event-log ARQ, cada evento que atacar() narra com printf vira um
+ * registro binário compacto: um byte com o tipo (3 bits) e o primeiro campo
+ * (5 bits; DIARIO_CAMPO_ESCAPE indica que o campo segue em varint), seguido
+ * dos demais campos em varint (7 bits por byte, o bit alto indica que há
+ * mais bytes). Os territórios de um ataque vão no registro EVENTO_ATAQUE (ou
+ * EVENTO_BATALHA); os registros seguintes (dados, conquista) se referem a
+ * ele. Uma batalha blitz com conquista e movimento ocupa 8 bytes no mapa
+ * clássico, um ataque com a primeira rodada de dados, 6 bytes, e cada rodada
+ * seguinte, 2.
+ *
+ * Cada thread que joga escreve num anel próprio (DIARIO_ANEL bytes), sem
+ * travas: a thread só avança a cabeça e a thread gravadora só avança a
+ * cauda, cada uma com store de liberação e a outra com load de aquisição.
+ * Os registros são escritos além da cabeça e publicados juntos, com um único
+ * store, quando o anel passa de DIARIO_GRAVACAO bytes (nas partidas em lote)
+ * ou por diarioConcluir no fim de cada partida de roteiro.
+ * A cada DIARIO_GRAVACAO bytes escritos, a thread do jogo acorda a gravadora,
+ * que grava direto do anel (writev, sem cópia intermediária) cada anel que
+ * acumulou DIARIO_GRAVACAO bytes; o anel é pequeno o bastante para ficar no
+ * cache junto com a partida. Um anel cheio faz a thread do jogo esperar
+ * (nenhum evento é perdido); as esperas aparecem no resumo de fecharDiario.
+ *
+ * Formato do arquivo:
+ * - cabeçalho: MAGICA_DIARIO (8 bytes) e varint número de territórios do mapa;
+ * - blocos: varint anel, varint tamanho e 'tamanho' bytes de registros
+ *   inteiros do anel. Os registros de um anel ficam na ordem em que
+ *   aconteceram; blocos de anéis diferentes se intercalam.
+ *
+ * Registros (campos na ordem, o primeiro no byte de tipo):
+ * - EVENTO_PARTIDA   : índice da partida no lote, como diferença para a seguinte à
+ *                      anterior do anel, em zigue-zague; só aparece quando a diferença
+ *                      não é 0 (senão, o primeiro registro do anel ou depois de um
+ *                      EVENTO_FIM já começa a partida seguinte)
+ * - EVENTO_ATAQUE    : atacante, defensor, tropas do atacante e do defensor (ataque com
+ *                      dados) e, em 2 bytes fixos (o baixo primeiro), a jogada da
+ *                      primeira rodada de dados, como em EVENTO_DADOS
+ * - EVENTO_DADOS     : rodadas seguintes à primeira de um ataque, com tamanho fixo de
+ *                      2 bytes; os 13 bits acima do tipo guardam
+ *                      jogada do ataque * DADOS_JOGADAS + jogada da defesa, onde a
+ *                      jogada é a posição dos dados ordenados entre as DADOS_JOGADAS
+ *                      possíveis com 1 a 3 dados (ver PosicaoDados); as baixas saem
+ *                      da comparação dos dados
+ * - EVENTO_BATALHA   : atacante, defensor, tropas iniciais do atacante e do defensor e
+ *                      resultado (batalha blitz, resolvida pela tabela): com conquista,
+ *                      tropas que sobraram no ataque * 2 + 1, seguido da cor nova, da
+ *                      cor anterior e das tropas movidas (a conquista vai no mesmo
+ *                      registro); sem conquista, tropas que sobraram na defesa * 2
+ *                      (o ataque fica com 1)
+ * - EVENTO_CONQUISTA : cor nova e cor anterior do defensor e tropas movidas do
+ *                      atacante para o território conquistado (0 se a partida
+ *                      acabou na conquista)
+ * - EVENTO_MISSAO    : jogador e missão cumprida
+ * - EVENTO_FIM       : vencedor + 1 (0 = empate) e turnos
+ *
+ * O diário vale para --simulate, --script e o jogo interativo; as cópias de
+ * partida das buscas (MCTS) não registram nada. --decode-log ARQ [texto|csv]
+ * converte um diário de volta em texto ou CSV.
+ */
+#ifndef EVENTOS_H
+#define EVENTOS_H
+
+#include <stdint.h>
+#include <string.h>
+
+#include "jogo.h"
+
+#define MAGICA_DIARIO "WARDIAR3"   // Assinatura do arquivo (8 bytes, sem o terminador)
+#define DIARIO_ANEL (1 << 19)     // Bytes do anel de cada thread (potência de 2)
+#define DIARIO_GRAVACAO (1 << 17) // Bytes que um anel acumula antes de a gravadora gravá-lo
+#define DIARIO_PAUSA_US 100000     // Maior pausa da gravadora sem aviso (grava os anéis das threads que terminaram)
+#define DIARIO_MAX_REGISTRO 88     // Maior registro (tipo e até 8 campos varint de 64 bits)
+#define DIARIO_CAMPO_ESCAPE 31     // Primeiro campo a partir do qual ele sai do byte de tipo
+#define DADOS_JOGADAS 83           // Jogadas ordenadas distintas com 1 a 3 dados (6 + 21 + 56)
+
+// Tipos de registro
+enum TipoEvento {
+    EVENTO_PARTIDA,
+    EVENTO_ATAQUE,
+    EVENTO_DADOS,
+    EVENTO_BATALHA,
+    EVENTO_CONQUISTA,
+    EVENTO_MISSAO,
+    EVENTO_FIM
+};
+
+// Anel de uma thread: só ela escreve em dados e cabeca; só a gravadora avança cauda
+struct AnelEventos {
+    unsigned char *posicao;   // Onde começa o próximo registro (em dados, talvez já na folga)
+    unsigned char *limite;    // Primeira posição em que um registro só começa depois de abrirEspacoDiario
+    uint64_t base;            // Bytes escritos antes da volta atual do anel (a que começa em dados[0])
+    uint64_t proximoAviso;    // Bytes escritos a partir dos quais a thread acorda a gravadora
+    uint64_t cabeca;          // Bytes já publicados pela thread do jogo
+    uint64_t caudaVista;      // Última cauda lida pela thread do jogo (evita ler a linha da gravadora)
+    int64_t proximaPartida;   // Partida seguinte à última registrada (ver diarioPartida)
+    long esperas;             // Vezes em que a thread do jogo encontrou o anel cheio
+    char preenchimento[64];   // Cabeça e cauda em linhas de cache diferentes
+    uint64_t cauda;           // Bytes já copiados pela gravadora
+    int encerrado;            // 1 depois que a thread do anel terminou
+    int id;                   // Número do anel no arquivo
+    struct AnelEventos *proximo; // Lista dos anéis (percorrida pela gravadora)
+    unsigned char dados[DIARIO_ANEL + DIARIO_MAX_REGISTRO]; // Anel e folga para o registro que passa do fim
+};
+
+extern __thread struct AnelEventos *AnelLocal;
+extern unsigned char PosicaoDados[343]; // Jogada de cada trio de dados ordenados em base 7 (0 = dado não rolado)
+
+// Resumo de um diário fechado
+struct ResumoDiario {
+    long long bytes;       // Bytes gravados (cabeçalho e blocos)
+    long blocos;           // Blocos de registros
+    long gravacoes;        // Chamadas a write
+    int aneis;             // Threads que registraram eventos
+    long esperas;          // Vezes em que uma thread do jogo encontrou o anel cheio
+    double segundosCpu;    // Tempo de CPU da thread gravadora
+};
+
+// --- Protótipos das Funções ---
+int abrirDiario(const char *caminho, const struct Mapa *mapa); // Função para criar o arquivo e iniciar a thread gravadora (0 em caso de sucesso)
+int fecharDiario(struct ResumoDiario *resumo);                 // Função para gravar o que falta, parar a gravadora e imprimir (ou devolver) o resumo
+int diarioAberto(void);                                        // Função para saber se há um diário aberto (define jogo->diario)
+
+// Caminhos raros da escrita (cold: o compilador tira do caminho quente os trechos que as chamam)
+__attribute__((cold)) struct AnelEventos *registrarAnelDiario(void);    // Função para criar o anel da thread atual
+__attribute__((cold)) void abrirEspacoDiario(struct AnelEventos *anel); // Função para voltar ao começo do anel ou esperar a gravadora liberar espaço
+__attribute__((cold)) void voltarAnelDiario(struct AnelEventos *anel);  // Função para levar ao começo do anel o registro que passou do fim
+__attribute__((cold)) unsigned char *diarioCamposVarint(unsigned char *p, int tipo, int numCampos, const uint64_t *campos); // Função para escrever um registro com os campos em varint
+__attribute__((cold)) unsigned char *diarioTrocarCampoFinal(unsigned char *fim, uint64_t valor); // Função para trocar o último campo (1 byte) de um registro por um varint
+int decodificarDiario(const char *caminho, const struct Mapa *mapa, int csv); // Função para converter um diário em texto ou CSV na saída padrão
+
+// --- Escrita dos registros ---
+// Um registro é montado direto no anel, além da cabeça, e a gravadora só o
+// vê depois de publicado (nunca vê meio registro). Sem diário na
+// partida, cada chamada custa uma comparação; com diário, o caso comum é
+// montar o registro numa palavra e gravá-la em anel->posicao, com uma
+// comparação com anel->limite. As funções são always_inline para que o
+// perfil padrão (-O0) também as expanda no lugar da chamada.
+
+/**
+ * @brief Anel da thread atual com espaço para um registro em anel->posicao (NULL se faltou memória).
+ */
+static inline __attribute__((always_inline)) struct AnelEventos *diarioReservar(void) {
+    struct AnelEventos *anel = AnelLocal;
+    if (__builtin_expect(anel == NULL, 0) && (anel = registrarAnelDiario()) == NULL) return NULL;
+    if (__builtin_expect(anel->posicao >= anel->limite, 0)) abrirEspacoDiario(anel);
+    return anel;
+}
+
+/**
+ * @brief Bytes que a thread já escreveu no anel (publicados ou não).
+ */
+static inline __attribute__((always_inline)) uint64_t diarioEscrita(const struct AnelEventos *anel) {
+    return anel->base + (uint64_t) (anel->posicao - anel->dados);
+}
+
+/**
+ * @brief Publica para a gravadora tudo o que a thread escreveu no anel.
+ * @note O registro que passou do fim do anel vai antes para o começo: a
+ *       gravadora lê os bytes publicados pela posição no anel.
+ */
+static inline __attribute__((always_inline)) void diarioPublicar(struct AnelEventos *anel) {
+    if (__builtin_expect(anel->posicao >= anel->dados + DIARIO_ANEL, 0)) voltarAnelDiario(anel);
+    __atomic_store_n(&anel->cabeca, diarioEscrita(anel), __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Publica os registros escritos desde a última chamada.
+ * @note Chamada no fim de cada partida de roteiro, para o diário acompanhar
+ *       o roteiro. As partidas em lote não a chamam: o anel publica a cada
+ *       DIARIO_GRAVACAO bytes, quando a thread termina e em fecharDiario.
+ */
+static inline __attribute__((always_inline)) void diarioConcluir(const struct Jogo *jogo) {
+    if (__builtin_expect(!jogo->diario, 1)) return;
+    if (AnelLocal != NULL) diarioPublicar(AnelLocal);
+}
+
+/**
+ * @brief Grava em anel->posicao um registro de até 8 bytes montado numa palavra (o byte de tipo é o mais baixo).
+ * @note Um único store: diarioReservar garante DIARIO_MAX_REGISTRO bytes
+ *       livres, e os que passam do registro são sobrescritos pelo seguinte.
+ */
+static inline __attribute__((always_inline)) void diarioGravarPalavra(struct AnelEventos *anel, uint64_t palavra, int bytes) {
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    palavra = __builtin_bswap64(palavra);
+#endif
+    memcpy(anel->posicao, &palavra, sizeof(palavra));
+    anel->posicao += bytes;
+}
+
+/**
+ * @brief Registra um evento de numCampos (1 a 3) campos: conquista, missão ou fim.
+ * @note O terceiro campo, se houver, é 0 (o movimento da conquista, ver diarioMovimento).
+ */
+static inline __attribute__((always_inline)) void diarioRegistrar(const struct Jogo *jogo, int tipo, int numCampos, uint64_t primeiro, uint64_t segundo) {
+    if (__builtin_expect(!jogo->diario, 1)) return;
+    struct AnelEventos *anel = diarioReservar();
+    if (anel == NULL) return;
+    if (__builtin_expect(primeiro < DIARIO_CAMPO_ESCAPE && segundo < 0x80, 1)) {
+        diarioGravarPalavra(anel, (uint64_t) tipo | primeiro << 3 | segundo << 8, numCampos);
+    } else {
+        anel->posicao = diarioCamposVarint(anel->posicao, tipo, numCampos, (const uint64_t[]) {primeiro, segundo, 0});
+    }
+}
+
+/**
+ * @brief Registra uma batalha blitz sem conquista, resolvida pela tabela, a partir das tropas de antes e da sobra da defesa.
+ * @note A batalha termina com 1 tropa no ataque ou nenhuma na defesa: o
+ *       resultado guarda só o que sobrou do outro lado. Sem conquista o
+ *       registro leva 5 campos (com conquista, ver diarioBatalhaConquista).
+ */
+static inline __attribute__((always_inline)) void diarioBatalha(const struct Jogo *jogo, int ataque, int defesa, int tropasAtaque,
+                                                            int tropasDefesa, int sobraDefesa) {
+    if (__builtin_expect(!jogo->diario, 1)) return;
+    struct AnelEventos *anel = diarioReservar();
+    if (anel == NULL) return;
+    uint64_t resultado = (uint64_t) sobraDefesa << 1;
+    uint64_t maiores = (uint64_t) defesa | (uint64_t) tropasAtaque | (uint64_t) tropasDefesa | resultado;
+    if (__builtin_expect((uint64_t) ataque < DIARIO_CAMPO_ESCAPE && maiores < 0x80, 1)) {
+        diarioGravarPalavra(anel, EVENTO_BATALHA | (uint64_t) ataque << 3 | (uint64_t) defesa << 8 | (uint64_t) tropasAtaque << 16 |
+                                  (uint64_t) tropasDefesa << 24 | resultado << 32, 5);
+    } else {
+        anel->posicao = diarioCamposVarint(anel->posicao, EVENTO_BATALHA, 5,
+                                           (const uint64_t[]) {(uint64_t) ataque, (uint64_t) defesa, (uint64_t) tropasAtaque,
+                                                               (uint64_t) tropasDefesa, resultado});
+    }
+}
+
+/**
+ * @brief Registra uma batalha blitz com conquista: a batalha, as cores nova e anterior do defensor e o movimento.
+ * @note O movimento fica 0 até diarioMovimento. Conquista ou não, quem
+ *       escolhe o registro é o desvio da própria partida (o resultado é
+ *       sorteado; um desvio a mais aqui erraria metade das vezes).
+ */
+static inline __attribute__((always_inline)) void diarioBatalhaConquista(const struct Jogo *jogo, int ataque, int defesa, int tropasAtaque,
+                                                                     int tropasDefesa, int sobraAtaque, int corNova, int corAnterior) {
+    if (__builtin_expect(!jogo->diario, 1)) return;
+    struct AnelEventos *anel = diarioReservar();
+    if (anel == NULL) return;
+    uint64_t resultado = (uint64_t) sobraAtaque << 1 | 1;
+    uint64_t maiores = (uint64_t) defesa | (uint64_t) tropasAtaque | (uint64_t) tropasDefesa | resultado | (uint64_t) corNova |
+                       (uint64_t) corAnterior;
+    if (__builtin_expect((uint64_t) ataque < DIARIO_CAMPO_ESCAPE && maiores < 0x80, 1)) {
+        diarioGravarPalavra(anel, EVENTO_BATALHA | (uint64_t) ataque << 3 | (uint64_t) defesa << 8 | (uint64_t) tropasAtaque << 16 |
+                                  (uint64_t) tropasDefesa << 24 | resultado << 32 | (uint64_t) corNova << 40 |
+                                  (uint64_t) corAnterior << 48,
+                            8);
+    } else {
+        anel->posicao = diarioCamposVarint(anel->posicao, EVENTO_BATALHA, 8,
+                                           (const uint64_t[]) {(uint64_t) ataque, (uint64_t) defesa, (uint64_t) tropasAtaque,
+                                                               (uint64_t) tropasDefesa, resultado, (uint64_t) corNova,
+                                                               (uint64_t) corAnterior, 0});
+    }
+}
+
+/**
+ * @brief Registra as tropas movidas para o território conquistado, no último campo do registro da conquista.
+ * @note Nenhum registro fica entre a conquista e o movimento (uma missão
+ *       cumprida na conquista acaba a partida, sem movimento): o 0 que fecha
+ *       o registro da conquista vira o número de tropas, sem registro próprio.
+ */
+static inline __attribute__((always_inline)) void diarioMovimento(const struct Jogo *jogo, int tropasMover) {
+    if (__builtin_expect(!jogo->diario, 1)) return;
+    struct AnelEventos *anel = AnelLocal;
+    if (anel == NULL) return; // Sem anel, a conquista também ficou de fora
+    if (__builtin_expect((unsigned) tropasMover < 0x80, 1)) anel->posicao[-1] = (unsigned char) tropasMover;
+    else anel->posicao = diarioTrocarCampoFinal(anel->posicao, (uint64_t) tropasMover);
+}
+
+/**
+ * @brief Registra o início da partida p de um lote.
+ * @note A partida seguinte à anterior do anel (quase sempre, num lote) não
+ *       gasta registro: o primeiro registro depois de EVENTO_FIM já a começa.
+ *       As outras (o roubo de trabalho pode pular ou voltar) levam a
+ *       diferença, em zigue-zague.
+ */
+static inline __attribute__((always_inline)) void diarioPartida(const struct Jogo *jogo, long p) {
+    if (__builtin_expect(!jogo->diario, 1)) return;
+    struct AnelEventos *anel = diarioReservar();
+    if (anel == NULL) return;
+    int64_t diferenca = (int64_t) p - anel->proximaPartida;
+    anel->proximaPartida = (int64_t) p + 1;
+    if (__builtin_expect(diferenca == 0, 1)) return;
+    uint64_t zigzag = ((uint64_t) diferenca << 1) ^ (uint64_t) (diferenca >> 63);
+    anel->posicao = diarioCamposVarint(anel->posicao, EVENTO_PARTIDA, 1, &zigzag);
+}
+
+/**
+ * @brief Número da rodada de dados nos 13 bits de EVENTO_DADOS (ver PosicaoDados).
+ */
+static inline __attribute__((always_inline)) unsigned diarioJogada(const int dadosAtaque[3], const int dadosDefesa[3]) {
+    return PosicaoDados[(dadosAtaque[0] * 7 + dadosAtaque[1]) * 7 + dadosAtaque[2]] * DADOS_JOGADAS +
+           PosicaoDados[(dadosDefesa[0] * 7 + dadosDefesa[1]) * 7 + dadosDefesa[2]];
+}
+
+/**
+ * @brief Registra a primeira rodada de dados de um ataque, junto com o ataque.
+ * @note Os dados vêm como rodadaDeDados os deixa e as tropas, de antes das
+ *       baixas; a jogada ocupa os 2 bytes finais do registro, o byte baixo
+ *       primeiro.
+ */
+static inline __attribute__((always_inline)) void diarioAtaque(const struct Jogo *jogo, int ataque, int defesa, int tropasAtaque,
+                                                             int tropasDefesa, const int dadosAtaque[3], const int dadosDefesa[3]) {
+    if (__builtin_expect(!jogo->diario, 1)) return;
+    struct AnelEventos *anel = diarioReservar();
+    if (anel == NULL) return;
+    uint64_t jogada = diarioJogada(dadosAtaque, dadosDefesa);
+    uint64_t maiores = (uint64_t) defesa | (uint64_t) tropasAtaque | (uint64_t) tropasDefesa;
+    if (__builtin_expect((uint64_t) ataque < DIARIO_CAMPO_ESCAPE && maiores < 0x80, 1)) {
+        diarioGravarPalavra(anel, EVENTO_ATAQUE | (uint64_t) ataque << 3 | (uint64_t) defesa << 8 | (uint64_t) tropasAtaque << 16 |
+                                  (uint64_t) tropasDefesa << 24 | jogada << 32, 6);
+        return;
+    }
+    unsigned char *p = diarioCamposVarint(anel->posicao, EVENTO_ATAQUE, 4,
+                                          (const uint64_t[]) {(uint64_t) ataque, (uint64_t) defesa, (uint64_t) tropasAtaque,
+                                                              (uint64_t) tropasDefesa});
+    p[0] = (unsigned char) jogada;
+    p[1] = (unsigned char) (jogada >> 8);
+    anel->posicao = p + 2;
+}
+
+/**
+ * @brief Registra as rodadas de dados seguintes de um ataque, como rodadaDeDados
+ *        os deixa: em ordem decrescente, com 0 nas posições dos dados não rolados.
+ * @note O número de dados de cada lado sai da própria jogada, e as baixas o
+ *       decodificador recalcula comparando os dados.
+ */
+static inline __attribute__((always_inline)) void diarioDados(const struct Jogo *jogo, const int dadosAtaque[3], const int dadosDefesa[3]) {
+    if (__builtin_expect(!jogo->diario, 1)) return;
+    struct AnelEventos *anel = diarioReservar();
+    if (anel == NULL) return;
+    diarioGravarPalavra(anel, EVENTO_DADOS | (uint64_t) diarioJogada(dadosAtaque, dadosDefesa) << 3, 2);
+}
+
+#endif // EVENTOS_H
@@ -0,0 +1,346 @@
+/**
+ * @file historico.c
+ * @brief Implementação das versões de uma partida com cópia na escrita por blocos.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "historico.h"
+#include "vista.h"
+
+/**
+ * @brief Garante espaço para 'necessario' elementos num vetor que cresce sob demanda.
+ * @note A capacidade dobra a cada realocação, então n inserções custam O(n).
+ * @return 0 em caso de sucesso, 1 se faltou memória (o vetor original continua válido)
+ */
+static int garantirCapacidade(void **vetor, long *capacidade, long necessario, size_t tamanho) {
+    if (necessario <= *capacidade) return 0;
+    long novaCapacidade = *capacidade > 0 ? *capacidade : 16;
+    while (novaCapacidade < necessario) novaCapacidade *= 2;
+    void *novo = realloc(*vetor, (size_t) novaCapacidade * tamanho);
+    if (novo == NULL) return 1;
+    *vetor = novo;
+    *capacidade = novaCapacidade;
+    return 0;
+}
+
+/**
+ * @brief Copia o estado pequeno da partida (jogadores, territórios de cada cor e vencedor).
+ */
+static void lerEscalares(const struct Jogo *jogo, char *destino) {
+    size_t jogadores = (size_t) jogo->numJogadores * sizeof(struct Jogador);
+    size_t porCor = (size_t) jogo->numCores * sizeof(int);
+    memcpy(destino, jogo->jogadores, jogadores);
+    memcpy(destino + jogadores, jogo->territoriosCor, porCor);
+    memcpy(destino + jogadores + porCor, &jogo->vencedor, sizeof(int));
+}
+
+/**
+ * @brief Restaura o estado pequeno copiado por lerEscalares.
+ */
+static void escreverEscalares(struct Jogo *jogo, const char *origem) {
+    size_t jogadores = (size_t) jogo->numJogadores * sizeof(struct Jogador);
+    size_t porCor = (size_t) jogo->numCores * sizeof(int);
+    memcpy(jogo->jogadores, origem, jogadores);
+    memcpy(jogo->territoriosCor, origem + jogadores, porCor);
+    memcpy(&jogo->vencedor, origem + jogadores + porCor, sizeof(int));
+}
+
+/**
+ * @brief Abre uma versão nova: todo bloco volta a ser copiado na primeira escrita.
+ */
+static void novaGeracao(struct Historico *historico) {
+    if (++historico->geracao == 0) {
+        memset(historico->geracaoBloco, 0, (size_t) historico->numBlocosMapa * sizeof(uint32_t));
+        historico->geracao = 1;
+    }
+}
+
+/**
+ * @brief Posição em blocos[] logo depois da última versão fechada.
+ */
+static long fimVersoesFechadas(const struct Historico *historico) {
+    if (historico->numVersoes == 0) return 0;
+    const struct VersaoHistorico *ultima = &historico->versoes[historico->numVersoes - 1];
+    return ultima->primeiroBloco + ultima->numBlocos;
+}
+
+/**
+ * @brief Descarta as versões que podiam ser refeitas (a partida seguiu outro caminho).
+ */
+static void descartarRefazer(struct Historico *historico) {
+    if (historico->atual >= historico->numVersoes) return;
+    historico->numVersoes = historico->atual;
+    historico->numBlocos = fimVersoesFechadas(historico);
+}
+
+/**
+ * @brief Função para começar a versionar a partida (a marca 0 é o estado atual)
+ * @note Os jogadores da partida já devem estar cadastrados: o estado pequeno
+ *       de cada versão tem o tamanho de numJogadores e numCores.
+ * @param historico Histórico a preparar
+ * @param jogo Partida versionada (recebe jogo->historico)
+ * @return 0 em caso de sucesso, 1 se faltou memória
+ */
+int criarHistorico(struct Historico *historico, struct Jogo *jogo) {
+    memset(historico, 0, sizeof(*historico));
+    historico->jogo = jogo;
+    historico->numBlocosMapa = (jogo->numTerritorios + HISTORICO_BLOCO - 1) / HISTORICO_BLOCO;
+    historico->geracao = 1;
+    historico->tamanhoEscalares = (size_t) jogo->numJogadores * sizeof(struct Jogador)
+                                + (size_t) jogo->numCores * sizeof(int) + sizeof(int);
+    historico->geracaoBloco = (uint32_t *) calloc((size_t) historico->numBlocosMapa, sizeof(uint32_t));
+    historico->escalaresAbertos = (char *) malloc(historico->tamanhoEscalares);
+    historico->escalaresTroca = (char *) malloc(historico->tamanhoEscalares);
+    if (historico->geracaoBloco == NULL || historico->escalaresAbertos == NULL || historico->escalaresTroca == NULL) {
+        liberarHistorico(historico);
+        return 1;
+    }
+    lerEscalares(jogo, historico->escalaresAbertos);
+    jogo->historico = historico;
+    return 0;
+}
+
+/**
+ * @brief Função para parar de versionar a partida e liberar as versões
+ * @param historico Histórico criado por criarHistorico (um histórico zerado também é aceito)
+ */
+void liberarHistorico(struct Historico *historico) {
+    if (historico->jogo != NULL && historico->jogo->historico == historico) historico->jogo->historico = NULL;
+    free(historico->geracaoBloco);
+    free(historico->blocos);
+    free(historico->versoes);
+    free(historico->escalares);
+    free(historico->escalaresAbertos);
+    free(historico->escalaresTroca);
+    memset(historico, 0, sizeof(*historico));
+}
+
+/**
+ * @brief Função para esquecer as versões (o estado atual vira a marca 0)
+ * @note A memória dos vetores é mantida para as próximas versões.
+ * @param historico Histórico da partida
+ */
+void limparHistorico(struct Historico *historico) {
+    historico->numBlocos = 0;
+    historico->numVersoes = 0;
+    historico->atual = 0;
+    lerEscalares(historico->jogo, historico->escalaresAbertos);
+    novaGeracao(historico);
+}
+
+/**
+ * @brief Função para copiar um bloco antes da primeira escrita da versão
+ * @note Chamada por antesDeAlterar. Escrever depois de desfazer descarta o
+ *       que podia ser refeito. Se faltar memória, o histórico é esvaziado.
+ * @param historico Histórico da partida
+ * @param bloco Índice do bloco que vai mudar
+ */
+void copiarBlocoHistorico(struct Historico *historico, int bloco) {
+    const struct Jogo *jogo = historico->jogo;
+    descartarRefazer(historico);
+    if (garantirCapacidade((void **) &historico->blocos, &historico->capacidadeBlocos,
+                           historico->numBlocos + 1, sizeof(struct BlocoHistorico)) != 0) {
+        historico->falhas++;
+        limparHistorico(historico);
+        return;
+    }
+
+    int inicio = bloco * HISTORICO_BLOCO;
+    int n = jogo->numTerritorios - inicio;
+    if (n > HISTORICO_BLOCO) n = HISTORICO_BLOCO;
+    struct BlocoHistorico *copia = &historico->blocos[historico->numBlocos++];
+    copia->bloco = bloco;
+    memcpy(copia->tropas, jogo->tropas + inicio, (size_t) n * sizeof(int32_t));
+    memcpy(copia->dono, jogo->dono + inicio, (size_t) n);
+    historico->geracaoBloco[bloco] = historico->geracao;
+    historico->blocosCopiados++;
+}
+
+/**
+ * @brief Função para fechar a versão nas fronteiras de ataque e turno
+ * @note Uma versão sem nenhuma mudança não é fechada: marcar duas vezes
+ *       seguidas não cria uma versão vazia para desfazer.
+ * @param historico Histórico da partida
+ * @return A marca em que a partida está (0 é a criação do histórico)
+ */
+long marcarVersao(struct Historico *historico) {
+    const struct Jogo *jogo = historico->jogo;
+    long fim = fimVersoesFechadas(historico);
+    int blocosPendentes = historico->atual == historico->numVersoes && historico->numBlocos > fim;
+    lerEscalares(jogo, historico->escalaresTroca);
+    int escalaresMudaram = memcmp(historico->escalaresTroca, historico->escalaresAbertos, historico->tamanhoEscalares) != 0;
+    if (!blocosPendentes && !escalaresMudaram) return historico->atual;
+
+    descartarRefazer(historico);
+    fim = fimVersoesFechadas(historico);
+    // Cada vetor tem a sua capacidade: se a segunda realocação falha, a
+    // primeira continua válida e nenhuma das duas passa do tamanho real
+    if (garantirCapacidade((void **) &historico->versoes, &historico->capacidadeVersoes,
+                           historico->numVersoes + 1, sizeof(struct VersaoHistorico)) != 0 ||
+        garantirCapacidade((void **) &historico->escalares, &historico->capacidadeEscalares,
+                           historico->numVersoes + 1, historico->tamanhoEscalares) != 0) {
+        historico->falhas++;
+        limparHistorico(historico);
+        return historico->atual;
+    }
+
+    // A versão guarda o estado pequeno da marca em que começou
+    struct VersaoHistorico *versao = &historico->versoes[historico->numVersoes];
+    versao->primeiroBloco = fim;
+    versao->numBlocos = historico->numBlocos - fim;
+    memcpy(historico->escalares + (size_t) historico->numVersoes * historico->tamanhoEscalares,
+           historico->escalaresAbertos, historico->tamanhoEscalares);
+    historico->numVersoes++;
+    historico->atual++;
+    memcpy(historico->escalaresAbertos, historico->escalaresTroca, historico->tamanhoEscalares);
+    novaGeracao(historico);
+    return historico->atual;
+}
+
+/**
+ * @brief Troca os blocos e o estado pequeno de uma versão com os da partida.
+ * @note Aplicada uma vez desfaz a versão; aplicada de novo a refaz. Os bits
+ *       de posse acompanham os donos trocados, e as visões (vista.h) cada
+ *       território que mudou.
+ */
+static void trocarVersao(struct Historico *historico, long indice) {
+    struct Jogo *jogo = historico->jogo;
+    const struct VersaoHistorico *versao = &historico->versoes[indice];
+
+    for (long k = versao->primeiroBloco; k < versao->primeiroBloco + versao->numBlocos; k++) {
+        struct BlocoHistorico *copia = &historico->blocos[k];
+        int inicio = copia->bloco * HISTORICO_BLOCO;
+        int n = jogo->numTerritorios - inicio;
+        if (n > HISTORICO_BLOCO) n = HISTORICO_BLOCO;
+
+        for (int i = 0; i < n; i++) {
+            int t = inicio + i;
+            int32_t tropas = jogo->tropas[t];
+            jogo->tropas[t] = copia->tropas[i];
+            copia->tropas[i] = tropas;
+
+            int corAtual = jogo->dono[t];
+            int corGuardada = copia->dono[i];
+            if (corAtual != corGuardada) {
+                uint64_t bit = 1ULL << (t & 63);
+                if (corAtual != SEM_COR) jogo->posse[(long) corAtual * jogo->palavrasPosse + (t >> 6)] &= ~bit;
+                if (corGuardada != SEM_COR) jogo->posse[(long) corGuardada * jogo->palavrasPosse + (t >> 6)] |= bit;
+                jogo->dono[t] = (int8_t) corGuardada;
+                copia->dono[i] = (int8_t) corAtual;
+            }
+            if (tropas != jogo->tropas[t] || corAtual != corGuardada) depoisDeAlterar(jogo, t);
+        }
+    }
+
+    char *escalares = historico->escalares + (size_t) indice * historico->tamanhoEscalares;
+    lerEscalares(jogo, historico->escalaresTroca);
+    escreverEscalares(jogo, escalares);
+    memcpy(escalares, historico->escalaresTroca, historico->tamanhoEscalares);
+}
+
+/**
+ * @brief Função para voltar à marca anterior
+ * @note O que mudou desde a última marca é fechado numa versão antes, então
+ *       desfazer sempre volta a uma marca. Custa O(blocos da versão).
+ * @param historico Histórico da partida
+ * @return 0 em caso de sucesso, 1 se não há o que desfazer
+ */
+int desfazerVersao(struct Historico *historico) {
+    marcarVersao(historico);
+    if (historico->atual == 0) return 1;
+    historico->atual--;
+    trocarVersao(historico, historico->atual);
+    lerEscalares(historico->jogo, historico->escalaresAbertos);
+    novaGeracao(historico);
+    return 0;
+}
+
+/**
+ * @brief Função para avançar para a marca seguinte
+ * @param historico Histórico da partida
+ * @return 0 em caso de sucesso, 1 se não há o que refazer (nada foi desfeito,
+ *         ou a partida mudou depois de desfazer)
+ */
+int refazerVersao(struct Historico *historico) {
+    marcarVersao(historico);
+    if (historico->atual >= historico->numVersoes) return 1;
+    trocarVersao(historico, historico->atual);
+    historico->atual++;
+    lerEscalares(historico->jogo, historico->escalaresAbertos);
+    novaGeracao(historico);
+    return 0;
+}
+
+/**
+ * @brief Copia de volta os blocos de uma versão sem guardar o que é desfeito.
+ * @note Usada quando o que vem depois da versão vai ser descartado. As
+ *       visões (vista.h) acompanham cada território que mudou.
+ */
+static void restaurarVersao(struct Historico *historico, long indice) {
+    struct Jogo *jogo = historico->jogo;
+    const struct VersaoHistorico *versao = &historico->versoes[indice];
+
+    for (long k = versao->primeiroBloco + versao->numBlocos - 1; k >= versao->primeiroBloco; k--) {
+        const struct BlocoHistorico *copia = &historico->blocos[k];
+        int inicio = copia->bloco * HISTORICO_BLOCO;
+        int n = jogo->numTerritorios - inicio;
+        if (n > HISTORICO_BLOCO) n = HISTORICO_BLOCO;
+
+        // Sem visões, as tropas são copiadas de uma vez; com elas, cada
+        // território alterado é comparado e avisado, como em trocarVersao
+        if (jogo->vistas == NULL) {
+            memcpy(jogo->tropas + inicio, copia->tropas, (size_t) n * sizeof(int32_t));
+            if (memcmp(jogo->dono + inicio, copia->dono, (size_t) n) == 0) continue; // Só tropas mudaram
+        }
+        for (int i = 0; i < n; i++) {
+            int t = inicio + i;
+            int32_t tropas = jogo->tropas[t];
+            jogo->tropas[t] = copia->tropas[i];
+            int corAtual = jogo->dono[t];
+            int corGuardada = copia->dono[i];
+            if (corAtual != corGuardada) {
+                uint64_t bit = 1ULL << (t & 63);
+                if (corAtual != SEM_COR) jogo->posse[(long) corAtual * jogo->palavrasPosse + (t >> 6)] &= ~bit;
+                if (corGuardada != SEM_COR) jogo->posse[(long) corGuardada * jogo->palavrasPosse + (t >> 6)] |= bit;
+                jogo->dono[t] = (int8_t) corGuardada;
+            }
+            if (tropas != jogo->tropas[t] || corAtual != corGuardada) depoisDeAlterar(jogo, t);
+        }
+    }
+}
+
+/**
+ * @brief Função para voltar a uma marca e descartar o que veio depois
+ * @note É o fim de um ramo de busca: marca antes do ramo, joga, volta. Como
+ *       as versões descartadas não serão refeitas, os blocos são só copiados
+ *       de volta (sem a troca de desfazerVersao).
+ * @param historico Histórico da partida
+ * @param marca Marca devolvida por marcarVersao
+ * @return 0 em caso de sucesso, 1 se a marca não existe
+ */
+int voltarParaVersao(struct Historico *historico, long marca) {
+    marcarVersao(historico);
+    if (marca < 0 || marca > historico->atual) return 1;
+    if (marca == historico->atual) return 0;
+
+    // Da versão mais nova para a mais velha: vale a cópia mais antiga de cada bloco
+    for (long v = historico->atual - 1; v >= marca; v--) restaurarVersao(historico, v);
+    const char *escalares = historico->escalares + (size_t) marca * historico->tamanhoEscalares;
+    escreverEscalares(historico->jogo, escalares);
+    memcpy(historico->escalaresAbertos, escalares, historico->tamanhoEscalares);
+    historico->atual = marca;
+    descartarRefazer(historico);
+    novaGeracao(historico);
+    return 0;
+}
+
+/**
+ * @brief Função para medir a memória guardada pelas versões
+ * @return Bytes dos blocos copiados e do estado pequeno das versões fechadas
+ */
+size_t bytesHistorico(const struct Historico *historico) {
+    return (size_t) historico->numBlocos * sizeof(struct BlocoHistorico)
+         + (size_t) historico->numVersoes * (sizeof(struct VersaoHistorico) + historico->tamanhoEscalares);
+}
@@ -0,0 +1,96 @@
+/**
+ * @file historico.h
+ * @brief Versões de uma partida com cópia na escrita por blocos (desfazer, refazer e ramos de busca).
+ *
+ * Os territórios são divididos em blocos de HISTORICO_BLOCO. Uma versão é
+ * marcada nas fronteiras de ataque e de turno (marcarVersao); depois dela, a
+ * primeira escrita em cada bloco (tropas ou dono, ver antesDeAlterar) copia o
+ * bloco como estava na marca. Uma versão guarda, portanto, só os blocos que
+ * mudaram, mais o estado pequeno da partida (jogadores, territórios de cada
+ * cor e vencedor), que não depende do tamanho do mapa.
+ *
+ * Desfazer troca o conteúdo dos blocos guardados com o da partida: a
+ * partida volta à marca e a versão passa a guardar o que foi desfeito, que
+ * refazer troca de novo. As duas operações custam O(blocos alterados). Uma
+ * escrita depois de desfazer descarta o que podia ser refeito. Os conjuntos
+ * de posse não são guardados: os bits de cada bloco restaurado são
+ * refeitos a partir dos donos (o bloco cabe numa palavra de posse).
+ *
+ * Uma busca (ex.: MCTS) marca a versão atual, joga um ramo na própria
+ * partida e volta com voltarParaVersao, sem copiar o mapa inteiro.
+ *
+ * O gerador de números aleatórios não é versionado: desfazer não devolve os
+ * dados já rolados, então atacar de novo depois de desfazer rola dados novos
+ * (refazer, por outro lado, devolve exatamente o resultado desfeito).
+ */
+#ifndef HISTORICO_H
+#define HISTORICO_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "jogo.h"
+
+#define HISTORICO_BLOCO 16 // Territórios de cada bloco copiado na escrita (divide 64)
+
+// Cópia de um bloco de territórios
+struct BlocoHistorico {
+    int32_t bloco;                    // Índice do bloco (territórios bloco * HISTORICO_BLOCO em diante)
+    int32_t tropas[HISTORICO_BLOCO];  // Tropas do bloco
+    int8_t dono[HISTORICO_BLOCO];     // Donos do bloco
+};
+
+// Uma versão fechada: os blocos que mudaram até a marca seguinte
+struct VersaoHistorico {
+    long primeiroBloco; // Posição do primeiro bloco em blocos[]
+    long numBlocos;     // Blocos da versão
+};
+
+// Histórico de versões de uma partida (ligado a ela por jogo->historico)
+struct Historico {
+    struct Jogo *jogo;              // Partida versionada
+    uint32_t *geracaoBloco;         // Geração em que cada bloco já foi copiado
+    uint32_t geracao;               // Geração da versão aberta (muda a cada marca, desfazer e refazer)
+    int numBlocosMapa;              // Blocos do mapa
+
+    struct BlocoHistorico *blocos;  // Blocos de todas as versões, em ordem
+    long numBlocos;
+    long capacidadeBlocos;
+    struct VersaoHistorico *versoes; // Versões fechadas (as posteriores à atual podem ser refeitas)
+    long numVersoes;
+    long capacidadeVersoes;
+    long atual;                     // A partida está na marca 'atual' (mais o que mudou depois dela)
+
+    size_t tamanhoEscalares;        // Bytes do estado pequeno (jogadores, territórios por cor, vencedor)
+    char *escalares;                // Estado pequeno de cada versão fechada (tamanhoEscalares cada)
+    long capacidadeEscalares;       // Versões que cabem em escalares
+    char *escalaresAbertos;         // Estado pequeno na marca atual
+    char *escalaresTroca;           // Área de troca
+
+    long blocosCopiados;            // Blocos copiados na escrita desde a criação
+    long falhas;                    // Vezes em que faltou memória (o histórico foi esvaziado)
+};
+
+// --- Protótipos das Funções ---
+int criarHistorico(struct Historico *historico, struct Jogo *jogo); // Função para começar a versionar a partida (a marca 0 é o estado atual)
+void liberarHistorico(struct Historico *historico);                 // Função para parar de versionar a partida e liberar as versões
+void limparHistorico(struct Historico *historico);                  // Função para esquecer as versões (o estado atual vira a marca 0)
+long marcarVersao(struct Historico *historico);                     // Função para fechar a versão nas fronteiras de ataque e turno (retorna a marca atual)
+int desfazerVersao(struct Historico *historico);                    // Função para voltar à marca anterior (retorna 1 se não há o que desfazer)
+int refazerVersao(struct Historico *historico);                     // Função para avançar para a marca seguinte (retorna 1 se não há o que refazer)
+int voltarParaVersao(struct Historico *historico, long marca);       // Função para voltar a uma marca e descartar o que veio depois (ramo de busca)
+size_t bytesHistorico(const struct Historico *historico);           // Função para medir a memória guardada pelas versões
+void copiarBlocoHistorico(struct Historico *historico, int bloco);  // Função para copiar um bloco antes da primeira escrita da versão (ver antesDeAlterar)
+
+/**
+ * @brief Avisa o histórico de que as tropas ou o dono do território t vão mudar.
+ * @note Sem histórico, ou com o bloco já copiado nesta versão, custa uma comparação.
+ */
+static inline void antesDeAlterar(struct Jogo *jogo, int t) {
+    struct Historico *historico = jogo->historico;
+    if (historico != NULL && historico->geracaoBloco[t / HISTORICO_BLOCO] != historico->geracao) {
+        copiarBlocoHistorico(historico, t / HISTORICO_BLOCO);
+    }
+}
+
+#endif // HISTORICO_H
@@ -0,0 +1,714 @@
+/**
+ * @file jogo.c
+ * @brief Implementação das regras do WAR ESTRUTURADO.
+ * @note Nenhuma função deste arquivo lê do teclado: toda decisão é delegada
+ *       à struct Politica do jogador envolvido.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#include "jogo.h"
+#include "batalha.h"
+#include "missao.h"
+#include "metricas.h"
+#include "arena.h"
+#include "historico.h"
+#include "eventos.h"
+#include "vista.h"
+
+// Define o vetor de cores disponíveis para os jogadores (as numeradas são preenchidas por nomearCoresExtras)
+const char *cores[MAX_CORES] = {"Vermelho", "Azul", "Verde", "Amarelo", "Preto", "Branco"};
+
+// Nomes das cores numeradas ("Cor7" a "Cor96")
+static char NomesCoresExtras[MAX_CORES - CORES_CLASSICAS][8];
+
+// Missão de destruir cada cor (índice em Missoes)
+static int MissaoDaCor[MAX_CORES];
+
+// Nomes dos motores (enum MotorPartida)
+static const char *NomesMotores[TOTAL_MOTORES] = {"generico", "compacto"};
+
+// Motor fixado por preferirMotor (-1 = o mais especializado que serve ao mapa)
+static int MotorPreferido = -1;
+
+// Definição do vetor Missões, para as missões, do tipo struct Missao
+struct Missao Missoes[MAX_MISSOES] = {
+    {0, COR_BRANCO, 0, "Destruir o exército Branco. Caso não exista ou é sua própria cor, conquistar 5 territórios"},
+    {1, COR_PRETO, 0, "Destruir o exército Preto. Caso não exista ou é sua própria cor, conquistar 5 territórios"},
+    {2, COR_VERDE, 0, "Destruir o exército Verde. Caso não exista ou é sua própria cor, conquistar 5 territórios"},
+    {3, COR_AZUL, 0, "Destruir o exército Azul. Caso não exista ou é sua própria cor, conquistar 5 territórios"},
+    {4, COR_AMARELO, 0, "Destruir o exército Amarelo. Caso não exista ou é sua própria cor, conquistar 5 territórios"},
+    {5, COR_VERMELHO, 0, "Destruir o exército Vermelho. Caso não exista ou é sua própria cor, conquistar 5 territórios"},
+    {6, SEM_COR, 3, "Conquistar 3 territórios"},
+    {7, SEM_COR, 4, "Conquistar 4 territórios"},
+    {8, SEM_COR, 5, "Conquistar 5 territórios"}
+};
+
+/**
+ * @brief Nomeia as cores numeradas e cria a missão de destruir cada uma.
+ * @note Roda antes de main (construtor), então cores[] e Missoes[] já estão
+ *       completos para qualquer thread.
+ */
+__attribute__((constructor))
+static void nomearCoresExtras(void) {
+    for (int m = 0; m < MISSOES_CLASSICAS; m++) {
+        if (Missoes[m].cor != SEM_COR) MissaoDaCor[Missoes[m].cor] = m;
+    }
+    for (int c = CORES_CLASSICAS; c < MAX_CORES; c++) {
+        char *nome = NomesCoresExtras[c - CORES_CLASSICAS];
+        snprintf(nome, sizeof(NomesCoresExtras[0]), "Cor%d", c + 1);
+        cores[c] = nome;
+
+        int m = MISSOES_CLASSICAS + c - CORES_CLASSICAS;
+        Missoes[m].codigo = m;
+        Missoes[m].cor = c;
+        Missoes[m].territorios = 0;
+        snprintf(Missoes[m].descricao, sizeof(Missoes[m].descricao),
+                 "Destruir o exército Cor%d. Caso não exista ou é sua própria cor, conquistar 5 territórios", c + 1);
+        MissaoDaCor[c] = m;
+    }
+}
+
+/**
+ * @brief Função para alocar memória para os jogadores
+ * @note Aloca dinamicamente a memória para o vetor de jogadores usando calloc
+ * @return Ponteiro para o array de jogadores alocado
+ */
+struct Jogador *alocarMemoriaJogadores() {
+    // Aloca dinamicamente a memória para o vetor de jogadores usando calloc
+    struct Jogador *ptr = (struct Jogador *) calloc(MAX_JOGADORES, sizeof(struct Jogador));
+    METRICA_CONTAR(METRICA_ALOCACOES);
+    // Nenhum jogador tem cor até ser cadastrado
+    for (int i = 0; ptr != NULL && i < MAX_JOGADORES; i++) ptr[i].cor = SEM_COR;
+    // Retorna o ponteiro para a memória alocada ou NULL em caso de falha
+    return ptr;
+}
+
+/**
+ * @brief Função para alocar a memória de uma partida sobre um mapa
+ * @note Partida com as cores clássicas (até CORES_CLASSICAS jogadores); ver alocarJogoComCores.
+ * @param jogo Partida a preparar
+ * @param mapa Mapa da partida (deve continuar válido enquanto a partida existir)
+ * @return 0 em caso de sucesso, 1 se faltou memória (nada fica alocado)
+ */
+int alocarJogo(struct Jogo *jogo, const struct Mapa *mapa) {
+    return alocarJogoComCores(jogo, mapa, CORES_CLASSICAS);
+}
+
+/**
+ * @brief Função para alocar uma partida com numCores cores
+ * @note Os vetores de tropas e donos dos territórios, os jogadores (um por
+ *       cor) e os conjuntos de posse (um por cor) são recortados de uma única
+ *       arena do pool da thread (ver arena.h): uma partida criada e destruída
+ *       em seguida por outra do mesmo mapa não chama o alocador. Os demais
+ *       campos de jogo não são alterados. Nenhum território tem dono nem
+ *       tropas até ser distribuído.
+ * @param jogo Partida a preparar
+ * @param mapa Mapa da partida (deve continuar válido enquanto a partida existir)
+ * @param numCores Cores da partida (CORES_CLASSICAS a MAX_CORES; ver coresParaJogadores)
+ * @return 0 em caso de sucesso, 1 se faltou memória (nada fica alocado)
+ */
+int alocarJogoComCores(struct Jogo *jogo, const struct Mapa *mapa, int numCores) {
+    size_t n = (size_t) mapa->numTerritorios;
+    jogo->mapa = mapa;
+    jogo->mapeamento = NULL;
+    jogo->historico = NULL;
+    jogo->vistas = NULL;
+    jogo->gravador = NULL;
+    jogo->diario = 0;
+    jogo->numTerritorios = mapa->numTerritorios;
+    definirMotor(jogo, escolherMotor(mapa));
+    jogo->numCores = numCores;
+    jogo->palavrasPosse = (mapa->numTerritorios + 63) / 64;
+    size_t tamanhoPosse = (size_t) numCores * jogo->palavrasPosse * sizeof(uint64_t);
+    size_t tamanhoJogadores = (size_t) numCores * sizeof(struct Jogador);
+
+    jogo->arena = obterArena(tamanhoNaArena(n * sizeof(int32_t)) + tamanhoNaArena(n) +
+                             tamanhoNaArena(tamanhoJogadores) + tamanhoNaArena(tamanhoPosse));
+    if (jogo->arena == NULL) {
+        jogo->tropas = NULL;
+        jogo->dono = NULL;
+        jogo->jogadores = NULL;
+        jogo->posse = NULL;
+        return 1;
+    }
+    jogo->tropas = (int32_t *) reservarNaArena(jogo->arena, n * sizeof(int32_t));
+    jogo->dono = (int8_t *) reservarNaArena(jogo->arena, n);
+    jogo->jogadores = (struct Jogador *) reservarNaArena(jogo->arena, tamanhoJogadores);
+    jogo->posse = (uint64_t *) reservarNaArena(jogo->arena, tamanhoPosse);
+
+    // A arena pode vir usada do pool: zera o que o calloc zerava
+    memset(jogo->tropas, 0, n * sizeof(int32_t));
+    memset(jogo->jogadores, 0, tamanhoJogadores);
+    for (int i = 0; i < numCores; i++) jogo->jogadores[i].cor = SEM_COR;
+    memset(jogo->dono, SEM_COR, n);
+    reiniciarPosse(jogo);
+    return 0;
+}
+
+/**
+ * @brief Função para liberar a memória de uma partida
+ * @note Numa partida retomada de um arquivo de estado, tropas, dono e posse
+ *       estão no mapeamento do arquivo, que é desfeito.
+ * @param jogo Partida alocada por alocarJogo ou retomada por retomarPartida
+ */
+void liberarJogo(struct Jogo *jogo) {
+    if (jogo->arena != NULL) {
+        devolverArena(jogo->arena);
+        jogo->arena = NULL;
+    } else if (jogo->mapeamento != NULL) {
+        munmap(jogo->mapeamento, jogo->tamanhoMapeamento);
+        jogo->mapeamento = NULL;
+        free(jogo->jogadores);
+    } else {
+        free(jogo->tropas);
+        free(jogo->dono);
+        free(jogo->posse);
+        free(jogo->jogadores);
+    }
+    jogo->tropas = NULL;
+    jogo->dono = NULL;
+    jogo->jogadores = NULL;
+    jogo->posse = NULL;
+}
+
+/**
+ * @brief Função para saber se um motor joga no mapa
+ * @param motor Motor (enum MotorPartida)
+ * @param mapa Mapa da partida
+ * @return 1 se o motor serve ao mapa, 0 caso contrário
+ */
+int motorServeAoMapa(int motor, const struct Mapa *mapa) {
+    if (motor == MOTOR_COMPACTO) return mapa->numTerritorios == MOTOR_TERRITORIOS_COMPACTO;
+    return motor == MOTOR_GENERICO;
+}
+
+/**
+ * @brief Função para escolher o motor de uma partida no mapa
+ * @note Sem preferência (preferirMotor), é o mais especializado que serve ao
+ *       mapa: o compacto no mapa clássico, o genérico nos demais.
+ * @param mapa Mapa da partida
+ * @return Motor escolhido (enum MotorPartida)
+ */
+int escolherMotor(const struct Mapa *mapa) {
+    if (MotorPreferido >= 0) return motorServeAoMapa(MotorPreferido, mapa) ? MotorPreferido : MOTOR_GENERICO;
+    return motorServeAoMapa(MOTOR_COMPACTO, mapa) ? MOTOR_COMPACTO : MOTOR_GENERICO;
+}
+
+/**
+ * @brief Função para trocar o motor de uma partida
+ * @note O motor compacto guarda os vizinhos de cada território numa palavra,
+ *       montada aqui a partir do CSR do mapa.
+ * @param jogo Partida com o mapa definido
+ * @param motor Motor que serve ao mapa (ver motorServeAoMapa)
+ */
+void definirMotor(struct Jogo *jogo, int motor) {
+    const struct Mapa *mapa = jogo->mapa;
+    jogo->motor = motor;
+    if (motor != MOTOR_COMPACTO) return;
+    for (int t = 0; t < MOTOR_TERRITORIOS_COMPACTO; t++) {
+        uint64_t vizinhos = 0;
+        for (int k = mapa->inicioVizinhos[t]; k < mapa->inicioVizinhos[t + 1]; k++) vizinhos |= 1ULL << mapa->vizinhos[k];
+        jogo->vizinhancaCompacta[t] = vizinhos;
+    }
+}
+
+/**
+ * @brief Função para fixar o motor das próximas partidas
+ * @note Um motor que não serve ao mapa de uma partida dá lugar ao genérico.
+ * @param nome "automatico" (o padrão), "generico" ou "compacto"
+ * @return 0 em caso de sucesso, 1 se o nome for desconhecido
+ */
+int preferirMotor(const char *nome) {
+    if (strcmp(nome, "automatico") == 0) {
+        MotorPreferido = -1;
+        return 0;
+    }
+    for (int m = 0; m < TOTAL_MOTORES; m++) {
+        if (strcmp(NomesMotores[m], nome) == 0) {
+            MotorPreferido = m;
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Função para obter o nome de um motor
+ */
+const char *nomeMotor(int motor) {
+    return (motor >= 0 && motor < TOTAL_MOTORES) ? NomesMotores[motor] : "?";
+}
+
+/**
+ * @brief Função para sortear a missão secreta de cada jogador
+ * @note As cores dos jogadores já devem estar definidas. As missões
+ *       disponíveis (as de territórios e as de destruir uma cor em jogo) são
+ *       marcadas num conjunto de bits e embaralhadas uma única vez
+ *       (Fisher-Yates parcial): cada jogador recebe uma missão distinta,
+ *       nunca a de destruir a própria cor, em O(jogadores + missões / 64)
+ *       sem sorteios repetidos. Só se as missões acabarem o jogador recebe a
+ *       MISSAO_RESERVA (conquistar 5 territórios).
+ * @param jogo Partida cujos jogadores receberão as missões
+ * @param Missoes Ponteiro para o vetor de missões disponíveis
+ * @param totalMissoes Número total de missões disponíveis
+ */
+void sortearMissoes(struct Jogo *jogo, const struct Missao *Missoes, int totalMissoes) {
+    struct Jogador *Jogadores = jogo->jogadores;
+
+    // Conjunto das missões disponíveis: as de territórios e as das cores em jogo
+    uint64_t disponiveis[(MAX_MISSOES + 63) / 64] = {0};
+    for (int m = CORES_CLASSICAS; m < MISSOES_CLASSICAS; m++) disponiveis[m >> 6] |= 1ULL << (m & 63);
+    for (int i = 0; i < jogo->numJogadores; i++) {
+        int m = MissaoDaCor[Jogadores[i].cor];
+        disponiveis[m >> 6] |= 1ULL << (m & 63);
+    }
+
+    // Vetor das disponíveis, com a posição de cada uma para achar a da própria cor em O(1)
+    int sorteio[MAX_MISSOES];
+    int posicao[MAX_MISSOES];
+    int total = 0;
+    for (int w = 0; w < (MAX_MISSOES + 63) / 64; w++) {
+        for (uint64_t bits = disponiveis[w]; bits != 0; bits &= bits - 1) {
+            int m = w * 64 + __builtin_ctzll(bits);
+            if (m >= totalMissoes) break;
+            posicao[m] = total;
+            sorteio[total++] = m;
+        }
+    }
+
+    // Define a missão secreta de cada jogador
+    int usadas = 0;
+    for (int i = 0; i < jogo->numJogadores; i++) {
+        // A missão de destruir a própria cor fica de fora do sorteio deste jogador
+        int propria = MissaoDaCor[Jogadores[i].cor];
+        int excluida = propria < totalMissoes && posicao[propria] >= usadas;
+        int restantes = total - usadas - excluida;
+
+        int missaoSorteada = MISSAO_RESERVA;
+        if (restantes > 0) {
+            int p = usadas + (int) rngLimitado(&jogo->rng, (uint32_t) restantes);
+            if (excluida && p >= posicao[propria]) p++;
+            int escolhida = sorteio[p];
+            sorteio[p] = sorteio[usadas];
+            posicao[sorteio[p]] = p;
+            sorteio[usadas] = escolhida;
+            posicao[escolhida] = usadas++;
+            missaoSorteada = escolhida;
+        }
+
+        // Atribui a missão sorteada ao jogador
+        Jogadores[i].missao = Missoes[missaoSorteada].codigo;
+        Jogadores[i].missaoCumprida = 0; // Inicializa como não cumprida
+
+        // Inicializa o número de territórios conquistados
+        Jogadores[i].conquistas = 0;
+
+        // Indexa o alvo da missão para a avaliação por eventos
+        registrarAlvoMissao(jogo, i);
+    }
+}
+
+/**
+ * @brief Corpo de distribuirTerritorios para n territórios.
+ * @note Instanciado com n constante no motor compacto, quando os laços são
+ *       desenrolados pelo compilador, e com jogo->numTerritorios no genérico.
+ */
+static inline __attribute__((always_inline)) void distribuirEmN(struct Jogo *jogo, const int n) {
+    int8_t *dono = jogo->dono;
+
+    // Embaralha os donos direto no vetor de donos (Fisher-Yates "de dentro para fora"):
+    // o i-ésimo dono sorteado é o jogador i % numJogadores, sem vetor auxiliar
+    for (int i = 0; i < n; i++) {
+        int j = (int) rngLimitado(&jogo->rng, i + 1);
+        dono[i] = dono[j];
+        dono[j] = (int8_t) jogo->jogadores[i % jogo->numJogadores].cor;
+    }
+
+    // Copia as tropas do mapa e registra os donos nos conjuntos de posse
+    for (int t = 0; t < n; t++) {
+        int cor = dono[t];
+        antesDeAlterar(jogo, t);
+        jogo->tropas[t] = jogo->mapa->tropasIniciais[t];
+        dono[t] = SEM_COR;
+        definirDono(jogo, t, cor);
+    }
+}
+
+/**
+ * @brief Função para distribuir, por sorteio, os territórios entre os jogadores
+ * @note Preenche a cor do exército e o número de tropas de cada território
+ *       a partir do mapa da partida. Os conjuntos de posse devem estar vazios.
+ * @param jogo Partida cujo mapa será preenchido
+ */
+void distribuirTerritorios(struct Jogo *jogo) {
+    if (jogo->motor == MOTOR_COMPACTO) {
+        distribuirEmN(jogo, MOTOR_TERRITORIOS_COMPACTO);
+    } else {
+        distribuirEmN(jogo, jogo->numTerritorios);
+    }
+}
+
+/**
+ * @brief Função para saber se algum território do mapa já tem dono
+ * @note Usa as contagens por cor mantidas por definirDono: O(cores).
+ *       distribuirTerritorios só pode ser chamada enquanto ela retornar 0.
+ * @param jogo Partida a consultar
+ * @return 1 se algum território tem dono, 0 se o mapa está vazio
+ */
+int mapaDistribuido(const struct Jogo *jogo) {
+    for (int c = 0; c < jogo->numCores; c++) {
+        if (jogo->territoriosCor[c] > 0) return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Função para retornar o pais pelo nome
+ * @note Consulta o índice de nomes do mapa (tabela hash): O(1) em vez de
+ *       percorrer todos os territórios.
+ * @param jogo Partida onde o território será buscado
+ * @param nome Nome do país a ser buscado
+ * @return Índice do território encontrado ou -1 se não encontrado
+ */
+int buscarTerritorioPorNome(const struct Jogo *jogo, const char *nome) {
+    METRICA_INICIO(inicio);
+    int t = buscarNomeNoMapa(jogo->mapa, nome);
+    METRICA_FIM(METRICA_BUSCAS_NOME, inicio);
+    return t;
+}
+
+/**
+ * @brief Função para retornar o jogador dono de uma cor
+ * @param jogo Partida onde o jogador será buscado
+ * @param cor Cor do exército (enum Cor)
+ * @return Ponteiro para o jogador encontrado ou NULL se nenhum jogador usa a cor
+ */
+struct Jogador *buscarJogadorPorCor(struct Jogo *jogo, int cor) {
+    if (cor < 0 || cor >= jogo->numCores || jogo->jogadorDaCor[cor] < 0) return NULL;
+    return &jogo->jogadores[jogo->jogadorDaCor[cor]];
+}
+
+/**
+ * @brief Função para converter o nome de uma cor em seu identificador
+ * @note Usada apenas na entrada de dados; o jogo trabalha com os identificadores.
+ * @param nome Nome da cor (como em cores[])
+ * @return Identificador da cor ou SEM_COR se o nome não existir
+ */
+int buscarCorPorNome(const char *nome) {
+    for (int c = 0; c < MAX_CORES; c++) {
+        if (strcmp(cores[c], nome) == 0) return c;
+    }
+    return SEM_COR;
+}
+
+/**
+ * @brief Função para obter a missão de destruir uma cor
+ * @param cor Identificador da cor (0 a MAX_CORES - 1)
+ * @return Índice da missão em Missoes
+ */
+int missaoDestruirCor(int cor) {
+    return MissaoDaCor[cor];
+}
+
+/**
+ * @brief Função para converter o identificador de uma cor em seu nome
+ * @param cor Identificador da cor
+ * @return Nome da cor, ou "" para SEM_COR
+ */
+const char *nomeCor(int cor) {
+    return (cor >= 0 && cor < MAX_CORES) ? cores[cor] : "";
+}
+
+/**
+ * @brief Esvazia os conjuntos de posse e desassocia as cores dos jogadores.
+ * @note Também zera as contagens e os alvos das missões (ver missao.h).
+ * @note Deve ser chamada antes de cadastrar uma nova partida.
+ * @param jogo Partida a reiniciar
+ */
+void reiniciarPosse(struct Jogo *jogo) {
+    memset(jogo->posse, 0, (size_t) jogo->numCores * jogo->palavrasPosse * sizeof(uint64_t));
+    for (int c = 0; c < jogo->numCores; c++) jogo->jogadorDaCor[c] = -1;
+    reiniciarMissoes(jogo);
+}
+
+/**
+ * @brief Atribui uma cor a um jogador e registra a associação cor -> jogador.
+ * @param jogo Partida em cadastro
+ * @param indiceJogador Índice do jogador
+ * @param cor Identificador da cor
+ */
+void definirCorJogador(struct Jogo *jogo, int indiceJogador, int cor) {
+    jogo->jogadores[indiceJogador].cor = cor;
+    jogo->jogadorDaCor[cor] = indiceJogador;
+}
+
+/**
+ * @brief Troca o dono de um território mantendo os conjuntos de posse em dia.
+ * @note Toda mudança de dono deve passar por esta função: ela também gera o
+ *       evento que atualiza as contagens e as missões (eventoTrocaDono).
+ * @param jogo Partida em andamento
+ * @param t Índice do território que muda de dono
+ * @param cor Nova cor dominante (SEM_COR para deixar sem dono)
+ */
+void definirDono(struct Jogo *jogo, int t, int cor) {
+    uint64_t bit = 1ULL << (t & 63);
+
+    antesDeAlterar(jogo, t);
+    if (jogo->dono[t] != SEM_COR) jogo->posse[(long) jogo->dono[t] * jogo->palavrasPosse + (t >> 6)] &= ~bit;
+    if (cor != SEM_COR) jogo->posse[(long) cor * jogo->palavrasPosse + (t >> 6)] |= bit;
+    int corAnterior = jogo->dono[t];
+    jogo->dono[t] = (int8_t) cor;
+    depoisDeAlterar(jogo, t);
+    eventoTrocaDono(jogo, corAnterior, cor);
+}
+
+// Corpo de atacar(); atacar() apenas o cronometra quando há métricas
+static void executarAtaque(struct Jogo *jogo, int ataque, int defesa, struct Jogador *Jogador){
+    const struct Politica *politicaAtaque = Jogador->politica;
+    int32_t *tropas = jogo->tropas;
+    const int8_t *dono = jogo->dono;
+    const char *nomeAtaque = nomeTerritorio(jogo->mapa, ataque);
+    const char *nomeDefesa = nomeTerritorio(jogo->mapa, defesa);
+    struct Jogador *defensor = buscarJogadorPorCor(jogo, dono[defesa]);
+    const struct Politica *politicaDefesa = defensor ? defensor->politica : politicaAtaque;
+
+    // Loop de ataque
+    JOGO_PRINTF(jogo, "\n--- Início do Ataque ---\n");
+    JOGO_PRINTF(jogo, "Território Atacante: %s (Cor: %s, Tropas: %d)\n", nomeAtaque, nomeCor(dono[ataque]), tropas[ataque]);
+    JOGO_PRINTF(jogo, "Território Defensor : %s (Cor: %s, Tropas: %d)\n", nomeDefesa, nomeCor(dono[defesa]), tropas[defesa]);
+    int continuar = 1;
+    int registrado = 0;          // 1 depois que o ataque entrou no diário
+    int blitzAtaque = 0;         // Tropas da batalha blitz antes dela (0 se não houve), registrada depois do laço
+    int blitzDefesa = 0;
+    int dadosAtaque[3]; // Dados da rodada: no máximo 3 de cada lado, sem alocação
+    int dadosDefesa[3];
+    do {
+        // Verifica se o território atacante possui tropas suficientes para atacar
+        if (tropas[ataque] < 2) {
+            JOGO_PRINTF(jogo, "Ataque não possui tropas suficientes para o ataque.\n");
+            return;
+        }
+
+        // Verifica se o território de ataque é o mesmo que o de defesa
+        if (dono[ataque] == dono[defesa]) {
+            JOGO_PRINTF(jogo, "Não é possível atacar países de mesma cor.\n");
+            return;
+        }
+
+        // Só é possível atacar um território vizinho
+        if (!fazFronteira(jogo->mapa, ataque, defesa)) {
+            JOGO_PRINTF(jogo, "%s não faz fronteira com %s.\n", nomeAtaque, nomeDefesa);
+            return;
+        }
+
+        // Resolução blitz: o resultado final da batalha sai de uma única consulta à tabela
+        if (politicaAtaque->blitz && batalhaNaTabela(tropas[ataque], tropas[defesa])) {
+            int tropasAtaque = tropas[ataque];
+            int tropasDefesa = tropas[defesa];
+            resolverBatalha(&jogo->rng, &tropasAtaque, &tropasDefesa);
+            antesDeAlterar(jogo, ataque);
+            antesDeAlterar(jogo, defesa);
+            blitzAtaque = tropas[ataque];
+            blitzDefesa = tropas[defesa];
+            tropas[ataque] = tropasAtaque;
+            tropas[defesa] = tropasDefesa;
+            depoisDeAlterar(jogo, ataque);
+            depoisDeAlterar(jogo, defesa);
+            JOGO_PRINTF(jogo, "Batalha resolvida: atacante com %d tropas, defesa com %d tropas\n", tropas[ataque], tropas[defesa]);
+            break;
+        }
+
+        // Pergunta quantos dados o atacante quer rolar (1 ao máximo de trocas - 1)
+        int maxDadosAtaque = (tropas[ataque] > 3) ? 3 : tropas[ataque] - 1;
+        int numDadosAtaque;
+
+        // Entra num loop até a política escolher um número válido de dados
+        do {
+            numDadosAtaque = politicaAtaque->dadosAtaque(jogo, ataque, defesa, maxDadosAtaque);
+        } while (numDadosAtaque < 1 || numDadosAtaque > maxDadosAtaque);
+
+        // Define o número máximo de dados da defesaa (número de tropas a 3)
+        int maxDadosDefesa = (tropas[defesa] > 3) ? 3 : tropas[defesa];
+        int numDadosDefesa;
+
+        // Entra num loop até a política escolher um número válido de dados
+        do {
+            numDadosDefesa = politicaDefesa->dadosDefesa(jogo, ataque, defesa, maxDadosDefesa);
+        } while (numDadosDefesa < 1 || numDadosDefesa > maxDadosDefesa);
+        if (jogo->gravador != NULL) jogo->gravador->rodada(jogo, ataque, defesa, numDadosAtaque, numDadosDefesa);
+
+        // Rola, ordena e compara os dados dos dois lados
+        int perdasAtaque = rodadaDeDados(&jogo->rng, numDadosAtaque, numDadosDefesa, dadosAtaque, dadosDefesa);
+        int comparacoes = (numDadosAtaque < numDadosDefesa) ? numDadosAtaque : numDadosDefesa;
+
+        if (JOGO_VERBOSO(jogo)) {
+            printf("\nAtacante: %d tropas, Defesa: %d tropas\n", tropas[ataque], tropas[defesa]);
+            printf("Atacante dados: ");
+            for (int i = 0; i < numDadosAtaque; i++) {
+                printf("%d ", dadosAtaque[i]);
+            }
+            printf("\nDefesa dados  : ");
+            for (int i = 0; i < numDadosDefesa; i++) {
+                printf("%d ", dadosDefesa[i]);
+            }
+            printf("\n");
+
+            // Narra cada comparação com a contagem de tropas após a perda
+            int tropasAtaque = tropas[ataque];
+            int tropasDefesa = tropas[defesa];
+            for (int i = 0; i < comparacoes; i++) {
+                if (dadosAtaque[i] > dadosDefesa[i]) {
+                    printf("Defensor perde 1 tropa! Tropas restantes: %d\n", --tropasDefesa);
+                } else {
+                    printf("Atacante perde 1 tropa! Tropas restantes: %d\n", --tropasAtaque);
+                }
+            }
+        }
+
+        // A primeira rodada vai no registro do ataque, com as tropas de antes das perdas
+        if (!registrado) {
+            diarioAtaque(jogo, ataque, defesa, tropas[ataque], tropas[defesa], dadosAtaque, dadosDefesa);
+            registrado = 1;
+        } else {
+            diarioDados(jogo, dadosAtaque, dadosDefesa);
+        }
+
+        // Aplica as perdas da rodada (as escritas seguintes nos dois territórios já estão cobertas)
+        antesDeAlterar(jogo, ataque);
+        antesDeAlterar(jogo, defesa);
+        tropas[ataque] -= perdasAtaque;
+        tropas[defesa] -= comparacoes - perdasAtaque;
+        depoisDeAlterar(jogo, ataque);
+        depoisDeAlterar(jogo, defesa);
+
+        if (tropas[ataque] > 1 && tropas[defesa] > 0){
+            // Pergunta se quer continuar o ataque
+            continuar = politicaAtaque->continuarAtaque(jogo, ataque, defesa);
+        } else {
+            continuar = 0; // Força a saída do loop se não houver tropas suficientes
+        }
+    } while (continuar);
+
+    // Verifica o vencedor
+    if (tropas[defesa] == 0) {
+        JOGO_PRINTF(jogo, "\nTerritório %s conquistado!\n", nomeDefesa);
+        METRICA_CONTAR(METRICA_CONQUISTAS);
+        // Depois de uma batalha blitz, a conquista vai no mesmo registro da batalha
+        if (blitzAtaque > 0) {
+            diarioBatalhaConquista(jogo, ataque, defesa, blitzAtaque, blitzDefesa, tropas[ataque], dono[ataque], dono[defesa]);
+        } else {
+            diarioRegistrar(jogo, EVENTO_CONQUISTA, 3, (uint64_t) dono[ataque], (uint64_t) dono[defesa]);
+        }
+        // Atualiza o dono do território conquistado; as contagens e as
+        // missões afetadas são reavaliadas pelo evento de troca de dono
+        definirDono(jogo, defesa, dono[ataque]);
+
+        if (jogo->vencedor < 0) {
+            // Pergunta quantas tropas o ataque quer mover (1 a número de tropas - 1)
+            int tropasMover;
+
+            // Cria um loop até o número de troas for correto
+            do {
+                tropasMover = politicaAtaque->tropasMover(jogo, ataque, defesa, tropas[ataque] - 1);
+            } while (tropasMover < 1 || tropasMover >= tropas[ataque]);
+            if (jogo->gravador != NULL) jogo->gravador->movimento(jogo, ataque, defesa, tropasMover);
+
+            // Move as tropas
+            tropas[ataque] -= tropasMover;
+            tropas[defesa] += tropasMover;
+            depoisDeAlterar(jogo, ataque);
+            depoisDeAlterar(jogo, defesa);
+            diarioMovimento(jogo, tropasMover);
+            JOGO_PRINTF(jogo, "%d tropas movidas para o território %s.\n", tropasMover, nomeDefesa);
+        }
+    } else {
+        if (blitzAtaque > 0) diarioBatalha(jogo, ataque, defesa, blitzAtaque, blitzDefesa, tropas[defesa]);
+        JOGO_PRINTF(jogo, "Ataque falhou! Território %s permanece com %d tropas.\n", nomeDefesa, tropas[defesa]);
+    }
+}
+
+/**
+* @brief Executa a lógica de uma batalha entre dois territórios.
+* @note Realiza validações, rola os dados, compara os resultados e atualiza o número de tropas.
+* @note Se um território for conquistado, atualiza seu dono e move uma tropa.
+* @note As escolhas (dados, continuar, tropas a mover) vêm da política do atacante;
+*       o número de dados da defesa vem da política do dono do território defensor.
+* @note Se a política do atacante for blitz, a batalha inteira é sorteada de uma vez.
+* @param jogo Partida em andamento
+* @param ataque Índice do território atacante
+* @param defesa Índice do território defensor
+* @param Jogador Ponteiro para o jogador atual
+*/
+void atacar(struct Jogo *jogo, int ataque, int defesa, struct Jogador *Jogador){
+    METRICA_INICIO(inicio);
+    executarAtaque(jogo, ataque, defesa, Jogador);
+    METRICA_FIM(METRICA_ATAQUES, inicio);
+}
+
+// Troca dois dados de lugar se estiverem fora da ordem decrescente, sem desvios
+// (o compilador gera cmov para os operadores ternários)
+#define ORDENAR_PAR(a, b) do { int maior_ = (a) > (b) ? (a) : (b); \
+                               int menor_ = (a) > (b) ? (b) : (a); \
+                               (a) = maior_; (b) = menor_; } while (0)
+
+/**
+ * @brief Ordena exatamente 3 dados em ordem decrescente com uma rede de ordenação.
+ * @note Rede de 3 comparadores: (0,1), (1,2), (0,1). Posições vazias valem 0 e
+ *       terminam no fim do vetor.
+ * @param dados Vetor com 3 posições
+ */
+static inline void ordenarTresDados(int dados[3]) {
+    ORDENAR_PAR(dados[0], dados[1]);
+    ORDENAR_PAR(dados[1], dados[2]);
+    ORDENAR_PAR(dados[0], dados[1]);
+}
+
+/**
+ * @brief Função auxiliar para ordenar um array de dados em ordem decrescente.
+ * @note Usa a rede de ordenação de 3 elementos; um lance nunca tem mais de 3 dados.
+ * @param dados Ponteiro para o array de inteiros a ser ordenado.
+ * @param n Número de elementos no array (1 a 3).
+ */
+void ordenarDados(int* dados, int n) {
+    int copia[3] = {0, 0, 0};
+    for (int i = 0; i < n; i++) copia[i] = dados[i];
+    ordenarTresDados(copia);
+    for (int i = 0; i < n; i++) dados[i] = copia[i];
+}
+
+/**
+ * @brief Rola, ordena e compara os dados de uma rodada de batalha.
+ * @note Núcleo da batalha: usa apenas os 3 espaços fixos de cada vetor, sem
+ *       alocação, e compara os pares sem desvios. Empates favorecem a defesa.
+ * @param rng Gerador de números aleatórios da partida
+ * @param numDadosAtaque Dados do atacante (1 a 3)
+ * @param numDadosDefesa Dados do defensor (1 a 3)
+ * @param dadosAtaque Recebe os dados do atacante em ordem decrescente (0 nas posições vazias)
+ * @param dadosDefesa Recebe os dados do defensor em ordem decrescente (0 nas posições vazias)
+ * @return Tropas perdidas pelo atacante; o defensor perde min(numDadosAtaque, numDadosDefesa) menos esse valor
+ */
+int rodadaDeDados(struct Rng *rng, int numDadosAtaque, int numDadosDefesa, int dadosAtaque[3], int dadosDefesa[3]) {
+    METRICA_INICIO(inicio);
+    // Todos os dados da rodada saem de um único lote (normalmente um só número de 64 bits)
+    int sorteados[6];
+    rngDados(rng, sorteados, numDadosAtaque + numDadosDefesa);
+
+    for (int i = 0; i < 3; i++) {
+        dadosAtaque[i] = (i < numDadosAtaque) ? sorteados[i] : 0;
+        dadosDefesa[i] = (i < numDadosDefesa) ? sorteados[numDadosAtaque + i] : 0;
+    }
+
+    ordenarTresDados(dadosAtaque);
+    ordenarTresDados(dadosDefesa);
+
+    int comparacoes = (numDadosAtaque < numDadosDefesa) ? numDadosAtaque : numDadosDefesa;
+    int perdasAtaque = ((0 < comparacoes) & (dadosAtaque[0] <= dadosDefesa[0]))
+                     + ((1 < comparacoes) & (dadosAtaque[1] <= dadosDefesa[1]))
+                     + ((2 < comparacoes) & (dadosAtaque[2] <= dadosDefesa[2]));
+    METRICA_FIM(METRICA_RODADAS_DADOS, inicio);
+    return perdasAtaque;
+}
@@ -0,0 +1,227 @@
+/**
+ * @file jogo.h
+ * @brief Regras do WAR ESTRUTURADO desacopladas da interface com o usuário.
+ *
+ * Este módulo concentra as estruturas de dados e a lógica de jogo (batalhas,
+ * conquistas, movimentação de tropas e verificação de missões). Todas as
+ * decisões que antes eram lidas com scanf passam por uma struct Politica,
+ * permitindo que o mesmo motor seja usado tanto pelo jogo interativo quanto
+ * pela simulação em lote (ver simulacao.h).
+ */
+#ifndef JOGO_H
+#define JOGO_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rng.h"
+#include "mapa.h"
+
+// --- Constantes Globais ---
+#define MAX_CORES 96             // Cores que uma partida pode usar (o dono de um território é um int8_t)
+#define CORES_CLASSICAS 6        // Cores com nome do jogo clássico; as demais se chamam "Cor7", "Cor8"...
+#define MAX_JOGADORES MAX_CORES  // Definição do número máximo de jogadores (um por cor)
+#define JOGADORES_CLASSICO 3     // Jogadores da partida padrão (simulações e suítes)
+#define MISSOES_TERRITORIOS 3    // Missões de conquistar territórios (as demais destroem uma cor)
+#define MISSOES_CLASSICAS (CORES_CLASSICAS + MISSOES_TERRITORIOS) // Missões do jogo clássico (as 9 primeiras)
+#define MAX_MISSOES (MAX_CORES + MISSOES_TERRITORIOS) // Definição do número máximo de missões
+#define MISSAO_RESERVA (MISSOES_CLASSICAS - 1) // "Conquistar 5 territórios": a missão de quem não tem outra
+#define TAM_STRING 100     // Definição do tamanho máximo das strings (aumentado para evitar erro de inicialização)
+#define MOTOR_TERRITORIOS_COMPACTO TERRITORIOS_CLASSICO // Territórios dos mapas do motor compacto (o clássico)
+
+// Vetor de cores disponíveis para os jogadores (as clássicas e depois as numeradas)
+extern const char *cores[MAX_CORES];
+
+// Identificadores das cores: a posição de cada nome no vetor cores[].
+// Dentro do jogo as cores são sempre esses inteiros; os nomes só aparecem na entrada e saída.
+// As cores de CORES_CLASSICAS em diante não têm nome no enum: são os inteiros seguintes.
+enum Cor { SEM_COR = -1, COR_VERMELHO, COR_AZUL, COR_VERDE, COR_AMARELO, COR_PRETO, COR_BRANCO };
+
+// --- Estrutura de Dados ---
+// Os territórios/países não têm uma struct própria: um território é o seu índice
+// no mapa. O estado que muda durante a partida fica em vetores paralelos de
+// struct Jogo (tropas e dono, 5 bytes por território) e os nomes ficam no mapa,
+// todos num único vetor de caracteres (ver mapa.h).
+
+// Motores das partidas: o mesmo jogo compilado para tamanhos de mapa diferentes.
+// O motor é escolhido ao alocar a partida (escolherMotor); com os mesmos
+// sorteios, todos chegam exatamente ao mesmo resultado.
+enum MotorPartida {
+    MOTOR_GENERICO, // Qualquer mapa: laços sobre numTerritorios, fronteiras em CSR e palavrasPosse palavras por cor
+    MOTOR_COMPACTO, // Mapas de MOTOR_TERRITORIOS_COMPACTO territórios: laços de tamanho fixo e uma palavra por conjunto
+    TOTAL_MOTORES
+};
+
+struct Politica;
+struct Historico;
+struct VistaMapa;
+struct GravadorAtaque;
+
+// Definição da estrutura para os jogadores
+// definindo a cor do exército e a missão secreta do jogador
+struct Jogador {
+    int cor;                         // Cor do exército do jogador (enum Cor, SEM_COR se não cadastrado)
+    int conquistas;                  // Número de territórios conquistados pelo jogador (tomados de outra cor)
+    int missaoCumprida;              // 1 - Sim e 0 - Não
+    int missao;                      // Código da missão secreta do jogador
+    const struct Politica *politica; // Quem toma as decisões do jogador (humano ou automático)
+};
+
+// Definição da estrutura para as missões
+// definindo o nome, a descrição da missão
+struct Missao {
+    int codigo;                 // Número da missão
+    int cor;                    // Cor do exército a ser destruído (SEM_COR se não for de destruição)
+    int territorios;            // Territórios a conquistar de outras cores (missões sem cor)
+    char descricao[TAM_STRING]; // Descrição da missão
+};
+
+// Vetor de missões disponíveis: as MISSOES_CLASSICAS do jogo clássico e
+// depois a de destruir cada cor numerada (preenchidas antes de main)
+extern struct Missao Missoes[MAX_MISSOES];
+
+#define TOTAL_MISSOES MAX_MISSOES // Número de missões disponíveis
+
+// Definição da estrutura de uma partida
+// agrupa o estado que antes vivia apenas em variáveis globais
+struct Jogo {
+    const struct Mapa *mapa;     // Mapa da partida (nomes, tropas iniciais e fronteiras)
+    int32_t *tropas;             // Número de tropas de cada território
+    int8_t *dono;                // Cor dominante de cada território (enum Cor, SEM_COR se não tiver dono)
+    int numTerritorios;          // Número de territórios no mapa
+    struct Jogador *jogadores;   // Vetor de jogadores
+    int numJogadores;            // Número de jogadores cadastrados
+    int verboso;                 // 1 - imprime o andamento da partida, 0 - silencioso
+    struct Rng rng;              // Gerador de números aleatórios da partida (dados e sorteios)
+    uint64_t *posse;             // Conjunto de bits dos territórios de cada cor (palavrasPosse palavras por cor)
+    int palavrasPosse;           // Palavras de 64 bits de cada conjunto de posse
+    int numCores;                // Cores da partida: posse e as tabelas por cor valem para as cores 0 a numCores - 1
+    int motor;                   // Motor da partida (enum MotorPartida; ver definirMotor)
+    uint64_t vizinhancaCompacta[MOTOR_TERRITORIOS_COMPACTO]; // Motor compacto: vizinhos de cada território em bits
+    int jogadorDaCor[MAX_CORES]; // Índice do jogador de cada cor (-1 se ninguém a usa)
+    int territoriosCor[MAX_CORES]; // Territórios de cada cor (mantido por definirDono, ver missao.h)
+    int cacadorDaCor[MAX_CORES]; // Jogador cuja missão é destruir a cor (-1 se nenhum)
+    int vencedor;                // Primeiro jogador a cumprir a missão (-1 enquanto ninguém cumpriu)
+    void *contexto;              // Dados das políticas da partida (ex.: o comando do roteiro em execução)
+    void *mapeamento;            // Arquivo de estado mapeado onde estão tropas, dono e posse (NULL se alocados; ver estado.h)
+    struct Arena *arena;         // Arena de onde saem tropas, dono, jogadores e posse (NULL se não vieram de uma; ver arena.h)
+    size_t tamanhoMapeamento;    // Tamanho do mapeamento
+    struct Historico *historico; // Versões da partida para desfazer e ramos de busca (NULL se não versionada; ver historico.h)
+    struct VistaMapa *vistas;    // Índices das visões ordenadas do mapa (NULL se não mantidos; ver vista.h)
+    int diario;                  // 1 - registra os eventos no diário binário, 0 - não registra (ver eventos.h)
+    const struct GravadorAtaque *gravador; // Recebe cada rodada e movimento de atacar() (NULL se ninguém grava)
+};
+
+// Observador das decisões de atacar(): recebe cada rodada de dados e cada
+// movimento de tropas, qualquer que seja a política de cada lado. O jogo
+// interativo o usa para gravar o roteiro (--record). Batalhas blitz, sem
+// rodadas, não passam por ele.
+struct GravadorAtaque {
+    // Uma rodada com os dados escolhidos pelos dois lados (chamada antes de rolar)
+    void (*rodada)(const struct Jogo *jogo, int ataque, int defesa, int numDadosAtaque, int numDadosDefesa);
+    // Tropas movidas para o território conquistado (chamada antes de mover)
+    void (*movimento)(const struct Jogo *jogo, int ataque, int defesa, int tropas);
+};
+
+// Definição da estrutura de uma política de decisão
+// cada ponto do jogo que exigia entrada do usuário vira uma função
+struct Politica {
+    const char *nome; // Nome da política (para relatórios)
+    int blitz;        // 1 - sempre luta até o fim com dados máximos (batalha resolvida pela tabela de batalha.h)
+
+    // Escolhe o par atacante/defensor (índices dos territórios); retorna 0 para terminar o turno
+    int (*escolherAtaque)(struct Jogo *jogo, struct Jogador *jogador, int *ataque, int *defesa);
+    // Número de dados do atacante (1 a maxDados)
+    int (*dadosAtaque)(struct Jogo *jogo, int ataque, int defesa, int maxDados);
+    // Número de dados do defensor (1 a maxDados)
+    int (*dadosDefesa)(struct Jogo *jogo, int ataque, int defesa, int maxDados);
+    // Retorna 1 para rolar mais uma rodada de dados
+    int (*continuarAtaque)(struct Jogo *jogo, int ataque, int defesa);
+    // Tropas a mover para o território conquistado (1 a maxTropas)
+    int (*tropasMover)(struct Jogo *jogo, int ataque, int defesa, int maxTropas);
+};
+
+// --- Consultas de posse ---
+// Com o conjunto de bits de cada cor, as perguntas mais comuns do jogo custam
+// uma instrução por palavra de 64 territórios.
+
+/**
+ * @brief Informa se o território de índice t pertence à cor.
+ */
+static inline int possuiTerritorio(const struct Jogo *jogo, int cor, int t) {
+    return (int) ((jogo->posse[(long) cor * jogo->palavrasPosse + (t >> 6)] >> (t & 63)) & 1);
+}
+
+/**
+ * @brief Conta os territórios de uma cor.
+ */
+static inline int contarTerritorios(const struct Jogo *jogo, int cor) {
+    const uint64_t *conjunto = jogo->posse + (long) cor * jogo->palavrasPosse;
+    int total = 0;
+    for (int w = 0; w < jogo->palavrasPosse; w++) total += __builtin_popcountll(conjunto[w]);
+    return total;
+}
+
+/**
+ * @brief Informa se uma cor não tem mais nenhum território.
+ */
+static inline int corEliminada(const struct Jogo *jogo, int cor) {
+    const uint64_t *conjunto = jogo->posse + (long) cor * jogo->palavrasPosse;
+    for (int w = 0; w < jogo->palavrasPosse; w++) {
+        if (conjunto[w]) return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Cores de uma partida com numJogadores jogadores: as clássicas, ou uma por jogador se forem mais.
+ */
+static inline int coresParaJogadores(int numJogadores) {
+    return numJogadores > CORES_CLASSICAS ? numJogadores : CORES_CLASSICAS;
+}
+
+// Informa se a partida imprime o seu andamento. Compilado com -DWAR_SILENCIOSO
+// (make quiet) vale sempre 0 e toda a narração sai do código das partidas.
+#ifdef WAR_SILENCIOSO
+#define JOGO_VERBOSO(jogo) ((void) (jogo), 0)
+#else
+#define JOGO_VERBOSO(jogo) ((jogo)->verboso)
+#endif
+
+// Imprime somente quando a partida está em modo verboso
+#define JOGO_PRINTF(jogo, ...) do { if (JOGO_VERBOSO(jogo)) printf(__VA_ARGS__); } while (0)
+
+// --- Protótipos das Funções ---
+// Funções de setup e gerenciamento de memória:
+struct Jogador *alocarMemoriaJogadores(); // Função para alocar dinamicamente os jogadores
+int alocarJogo(struct Jogo *jogo, const struct Mapa *mapa); // Função para recortar tropas, donos, jogadores e posse de uma arena
+int alocarJogoComCores(struct Jogo *jogo, const struct Mapa *mapa, int numCores); // Função para alocar uma partida com numCores cores
+void liberarJogo(struct Jogo *jogo);      // Função para devolver a arena (ou liberar a memória) de uma partida
+
+// Funções dos motores especializados:
+int escolherMotor(const struct Mapa *mapa); // Função para escolher o motor mais especializado que serve ao mapa
+void definirMotor(struct Jogo *jogo, int motor); // Função para trocar o motor de uma partida (o motor deve servir ao mapa)
+int preferirMotor(const char *nome);       // Função para fixar o motor das próximas partidas pelo nome (0 em caso de sucesso)
+int motorServeAoMapa(int motor, const struct Mapa *mapa); // Função para saber se um motor joga no mapa
+const char *nomeMotor(int motor);          // Função para obter o nome de um motor
+
+// Funções de lógica principal do jogo:
+void sortearMissoes(struct Jogo *jogo, const struct Missao *Missoes, int totalMissoes); // Função para sortear a missão secreta de cada jogador
+void distribuirTerritorios(struct Jogo *jogo);   // Função para sortear os territórios entre os jogadores
+void atacar(struct Jogo *jogo, int ataque, int defesa, struct Jogador *Jogador); // Função para realizar um ataque entre dois países
+void ordenarDados(int* dados, int n);     // Função auxiliar para ordenar os dados
+int rodadaDeDados(struct Rng *rng, int numDadosAtaque, int numDadosDefesa, int dadosAtaque[3], int dadosDefesa[3]); // Função para rolar e comparar os dados de uma rodada
+int buscarTerritorioPorNome(const struct Jogo *jogo, const char *nome);          // Função para buscar um território pelo nome
+struct Jogador *buscarJogadorPorCor(struct Jogo *jogo, int cor);                // Função para buscar o dono de uma cor
+
+// Funções de cores e posse:
+int buscarCorPorNome(const char *nome);    // Função para converter o nome de uma cor em seu identificador
+int missaoDestruirCor(int cor);            // Função para obter a missão de destruir uma cor
+const char *nomeCor(int cor);              // Função para converter o identificador de uma cor em seu nome
+void reiniciarPosse(struct Jogo *jogo);    // Função para esvaziar os conjuntos de posse e a tabela cor -> jogador
+void definirCorJogador(struct Jogo *jogo, int indiceJogador, int cor); // Função para atribuir uma cor a um jogador
+void definirDono(struct Jogo *jogo, int territorio, int cor); // Função para trocar o dono de um território
+int mapaDistribuido(const struct Jogo *jogo); // Função para saber se algum território já tem dono (distribuir só no mapa vazio)
+
+#endif // JOGO_H
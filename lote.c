@@ -0,0 +1,293 @@
+/**
+ * @file lote.c
+ * @brief Implementação das rodadas de dados em lote (escalar, SSE4.1 e AVX2).
+ * @note Os núcleos vetoriais usam atributos de alvo do GCC, então o resto do
+ *       programa continua compilado para o processador base.
+ */
+
+#include "lote.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define LOTE_X86 1
+#include <immintrin.h>
+#else
+#define LOTE_X86 0
+#endif
+
+// Rede de ordenação de 3 elementos em ordem decrescente (a mesma de ordenarTresDados)
+#define REDE_TRES(TIPO, MAX, MIN, x0, x1, x2) do { \
+        TIPO maior_;                                \
+        maior_ = MAX(x0, x1); x1 = MIN(x0, x1); x0 = maior_; \
+        maior_ = MAX(x1, x2); x2 = MIN(x1, x2); x1 = maior_; \
+        maior_ = MAX(x0, x1); x1 = MIN(x0, x1); x0 = maior_; \
+    } while (0)
+
+#define MAIOR(a, b) ((a) > (b) ? (a) : (b))
+#define MENOR(a, b) ((a) < (b) ? (a) : (b))
+
+/**
+ * @brief Núcleo escalar: uma batalha por vez, da posição 'inicio' até m.
+ * @note Os dados da faixa k (0 a 2 do atacante, 3 a 5 do defensor) da
+ *       batalha i estão em dados[k * m + i]. Os dados além do número de cada
+ *       lado viram 0 e vão para o fim na ordenação; um par só é comparado se
+ *       os dois lados têm dado nele.
+ */
+static void rodadasEscalar(const int *dados, int m, int inicio, const int32_t *dadosAtaque, const int32_t *dadosDefesa,
+                           int32_t *tropasAtaque, int32_t *tropasDefesa) {
+    for (int i = inicio; i < m; i++) {
+        int a0 = (dadosAtaque[i] > 0) ? dados[i] : 0;
+        int a1 = (dadosAtaque[i] > 1) ? dados[m + i] : 0;
+        int a2 = (dadosAtaque[i] > 2) ? dados[2 * m + i] : 0;
+        int d0 = (dadosDefesa[i] > 0) ? dados[3 * m + i] : 0;
+        int d1 = (dadosDefesa[i] > 1) ? dados[4 * m + i] : 0;
+        int d2 = (dadosDefesa[i] > 2) ? dados[5 * m + i] : 0;
+        REDE_TRES(int, MAIOR, MENOR, a0, a1, a2);
+        REDE_TRES(int, MAIOR, MENOR, d0, d1, d2);
+
+        int valido0 = (a0 > 0) & (d0 > 0);
+        int valido1 = (a1 > 0) & (d1 > 0);
+        int valido2 = (a2 > 0) & (d2 > 0);
+        int perdasAtaque = (valido0 & (a0 <= d0)) + (valido1 & (a1 <= d1)) + (valido2 & (a2 <= d2));
+        tropasAtaque[i] -= perdasAtaque;
+        tropasDefesa[i] -= valido0 + valido1 + valido2 - perdasAtaque;
+    }
+}
+
+#if LOTE_X86
+/**
+ * @brief Núcleo SSE4.1: 4 batalhas por instrução.
+ * @note As comparações dão -1 nas posições verdadeiras, então as perdas
+ *       são somadas já negativas e depois somadas às tropas.
+ * @return Primeira batalha não resolvida (o restante vai para o escalar)
+ */
+__attribute__((target("sse4.1")))
+static int rodadasSse41(const int *dados, int m, const int32_t *dadosAtaque, const int32_t *dadosDefesa,
+                        int32_t *tropasAtaque, int32_t *tropasDefesa) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i um = _mm_set1_epi32(1);
+    const __m128i dois = _mm_set1_epi32(2);
+    int i = 0;
+    for (; i + 4 <= m; i += 4) {
+        __m128i na = _mm_loadu_si128((const __m128i *) (dadosAtaque + i));
+        __m128i nd = _mm_loadu_si128((const __m128i *) (dadosDefesa + i));
+        __m128i a0 = _mm_and_si128(_mm_loadu_si128((const __m128i *) (dados + i)), _mm_cmpgt_epi32(na, zero));
+        __m128i a1 = _mm_and_si128(_mm_loadu_si128((const __m128i *) (dados + m + i)), _mm_cmpgt_epi32(na, um));
+        __m128i a2 = _mm_and_si128(_mm_loadu_si128((const __m128i *) (dados + 2 * m + i)), _mm_cmpgt_epi32(na, dois));
+        __m128i d0 = _mm_and_si128(_mm_loadu_si128((const __m128i *) (dados + 3 * m + i)), _mm_cmpgt_epi32(nd, zero));
+        __m128i d1 = _mm_and_si128(_mm_loadu_si128((const __m128i *) (dados + 4 * m + i)), _mm_cmpgt_epi32(nd, um));
+        __m128i d2 = _mm_and_si128(_mm_loadu_si128((const __m128i *) (dados + 5 * m + i)), _mm_cmpgt_epi32(nd, dois));
+        REDE_TRES(__m128i, _mm_max_epi32, _mm_min_epi32, a0, a1, a2);
+        REDE_TRES(__m128i, _mm_max_epi32, _mm_min_epi32, d0, d1, d2);
+
+        __m128i perdasAtaque = zero;
+        __m128i perdasDefesa = zero;
+        const __m128i pares[3][2] = {{a0, d0}, {a1, d1}, {a2, d2}};
+        for (int k = 0; k < 3; k++) {
+            __m128i valido = _mm_and_si128(_mm_cmpgt_epi32(pares[k][0], zero), _mm_cmpgt_epi32(pares[k][1], zero));
+            __m128i vence = _mm_cmpgt_epi32(pares[k][0], pares[k][1]);
+            perdasDefesa = _mm_add_epi32(perdasDefesa, _mm_and_si128(vence, valido));
+            perdasAtaque = _mm_add_epi32(perdasAtaque, _mm_andnot_si128(vence, valido));
+        }
+        __m128i *ataque = (__m128i *) (tropasAtaque + i);
+        __m128i *defesa = (__m128i *) (tropasDefesa + i);
+        _mm_storeu_si128(ataque, _mm_add_epi32(_mm_loadu_si128(ataque), perdasAtaque));
+        _mm_storeu_si128(defesa, _mm_add_epi32(_mm_loadu_si128(defesa), perdasDefesa));
+    }
+    return i;
+}
+
+/**
+ * @brief Núcleo AVX2: 8 batalhas por instrução (mesmo algoritmo do SSE4.1).
+ * @return Primeira batalha não resolvida (o restante vai para o escalar)
+ */
+__attribute__((target("avx2")))
+static int rodadasAvx2(const int *dados, int m, const int32_t *dadosAtaque, const int32_t *dadosDefesa,
+                       int32_t *tropasAtaque, int32_t *tropasDefesa) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i um = _mm256_set1_epi32(1);
+    const __m256i dois = _mm256_set1_epi32(2);
+    int i = 0;
+    for (; i + 8 <= m; i += 8) {
+        __m256i na = _mm256_loadu_si256((const __m256i *) (dadosAtaque + i));
+        __m256i nd = _mm256_loadu_si256((const __m256i *) (dadosDefesa + i));
+        __m256i a0 = _mm256_and_si256(_mm256_loadu_si256((const __m256i *) (dados + i)), _mm256_cmpgt_epi32(na, zero));
+        __m256i a1 = _mm256_and_si256(_mm256_loadu_si256((const __m256i *) (dados + m + i)), _mm256_cmpgt_epi32(na, um));
+        __m256i a2 = _mm256_and_si256(_mm256_loadu_si256((const __m256i *) (dados + 2 * m + i)), _mm256_cmpgt_epi32(na, dois));
+        __m256i d0 = _mm256_and_si256(_mm256_loadu_si256((const __m256i *) (dados + 3 * m + i)), _mm256_cmpgt_epi32(nd, zero));
+        __m256i d1 = _mm256_and_si256(_mm256_loadu_si256((const __m256i *) (dados + 4 * m + i)), _mm256_cmpgt_epi32(nd, um));
+        __m256i d2 = _mm256_and_si256(_mm256_loadu_si256((const __m256i *) (dados + 5 * m + i)), _mm256_cmpgt_epi32(nd, dois));
+        REDE_TRES(__m256i, _mm256_max_epi32, _mm256_min_epi32, a0, a1, a2);
+        REDE_TRES(__m256i, _mm256_max_epi32, _mm256_min_epi32, d0, d1, d2);
+
+        __m256i perdasAtaque = zero;
+        __m256i perdasDefesa = zero;
+        const __m256i pares[3][2] = {{a0, d0}, {a1, d1}, {a2, d2}};
+        for (int k = 0; k < 3; k++) {
+            __m256i valido = _mm256_and_si256(_mm256_cmpgt_epi32(pares[k][0], zero), _mm256_cmpgt_epi32(pares[k][1], zero));
+            __m256i vence = _mm256_cmpgt_epi32(pares[k][0], pares[k][1]);
+            perdasDefesa = _mm256_add_epi32(perdasDefesa, _mm256_and_si256(vence, valido));
+            perdasAtaque = _mm256_add_epi32(perdasAtaque, _mm256_andnot_si256(vence, valido));
+        }
+        __m256i *ataque = (__m256i *) (tropasAtaque + i);
+        __m256i *defesa = (__m256i *) (tropasDefesa + i);
+        _mm256_storeu_si256(ataque, _mm256_add_epi32(_mm256_loadu_si256(ataque), perdasAtaque));
+        _mm256_storeu_si256(defesa, _mm256_add_epi32(_mm256_loadu_si256(defesa), perdasDefesa));
+    }
+    return i;
+}
+#endif
+
+/**
+ * @brief Função para saber se o processador executa o núcleo
+ * @param nucleo Núcleo consultado (o automático e o escalar sempre estão disponíveis)
+ * @return 1 se disponível, 0 caso contrário
+ */
+int nucleoLoteDisponivel(enum NucleoLote nucleo) {
+    switch (nucleo) {
+        case LOTE_AUTOMATICO:
+        case LOTE_ESCALAR:
+            return 1;
+#if LOTE_X86
+        case LOTE_SSE41:
+            return __builtin_cpu_supports("sse4.1");
+        case LOTE_AVX2:
+            return __builtin_cpu_supports("avx2");
+#endif
+        default:
+            return 0;
+    }
+}
+
+/**
+ * @brief Troca o automático (ou um núcleo indisponível) pelo núcleo que será usado.
+ */
+static enum NucleoLote resolverNucleo(enum NucleoLote nucleo) {
+    if (nucleo == LOTE_AUTOMATICO) {
+        if (nucleoLoteDisponivel(LOTE_AVX2)) return LOTE_AVX2;
+        if (nucleoLoteDisponivel(LOTE_SSE41)) return LOTE_SSE41;
+        return LOTE_ESCALAR;
+    }
+    return nucleoLoteDisponivel(nucleo) ? nucleo : LOTE_ESCALAR;
+}
+
+/**
+ * @brief Função para obter o nome de um núcleo
+ * @param nucleo Núcleo (o automático é resolvido para o que seria usado)
+ * @return Nome do núcleo
+ */
+const char *nomeNucleoLote(enum NucleoLote nucleo) {
+    static const char *nomes[TOTAL_NUCLEOS_LOTE] = {"automático", "escalar", "SSE4.1", "AVX2"};
+    return nomes[resolverNucleo(nucleo)];
+}
+
+/**
+ * @brief Sorteia n dados (1 a 6) em lote, com os mesmos valores de rngDados().
+ * @note Sem desvios: cada byte é sempre escrito e só avança a posição se for
+ *       aceito (< 252, sem viés). Escreve até 7 posições além de n.
+ */
+static void sortearDados(struct Rng *rng, int *dados, int n) {
+    int i = 0;
+    while (i < n) {
+        uint64_t bits = rngProximo(rng);
+        for (int b = 0; b < 8; b++, bits >>= 8) {
+            unsigned int byte = (unsigned int) (bits & 0xff);
+            dados[i] = (int) (byte % 6) + 1;
+            i += (byte < 252);
+        }
+    }
+}
+
+/**
+ * @brief Rola uma rodada de até LOTE_BLOCO batalhas com o núcleo já resolvido.
+ */
+static void rodarBloco(struct Rng *rng, int32_t *tropasAtaque, int32_t *tropasDefesa,
+                       const int32_t *dadosAtaque, const int32_t *dadosDefesa, int m, enum NucleoLote nucleo) {
+    // Seis faixas de m dados, todas de um único lote do gerador
+    int dados[6 * LOTE_BLOCO + 8];
+    sortearDados(rng, dados, 6 * m);
+
+    int inicio = 0;
+#if LOTE_X86
+    if (nucleo == LOTE_AVX2) inicio = rodadasAvx2(dados, m, dadosAtaque, dadosDefesa, tropasAtaque, tropasDefesa);
+    else if (nucleo == LOTE_SSE41) inicio = rodadasSse41(dados, m, dadosAtaque, dadosDefesa, tropasAtaque, tropasDefesa);
+#else
+    (void) nucleo;
+#endif
+    rodadasEscalar(dados, m, inicio, dadosAtaque, dadosDefesa, tropasAtaque, tropasDefesa);
+}
+
+/**
+ * @brief Função para rolar uma rodada de dados de n batalhas
+ * @note O número de dados de cada lado deve ser válido (até 3, e o atacante
+ *       deixa uma tropa no território); 0 dados deixa a batalha de fora da rodada.
+ * @param rng Gerador de números aleatórios
+ * @param tropasAtaque Tropas do atacante de cada batalha; recebem as perdas
+ * @param tropasDefesa Tropas do defensor de cada batalha; recebem as perdas
+ * @param dadosAtaque Dados do atacante em cada batalha (0 a 3)
+ * @param dadosDefesa Dados do defensor em cada batalha (0 a 3)
+ * @param n Número de batalhas
+ * @param nucleo Núcleo a usar (LOTE_AUTOMATICO = o mais largo disponível)
+ */
+void rodadasEmLote(struct Rng *rng, int32_t *tropasAtaque, int32_t *tropasDefesa,
+                   const int32_t *dadosAtaque, const int32_t *dadosDefesa, int n, enum NucleoLote nucleo) {
+    nucleo = resolverNucleo(nucleo);
+    for (int inicio = 0; inicio < n; inicio += LOTE_BLOCO) {
+        int m = MENOR(n - inicio, LOTE_BLOCO);
+        rodarBloco(rng, tropasAtaque + inicio, tropasDefesa + inicio, dadosAtaque + inicio, dadosDefesa + inicio, m, nucleo);
+    }
+}
+
+/**
+ * @brief Função para levar n batalhas blitz até o fim
+ * @note Como resolverBatalha(), mas rolando rodada a rodada: os dois lados
+ *       rolam sempre o máximo de dados e o atacante para com 1 tropa ou ao
+ *       conquistar. A cada rodada as batalhas encerradas saem do bloco, então
+ *       os dados sorteados vão só para as que continuam.
+ * @param rng Gerador de números aleatórios
+ * @param tropasAtaque Tropas do atacante de cada batalha; recebem as tropas finais
+ * @param tropasDefesa Tropas do defensor de cada batalha; recebem as tropas finais
+ * @param n Número de batalhas
+ * @param nucleo Núcleo a usar (LOTE_AUTOMATICO = o mais largo disponível)
+ * @return Rodadas de dados resolvidas (somadas em todas as batalhas)
+ */
+long batalhasEmLote(struct Rng *rng, int32_t *tropasAtaque, int32_t *tropasDefesa, int n, enum NucleoLote nucleo) {
+    int32_t ataque[LOTE_BLOCO], defesa[LOTE_BLOCO];
+    int32_t dadosAtaque[LOTE_BLOCO], dadosDefesa[LOTE_BLOCO];
+    int indice[LOTE_BLOCO];
+    long rodadas = 0;
+
+    nucleo = resolverNucleo(nucleo);
+    for (int inicio = 0; inicio < n; inicio += LOTE_BLOCO) {
+        int ativas = MENOR(n - inicio, LOTE_BLOCO);
+        for (int i = 0; i < ativas; i++) {
+            ataque[i] = tropasAtaque[inicio + i];
+            defesa[i] = tropasDefesa[inicio + i];
+            indice[i] = inicio + i;
+        }
+
+        for (;;) {
+            // Devolve as batalhas encerradas e põe a última ativa no lugar delas
+            for (int i = 0; i < ativas;) {
+                if (ataque[i] > 1 && defesa[i] > 0) {
+                    i++;
+                    continue;
+                }
+                tropasAtaque[indice[i]] = ataque[i];
+                tropasDefesa[indice[i]] = defesa[i];
+                ativas--;
+                ataque[i] = ataque[ativas];
+                defesa[i] = defesa[ativas];
+                indice[i] = indice[ativas];
+            }
+            if (ativas == 0) break;
+
+            for (int i = 0; i < ativas; i++) {
+                dadosAtaque[i] = MENOR(ataque[i] - 1, 3);
+                dadosDefesa[i] = MENOR(defesa[i], 3);
+            }
+            rodarBloco(rng, ataque, defesa, dadosAtaque, dadosDefesa, ativas, nucleo);
+            rodadas += ativas;
+        }
+    }
+    return rodadas;
+}
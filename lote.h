@@ -0,0 +1,45 @@
+/**
+ * @file lote.h
+ * @brief Rodadas de dados de muitas batalhas de uma vez (SIMD).
+ *
+ * Resolve em passo único (lockstep) rodadas de dados de batalhas
+ * independentes guardadas em vetores paralelos de tropas e de número de
+ * dados. Os dados de todas as batalhas saem de um único lote do gerador
+ * (os mesmos valores de rngDados), em seis faixas: três do atacante e três
+ * do defensor. Cada faixa é ordenada pela mesma rede de ordenação de 3
+ * elementos de rodadaDeDados(), agora com max/min de vetores, e os pares são
+ * comparados sem desvios, com as perdas aplicadas a 8 (AVX2) ou 4 (SSE4.1)
+ * batalhas por instrução.
+ *
+ * O núcleo é escolhido na execução pelo que o processador suporta (não
+ * depende de -march); o escalar existe sempre e serve de referência. Como os
+ * dados sorteados não dependem do núcleo, todos chegam exatamente às mesmas
+ * tropas, e cada rodada segue as regras de rodadaDeDados: empates favorecem
+ * a defesa e só são comparados min(dados do atacante, dados do defensor) pares.
+ */
+#ifndef LOTE_H
+#define LOTE_H
+
+#include <stdint.h>
+
+#include "rng.h"
+
+#define LOTE_BLOCO 256 // Batalhas resolvidas juntas em cada bloco (os dados do bloco ficam na pilha)
+
+// Núcleos disponíveis para as rodadas em lote
+enum NucleoLote {
+    LOTE_AUTOMATICO, // O mais largo que o processador suporta
+    LOTE_ESCALAR,    // Uma batalha por vez (referência)
+    LOTE_SSE41,      // 4 batalhas por instrução
+    LOTE_AVX2,       // 8 batalhas por instrução
+    TOTAL_NUCLEOS_LOTE
+};
+
+// --- Protótipos das Funções ---
+int nucleoLoteDisponivel(enum NucleoLote nucleo);  // Função para saber se o processador executa o núcleo
+const char *nomeNucleoLote(enum NucleoLote nucleo); // Função para obter o nome de um núcleo (após resolver o automático)
+void rodadasEmLote(struct Rng *rng, int32_t *tropasAtaque, int32_t *tropasDefesa,
+                   const int32_t *dadosAtaque, const int32_t *dadosDefesa, int n, enum NucleoLote nucleo); // Função para rolar uma rodada de n batalhas
+long batalhasEmLote(struct Rng *rng, int32_t *tropasAtaque, int32_t *tropasDefesa, int n, enum NucleoLote nucleo); // Função para levar n batalhas blitz até o fim
+
+#endif // LOTE_H
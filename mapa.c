@@ -0,0 +1,644 @@
+/**
+ * @file mapa.c
+ * @brief Leitura, geração e consultas dos mapas do jogo.
+ * @note O arquivo é lido linha a linha (nunca inteiro na memória). As
+ *       fronteiras são guardadas numa lista de pares enquanto o arquivo é lido
+ *       e convertidas para CSR no final, com os vizinhos de cada território
+ *       ordenados e sem repetições.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+#include <limits.h>
+
+#include "mapa.h"
+
+// Separadores das palavras de uma linha do arquivo de mapa
+#define MAPA_SEPARADORES " \t\r\n"
+
+/**
+ * @brief Imprime um erro de leitura do mapa indicando a linha.
+ */
+static void erroMapa(const char *caminho, long numLinha, const char *mensagem) {
+    printf("Erro no mapa %s, linha %ld: %s\n", caminho, numLinha, mensagem);
+}
+
+/**
+ * @brief Converte uma palavra em inteiro dentro de [minimo, maximo].
+ * @return 1 se a palavra é um inteiro válido no intervalo, 0 caso contrário
+ */
+static int lerInteiro(const char *palavra, long minimo, long maximo, int *valor) {
+    if (palavra == NULL) return 0;
+    char *fim;
+    long lido = strtol(palavra, &fim, 10);
+    if (fim == palavra || *fim != '\0' || lido < minimo || lido > maximo) return 0;
+    *valor = (int) lido;
+    return 1;
+}
+
+/**
+ * @brief Garante espaço para 'necessario' elementos num vetor que cresce sob demanda.
+ * @note A capacidade dobra a cada realocação, então n inserções custam O(n).
+ * @return 0 em caso de sucesso, 1 se faltou memória (o vetor original continua válido)
+ */
+static int garantirCapacidade(void **vetor, long *capacidade, long necessario, size_t tamanho) {
+    if (necessario <= *capacidade) return 0;
+    long novaCapacidade = *capacidade > 0 ? *capacidade : 16;
+    while (novaCapacidade < necessario) novaCapacidade *= 2;
+    void *novo = realloc(*vetor, (size_t) novaCapacidade * tamanho);
+    if (novo == NULL) return 1;
+    *vetor = novo;
+    *capacidade = novaCapacidade;
+    return 0;
+}
+
+static int compararInteiros(const void *a, const void *b) {
+    int x = *(const int *) a;
+    int y = *(const int *) b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Monta as fronteiras em CSR a partir da lista de pares lida do arquivo.
+ * @note Conta os graus, acumula as posições iniciais e espalha os vizinhos;
+ *       depois ordena cada lista e remove fronteiras repetidas.
+ * @param mapa Mapa com numTerritorios já definido
+ * @param pares Fronteiras lidas (2 * numPares inteiros)
+ * @param numPares Número de fronteiras lidas (com possíveis repetições)
+ * @return 0 em caso de sucesso, 1 se faltou memória
+ */
+static int montarVizinhos(struct Mapa *mapa, const int *pares, long numPares) {
+    int n = mapa->numTerritorios;
+    mapa->inicioVizinhos = (int *) calloc((size_t) n + 1, sizeof(int));
+    mapa->vizinhos = (int *) malloc((size_t) (2 * numPares > 0 ? 2 * numPares : 1) * sizeof(int));
+    if (mapa->inicioVizinhos == NULL || mapa->vizinhos == NULL) return 1;
+
+    // Grau de cada território, deslocado de uma posição para virar o início da lista
+    for (long e = 0; e < numPares; e++) {
+        mapa->inicioVizinhos[pares[2 * e] + 1]++;
+        mapa->inicioVizinhos[pares[2 * e + 1] + 1]++;
+    }
+    for (int t = 0; t < n; t++) mapa->inicioVizinhos[t + 1] += mapa->inicioVizinhos[t];
+
+    // Espalha os vizinhos usando inicioVizinhos[t] como cursor da lista de t;
+    // ao final cada cursor aponta para o início da lista seguinte
+    for (long e = 0; e < numPares; e++) {
+        int a = pares[2 * e];
+        int b = pares[2 * e + 1];
+        mapa->vizinhos[mapa->inicioVizinhos[a]++] = b;
+        mapa->vizinhos[mapa->inicioVizinhos[b]++] = a;
+    }
+    for (int t = n; t > 0; t--) mapa->inicioVizinhos[t] = mapa->inicioVizinhos[t - 1];
+    mapa->inicioVizinhos[0] = 0;
+
+    // Ordena cada lista e compacta as repetições
+    int escrita = 0;
+    for (int t = 0; t < n; t++) {
+        int inicio = mapa->inicioVizinhos[t];
+        int fim = mapa->inicioVizinhos[t + 1];
+        qsort(mapa->vizinhos + inicio, (size_t) (fim - inicio), sizeof(int), compararInteiros);
+        mapa->inicioVizinhos[t] = escrita;
+        for (int k = inicio; k < fim; k++) {
+            if (k == inicio || mapa->vizinhos[k] != mapa->vizinhos[k - 1]) {
+                mapa->vizinhos[escrita++] = mapa->vizinhos[k];
+            }
+        }
+    }
+    mapa->inicioVizinhos[n] = escrita;
+    mapa->numFronteiras = escrita / 2;
+
+    // Devolve o espaço das repetições removidas
+    int *compacto = (int *) realloc(mapa->vizinhos, (size_t) (escrita > 0 ? escrita : 1) * sizeof(int));
+    if (compacto != NULL) mapa->vizinhos = compacto;
+    return 0;
+}
+
+/**
+ * @brief Hash FNV-1a do nome sem diferenciar maiúsculas (apenas ASCII).
+ * @note Nomes que diferem só em maiúsculas têm o mesmo hash, então a mesma
+ *       tabela serve às buscas exatas e às buscas sem diferenciar maiúsculas.
+ */
+static uint32_t hashNome(const char *nome) {
+    uint32_t hash = 2166136261u;
+    for (const unsigned char *c = (const unsigned char *) nome; *c != '\0'; c++) {
+        hash ^= (uint32_t) tolower(*c);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// Par (nome, território) usado para ordenar os nomes
+struct NomeOrdenado {
+    const char *nome;
+    int territorio;
+};
+
+static int compararNomes(const void *a, const void *b) {
+    const struct NomeOrdenado *x = (const struct NomeOrdenado *) a;
+    const struct NomeOrdenado *y = (const struct NomeOrdenado *) b;
+    int comparacao = strcasecmp(x->nome, y->nome);
+    if (comparacao != 0) return comparacao;
+    return (x->territorio > y->territorio) - (x->territorio < y->territorio);
+}
+
+/**
+ * @brief Monta a tabela hash de nomes e a ordem alfabética dos territórios.
+ * @note A tabela tem pelo menos o dobro de entradas que territórios (carga
+ *       máxima de 50%), então as sondagens lineares são curtas.
+ * @param mapa Mapa com os nomes já preenchidos
+ * @param repetido Recebe o território cujo nome já existia no mapa
+ * @return 0 em caso de sucesso, 1 se faltou memória, 2 se há nomes repetidos
+ */
+static int indexarNomes(struct Mapa *mapa, int *repetido) {
+    int n = mapa->numTerritorios;
+    uint32_t tamanho = 16;
+    while (tamanho < 2u * (uint32_t) n) tamanho *= 2;
+
+    mapa->tabelaNomes = (struct EntradaNome *) malloc(tamanho * sizeof(struct EntradaNome));
+    mapa->ordemNomes = (int *) malloc((size_t) n * sizeof(int));
+    struct NomeOrdenado *ordenados = (struct NomeOrdenado *) malloc((size_t) n * sizeof(struct NomeOrdenado));
+    if (mapa->tabelaNomes == NULL || mapa->ordemNomes == NULL || ordenados == NULL) {
+        free(ordenados);
+        return 1;
+    }
+    mapa->mascaraTabela = tamanho - 1;
+    for (uint32_t i = 0; i < tamanho; i++) mapa->tabelaNomes[i].territorio = -1;
+
+    for (int t = 0; t < n; t++) {
+        const char *nome = nomeTerritorio(mapa, t);
+        uint32_t hash = hashNome(nome);
+        uint32_t i = hash & mapa->mascaraTabela;
+        while (mapa->tabelaNomes[i].territorio >= 0) {
+            if (mapa->tabelaNomes[i].hash == hash &&
+                strcmp(nomeTerritorio(mapa, mapa->tabelaNomes[i].territorio), nome) == 0) {
+                *repetido = t;
+                free(ordenados);
+                return 2;
+            }
+            i = (i + 1) & mapa->mascaraTabela;
+        }
+        mapa->tabelaNomes[i].hash = hash;
+        mapa->tabelaNomes[i].territorio = t;
+
+        ordenados[t].nome = nome;
+        ordenados[t].territorio = t;
+    }
+
+    qsort(ordenados, (size_t) n, sizeof(struct NomeOrdenado), compararNomes);
+    for (int k = 0; k < n; k++) mapa->ordemNomes[k] = ordenados[k].territorio;
+    free(ordenados);
+    return 0;
+}
+
+/**
+ * @brief Função para ler um mapa de um arquivo
+ * @note O formato está descrito em mapa.h. Erros de formato são impressos com
+ *       o número da linha.
+ * @param caminho Caminho do arquivo de mapa
+ * @return Ponteiro para o mapa carregado ou NULL em caso de erro
+ */
+struct Mapa *carregarMapa(const char *caminho) {
+    FILE *arquivo = fopen(caminho, "r");
+    if (arquivo == NULL) {
+        printf("Erro ao abrir o mapa %s.\n", caminho);
+        return NULL;
+    }
+
+    struct Mapa *mapa = (struct Mapa *) calloc(1, sizeof(struct Mapa));
+    int *pares = NULL;                  // Fronteiras lidas, dois inteiros por fronteira
+    long numPares = 0, capPares = 0;
+    long tamNomes = 0, capNomes = 0;
+    long capContinentes = 0;
+    int lidos = 0;                      // Territórios já lidos
+    int declarados = -1;                // Valor da diretiva 'territorios' (-1 = ainda não lida)
+    long numLinha = 0;
+    int erro = (mapa == NULL);
+    char linha[MAPA_TAM_LINHA];
+
+    while (!erro && fgets(linha, sizeof(linha), arquivo) != NULL) {
+        numLinha++;
+        if (strchr(linha, '\n') == NULL && !feof(arquivo)) {
+            erroMapa(caminho, numLinha, "linha longa demais");
+            erro = 1;
+            break;
+        }
+        char *comentario = strchr(linha, '#');
+        if (comentario != NULL) *comentario = '\0';
+
+        char *resto;
+        char *diretiva = strtok_r(linha, MAPA_SEPARADORES, &resto);
+        if (diretiva == NULL) continue; // Linha vazia ou só comentário
+
+        char *arg1 = strtok_r(NULL, MAPA_SEPARADORES, &resto);
+        char *arg2 = strtok_r(NULL, MAPA_SEPARADORES, &resto);
+        char *arg3 = strtok_r(NULL, MAPA_SEPARADORES, &resto);
+
+        if (strcmp(diretiva, "territorios") == 0) {
+            if (declarados >= 0 || !lerInteiro(arg1, 1, INT_MAX - 1, &declarados) || arg2 != NULL) {
+                erroMapa(caminho, numLinha, "esperado 'territorios N' uma única vez, com N >= 1");
+                erro = 1;
+                break;
+            }
+            mapa->numTerritorios = declarados;
+            mapa->inicioNome = (int *) malloc((size_t) declarados * sizeof(int));
+            mapa->tropasIniciais = (int *) malloc((size_t) declarados * sizeof(int));
+            mapa->continente = (int *) malloc((size_t) declarados * sizeof(int));
+            if (mapa->inicioNome == NULL || mapa->tropasIniciais == NULL || mapa->continente == NULL) {
+                printf("Erro na alocação de memória para o mapa.\n");
+                erro = 1;
+            }
+        } else if (strcmp(diretiva, "continente") == 0) {
+            if (arg1 == NULL || arg2 != NULL || strlen(arg1) >= MAPA_TAM_NOME) {
+                erroMapa(caminho, numLinha, "esperado 'continente NOME' (nome sem espaços, até 29 caracteres)");
+                erro = 1;
+                break;
+            }
+            if (garantirCapacidade((void **) &mapa->nomesContinentes, &capContinentes,
+                                   mapa->numContinentes + 1L, MAPA_TAM_NOME)) {
+                printf("Erro na alocação de memória para o mapa.\n");
+                erro = 1;
+                break;
+            }
+            strcpy(mapa->nomesContinentes[mapa->numContinentes++], arg1);
+        } else if (strcmp(diretiva, "territorio") == 0) {
+            int continente, tropas;
+            if (declarados < 0) {
+                erroMapa(caminho, numLinha, "'territorio' antes de 'territorios N'");
+                erro = 1;
+                break;
+            }
+            if (lidos >= declarados) {
+                erroMapa(caminho, numLinha, "mais territórios do que o declarado");
+                erro = 1;
+                break;
+            }
+            if (arg1 == NULL || strlen(arg1) >= MAPA_TAM_NOME ||
+                !lerInteiro(arg2, 0, mapa->numContinentes - 1L, &continente) ||
+                !lerInteiro(arg3, 1, INT_MAX, &tropas) || strtok_r(NULL, MAPA_SEPARADORES, &resto) != NULL) {
+                erroMapa(caminho, numLinha, "esperado 'territorio NOME CONTINENTE TROPAS' com continente já declarado e tropas >= 1");
+                erro = 1;
+                break;
+            }
+            long tamanho = (long) strlen(arg1) + 1;
+            if (tamNomes + tamanho > INT_MAX ||
+                garantirCapacidade((void **) &mapa->nomes, &capNomes, tamNomes + tamanho, sizeof(char))) {
+                printf("Erro na alocação de memória para o mapa.\n");
+                erro = 1;
+                break;
+            }
+            memcpy(mapa->nomes + tamNomes, arg1, (size_t) tamanho);
+            mapa->inicioNome[lidos] = (int) tamNomes;
+            mapa->continente[lidos] = continente;
+            mapa->tropasIniciais[lidos] = tropas;
+            tamNomes += tamanho;
+            lidos++;
+        } else if (strcmp(diretiva, "fronteira") == 0) {
+            int a, b;
+            if (declarados < 0 || !lerInteiro(arg1, 0, declarados - 1L, &a) ||
+                !lerInteiro(arg2, 0, declarados - 1L, &b) || arg3 != NULL || a == b) {
+                erroMapa(caminho, numLinha, "esperado 'fronteira A B' com territórios distintos entre 0 e N-1");
+                erro = 1;
+                break;
+            }
+            if (2 * (numPares + 1) > INT_MAX ||
+                garantirCapacidade((void **) &pares, &capPares, 2 * (numPares + 1), sizeof(int))) {
+                printf("Erro na alocação de memória para as fronteiras.\n");
+                erro = 1;
+                break;
+            }
+            pares[2 * numPares] = a;
+            pares[2 * numPares + 1] = b;
+            numPares++;
+        } else {
+            erroMapa(caminho, numLinha, "diretiva desconhecida");
+            erro = 1;
+        }
+    }
+
+    if (!erro && ferror(arquivo)) {
+        printf("Erro ao ler o mapa %s.\n", caminho);
+        erro = 1;
+    }
+    if (!erro && (declarados < 0 || lidos != declarados)) {
+        printf("Erro no mapa %s: %d territórios declarados, %d lidos.\n", caminho, declarados < 0 ? 0 : declarados, lidos);
+        erro = 1;
+    }
+    if (!erro && montarVizinhos(mapa, pares, numPares) != 0) {
+        printf("Erro na alocação de memória para as fronteiras.\n");
+        erro = 1;
+    }
+    if (!erro) {
+        int repetido = 0;
+        int resultado = indexarNomes(mapa, &repetido);
+        if (resultado == 1) printf("Erro na alocação de memória para o índice de nomes.\n");
+        if (resultado == 2) printf("Erro no mapa %s: território repetido: %s\n", caminho, nomeTerritorio(mapa, repetido));
+        erro = (resultado != 0);
+    }
+
+    free(pares);
+    fclose(arquivo);
+    if (erro) {
+        liberarMapa(mapa);
+        return NULL;
+    }
+    return mapa;
+}
+
+/**
+ * @brief Função para montar o mapa clássico de 5 países
+ * @note Todos os países fazem fronteira entre si, como no jogo original.
+ * @return Ponteiro para o mapa ou NULL se faltou memória
+ */
+struct Mapa *criarMapaClassico(void) {
+    // Nomes, tropas e continentes fixos dos países
+    const char *nomesPaises[TERRITORIOS_CLASSICO] = {"America", "Brasil", "Chile", "Peru", "Argelia"};
+    const int tropasIniciais[TERRITORIOS_CLASSICO] = {4, 8, 3, 9, 15};
+    const int continentes[TERRITORIOS_CLASSICO] = {0, 0, 0, 0, 1};
+    const int n = TERRITORIOS_CLASSICO;
+
+    struct Mapa *mapa = (struct Mapa *) calloc(1, sizeof(struct Mapa));
+    if (mapa == NULL) return NULL;
+
+    mapa->numTerritorios = n;
+    mapa->numContinentes = 2;
+    mapa->numFronteiras = (long) n * (n - 1) / 2;
+    mapa->nomes = (char *) malloc((size_t) n * MAPA_TAM_NOME);
+    mapa->inicioNome = (int *) malloc((size_t) n * sizeof(int));
+    mapa->tropasIniciais = (int *) malloc((size_t) n * sizeof(int));
+    mapa->continente = (int *) malloc((size_t) n * sizeof(int));
+    mapa->nomesContinentes = malloc(2 * sizeof(*mapa->nomesContinentes));
+    mapa->inicioVizinhos = (int *) malloc(((size_t) n + 1) * sizeof(int));
+    mapa->vizinhos = (int *) malloc((size_t) n * (n - 1) * sizeof(int));
+    if (mapa->nomes == NULL || mapa->inicioNome == NULL || mapa->tropasIniciais == NULL ||
+        mapa->continente == NULL || mapa->nomesContinentes == NULL ||
+        mapa->inicioVizinhos == NULL || mapa->vizinhos == NULL) {
+        liberarMapa(mapa);
+        return NULL;
+    }
+
+    strcpy(mapa->nomesContinentes[0], "America");
+    strcpy(mapa->nomesContinentes[1], "Africa");
+
+    int tamNomes = 0;
+    int k = 0;
+    for (int t = 0; t < n; t++) {
+        strcpy(mapa->nomes + tamNomes, nomesPaises[t]);
+        mapa->inicioNome[t] = tamNomes;
+        tamNomes += (int) strlen(nomesPaises[t]) + 1;
+        mapa->tropasIniciais[t] = tropasIniciais[t];
+        mapa->continente[t] = continentes[t];
+
+        // Grafo completo: todos os outros países, em ordem crescente
+        mapa->inicioVizinhos[t] = k;
+        for (int v = 0; v < n; v++) {
+            if (v != t) mapa->vizinhos[k++] = v;
+        }
+    }
+    mapa->inicioVizinhos[n] = k;
+
+    int repetido;
+    if (indexarNomes(mapa, &repetido) != 0) {
+        liberarMapa(mapa);
+        return NULL;
+    }
+    return mapa;
+}
+
+/**
+ * @brief Função para liberar a memória de um mapa
+ * @param mapa Mapa a liberar (pode ser NULL ou estar parcialmente preenchido)
+ */
+void liberarMapa(struct Mapa *mapa) {
+    if (mapa == NULL) return;
+    free(mapa->nomes);
+    free(mapa->inicioNome);
+    free(mapa->tropasIniciais);
+    free(mapa->continente);
+    free(mapa->nomesContinentes);
+    free(mapa->inicioVizinhos);
+    free(mapa->vizinhos);
+    free(mapa->tabelaNomes);
+    free(mapa->ordemNomes);
+    free(mapa);
+}
+
+/**
+ * @brief Função para saber se dois territórios fazem fronteira
+ * @note Busca binária na lista ordenada de vizinhos de a: O(log grau).
+ * @param mapa Mapa consultado
+ * @param a Índice do primeiro território
+ * @param b Índice do segundo território
+ * @return 1 se são vizinhos, 0 caso contrário
+ */
+int fazFronteira(const struct Mapa *mapa, int a, int b) {
+    int inicio = mapa->inicioVizinhos[a];
+    int fim = mapa->inicioVizinhos[a + 1];
+    while (inicio < fim) {
+        int meio = inicio + (fim - inicio) / 2;
+        if (mapa->vizinhos[meio] == b) return 1;
+        if (mapa->vizinhos[meio] < b) {
+            inicio = meio + 1;
+        } else {
+            fim = meio;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Função para buscar um território pelo nome exato
+ * @param mapa Mapa consultado
+ * @param nome Nome do território
+ * @return Índice do território ou -1 se não existir
+ */
+int buscarNomeNoMapa(const struct Mapa *mapa, const char *nome) {
+    uint32_t hash = hashNome(nome);
+    for (uint32_t i = hash & mapa->mascaraTabela; mapa->tabelaNomes[i].territorio >= 0; i = (i + 1) & mapa->mascaraTabela) {
+        const struct EntradaNome *entrada = &mapa->tabelaNomes[i];
+        if (entrada->hash == hash && strcmp(nomeTerritorio(mapa, entrada->territorio), nome) == 0) {
+            return entrada->territorio;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Função para buscar um território sem diferenciar maiúsculas
+ * @note Se mais de um território tiver o nome (com maiúsculas diferentes),
+ *       retorna o que aparece primeiro na tabela.
+ * @param mapa Mapa consultado
+ * @param nome Nome do território, com quaisquer maiúsculas
+ * @return Índice do território ou -1 se não existir
+ */
+int buscarNomeSemCaixa(const struct Mapa *mapa, const char *nome) {
+    uint32_t hash = hashNome(nome);
+    for (uint32_t i = hash & mapa->mascaraTabela; mapa->tabelaNomes[i].territorio >= 0; i = (i + 1) & mapa->mascaraTabela) {
+        const struct EntradaNome *entrada = &mapa->tabelaNomes[i];
+        if (entrada->hash == hash && strcasecmp(nomeTerritorio(mapa, entrada->territorio), nome) == 0) {
+            return entrada->territorio;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Função para buscar os territórios cujo nome começa com um prefixo
+ * @note Sem diferenciar maiúsculas. Os nomes com o prefixo formam uma faixa
+ *       contígua de ordemNomes[], encontrada com duas buscas binárias.
+ * @param mapa Mapa consultado
+ * @param prefixo Início do nome
+ * @param primeiro Recebe a posição em ordemNomes[] do primeiro território encontrado
+ * @return Número de territórios encontrados (ordemNomes[*primeiro] em diante)
+ */
+int buscarPrefixoNoMapa(const struct Mapa *mapa, const char *prefixo, int *primeiro) {
+    size_t tamanho = strlen(prefixo);
+
+    // Primeiro nome >= prefixo
+    int inicio = 0, fim = mapa->numTerritorios;
+    while (inicio < fim) {
+        int meio = inicio + (fim - inicio) / 2;
+        if (strncasecmp(nomeTerritorio(mapa, mapa->ordemNomes[meio]), prefixo, tamanho) < 0) {
+            inicio = meio + 1;
+        } else {
+            fim = meio;
+        }
+    }
+    *primeiro = inicio;
+
+    // Primeiro nome que já não começa com o prefixo
+    fim = mapa->numTerritorios;
+    while (inicio < fim) {
+        int meio = inicio + (fim - inicio) / 2;
+        if (strncasecmp(nomeTerritorio(mapa, mapa->ordemNomes[meio]), prefixo, tamanho) == 0) {
+            inicio = meio + 1;
+        } else {
+            fim = meio;
+        }
+    }
+    return inicio - *primeiro;
+}
+
+/**
+ * @brief Função para montar um mapa em grade com qualquer número de territórios
+ * @note Os territórios (T0, T1, ...) ocupam uma grade quase quadrada, cada um
+ *       fazendo fronteira com os vizinhos de cima, baixo, esquerda e direita;
+ *       cada bloco de 8x8 territórios é um continente. Útil para testar mapas grandes.
+ * @param numTerritorios Número de territórios (>= 2)
+ * @return Ponteiro para o mapa ou NULL em caso de erro
+ */
+struct Mapa *criarMapaGrade(int numTerritorios) {
+    if (numTerritorios < 2) return NULL;
+
+    int largura = 1;
+    while ((long) largura * largura < numTerritorios) largura++;
+    int altura = (numTerritorios + largura - 1) / largura;
+    int blocosLinha = (largura + 7) / 8;
+    int blocosColuna = (altura + 7) / 8;
+    const int n = numTerritorios;
+
+    struct Mapa *mapa = (struct Mapa *) calloc(1, sizeof(struct Mapa));
+    int *pares = (int *) malloc((size_t) n * 4 * sizeof(int)); // No máximo 2 fronteiras por território
+    if (mapa == NULL || pares == NULL) {
+        free(pares);
+        liberarMapa(mapa);
+        return NULL;
+    }
+
+    mapa->numTerritorios = n;
+    mapa->numContinentes = blocosLinha * blocosColuna;
+    mapa->nomes = (char *) malloc((size_t) n * 12); // "T" + até 10 dígitos + '\0'
+    mapa->inicioNome = (int *) malloc((size_t) n * sizeof(int));
+    mapa->tropasIniciais = (int *) malloc((size_t) n * sizeof(int));
+    mapa->continente = (int *) malloc((size_t) n * sizeof(int));
+    mapa->nomesContinentes = malloc((size_t) mapa->numContinentes * sizeof(*mapa->nomesContinentes));
+    if (mapa->nomes == NULL || mapa->inicioNome == NULL || mapa->tropasIniciais == NULL ||
+        mapa->continente == NULL || mapa->nomesContinentes == NULL) {
+        free(pares);
+        liberarMapa(mapa);
+        return NULL;
+    }
+
+    for (int c = 0; c < mapa->numContinentes; c++) sprintf(mapa->nomesContinentes[c], "C%d", c);
+
+    int tamNomes = 0;
+    long numPares = 0;
+    for (int t = 0; t < n; t++) {
+        int linha = t / largura, coluna = t % largura;
+        mapa->inicioNome[t] = tamNomes;
+        tamNomes += sprintf(mapa->nomes + tamNomes, "T%d", t) + 1;
+        mapa->tropasIniciais[t] = 1 + t % 9;
+        mapa->continente[t] = (linha / 8) * blocosLinha + coluna / 8;
+
+        if (coluna + 1 < largura && t + 1 < n) {
+            pares[2 * numPares] = t;
+            pares[2 * numPares++ + 1] = t + 1;
+        }
+        if (t + largura < n) {
+            pares[2 * numPares] = t;
+            pares[2 * numPares++ + 1] = t + largura;
+        }
+    }
+
+    int repetido;
+    int erro = montarVizinhos(mapa, pares, numPares) != 0 || indexarNomes(mapa, &repetido) != 0;
+    free(pares);
+    if (erro) {
+        liberarMapa(mapa);
+        return NULL;
+    }
+    return mapa;
+}
+
+/**
+ * @brief Função para gravar um mapa no formato de arquivo (ver mapa.h)
+ * @param mapa Mapa a gravar
+ * @param caminho Arquivo a ser gravado
+ * @return 0 em caso de sucesso, 1 em caso de erro
+ */
+int gravarMapa(const struct Mapa *mapa, const char *caminho) {
+    FILE *arquivo = fopen(caminho, "w");
+    if (arquivo == NULL) return 1;
+
+    fprintf(arquivo, "# Mapa gravado pelo WAR ESTRUTURADO\n");
+    fprintf(arquivo, "territorios %d\n", mapa->numTerritorios);
+    for (int c = 0; c < mapa->numContinentes; c++) fprintf(arquivo, "continente %s\n", mapa->nomesContinentes[c]);
+    for (int t = 0; t < mapa->numTerritorios; t++) {
+        fprintf(arquivo, "territorio %s %d %d\n", nomeTerritorio(mapa, t), mapa->continente[t], mapa->tropasIniciais[t]);
+    }
+    // Cada fronteira é gravada uma vez, a partir do território de menor índice
+    for (int t = 0; t < mapa->numTerritorios; t++) {
+        for (int k = mapa->inicioVizinhos[t]; k < mapa->inicioVizinhos[t + 1]; k++) {
+            if (mapa->vizinhos[k] > t) fprintf(arquivo, "fronteira %d %d\n", t, mapa->vizinhos[k]);
+        }
+    }
+
+    int erro = ferror(arquivo);
+    if (fclose(arquivo) != 0) erro = 1;
+    return erro ? 1 : 0;
+}
+
+/**
+ * @brief Função para consultar a memória residente do processo
+ * @note Lê /proc/self/status (Linux); em outros sistemas retorna -1.
+ * @param pico 1 para o pico de memória residente, 0 para o valor atual
+ * @return Memória residente em KB ou -1 se não estiver disponível
+ */
+long memoriaResidenteKB(int pico) {
+    const char *campo = pico ? "VmHWM:" : "VmRSS:";
+    FILE *status = fopen("/proc/self/status", "r");
+    if (status == NULL) return -1;
+
+    char linha[MAPA_TAM_LINHA];
+    long kb = -1;
+    while (fgets(linha, sizeof(linha), status) != NULL) {
+        if (strncmp(linha, campo, strlen(campo)) == 0) {
+            kb = strtol(linha + strlen(campo), NULL, 10);
+            break;
+        }
+    }
+    fclose(status);
+    return kb;
+}
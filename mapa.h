@@ -0,0 +1,87 @@
+/**
+ * @file mapa.h
+ * @brief Mapas do jogo: territórios, continentes e fronteiras.
+ *
+ * O mapa é a parte do mundo que não muda durante a partida (nomes, tropas
+ * iniciais, continentes e quem faz fronteira com quem). Ele é carregado uma
+ * vez, de um arquivo ou do mapa clássico embutido, e compartilhado (somente
+ * leitura) por todas as partidas e threads.
+ *
+ * As fronteiras ficam em formato CSR (compressed sparse row): os vizinhos do
+ * território t são vizinhos[inicioVizinhos[t]] .. vizinhos[inicioVizinhos[t + 1] - 1],
+ * em ordem crescente. São dois vetores de int para o mapa inteiro, sem um
+ * ponteiro por território.
+ *
+ * Os nomes são indexados quando o mapa é montado: uma tabela hash com
+ * endereçamento aberto (hash do nome sem diferenciar maiúsculas, guardado em
+ * cada entrada) responde buscas exatas e sem diferenciar maiúsculas em O(1),
+ * e um vetor com os territórios em ordem alfabética responde buscas por
+ * prefixo com duas buscas binárias.
+ *
+ * Formato do arquivo (uma diretiva por linha, '#' inicia um comentário):
+ * @code
+ * territorios 5                # Número de territórios (antes de qualquer 'territorio')
+ * continente America           # Continentes, numerados a partir de 0 na ordem do arquivo
+ * territorio Brasil 0 8        # Nome, continente e tropas iniciais; numerados a partir de 0
+ * fronteira 0 1                # Fronteira (nos dois sentidos) entre dois territórios
+ * @endcode
+ */
+#ifndef MAPA_H
+#define MAPA_H
+
+#include <stdint.h>
+
+#define MAPA_TAM_NOME 30         // Tamanho máximo dos nomes de territórios e continentes (com o '\0')
+#define MAPA_TAM_LINHA 256       // Tamanho máximo de uma linha do arquivo de mapa
+#define TERRITORIOS_CLASSICO 5   // Número de países do mapa clássico embutido
+
+// Entrada da tabela hash de nomes
+struct EntradaNome {
+    uint32_t hash;   // Hash do nome (sem diferenciar maiúsculas), calculado uma única vez
+    int territorio;  // Índice do território ou -1 se a entrada está vazia
+};
+
+// Definição da estrutura do mapa (somente leitura durante as partidas)
+struct Mapa {
+    int numTerritorios;      // Número de territórios
+    int numContinentes;      // Número de continentes
+    long numFronteiras;      // Fronteiras distintas (cada uma liga dois territórios)
+    char *nomes;             // Nomes dos territórios, um após o outro, terminados em '\0'
+    int *inicioNome;         // Posição do nome de cada território em nomes[]
+    int *tropasIniciais;     // Tropas de cada território no início da partida
+    int *continente;         // Continente de cada território
+    char (*nomesContinentes)[MAPA_TAM_NOME]; // Nome de cada continente
+    int *inicioVizinhos;     // CSR: numTerritorios + 1 posições em vizinhos[]
+    int *vizinhos;           // CSR: vizinhos de todos os territórios, em sequência
+    struct EntradaNome *tabelaNomes; // Índice nome -> território (endereçamento aberto)
+    uint32_t mascaraTabela;  // Tamanho da tabela - 1 (o tamanho é potência de 2)
+    int *ordemNomes;         // Territórios em ordem alfabética (sem diferenciar maiúsculas)
+};
+
+/**
+ * @brief Retorna o nome do território t do mapa.
+ */
+static inline const char *nomeTerritorio(const struct Mapa *mapa, int t) {
+    return mapa->nomes + mapa->inicioNome[t];
+}
+
+/**
+ * @brief Retorna o número de vizinhos do território t.
+ */
+static inline int grauTerritorio(const struct Mapa *mapa, int t) {
+    return mapa->inicioVizinhos[t + 1] - mapa->inicioVizinhos[t];
+}
+
+// --- Protótipos das Funções ---
+struct Mapa *carregarMapa(const char *caminho);  // Função para ler um mapa de um arquivo (NULL em caso de erro)
+struct Mapa *criarMapaClassico(void);            // Função para montar o mapa clássico de 5 países
+void liberarMapa(struct Mapa *mapa);             // Função para liberar a memória de um mapa
+int fazFronteira(const struct Mapa *mapa, int a, int b); // Função para saber se dois territórios são vizinhos
+struct Mapa *criarMapaGrade(int numTerritorios); // Função para montar um mapa em grade de qualquer tamanho
+int gravarMapa(const struct Mapa *mapa, const char *caminho); // Função para gravar um mapa no formato de arquivo
+int buscarNomeNoMapa(const struct Mapa *mapa, const char *nome); // Função para buscar um território pelo nome exato
+int buscarNomeSemCaixa(const struct Mapa *mapa, const char *nome); // Função para buscar um território sem diferenciar maiúsculas
+int buscarPrefixoNoMapa(const struct Mapa *mapa, const char *prefixo, int *primeiro); // Função para buscar os territórios que começam com um prefixo
+long memoriaResidenteKB(int pico);               // Função para consultar a memória residente do processo
+
+#endif // MAPA_H
@@ -0,0 +1,504 @@
+/**
+ * @file mcts.c
+ * @brief Implementação do jogador automático por busca em árvore de Monte Carlo.
+ * @note As threads não compartilham nada durante a busca: cada uma tem a sua
+ *       cópia da partida, o seu fluxo do gerador e a sua árvore. Só a raiz é
+ *       combinada, depois de todas terminarem.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+
+#include "mcts.h"
+#include "batalha.h"
+#include "simulacao.h"
+#include "torneio.h"
+#include "arena.h"
+#include "historico.h"
+
+// Jogada de um nó da árvore
+struct AcaoMcts {
+    int ataque;     // Território atacante (-1 = terminar o turno)
+    int defesa;     // Território defensor
+    int moverTudo;  // 1 - move todas as tropas possíveis após a conquista, 0 - metade
+};
+
+// Nó da árvore (os filhos formam uma lista ligada por índices no vetor de nós)
+struct NoMcts {
+    struct AcaoMcts acao; // Jogada que leva do pai a este nó
+    int visitas;          // Iterações que passaram pelo nó
+    double soma;          // Soma das recompensas dessas iterações
+    int primeiroFilho;    // Índice do primeiro filho (-1 se nenhum)
+    int proximoIrmao;     // Índice do próximo irmão (-1 se nenhum)
+};
+
+// Busca de uma thread
+struct TrabalhoMcts {
+    const struct Jogo *raiz;  // Partida real (somente leitura durante a busca)
+    int indiceJogador;        // Jogador que está decidindo
+    double prazo;             // Fim da decisão (relogioSegundos)
+    struct Jogo copia;        // Cópia da partida onde as iterações são jogadas
+    struct Historico historico; // Versões da cópia: cada iteração volta à marca 0 (a raiz)
+    int versionada;           // 1 se a cópia já tem a raiz e o histórico
+    int moverTudo;            // Tropas a mover na conquista em andamento na cópia
+    struct Arena *arena;      // Arena de onde saem os nós (volta ao pool ao fim da decisão)
+    struct NoMcts *nos;       // Árvore da thread (nos[0] é a raiz)
+    int numNos;               // Nós usados
+    long simulacoes;          // Iterações completas
+};
+
+// --- Política das simulações ---
+// Joga na cópia da partida: escolhe como a política gulosa, rola sempre o
+// máximo de dados e resolve a batalha inteira pela tabela (blitz). As tropas
+// movidas após a conquista seguem a jogada da árvore em andamento.
+
+static int simulacaoDados(struct Jogo *jogo, int ataque, int defesa, int maxDados) {
+    (void) jogo; (void) ataque; (void) defesa;
+    return maxDados;
+}
+
+static int simulacaoContinuar(struct Jogo *jogo, int ataque, int defesa) {
+    (void) jogo; (void) ataque; (void) defesa;
+    return 1;
+}
+
+static int simulacaoTropasMover(struct Jogo *jogo, int ataque, int defesa, int maxTropas) {
+    (void) ataque; (void) defesa;
+    const struct TrabalhoMcts *trabalho = (const struct TrabalhoMcts *) jogo->contexto;
+    return trabalho->moverTudo ? maxTropas : (maxTropas + 1) / 2;
+}
+
+static int simulacaoEscolherAtaque(struct Jogo *jogo, struct Jogador *jogador, int *ataque, int *defesa) {
+    return politicaGulosa.escolherAtaque(jogo, jogador, ataque, defesa);
+}
+
+static const struct Politica politicaSimulacaoMcts = {
+    "mcts-simulacao", 1, simulacaoEscolherAtaque, simulacaoDados, simulacaoDados, simulacaoContinuar, simulacaoTropasMover
+};
+
+/**
+ * @brief Copia o estado de uma partida para outra alocada sobre o mesmo mapa.
+ * @note Todos os jogadores da cópia passam a usar a política das simulações.
+ */
+static void copiarPartida(struct TrabalhoMcts *trabalho) {
+    const struct Jogo *origem = trabalho->raiz;
+    struct Jogo *destino = &trabalho->copia;
+    size_t n = (size_t) origem->numTerritorios;
+
+    memcpy(destino->tropas, origem->tropas, n * sizeof(int32_t));
+    memcpy(destino->dono, origem->dono, n);
+    size_t porCor = (size_t) origem->numCores * sizeof(int);
+
+    memcpy(destino->posse, origem->posse, (size_t) origem->numCores * origem->palavrasPosse * sizeof(uint64_t));
+    memcpy(destino->jogadores, origem->jogadores, (size_t) origem->numJogadores * sizeof(struct Jogador));
+    memcpy(destino->jogadorDaCor, origem->jogadorDaCor, porCor);
+    memcpy(destino->territoriosCor, origem->territoriosCor, porCor);
+    memcpy(destino->cacadorDaCor, origem->cacadorDaCor, porCor);
+    destino->numJogadores = origem->numJogadores;
+    destino->vencedor = origem->vencedor;
+    destino->verboso = 0;
+    destino->contexto = trabalho;
+    for (int i = 0; i < destino->numJogadores; i++) destino->jogadores[i].politica = &politicaSimulacaoMcts;
+}
+
+/**
+ * @brief Lista as jogadas possíveis do jogador: os MCTS_MAX_ACOES pares
+ *        atacante/defensor de maior vantagem de tropas, cada um com as duas
+ *        opções de tropas a mover, e terminar o turno.
+ * @param acoes Recebe as jogadas (espaço para 2 * MCTS_MAX_ACOES + 1)
+ * @return Número de jogadas (terminar o turno é sempre a última)
+ */
+static int listarAcoes(const struct Jogo *jogo, int cor, struct AcaoMcts *acoes) {
+    const struct Mapa *mapa = jogo->mapa;
+    const int32_t *tropas = jogo->tropas;
+    int vantagens[MCTS_MAX_ACOES];
+    int numPares = 0;
+
+    for (int a = 0; a < jogo->numTerritorios; a++) {
+        if (tropas[a] < 2 || !possuiTerritorio(jogo, cor, a)) continue;
+        for (int k = mapa->inicioVizinhos[a]; k < mapa->inicioVizinhos[a + 1]; k++) {
+            int d = mapa->vizinhos[k];
+            if (possuiTerritorio(jogo, cor, d)) continue;
+
+            // Inserção ordenada por vantagem, descartando o pior quando a lista enche
+            int vantagem = tropas[a] - tropas[d];
+            if (numPares == MCTS_MAX_ACOES && vantagem <= vantagens[numPares - 1]) continue;
+            int pos = (numPares < MCTS_MAX_ACOES) ? numPares++ : numPares - 1;
+            while (pos > 0 && vantagens[pos - 1] < vantagem) {
+                vantagens[pos] = vantagens[pos - 1];
+                acoes[pos] = acoes[pos - 1];
+                pos--;
+            }
+            vantagens[pos] = vantagem;
+            acoes[pos].ataque = a;
+            acoes[pos].defesa = d;
+            acoes[pos].moverTudo = 1;
+        }
+    }
+
+    // Mover metade só difere de mover tudo com 4 ou mais tropas no atacante
+    int numAcoes = numPares;
+    for (int p = 0; p < numPares; p++) {
+        if (tropas[acoes[p].ataque] >= 4) {
+            acoes[numAcoes] = acoes[p];
+            acoes[numAcoes++].moverTudo = 0;
+        }
+    }
+    acoes[numAcoes].ataque = -1;
+    acoes[numAcoes].defesa = -1;
+    acoes[numAcoes].moverTudo = 1;
+    return numAcoes + 1;
+}
+
+static int mesmaAcao(const struct AcaoMcts *x, const struct AcaoMcts *y) {
+    return x->ataque == y->ataque && x->defesa == y->defesa && x->moverTudo == y->moverTudo;
+}
+
+/**
+ * @brief Aplica a jogada de um nó na cópia da partida.
+ * @return 1 se o turno do jogador continua, 0 se terminou
+ */
+static int aplicarAcao(struct TrabalhoMcts *trabalho, const struct AcaoMcts *acao) {
+    if (acao->ataque < 0) return 0;
+    struct Jogo *copia = &trabalho->copia;
+    trabalho->moverTudo = acao->moverTudo;
+    atacar(copia, acao->ataque, acao->defesa, &copia->jogadores[trabalho->indiceJogador]);
+    trabalho->moverTudo = 1;
+    return copia->vencedor < 0;
+}
+
+/**
+ * @brief Joga o resto de um turno com a política das simulações.
+ * @note Limitado a MCTS_ATAQUES_TURNO ataques, para que mesmo em mapas grandes
+ *       cada decisão tenha várias simulações completas.
+ * @return 1 se o prazo da decisão acabou no meio do turno
+ */
+static int jogarTurno(struct TrabalhoMcts *trabalho, int indiceJogador) {
+    struct Jogo *copia = &trabalho->copia;
+    struct Jogador *jogador = &copia->jogadores[indiceJogador];
+    int ataque;
+    int defesa;
+    for (int k = 0; k < MCTS_ATAQUES_TURNO && copia->vencedor < 0 &&
+                    jogador->politica->escolherAtaque(copia, jogador, &ataque, &defesa); k++) {
+        atacar(copia, ataque, defesa, jogador);
+        if (relogioSegundos() >= trabalho->prazo) return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Recompensa do jogador que está decidindo no estado atual da cópia.
+ * @note Sem vencedor, vale o progresso da missão: conquistas em relação à
+ *       meta, ou territórios já tirados da cor alvo.
+ * @return Valor entre 0 (outro jogador venceu) e 1 (o jogador venceu)
+ */
+static double recompensa(const struct TrabalhoMcts *trabalho) {
+    const struct Jogo *copia = &trabalho->copia;
+    if (copia->vencedor >= 0) return copia->vencedor == trabalho->indiceJogador ? 1.0 : 0.0;
+
+    const struct Jogador *jogador = &copia->jogadores[trabalho->indiceJogador];
+    const struct Missao *missao = &Missoes[jogador->missao];
+    int meus = copia->territoriosCor[jogador->cor];
+    if (meus == 0) return 0.0;
+
+    double progresso;
+    if (missao->cor != SEM_COR) {
+        progresso = 1.0 - (double) copia->territoriosCor[missao->cor] / copia->numTerritorios;
+    } else {
+        progresso = (double) jogador->conquistas / missao->territorios;
+        if (progresso > 1.0) progresso = 1.0;
+    }
+    return 0.2 + 0.6 * progresso;
+}
+
+/**
+ * @brief Faz uma iteração: seleção por UCB1 entre as jogadas possíveis na
+ *        amostra atual, expansão de uma jogada nova, simulação e retropropagação.
+ * @return 1 se a iteração terminou, 0 se o prazo acabou no meio dela
+ */
+static int iterar(struct TrabalhoMcts *trabalho) {
+    struct AcaoMcts acoes[2 * MCTS_MAX_ACOES + 1];
+    int caminho[MCTS_PROFUNDIDADE + 2];
+    int profundidade = 0;
+    int no = 0;
+    int turnoContinua = 1;
+
+    // Em mapas grandes a primeira iteração copia a raiz e as outras desfazem
+    // só os blocos que a iteração anterior alterou (sem memória para o
+    // histórico, volta a copiar)
+    if (!trabalho->versionada) {
+        copiarPartida(trabalho);
+        if (trabalho->copia.numTerritorios >= MCTS_TERRITORIOS_HISTORICO) {
+            trabalho->versionada = criarHistorico(&trabalho->historico, &trabalho->copia) == 0;
+        }
+    } else if (voltarParaVersao(&trabalho->historico, 0) != 0 || trabalho->historico.falhas > 0) {
+        liberarHistorico(&trabalho->historico);
+        trabalho->versionada = 0;
+        copiarPartida(trabalho);
+    }
+    caminho[profundidade++] = 0;
+
+    while (turnoContinua && profundidade <= MCTS_PROFUNDIDADE) {
+        struct NoMcts *pai = &trabalho->nos[no];
+        int cor = trabalho->copia.jogadores[trabalho->indiceJogador].cor;
+        int numAcoes = listarAcoes(&trabalho->copia, cor, acoes);
+
+        // Procura uma jogada possível ainda sem nó; senão escolhe o filho pelo UCB1
+        int escolhido = -1;
+        int nova = -1;
+        double melhor = -1.0;
+        double logPai = log((double) pai->visitas + 1.0);
+        for (int i = 0; i < numAcoes && nova < 0; i++) {
+            int filho = pai->primeiroFilho;
+            while (filho >= 0 && !mesmaAcao(&trabalho->nos[filho].acao, &acoes[i])) filho = trabalho->nos[filho].proximoIrmao;
+            if (filho < 0) {
+                nova = i;
+                break;
+            }
+            const struct NoMcts *f = &trabalho->nos[filho];
+            double ucb = f->soma / f->visitas + MCTS_EXPLORACAO * sqrt(logPai / f->visitas);
+            if (ucb > melhor) {
+                melhor = ucb;
+                escolhido = filho;
+            }
+        }
+
+        if (nova >= 0) {
+            // Árvore cheia: continua só pelos nós existentes
+            if (trabalho->numNos == MCTS_MAX_NOS) {
+                if (escolhido < 0) break;
+            } else {
+                escolhido = trabalho->numNos++;
+                struct NoMcts *filho = &trabalho->nos[escolhido];
+                filho->acao = acoes[nova];
+                filho->visitas = 0;
+                filho->soma = 0.0;
+                filho->primeiroFilho = -1;
+                filho->proximoIrmao = pai->primeiroFilho;
+                pai->primeiroFilho = escolhido;
+            }
+        }
+
+        no = escolhido;
+        caminho[profundidade++] = no;
+        turnoContinua = aplicarAcao(trabalho, &trabalho->nos[no].acao);
+        if (nova >= 0) break; // Expandiu: o resto é simulação
+    }
+
+    // Simulação: termina o turno do jogador e joga MCTS_HORIZONTE turnos
+    int indice = trabalho->indiceJogador;
+    if (turnoContinua && jogarTurno(trabalho, indice)) return 0;
+    for (int t = 0; t < MCTS_HORIZONTE && trabalho->copia.vencedor < 0; t++) {
+        indice = (indice + 1) % trabalho->copia.numJogadores;
+        if (jogarTurno(trabalho, indice)) return 0;
+    }
+
+    double valor = recompensa(trabalho);
+    for (int i = 0; i < profundidade; i++) {
+        trabalho->nos[caminho[i]].visitas++;
+        trabalho->nos[caminho[i]].soma += valor;
+    }
+    return 1;
+}
+
+/**
+ * @brief Laço de uma thread: itera até o prazo da decisão.
+ */
+static void *executarBusca(void *arg) {
+    struct TrabalhoMcts *trabalho = (struct TrabalhoMcts *) arg;
+    trabalho->nos[0].visitas = 0;
+    trabalho->nos[0].soma = 0.0;
+    trabalho->nos[0].primeiroFilho = -1;
+    trabalho->nos[0].proximoIrmao = -1;
+    trabalho->numNos = 1;
+
+    while (relogioSegundos() < trabalho->prazo) {
+        if (iterar(trabalho)) trabalho->simulacoes++;
+    }
+    return NULL;
+}
+
+/**
+ * @brief Escolhe a jogada do jogador com a busca em paralelo.
+ * @note Soma as visitas de cada jogada da raiz em todas as threads e escolhe
+ *       a mais visitada. Sem nenhuma simulação completa (mapa enorme ou
+ *       orçamento pequeno demais) segue a escolha gulosa.
+ * @return 1 se escolheu um ataque, 0 para terminar o turno
+ */
+static int buscar(struct Jogo *jogo, struct ContextoMcts *contexto, int indiceJogador, struct AcaoMcts *escolha) {
+    int numThreads = contexto->numThreads;
+    if (numThreads < 1) numThreads = 1;
+    if (numThreads > TORNEIO_MAX_THREADS) numThreads = TORNEIO_MAX_THREADS;
+
+    double inicio = relogioSegundos();
+    struct TrabalhoMcts *trabalhos = (struct TrabalhoMcts *) calloc(numThreads, sizeof(struct TrabalhoMcts));
+    pthread_t *threads = (pthread_t *) calloc(numThreads, sizeof(pthread_t));
+    int erro = (trabalhos == NULL || threads == NULL);
+
+    for (int t = 0; t < numThreads && !erro; t++) {
+        struct TrabalhoMcts *trabalho = &trabalhos[t];
+        trabalho->raiz = jogo;
+        trabalho->indiceJogador = indiceJogador;
+        trabalho->prazo = inicio + contexto->orcamentoMs / 1000.0;
+        trabalho->moverTudo = 1;
+        // Os nós e a cópia vêm do pool de arenas desta thread: da segunda
+        // decisão em diante nenhum dos dois chama o alocador
+        trabalho->arena = obterArena(MCTS_MAX_NOS * sizeof(struct NoMcts));
+        if (trabalho->arena != NULL) trabalho->nos = (struct NoMcts *) reservarNaArena(trabalho->arena, MCTS_MAX_NOS * sizeof(struct NoMcts));
+        if (trabalho->arena == NULL || alocarJogoComCores(&trabalho->copia, jogo->mapa, jogo->numCores) != 0) erro = 1;
+        // Um fluxo por thread e por decisão; o gerador da partida não é tocado
+        rngSemearFluxo(&trabalho->copia.rng, contexto->semente, ((uint64_t) contexto->decisoes << 8) | (uint64_t) t);
+    }
+
+    int criadas = 0;
+    for (int t = 0; t < numThreads && !erro; t++) {
+        if (pthread_create(&threads[t], NULL, executarBusca, &trabalhos[t]) != 0) {
+            erro = 1;
+            break;
+        }
+        criadas++; // Só as threads criadas são esperadas (e só as raízes delas são combinadas)
+    }
+    for (int t = 0; t < criadas; t++) pthread_join(threads[t], NULL);
+
+    // Combina as raízes: a raiz é a mesma partida em todas as threads, então os
+    // filhos de cada uma são jogadas da mesma lista
+    struct AcaoMcts acoes[2 * MCTS_MAX_ACOES + 1];
+    long visitas[2 * MCTS_MAX_ACOES + 1] = {0};
+    double somas[2 * MCTS_MAX_ACOES + 1] = {0};
+    int numAcoes = listarAcoes(jogo, jogo->jogadores[indiceJogador].cor, acoes);
+    long simulacoes = 0;
+    for (int t = 0; t < criadas; t++) {
+        simulacoes += trabalhos[t].simulacoes;
+        for (int f = trabalhos[t].nos[0].primeiroFilho; f >= 0; f = trabalhos[t].nos[f].proximoIrmao) {
+            for (int i = 0; i < numAcoes; i++) {
+                if (!mesmaAcao(&trabalhos[t].nos[f].acao, &acoes[i])) continue;
+                visitas[i] += trabalhos[t].nos[f].visitas;
+                somas[i] += trabalhos[t].nos[f].soma;
+                break;
+            }
+        }
+    }
+
+    // A jogada mais visitada (empate: a de maior recompensa)
+    int melhor = -1;
+    for (int i = 0; i < numAcoes; i++) {
+        if (visitas[i] == 0) continue;
+        if (melhor < 0 || visitas[i] > visitas[melhor] || (visitas[i] == visitas[melhor] && somas[i] > somas[melhor])) melhor = i;
+    }
+
+    for (int t = 0; t < numThreads && trabalhos != NULL; t++) {
+        devolverArena(trabalhos[t].arena);
+        if (trabalhos[t].versionada) liberarHistorico(&trabalhos[t].historico);
+        liberarJogo(&trabalhos[t].copia);
+    }
+    free(trabalhos);
+    free(threads);
+
+    double duracao = relogioSegundos() - inicio;
+    contexto->decisoes++;
+    contexto->simulacoes += simulacoes;
+    contexto->segundos += duracao;
+    contexto->simulacoesUltima = simulacoes;
+    contexto->segundosUltima = duracao;
+
+    if (melhor >= 0) {
+        *escolha = acoes[melhor];
+    } else {
+        // Sem simulações: a escolha gulosa, movendo todas as tropas
+        escolha->moverTudo = 1;
+        escolha->ataque = -1;
+        int ataque, defesa;
+        if (!politicaGulosa.escolherAtaque(jogo, &jogo->jogadores[indiceJogador], &ataque, &defesa)) return 0;
+        escolha->ataque = ataque;
+        escolha->defesa = defesa;
+    }
+    return escolha->ataque >= 0;
+}
+
+// --- Política do jogador automático ---
+
+/**
+ * @brief Escolhe o próximo ataque (ou termina o turno) com a busca.
+ * @note Sem contexto em jogo->contexto, segue a política gulosa.
+ * @return 1 se um ataque foi escolhido, 0 para terminar o turno
+ */
+static int mctsEscolherAtaque(struct Jogo *jogo, struct Jogador *jogador, int *ataque, int *defesa) {
+    struct ContextoMcts *contexto = (struct ContextoMcts *) jogo->contexto;
+    if (contexto == NULL) return politicaGulosa.escolherAtaque(jogo, jogador, ataque, defesa);
+
+    struct AcaoMcts escolha;
+    int indiceJogador = (int) (jogador - jogo->jogadores);
+    int atacar = buscar(jogo, contexto, indiceJogador, &escolha);
+    *ataque = escolha.ataque;
+    *defesa = escolha.defesa;
+    contexto->moverTudo = escolha.moverTudo;
+
+    double porSegundo = contexto->segundosUltima > 0 ? contexto->simulacoesUltima / contexto->segundosUltima : 0.0;
+    if (atacar) {
+        JOGO_PRINTF(jogo, "\nComputador (%s): ataca %s a partir de %s, movendo %s", nomeCor(jogador->cor),
+                    nomeTerritorio(jogo->mapa, escolha.defesa), nomeTerritorio(jogo->mapa, escolha.ataque),
+                    escolha.moverTudo ? "todas as tropas" : "metade das tropas");
+    } else {
+        JOGO_PRINTF(jogo, "\nComputador (%s): termina o turno", nomeCor(jogador->cor));
+    }
+    JOGO_PRINTF(jogo, " [%ld simulações em %.1f ms = %.0f/s, %d threads]\n",
+                contexto->simulacoesUltima, contexto->segundosUltima * 1000.0, porSegundo, contexto->numThreads);
+    return atacar;
+}
+
+static int mctsDados(struct Jogo *jogo, int ataque, int defesa, int maxDados) {
+    (void) jogo; (void) ataque; (void) defesa;
+    return maxDados;
+}
+
+static int mctsContinuar(struct Jogo *jogo, int ataque, int defesa) {
+    (void) jogo; (void) ataque; (void) defesa;
+    return 1;
+}
+
+static int mctsTropasMover(struct Jogo *jogo, int ataque, int defesa, int maxTropas) {
+    (void) ataque; (void) defesa;
+    const struct ContextoMcts *contexto = (const struct ContextoMcts *) jogo->contexto;
+    if (contexto == NULL || contexto->moverTudo) return maxTropas;
+    return (maxTropas + 1) / 2;
+}
+
+// Na partida real a batalha é rodada a rodada (blitz = 0), como a de um
+// jogador humano, para que uma partida gravada com --record se repita igual
+const struct Politica politicaMcts = {
+    "mcts", 0, mctsEscolherAtaque, mctsDados, mctsDados, mctsContinuar, mctsTropasMover
+};
+
+/**
+ * @brief Função para preparar o jogador automático de uma partida
+ * @note Constrói a tabela de batalhas usada pelas simulações (se ainda não existir).
+ * @param contexto Contexto a preparar (depois, aponte jogo->contexto para ele)
+ * @param orcamentoMs Tempo máximo de cada decisão em milissegundos
+ * @param numThreads Threads das simulações (1 a TORNEIO_MAX_THREADS)
+ * @param semente Semente dos fluxos das simulações
+ * @return 0 em caso de sucesso, 1 se faltou memória
+ */
+int iniciarContextoMcts(struct ContextoMcts *contexto, double orcamentoMs, int numThreads, uint64_t semente) {
+    memset(contexto, 0, sizeof(*contexto));
+    contexto->orcamentoMs = orcamentoMs > 0 ? orcamentoMs : MCTS_ORCAMENTO_PADRAO_MS;
+    contexto->numThreads = numThreads;
+    contexto->semente = semente;
+    contexto->moverTudo = 1;
+    return inicializarTabelaBatalhas();
+}
+
+/**
+ * @brief Função para imprimir as estatísticas do jogador automático
+ * @note Simulações/s é a medida de velocidade do motor: acompanha regressões de desempenho.
+ * @param contexto Contexto da partida
+ */
+void relatarMcts(const struct ContextoMcts *contexto) {
+    if (contexto->decisoes == 0) return;
+    printf("Computador: %ld decisões, %ld simulações em %.1f ms (%.0f simulações/s, %d threads, orçamento %.0f ms)\n",
+           contexto->decisoes, contexto->simulacoes, contexto->segundos * 1000.0,
+           contexto->segundos > 0 ? contexto->simulacoes / contexto->segundos : 0.0,
+           contexto->numThreads, contexto->orcamentoMs);
+}
@@ -0,0 +1,63 @@
+/**
+ * @file mcts.h
+ * @brief Jogador automático por busca em árvore de Monte Carlo (MCTS).
+ *
+ * A cada decisão o jogador monta uma árvore com os ataques possíveis do seu
+ * turno (pares atacante/defensor e quantas tropas mover após a conquista,
+ * além de terminar o turno) e a explora com UCB1. Cada iteração percorre a
+ * árvore aplicando as jogadas com atacar() sobre uma cópia da partida, com
+ * dados novos a cada vez (árvore "de laço aberto": os nós guardam jogadas,
+ * não estados), e termina com uma simulação gulosa de MCTS_HORIZONTE turnos.
+ * Em mapas grandes (MCTS_TERRITORIOS_HISTORICO ou mais) a cópia volta à raiz
+ * entre uma iteração e outra pelo histórico de versões (historico.h), que
+ * desfaz só os blocos de territórios que a iteração alterou; nos pequenos,
+ * copiar a partida inteira é mais barato.
+ * A recompensa é 1 se o jogador cumpre a sua missão de Missoes[], 0 se outro
+ * cumpre antes, e o progresso da missão quando ninguém venceu ainda.
+ *
+ * As simulações rodam em paralelo: cada thread explora a sua própria árvore
+ * até o prazo da decisão (orçamento em milissegundos) e, no fim, as visitas
+ * dos filhos da raiz são somadas e a jogada mais visitada é escolhida. Cada
+ * decisão informa quantas simulações foram feitas por segundo.
+ *
+ * A árvore não ramifica no número de dados: o jogador sempre rola o máximo,
+ * tanto no ataque quanto na defesa.
+ */
+#ifndef MCTS_H
+#define MCTS_H
+
+#include <stdint.h>
+
+#include "jogo.h"
+
+#define MCTS_ORCAMENTO_PADRAO_MS 50.0 // Tempo de cada decisão, por padrão
+#define MCTS_MAX_ACOES 32          // Pares atacante/defensor considerados em cada nó (os de maior vantagem)
+#define MCTS_MAX_NOS 65536         // Nós da árvore de cada thread
+#define MCTS_PROFUNDIDADE 4        // Ataques do próprio turno explorados pela árvore
+#define MCTS_HORIZONTE 6           // Turnos jogados pela simulação depois da árvore
+#define MCTS_ATAQUES_TURNO 8       // Ataques de cada turno da simulação (cada escolha percorre o mapa)
+#define MCTS_EXPLORACAO 0.7        // Constante de exploração do UCB1
+#define MCTS_TERRITORIOS_HISTORICO 4096 // Mapas a partir dos quais cada iteração desfaz a anterior em vez de copiar a raiz
+
+// Configuração e estatísticas do jogador automático de uma partida
+// (fica em jogo->contexto enquanto a partida tiver jogadores automáticos)
+struct ContextoMcts {
+    double orcamentoMs;     // Tempo máximo de cada decisão
+    int numThreads;         // Threads das simulações
+    uint64_t semente;       // Semente dos fluxos das simulações (não consome o gerador da partida)
+    int moverTudo;          // Decisão em andamento: 1 - mover todas as tropas, 0 - metade
+    long decisoes;          // Decisões tomadas
+    long simulacoes;        // Simulações feitas em todas as decisões
+    double segundos;        // Tempo gasto em todas as decisões
+    long simulacoesUltima;  // Simulações da última decisão
+    double segundosUltima;  // Tempo da última decisão
+};
+
+// Política do jogador automático
+extern const struct Politica politicaMcts;
+
+// --- Protótipos das Funções ---
+int iniciarContextoMcts(struct ContextoMcts *contexto, double orcamentoMs, int numThreads, uint64_t semente); // Função para preparar o jogador automático (tabela de batalhas)
+void relatarMcts(const struct ContextoMcts *contexto); // Função para imprimir as simulações/s do jogador automático
+
+#endif // MCTS_H
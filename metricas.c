@@ -0,0 +1,289 @@
+/**
+ * @file metricas.c
+ * @brief Contadores dos pontos quentes e sua gravação (Prometheus e JSON).
+ *
+ * Cada thread recebe, no primeiro ponto instrumentado que alcança, um bloco
+ * de contadores só seu, ligado à lista de threads vivas. Ao terminar, a
+ * thread soma o bloco aos totais das threads encerradas e o libera (destrutor
+ * da chave pthread), então lotes com milhares de threads curtas (torneios,
+ * decisões do MCTS) não acumulam memória. A gravação soma os totais com os
+ * blocos vivos, lidos com cargas atômicas relaxadas.
+ *
+ * O SIGUSR1 é bloqueado em todas as threads e atendido por uma thread própria
+ * com sigwait(), de modo que a gravação roda fora de um tratador de sinal e
+ * pode usar stdio à vontade.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "metricas.h"
+
+#ifdef WAR_METRICAS
+
+#include <signal.h>
+#include <pthread.h>
+
+#include "simulacao.h"
+
+#define METRICAS_MAX_CAMINHO 4096 // Tamanho máximo do prefixo dos arquivos
+
+// Nome exportado, texto de ajuda e se a métrica é cronometrada
+struct DescricaoMetrica {
+    const char *nome;
+    const char *ajuda;
+    int cronometrada;
+};
+
+static const struct DescricaoMetrica DescricoesMetricas[TOTAL_METRICAS] = {
+    [METRICA_RODADAS_DADOS]      = {"rodadas_dados", "Rodadas de dados disputadas (rodadaDeDados)", 1},
+    [METRICA_BATALHAS_TABELA]    = {"batalhas_tabela", "Batalhas resolvidas pela tabela de Markov (resolverBatalha)", 0},
+    [METRICA_ATAQUES]            = {"ataques", "Chamadas de atacar", 1},
+    [METRICA_CONQUISTAS]         = {"conquistas", "Territórios conquistados em atacar", 0},
+    [METRICA_ALOCACOES]          = {"alocacoes", "Blocos alocados para partidas, telas e quadros", 0},
+    [METRICA_BUSCAS_NOME]        = {"buscas_nome", "Chamadas de buscarTerritorioPorNome", 1},
+    [METRICA_PERGUNTAS]          = {"perguntas", "Respostas lidas do teclado", 0},
+    [METRICA_DESENHOS]           = {"desenhos", "Chamadas de mostrarMapa", 1},
+    [METRICA_CADASTRO_JOGADORES] = {"cadastro_jogadores", "Chamadas de cadastroJogadores (inclui a espera pelo teclado)", 1},
+};
+
+// Bloco de contadores de uma thread viva
+struct RegistroThread {
+    struct ContadoresThread contadores;
+    struct RegistroThread *anterior;
+    struct RegistroThread *proximo;
+};
+
+__thread struct ContadoresThread *ContadoresLocais = NULL;
+
+static pthread_mutex_t TravaRegistro = PTHREAD_MUTEX_INITIALIZER;  // Lista de threads e totais
+static pthread_mutex_t TravaGravacao = PTHREAD_MUTEX_INITIALIZER;  // Uma gravação por vez (saída e sinal)
+static pthread_once_t ChaveCriada = PTHREAD_ONCE_INIT;
+static pthread_key_t ChaveThread;
+static struct RegistroThread *ThreadsVivas = NULL;
+static struct ContadoresThread TotaisEncerradas;
+static long ThreadsRegistradas = 0;
+
+static char PrefixoMetricas[METRICAS_MAX_CAMINHO];
+static int MetricasAtivas = 0;
+static uint64_t RelogioInicial;
+static double SegundosIniciais;
+
+/**
+ * @brief Devolve os contadores de uma thread que terminou aos totais.
+ * @param dados Bloco da thread (struct RegistroThread).
+ */
+static void encerrarThread(void *dados) {
+    struct RegistroThread *registro = (struct RegistroThread *) dados;
+
+    pthread_mutex_lock(&TravaRegistro);
+    for (int m = 0; m < TOTAL_METRICAS; m++) {
+        TotaisEncerradas.contagem[m] += registro->contadores.contagem[m];
+        TotaisEncerradas.ciclos[m] += registro->contadores.ciclos[m];
+    }
+    if (registro->anterior != NULL) registro->anterior->proximo = registro->proximo;
+    else ThreadsVivas = registro->proximo;
+    if (registro->proximo != NULL) registro->proximo->anterior = registro->anterior;
+    pthread_mutex_unlock(&TravaRegistro);
+
+    free(registro);
+}
+
+static void criarChave(void) {
+    pthread_key_create(&ChaveThread, encerrarThread);
+}
+
+/**
+ * @brief Cria os contadores da thread atual e os liga à lista de threads vivas.
+ * @return Contadores da thread, ou NULL se faltar memória (a thread não é medida).
+ */
+struct ContadoresThread *registrarThreadMetricas(void) {
+    pthread_once(&ChaveCriada, criarChave);
+
+    struct RegistroThread *registro = (struct RegistroThread *) calloc(1, sizeof(struct RegistroThread));
+    if (registro == NULL) return NULL;
+
+    pthread_mutex_lock(&TravaRegistro);
+    registro->proximo = ThreadsVivas;
+    if (ThreadsVivas != NULL) ThreadsVivas->anterior = registro;
+    ThreadsVivas = registro;
+    ThreadsRegistradas++;
+    pthread_mutex_unlock(&TravaRegistro);
+
+    pthread_setspecific(ChaveThread, registro);
+    ContadoresLocais = &registro->contadores;
+    return ContadoresLocais;
+}
+
+/**
+ * @brief Soma os contadores das threads encerradas e das vivas.
+ * @param total Recebe as somas.
+ * @return Número de threads que já registraram contadores.
+ */
+static long somarContadores(struct ContadoresThread *total) {
+    pthread_mutex_lock(&TravaRegistro);
+    *total = TotaisEncerradas;
+    for (const struct RegistroThread *r = ThreadsVivas; r != NULL; r = r->proximo) {
+        for (int m = 0; m < TOTAL_METRICAS; m++) {
+            total->contagem[m] += __atomic_load_n(&r->contadores.contagem[m], __ATOMIC_RELAXED);
+            total->ciclos[m] += __atomic_load_n(&r->contadores.ciclos[m], __ATOMIC_RELAXED);
+        }
+    }
+    long threads = ThreadsRegistradas;
+    pthread_mutex_unlock(&TravaRegistro);
+    return threads;
+}
+
+/**
+ * @brief Grava as métricas no formato de texto do Prometheus.
+ */
+static void escreverPrometheus(FILE *arquivo, const struct ContadoresThread *total, long threads,
+                               double segundos, double ciclosPorSegundo) {
+    for (int m = 0; m < TOTAL_METRICAS; m++) {
+        const struct DescricaoMetrica *d = &DescricoesMetricas[m];
+        fprintf(arquivo, "# HELP war_%s_total %s.\n", d->nome, d->ajuda);
+        fprintf(arquivo, "# TYPE war_%s_total counter\n", d->nome);
+        fprintf(arquivo, "war_%s_total %llu\n", d->nome, (unsigned long long) total->contagem[m]);
+        if (!d->cronometrada) continue;
+        fprintf(arquivo, "# HELP war_%s_ciclos_total Ciclos gastos em: %s.\n", d->nome, d->ajuda);
+        fprintf(arquivo, "# TYPE war_%s_ciclos_total counter\n", d->nome);
+        fprintf(arquivo, "war_%s_ciclos_total %llu\n", d->nome, (unsigned long long) total->ciclos[m]);
+    }
+    fprintf(arquivo, "# HELP war_ciclos_por_segundo Ciclos do relógio das métricas por segundo (converte os *_ciclos_total).\n");
+    fprintf(arquivo, "# TYPE war_ciclos_por_segundo gauge\n");
+    fprintf(arquivo, "war_ciclos_por_segundo %.0f\n", ciclosPorSegundo);
+    fprintf(arquivo, "# HELP war_threads_medidas_total Threads que registraram contadores.\n");
+    fprintf(arquivo, "# TYPE war_threads_medidas_total counter\n");
+    fprintf(arquivo, "war_threads_medidas_total %ld\n", threads);
+    fprintf(arquivo, "# HELP war_segundos_medidos Segundos desde o início das métricas.\n");
+    fprintf(arquivo, "# TYPE war_segundos_medidos gauge\n");
+    fprintf(arquivo, "war_segundos_medidos %.6f\n", segundos);
+}
+
+/**
+ * @brief Grava as métricas em JSON.
+ */
+static void escreverJson(FILE *arquivo, const struct ContadoresThread *total, long threads,
+                         double segundos, double ciclosPorSegundo) {
+    fprintf(arquivo, "{\n  \"segundos\": %.6f,\n  \"ciclos_por_segundo\": %.0f,\n  \"threads\": %ld,\n  \"metricas\": {\n",
+            segundos, ciclosPorSegundo, threads);
+    for (int m = 0; m < TOTAL_METRICAS; m++) {
+        const struct DescricaoMetrica *d = &DescricoesMetricas[m];
+        fprintf(arquivo, "    \"%s\": {\"contagem\": %llu", d->nome, (unsigned long long) total->contagem[m]);
+        if (d->cronometrada) {
+            double ns = (total->contagem[m] > 0 && ciclosPorSegundo > 0)
+                ? total->ciclos[m] / (double) total->contagem[m] / ciclosPorSegundo * 1e9 : 0.0;
+            fprintf(arquivo, ", \"ciclos\": %llu, \"ns_por_chamada\": %.1f",
+                    (unsigned long long) total->ciclos[m], ns);
+        }
+        fprintf(arquivo, "}%s\n", m + 1 < TOTAL_METRICAS ? "," : "");
+    }
+    fprintf(arquivo, "  }\n}\n");
+}
+
+/**
+ * @brief Grava um arquivo de métricas por um temporário renomeado no fim,
+ *        para que um coletor nunca leia um arquivo pela metade.
+ * @return 0 em caso de sucesso, 1 em caso de erro.
+ */
+static int gravarArquivo(const char *extensao, void (*escrever)(FILE *, const struct ContadoresThread *, long, double, double),
+                         const struct ContadoresThread *total, long threads, double segundos, double ciclosPorSegundo) {
+    char caminho[METRICAS_MAX_CAMINHO + 16];
+    char temporario[METRICAS_MAX_CAMINHO + 32];
+    snprintf(caminho, sizeof(caminho), "%s%s", PrefixoMetricas, extensao);
+    snprintf(temporario, sizeof(temporario), "%s.tmp", caminho);
+
+    FILE *arquivo = fopen(temporario, "w");
+    if (arquivo == NULL) {
+        perror(temporario);
+        return 1;
+    }
+    escrever(arquivo, total, threads, segundos, ciclosPorSegundo);
+    if (fclose(arquivo) != 0 || rename(temporario, caminho) != 0) {
+        perror(caminho);
+        remove(temporario);
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Grava as métricas agora em PREFIXO.prom e PREFIXO.json.
+ * @return 0 em caso de sucesso, 1 se as métricas não foram iniciadas ou houve erro.
+ */
+int gravarMetricas(void) {
+    if (!MetricasAtivas) return 1;
+
+    pthread_mutex_lock(&TravaGravacao);
+    struct ContadoresThread total;
+    long threads = somarContadores(&total);
+    double segundos = relogioSegundos() - SegundosIniciais;
+    double ciclosPorSegundo = segundos > 0 ? (metricaRelogio() - RelogioInicial) / segundos : 0.0;
+
+    int erro = gravarArquivo(".prom", escreverPrometheus, &total, threads, segundos, ciclosPorSegundo);
+    erro |= gravarArquivo(".json", escreverJson, &total, threads, segundos, ciclosPorSegundo);
+    pthread_mutex_unlock(&TravaGravacao);
+    return erro;
+}
+
+static void gravarNaSaida(void) {
+    gravarMetricas();
+}
+
+/**
+ * @brief Atende o SIGUSR1 gravando as métricas (roda numa thread própria).
+ */
+static void *esperarSinal(void *argumento) {
+    const sigset_t *sinais = (const sigset_t *) argumento;
+    for (;;) {
+        int sinal;
+        if (sigwait(sinais, &sinal) == 0) gravarMetricas();
+    }
+    return NULL;
+}
+
+/**
+ * @brief Passa a gravar as métricas na saída do programa e a cada SIGUSR1.
+ * @note Deve ser chamada antes de criar outras threads, que herdam o SIGUSR1 bloqueado.
+ * @param prefixo Prefixo dos arquivos (PREFIXO.prom e PREFIXO.json).
+ * @return 0 em caso de sucesso, 1 em caso de erro.
+ */
+int iniciarMetricas(const char *prefixo) {
+    static sigset_t sinais;
+
+    if (strlen(prefixo) >= sizeof(PrefixoMetricas)) {
+        fprintf(stderr, "Erro: prefixo das métricas muito longo.\n");
+        return 1;
+    }
+    strcpy(PrefixoMetricas, prefixo);
+    SegundosIniciais = relogioSegundos();
+    RelogioInicial = metricaRelogio();
+
+    sigemptyset(&sinais);
+    sigaddset(&sinais, SIGUSR1);
+    pthread_t thread;
+    if (pthread_sigmask(SIG_BLOCK, &sinais, NULL) != 0 ||
+        pthread_create(&thread, NULL, esperarSinal, &sinais) != 0) {
+        fprintf(stderr, "Erro: não foi possível atender o SIGUSR1 das métricas.\n");
+        return 1;
+    }
+    pthread_detach(thread);
+
+    MetricasAtivas = 1;
+    atexit(gravarNaSaida);
+    return 0;
+}
+
+#else
+
+int iniciarMetricas(const char *prefixo) {
+    (void) prefixo;
+    fprintf(stderr, "Erro: o programa foi compilado sem métricas (use make metrics).\n");
+    return 1;
+}
+
+int gravarMetricas(void) {
+    return 1;
+}
+
+#endif // WAR_METRICAS
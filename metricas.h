@@ -0,0 +1,91 @@
+/**
+ * @file metricas.h
+ * @brief Contadores e cronômetros dos pontos quentes do jogo.
+ *
+ * Compilado com -DWAR_METRICAS (make metrics), cada ponto instrumentado
+ * soma uma contagem e, nos cronometrados, os ciclos gastos (rdtsc em x86,
+ * nanossegundos do relógio monotônico nas outras arquiteturas). Cada thread
+ * soma nos seus próprios contadores, sem travas nem instruções atômicas com
+ * prefixo lock; ao terminar, a thread devolve as contagens ao total geral.
+ *
+ * Com --metrics PREFIXO os contadores são gravados na saída do programa
+ * (ou ao receber SIGUSR1) em PREFIXO.prom, no formato de texto do
+ * Prometheus, e em PREFIXO.json.
+ *
+ * Sem WAR_METRICAS as macros não geram código nenhum.
+ */
+#ifndef METRICAS_H
+#define METRICAS_H
+
+#include <stdint.h>
+
+// Pontos instrumentados
+enum Metrica {
+    METRICA_RODADAS_DADOS,      // rodadaDeDados (cronometrada)
+    METRICA_BATALHAS_TABELA,    // Batalhas resolvidas de uma vez pela tabela (resolverBatalha)
+    METRICA_ATAQUES,            // atacar (cronometrada)
+    METRICA_CONQUISTAS,         // Territórios conquistados em atacar
+    METRICA_ALOCACOES,          // Blocos alocados para partidas, telas e quadros
+    METRICA_BUSCAS_NOME,        // buscarTerritorioPorNome (cronometrada)
+    METRICA_PERGUNTAS,          // Respostas lidas do teclado
+    METRICA_DESENHOS,           // mostrarMapa (cronometrada)
+    METRICA_CADASTRO_JOGADORES, // cadastroJogadores (cronometrada, inclui a espera pelo teclado)
+    TOTAL_METRICAS
+};
+
+// --- Protótipos das Funções ---
+int iniciarMetricas(const char *prefixo); // Função para gravar as métricas na saída e a cada SIGUSR1 (0 em caso de sucesso)
+int gravarMetricas(void);                 // Função para gravar as métricas agora
+
+#ifdef WAR_METRICAS
+
+#include <time.h>
+
+// Contadores de uma thread (só ela escreve; a gravação lê com cargas atômicas)
+struct ContadoresThread {
+    uint64_t contagem[TOTAL_METRICAS];
+    uint64_t ciclos[TOTAL_METRICAS];
+};
+
+extern __thread struct ContadoresThread *ContadoresLocais;
+struct ContadoresThread *registrarThreadMetricas(void); // Função para criar os contadores da thread atual
+
+/**
+ * @brief Lê o contador de ciclos (ou o relógio monotônico em nanossegundos).
+ */
+static inline uint64_t metricaRelogio(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return __builtin_ia32_rdtsc();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000u + (uint64_t) ts.tv_nsec;
+#endif
+}
+
+/**
+ * @brief Soma n à contagem e ciclos ao tempo de uma métrica da thread atual.
+ */
+static inline void metricaSomar(int metrica, uint64_t n, uint64_t ciclos) {
+    struct ContadoresThread *c = ContadoresLocais;
+    if (__builtin_expect(c == NULL, 0)) c = registrarThreadMetricas();
+    if (c == NULL) return;
+    __atomic_store_n(&c->contagem[metrica], c->contagem[metrica] + n, __ATOMIC_RELAXED);
+    __atomic_store_n(&c->ciclos[metrica], c->ciclos[metrica] + ciclos, __ATOMIC_RELAXED);
+}
+
+#define METRICA_CONTAR(metrica) metricaSomar((metrica), 1, 0)
+#define METRICA_SOMAR(metrica, n) metricaSomar((metrica), (uint64_t) (n), 0)
+#define METRICA_INICIO(var) uint64_t var = metricaRelogio()
+#define METRICA_FIM(metrica, var) metricaSomar((metrica), 1, metricaRelogio() - (var))
+
+#else
+
+#define METRICA_CONTAR(metrica) ((void) 0)
+#define METRICA_SOMAR(metrica, n) ((void) 0)
+#define METRICA_INICIO(var) ((void) 0)
+#define METRICA_FIM(metrica, var) ((void) 0)
+
+#endif // WAR_METRICAS
+
+#endif // METRICAS_H
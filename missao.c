@@ -0,0 +1,93 @@
+/**
+ * @file missao.c
+ * @brief Implementação da avaliação incremental das missões.
+ * @note As contagens são atualizadas por eventoTrocaDono, chamada apenas por
+ *       definirDono; nenhuma função deste arquivo percorre os territórios.
+ */
+
+#include "missao.h"
+#include "eventos.h"
+
+/**
+ * @brief Reavalia a missão de um jogador a partir das contagens atuais.
+ * @note Uma missão cumprida continua cumprida; o primeiro jogador a cumprir
+ *       a sua missão é o vencedor da partida.
+ * @param jogo Partida em andamento
+ * @param indiceJogador Índice do jogador
+ */
+static void avaliarMissao(struct Jogo *jogo, int indiceJogador) {
+    struct Jogador *jogador = &jogo->jogadores[indiceJogador];
+    const struct Missao *missao = &Missoes[jogador->missao];
+    if (jogador->missaoCumprida) return;
+
+    int cumprida;
+    if (missao->cor != SEM_COR) {
+        // Missão de destruir um exército: a cor alvo não tem mais territórios
+        cumprida = jogo->territoriosCor[missao->cor] == 0;
+    } else {
+        // Missão de conquistar um número de territórios (tomados de outra cor,
+        // não os recebidos na distribuição)
+        cumprida = jogador->conquistas >= missao->territorios;
+    }
+
+    if (cumprida) {
+        jogador->missaoCumprida = 1;
+        diarioRegistrar(jogo, EVENTO_MISSAO, 2, (uint64_t) indiceJogador, (uint64_t) jogador->missao);
+        if (jogo->vencedor < 0) jogo->vencedor = indiceJogador;
+    }
+}
+
+/**
+ * @brief Zera as contagens de territórios, os alvos das missões e o vencedor.
+ * @note Chamada por reiniciarPosse, antes de cadastrar uma nova partida.
+ * @param jogo Partida a reiniciar
+ */
+void reiniciarMissoes(struct Jogo *jogo) {
+    for (int c = 0; c < jogo->numCores; c++) {
+        jogo->territoriosCor[c] = 0;
+        jogo->cacadorDaCor[c] = -1;
+    }
+    jogo->vencedor = -1;
+}
+
+/**
+ * @brief Registra a missão sorteada de um jogador.
+ * @note Se a missão for de destruição, o jogador passa a ser avisado quando a
+ *       cor alvo perder o seu último território. Nenhuma missão começa
+ *       cumprida: as de territórios contam conquistas, e a distribuição não
+ *       tira território de ninguém.
+ * @param jogo Partida em cadastro
+ * @param indiceJogador Índice do jogador cuja missão acabou de ser sorteada
+ */
+void registrarAlvoMissao(struct Jogo *jogo, int indiceJogador) {
+    int alvo = Missoes[jogo->jogadores[indiceJogador].missao].cor;
+    if (alvo != SEM_COR) jogo->cacadorDaCor[alvo] = indiceJogador;
+}
+
+/**
+ * @brief Processa a troca de dono de um território.
+ * @note Se as duas cores forem válidas a troca é uma conquista e conta para o
+ *       jogador da cor nova; a distribuição (corAnterior SEM_COR) não conta.
+ * @param jogo Partida em andamento
+ * @param corAnterior Cor que perdeu o território (SEM_COR se não tinha dono)
+ * @param corNova Cor que ganhou o território (SEM_COR se ficou sem dono)
+ */
+void eventoTrocaDono(struct Jogo *jogo, int corAnterior, int corNova) {
+    if (corAnterior != SEM_COR) {
+        // A cor que ficou sem territórios cumpre a missão de quem a caçava
+        if (--jogo->territoriosCor[corAnterior] == 0 && jogo->cacadorDaCor[corAnterior] >= 0) {
+            avaliarMissao(jogo, jogo->cacadorDaCor[corAnterior]);
+        }
+    }
+
+    if (corNova != SEM_COR) {
+        jogo->territoriosCor[corNova]++;
+        int indiceJogador = jogo->jogadorDaCor[corNova];
+        if (indiceJogador >= 0 && corAnterior != SEM_COR) {
+            struct Jogador *jogador = &jogo->jogadores[indiceJogador];
+            jogador->conquistas++;
+            // Uma conquista só pode cumprir uma missão de territórios
+            if (Missoes[jogador->missao].cor == SEM_COR) avaliarMissao(jogo, indiceJogador);
+        }
+    }
+}
@@ -0,0 +1,27 @@
+/**
+ * @file missao.h
+ * @brief Avaliação incremental das missões secretas, guiada por eventos.
+ *
+ * Toda troca de dono de um território (definirDono) gera um evento com a cor
+ * que perdeu e a cor que ganhou o território. O evento atualiza as contagens
+ * de territórios por cor e de conquistas por jogador e reavalia somente as
+ * missões que ele pode ter cumprido:
+ *  - a missão de territórios do jogador que conquistou o território (conta as
+ *    conquistas, não os territórios recebidos na distribuição);
+ *  - a missão de destruição que tem como alvo a cor que perdeu o seu último território.
+ *
+ * Assim o estado de vitória de todos os jogadores (jogo->vencedor e
+ * missaoCumprida de cada um) está correto após qualquer jogada, em O(1),
+ * inclusive quando a missão de um jogador é cumprida na jogada de outro.
+ */
+#ifndef MISSAO_H
+#define MISSAO_H
+
+#include "jogo.h"
+
+// --- Protótipos das Funções ---
+void reiniciarMissoes(struct Jogo *jogo);  // Função para zerar as contagens, os alvos e o vencedor da partida
+void registrarAlvoMissao(struct Jogo *jogo, int indiceJogador); // Função para indexar o alvo da missão sorteada de um jogador
+void eventoTrocaDono(struct Jogo *jogo, int corAnterior, int corNova); // Função para processar a troca de dono de um território
+
+#endif // MISSAO_H
@@ -0,0 +1,350 @@
+/**
+ * @file planejador.c
+ * @brief Implementação do planejador de ataques (Dijkstra sobre -log das chances).
+ */
+
+#include <math.h>
+#include <string.h>
+
+#include "planejador.h"
+#include "arena.h"
+#include "batalha.h"
+#include "mapa.h"
+
+#define HEAP_FECHADO -1  // Território já retirado do heap (custo definitivo)
+#define HEAP_FORA -2     // Território alcançado pela busca mas ainda sem custo
+
+// Estado de uma busca em andamento
+struct Busca {
+    int cor;      // Cor do jogador
+    int alvo;     // Cor a destruir (SEM_COR nas missões de territórios)
+    int faltam;   // Conquistas que cumprem a missão de territórios
+    int tamanho;  // Entradas no heap
+    float limite; // Custo do melhor alvo já alcançado (poda)
+};
+
+/**
+ * @brief Função para preparar o planejador para mapas de até numTerritorios
+ * @note Todos os vetores saem de uma única arena; a tabela de batalhas é
+ *       construída aqui se ainda não existir, e os pesos de cada par de
+ *       tropas são copiados dela.
+ * @param planejador Planejador a preparar
+ * @param numTerritorios Maior número de territórios das partidas consultadas
+ * @return 0 em caso de sucesso, 1 se faltou memória
+ */
+int criarPlanejador(struct Planejador *planejador, int numTerritorios) {
+    memset(planejador, 0, sizeof(*planejador));
+    if (inicializarTabelaBatalhas() != 0) return 1;
+
+    size_t n = (size_t) numTerritorios;
+    size_t numPesos = (BATALHA_MAX_TROPAS + 1) * (BATALHA_MAX_TROPAS + 1);
+    size_t capacidade = tamanhoNaArena(numPesos * sizeof(struct PesoConquista))
+                      + 2 * tamanhoNaArena(n * sizeof(float))
+                      + 7 * tamanhoNaArena(n * sizeof(int32_t))
+                      + tamanhoNaArena(n * sizeof(struct EntradaHeap))
+                      + tamanhoNaArena(n * sizeof(int8_t));
+    planejador->arena = obterArena(capacidade);
+    if (planejador->arena == NULL) return 1;
+
+    struct Arena *arena = planejador->arena;
+    planejador->pesos = (struct PesoConquista *) reservarNaArena(arena, numPesos * sizeof(struct PesoConquista));
+    planejador->custo = (float *) reservarNaArena(arena, n * sizeof(float));
+    planejador->exercito = (float *) reservarNaArena(arena, n * sizeof(float));
+    planejador->anterior = (int32_t *) reservarNaArena(arena, n * sizeof(int32_t));
+    planejador->saltos = (int32_t *) reservarNaArena(arena, n * sizeof(int32_t));
+    planejador->heap = (struct EntradaHeap *) reservarNaArena(arena, n * sizeof(struct EntradaHeap));
+    planejador->posicaoHeap = (int32_t *) reservarNaArena(arena, n * sizeof(int32_t));
+    planejador->marca = (uint32_t *) reservarNaArena(arena, n * sizeof(uint32_t));
+    planejador->dependencias = (int32_t *) reservarNaArena(arena, n * sizeof(int32_t));
+    planejador->tropasVistas = (int32_t *) reservarNaArena(arena, n * sizeof(int32_t));
+    planejador->donoVisto = (int8_t *) reservarNaArena(arena, n * sizeof(int8_t));
+    memset(planejador->marca, 0, n * sizeof(uint32_t));
+
+    // Cópia local da tabela de batalhas, consultada a cada aresta sem chamar batalha.c
+    for (int a = 0; a <= BATALHA_MAX_TROPAS; a++) {
+        for (int d = 0; d <= BATALHA_MAX_TROPAS; d++) {
+            struct PesoConquista *peso = &planejador->pesos[a * (BATALHA_MAX_TROPAS + 1) + d];
+            if (!custoConquista(a, d, &peso->custo, &peso->sobra)) peso->custo = INFINITY;
+        }
+    }
+    planejador->capacidade = numTerritorios;
+    return 0;
+}
+
+/**
+ * @brief Função para devolver a memória do planejador
+ * @param planejador Planejador criado por criarPlanejador
+ */
+void liberarPlanejador(struct Planejador *planejador) {
+    devolverArena(planejador->arena);
+    memset(planejador, 0, sizeof(*planejador));
+}
+
+/**
+ * @brief Função para descartar o plano memorizado
+ * @note Só é necessária se a partida mudar sem passar por tropas ou dono
+ *       (o planejador confere os dois sozinho).
+ */
+void esquecerPlano(struct Planejador *planejador) {
+    planejador->valido = 0;
+}
+
+/**
+ * @brief Inicializa um território na busca atual e anota o que foi lido dele.
+ */
+static inline void tocarTerritorio(struct Planejador *planejador, const struct Jogo *jogo, int t) {
+    if (planejador->marca[t] == planejador->geracao) return;
+    planejador->marca[t] = planejador->geracao;
+    planejador->custo[t] = INFINITY;
+    planejador->posicaoHeap[t] = HEAP_FORA;
+
+    int i = planejador->numDependencias++;
+    planejador->dependencias[i] = t;
+    planejador->tropasVistas[i] = jogo->tropas[t];
+    planejador->donoVisto[i] = jogo->dono[t];
+}
+
+/**
+ * @brief Sobe a entrada da posição i do heap até o lugar do seu custo.
+ */
+static void subirHeap(struct Planejador *planejador, int i, struct EntradaHeap entrada) {
+    struct EntradaHeap *heap = planejador->heap;
+    int32_t *posicao = planejador->posicaoHeap;
+
+    while (i > 0) {
+        int pai = (i - 1) / 2;
+        if (heap[pai].custo <= entrada.custo) break;
+        heap[i] = heap[pai];
+        posicao[heap[i].territorio] = i;
+        i = pai;
+    }
+    heap[i] = entrada;
+    posicao[entrada.territorio] = i;
+}
+
+/**
+ * @brief Retira do heap o território de menor custo e o marca como fechado.
+ */
+static int retirarHeap(struct Planejador *planejador, int *tamanho) {
+    struct EntradaHeap *heap = planejador->heap;
+    int32_t *posicao = planejador->posicaoHeap;
+    int topo = heap[0].territorio;
+    struct EntradaHeap ultima = heap[--*tamanho];
+    int i = 0;
+
+    // Desce a última entrada a partir da raiz
+    for (;;) {
+        int filho = 2 * i + 1;
+        if (filho >= *tamanho) break;
+        if (filho + 1 < *tamanho && heap[filho + 1].custo < heap[filho].custo) filho++;
+        if (ultima.custo <= heap[filho].custo) break;
+        heap[i] = heap[filho];
+        posicao[heap[i].territorio] = i;
+        i = filho;
+    }
+    if (*tamanho > 0) {
+        heap[i] = ultima;
+        posicao[ultima.territorio] = i;
+    }
+    posicao[topo] = HEAP_FECHADO;
+    return topo;
+}
+
+/**
+ * @brief Calcula o peso de um ataque e as tropas que sobram ao conquistar.
+ * @note Acima de BATALHA_MAX_TROPAS as forças são reduzidas na mesma
+ *       proporção até caber na tabela, e a sobra volta à escala original.
+ * @param exercito Tropas esperadas no território atacante
+ * @param tropasDefesa Tropas do território atacado
+ * @param custo Recebe -log da chance de conquista
+ * @param sobra Recebe as tropas esperadas do atacante após conquistar
+ * @return 1 se o ataque é possível, 0 caso contrário
+ */
+static inline int pesoAtaque(const struct Planejador *planejador, float exercito, int tropasDefesa,
+                             float *custo, float *sobra) {
+    int a = (int) (exercito + 0.5f);
+    int d = (tropasDefesa < 1) ? 1 : tropasDefesa;
+    float escala = 1.0f;
+    if (a < 2) return 0;
+    if (a > BATALHA_MAX_TROPAS || d > BATALHA_MAX_TROPAS) {
+        escala = (float) BATALHA_MAX_TROPAS / (float) ((a > d) ? a : d);
+        a = (int) (a * escala + 0.5f);
+        d = (int) (d * escala + 0.5f);
+        if (a < 2) a = 2;
+        if (d < 1) d = 1;
+    }
+
+    const struct PesoConquista *peso = &planejador->pesos[a * (BATALHA_MAX_TROPAS + 1) + d];
+    if (peso->custo == INFINITY) return 0;
+    *custo = peso->custo;
+    *sobra = peso->sobra / escala;
+    return 1;
+}
+
+/**
+ * @brief Confere se o plano memorizado ainda vale para a partida.
+ * @note Custa uma comparação por território lido pela busca que o gerou.
+ */
+static int planoMemorizadoValido(const struct Planejador *planejador, const struct Jogo *jogo,
+                                 int cor, int missao, int alvo, int conquistas) {
+    if (!planejador->valido || planejador->mapaMemo != jogo->mapa || planejador->corMemo != cor
+        || planejador->missaoMemo != missao || planejador->alvoMemo != alvo
+        || planejador->conquistasMemo != conquistas) return 0;
+
+    const int32_t *tropas = jogo->tropas;
+    const int8_t *dono = jogo->dono;
+    for (int i = 0; i < planejador->numDependencias; i++) {
+        int t = planejador->dependencias[i];
+        if (tropas[t] != planejador->tropasVistas[i] || dono[t] != planejador->donoVisto[i]) return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Monta o plano percorrendo os ataques de trás para a frente a partir do fim.
+ */
+static void montarPlano(struct Planejador *planejador, int fim, int completo) {
+    struct Plano *plano = &planejador->plano;
+    plano->numPassos = 0;
+    plano->completo = 0;
+    plano->chance = 0.0;
+    if (fim < 0) return;
+
+    int n = planejador->saltos[fim];
+    plano->numPassos = n;
+    plano->completo = completo;
+    plano->chance = exp(-(double) planejador->custo[fim]);
+    for (int t = fim, i = n - 1; i >= 0; t = planejador->anterior[t], i--) {
+        int origem = planejador->anterior[t];
+        plano->passos[i].ataque = origem;
+        plano->passos[i].defesa = t;
+        plano->passos[i].chance = expf(planejador->custo[origem] - planejador->custo[t]);
+        plano->passos[i].tropas = planejador->exercito[origem];
+    }
+}
+
+/**
+ * @brief Informa se a conquista do território cumpre o alvo da busca.
+ */
+static inline int atingeAlvo(const struct Planejador *planejador, const struct Jogo *jogo,
+                             const struct Busca *busca, int t) {
+    return (busca->alvo != SEM_COR) ? jogo->dono[t] == busca->alvo : planejador->saltos[t] >= busca->faltam;
+}
+
+/**
+ * @brief Relaxa os ataques a partir de um território já fechado.
+ * @note Territórios cujo custo já passa do melhor alvo encontrado não entram
+ *       no heap: com pesos não negativos, nada depois deles pode ser melhor.
+ */
+static void expandirTerritorio(struct Planejador *planejador, const struct Jogo *jogo, struct Busca *busca, int u) {
+    const struct Mapa *mapa = jogo->mapa;
+    const int32_t *tropas = jogo->tropas;
+    const int8_t *dono = jogo->dono;
+    float *custo = planejador->custo;
+    int32_t *posicao = planejador->posicaoHeap;
+    float exercito = planejador->exercito[u];
+    if (exercito < 2.0f || planejador->saltos[u] >= PLANO_MAX_PASSOS) return;
+
+    for (int k = mapa->inicioVizinhos[u]; k < mapa->inicioVizinhos[u + 1]; k++) {
+        int v = mapa->vizinhos[k];
+        tocarTerritorio(planejador, jogo, v);
+        if (dono[v] == busca->cor || posicao[v] == HEAP_FECHADO) continue;
+
+        float peso, sobra;
+        if (!pesoAtaque(planejador, exercito, tropas[v], &peso, &sobra)) continue;
+        float novo = custo[u] + peso;
+        if (novo >= custo[v] || novo >= busca->limite) continue;
+
+        custo[v] = novo;
+        planejador->exercito[v] = sobra - 1.0f; // Uma tropa fica para trás
+        planejador->saltos[v] = planejador->saltos[u] + 1;
+        planejador->anterior[v] = u;
+        if (atingeAlvo(planejador, jogo, busca, v)) busca->limite = novo;
+
+        struct EntradaHeap entrada = {novo, v};
+        subirHeap(planejador, (posicao[v] == HEAP_FORA) ? busca->tamanho++ : posicao[v], entrada);
+    }
+}
+
+/**
+ * @brief Função para obter a sequência de conquistas mais provável até o alvo da missão
+ * @note Devolve o plano memorizado se nenhum território lido pela busca
+ *       anterior mudou; senão refaz a busca. Se nenhuma sequência atinge o
+ *       alvo, devolve a mais longa encontrada, com completo = 0.
+ * @param planejador Planejador criado para mapas do tamanho da partida
+ * @param jogo Partida em andamento
+ * @param indiceJogador Jogador que vai atacar
+ * @return Plano (válido até a próxima consulta), ou NULL se o mapa não cabe no planejador
+ */
+const struct Plano *planejarAtaque(struct Planejador *planejador, const struct Jogo *jogo, int indiceJogador) {
+    if (jogo->numTerritorios > planejador->capacidade || indiceJogador < 0 || indiceJogador >= jogo->numJogadores) return NULL;
+    planejador->consultas++;
+
+    const struct Jogador *jogador = &jogo->jogadores[indiceJogador];
+    const struct Missao *missao = &Missoes[jogador->missao];
+    int cor = jogador->cor;
+    // Alvo: a cor a destruir (se ainda tem territórios) ou as conquistas que faltam
+    int alvo = (missao->cor != SEM_COR && jogo->territoriosCor[missao->cor] > 0) ? missao->cor : SEM_COR;
+    int faltam = missao->territorios - jogador->conquistas;
+    int alcancavel = faltam <= PLANO_MAX_PASSOS; // O plano pode cumprir a missão de territórios
+    if (!alcancavel) faltam = PLANO_MAX_PASSOS;
+
+    if (planoMemorizadoValido(planejador, jogo, cor, jogador->missao, alvo, jogador->conquistas)) {
+        planejador->reaproveitadas++;
+        return &planejador->plano;
+    }
+
+    // Nova geração: os territórios são inicializados quando a busca os alcança
+    if (++planejador->geracao == 0) {
+        memset(planejador->marca, 0, (size_t) planejador->capacidade * sizeof(uint32_t));
+        planejador->geracao = 1;
+    }
+    planejador->valido = 1;
+    planejador->mapaMemo = jogo->mapa;
+    planejador->corMemo = cor;
+    planejador->missaoMemo = jogador->missao;
+    planejador->alvoMemo = alvo;
+    planejador->conquistasMemo = jogador->conquistas;
+    planejador->numDependencias = 0;
+
+    int semAlvo = jogador->missaoCumprida || (missao->cor != SEM_COR ? alvo == SEM_COR : faltam <= 0);
+    if (semAlvo) {
+        montarPlano(planejador, -1, 0);
+        return &planejador->plano;
+    }
+
+    struct Busca busca = {cor, alvo, faltam, 0, INFINITY};
+
+    // Origens: os territórios do jogador que podem atacar saem com custo 0
+    // e são expandidos direto, sem passar pelo heap
+    const int32_t *tropas = jogo->tropas;
+    const uint64_t *conjunto = jogo->posse + (long) cor * jogo->palavrasPosse;
+    for (int w = 0; w < jogo->palavrasPosse; w++) {
+        for (uint64_t bits = conjunto[w]; bits; bits &= bits - 1) {
+            int t = w * 64 + __builtin_ctzll(bits);
+            tocarTerritorio(planejador, jogo, t);
+            planejador->posicaoHeap[t] = HEAP_FECHADO;
+            if (tropas[t] < 2) continue;
+            planejador->custo[t] = 0.0f;
+            planejador->exercito[t] = (float) tropas[t];
+            planejador->saltos[t] = 0;
+            planejador->anterior[t] = -1;
+            expandirTerritorio(planejador, jogo, &busca, t);
+        }
+    }
+
+    int fim = -1;
+    int maisLongo = -1; // Fim da sequência mais longa, se o alvo não for alcançado
+    while (busca.tamanho > 0) {
+        int u = retirarHeap(planejador, &busca.tamanho);
+        if (atingeAlvo(planejador, jogo, &busca, u)) {
+            fim = u;
+            break;
+        }
+        if (maisLongo < 0 || planejador->saltos[u] > planejador->saltos[maisLongo]) maisLongo = u;
+        expandirTerritorio(planejador, jogo, &busca, u);
+    }
+
+    montarPlano(planejador, (fim >= 0) ? fim : maisLongo, fim >= 0 && (alvo != SEM_COR || alcancavel));
+    return &planejador->plano;
+}
@@ -0,0 +1,103 @@
+/**
+ * @file planejador.h
+ * @brief Planejador de ataques: a sequência de conquistas mais provável até o alvo da missão.
+ *
+ * O mapa vira um grafo em que cada fronteira com um território inimigo é uma
+ * aresta de peso -log P(conquista), com P tirada da tabela de batalhas
+ * (batalha.h) para as tropas atuais. Somar pesos equivale a multiplicar
+ * chances, então o caminho mais curto (Dijkstra, com heap binário indexado)
+ * é a sequência de conquistas mais provável. A busca parte de todos os
+ * territórios do jogador com pelo menos 2 tropas e para no primeiro
+ * território que atinge o alvo da missão:
+ * - destruir uma cor: qualquer território da cor;
+ * - conquistar N territórios: o primeiro território fechado a tantas conquistas
+ *   quantas faltam para N (limitado a PLANO_MAX_PASSOS).
+ *
+ * O exército avança junto: quem conquista fica com as tropas esperadas de
+ * uma vitória e move todas menos uma para o território tomado, que ataca o
+ * próximo. Forças acima da tabela são reduzidas na mesma proporção até caber.
+ *
+ * O plano fica memorizado junto com as tropas e os donos de cada território
+ * que a busca leu (os do jogador e os que ela alcançou). A próxima consulta
+ * só compara esses territórios: se nenhum deles mudou (nem as conquistas do
+ * jogador, que revelam conquistas fora da região lida), o
+ * plano é devolvido sem nova busca. Mudanças longe da região explorada não
+ * invalidam o plano. Cada busca marca os territórios com um número de
+ * geração, sem limpar os vetores.
+ */
+#ifndef PLANEJADOR_H
+#define PLANEJADOR_H
+
+#include <stdint.h>
+
+#include "jogo.h"
+#include "batalha.h"
+
+#define PLANO_MAX_PASSOS 16 // Conquistas de um plano (a busca não avança além delas)
+
+// Um ataque do plano
+struct PassoPlano {
+    int ataque;   // Território atacante
+    int defesa;   // Território atacado
+    float chance; // Chance de conquista com o exército esperado
+    float tropas; // Tropas esperadas no território atacante ao atacar
+};
+
+// Sequência de conquistas sugerida a um jogador
+struct Plano {
+    int numPassos;    // 0 se não há ataque possível ou a missão já está cumprida
+    int completo;     // 1 se a sequência atinge o alvo da missão
+    double chance;    // Chance de todas as conquistas darem certo
+    struct PassoPlano passos[PLANO_MAX_PASSOS];
+};
+
+// Peso de um ataque na tabela do planejador (custo infinito se impossível)
+struct PesoConquista {
+    float custo; // -log da chance de conquista
+    float sobra; // Tropas esperadas do atacante após conquistar
+};
+
+// Entrada do heap da busca (o custo fica junto para não seguir o índice)
+struct EntradaHeap {
+    float custo;
+    int32_t territorio;
+};
+
+// Espaço de trabalho da busca e plano memorizado (um por thread)
+struct Planejador {
+    struct Arena *arena;     // Arena de onde saem os vetores abaixo (ver arena.h)
+    int capacidade;          // Territórios cobertos pelos vetores
+    struct PesoConquista *pesos; // Peso de cada par (a, d) até BATALHA_MAX_TROPAS, índice a * (BATALHA_MAX_TROPAS + 1) + d
+    float *custo;            // -log da chance acumulada até cada território
+    float *exercito;         // Tropas esperadas em cada território ao atacar a partir dele
+    int32_t *anterior;       // Território de onde veio o ataque (-1 nas origens)
+    int32_t *saltos;         // Conquistas até cada território
+    struct EntradaHeap *heap; // Heap binário de territórios ordenado por custo
+    int32_t *posicaoHeap;    // Posição de cada território no heap (-1 fechado, -2 fora do heap)
+    uint32_t *marca;         // Geração da busca que inicializou cada território
+    uint32_t geracao;        // Geração da busca atual
+
+    // Plano memorizado e o que ele leu da partida
+    int valido;                  // 1 se há um plano memorizado
+    const struct Mapa *mapaMemo; // Chave do plano: mapa, cor, missão e contagens
+    int corMemo;
+    int missaoMemo;
+    int conquistasMemo;
+    int alvoMemo;
+    int numDependencias;         // Territórios lidos pela busca
+    int32_t *dependencias;
+    int32_t *tropasVistas;       // Tropas de cada território lido
+    int8_t *donoVisto;           // Dono de cada território lido
+    struct Plano plano;
+
+    long consultas;     // Chamadas a planejarAtaque
+    long reaproveitadas; // Consultas respondidas pelo plano memorizado
+};
+
+// --- Protótipos das Funções ---
+int criarPlanejador(struct Planejador *planejador, int numTerritorios); // Função para preparar o planejador para mapas de até numTerritorios (retorna 0 em caso de sucesso)
+void liberarPlanejador(struct Planejador *planejador);                  // Função para devolver a memória do planejador
+void esquecerPlano(struct Planejador *planejador);                      // Função para descartar o plano memorizado
+const struct Plano *planejarAtaque(struct Planejador *planejador, const struct Jogo *jogo, int indiceJogador); // Função para obter a sequência de conquistas mais provável (NULL se o mapa não cabe)
+
+#endif // PLANEJADOR_H
@@ -0,0 +1,61 @@
+/**
+ * @file rng.c
+ * @brief Semeadura e sorteio em lote do gerador xoshiro256**.
+ */
+
+#include "rng.h"
+
+/**
+ * @brief Passo do gerador splitmix64, usado apenas para espalhar a semente.
+ */
+static uint64_t splitmix64(uint64_t *estado) {
+    uint64_t z = (*estado += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * @brief Inicia o gerador a partir de uma semente de 64 bits.
+ * @note Sementes iguais produzem sempre a mesma sequência.
+ * @param rng Gerador a iniciar
+ * @param semente Semente (qualquer valor, inclusive 0)
+ */
+void rngSemear(struct Rng *rng, uint64_t semente) {
+    uint64_t estado = semente;
+    for (int i = 0; i < 4; i++) rng->s[i] = splitmix64(&estado);
+}
+
+/**
+ * @brief Inicia um fluxo independente derivado de uma semente.
+ * @note Usado para dar a cada partida/thread a sua própria sequência: a
+ *       partida p de um lote com semente S é sempre a mesma, qualquer que
+ *       seja a ordem (ou a thread) em que for jogada.
+ * @param rng Gerador a iniciar
+ * @param semente Semente do lote
+ * @param fluxo Identificador do fluxo (índice da partida, da thread...)
+ */
+void rngSemearFluxo(struct Rng *rng, uint64_t semente, uint64_t fluxo) {
+    uint64_t estado = semente;
+    uint64_t mistura = splitmix64(&estado) ^ (fluxo * 0xd1342543de82ef95ULL);
+    rngSemear(rng, mistura);
+}
+
+/**
+ * @brief Sorteia n dados de 6 faces aproveitando os 8 bytes de cada número de 64 bits.
+ * @note Cada byte abaixo de 252 (múltiplo de 6) vira um dado; os bytes 252 a 255
+ *       são descartados, o que mantém a distribuição uniforme.
+ * @param rng Gerador
+ * @param dados Recebe os dados (1 a 6)
+ * @param n Número de dados a sortear
+ */
+void rngDados(struct Rng *rng, int *dados, int n) {
+    int i = 0;
+    while (i < n) {
+        uint64_t bits = rngProximo(rng);
+        for (int b = 0; b < 8 && i < n; b++, bits >>= 8) {
+            unsigned int byte = (unsigned int) (bits & 0xff);
+            if (byte < 252) dados[i++] = (int) (byte % 6) + 1;
+        }
+    }
+}
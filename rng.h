@@ -0,0 +1,76 @@
+/**
+ * @file rng.h
+ * @brief Gerador de números aleatórios com estado explícito (xoshiro256**).
+ *
+ * Substitui rand()/srand(): cada partida (ou thread) carrega o seu próprio
+ * struct Rng, de modo que partidas diferentes não disputam um estado global
+ * e qualquer partida pode ser repetida a partir da semente. Os sorteios em
+ * intervalos usam o método de Lemire, sem o viés de rand() % n.
+ */
+#ifndef RNG_H
+#define RNG_H
+
+#include <stdint.h>
+
+// Estado do gerador xoshiro256** (período 2^256 - 1)
+struct Rng {
+    uint64_t s[4];
+};
+
+// --- Protótipos das Funções ---
+void rngSemear(struct Rng *rng, uint64_t semente);                      // Função para iniciar o gerador a partir de uma semente
+void rngSemearFluxo(struct Rng *rng, uint64_t semente, uint64_t fluxo); // Função para iniciar um fluxo independente (partida, thread...)
+void rngDados(struct Rng *rng, int *dados, int n);                      // Função para sortear n dados (1 a 6) de uma vez
+
+/**
+ * @brief Sorteia o próximo número de 64 bits (xoshiro256**).
+ */
+static inline uint64_t rngProximo(struct Rng *rng) {
+    uint64_t *s = rng->s;
+    uint64_t x = s[1] * 5;
+    uint64_t resultado = ((x << 7) | (x >> 57)) * 9;
+    uint64_t t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = (s[3] << 45) | (s[3] >> 19);
+
+    return resultado;
+}
+
+/**
+ * @brief Sorteia um inteiro uniforme em [0, n) sem viés (método de Lemire).
+ * @param n Tamanho do intervalo (maior que zero)
+ */
+static inline uint32_t rngLimitado(struct Rng *rng, uint32_t n) {
+    uint64_t m = (rngProximo(rng) >> 32) * (uint64_t) n;
+    uint32_t resto = (uint32_t) m;
+    if (resto < n) {
+        // Rejeita a pequena faixa que causaria viés
+        uint32_t limite = (uint32_t) -n % n;
+        while (resto < limite) {
+            m = (rngProximo(rng) >> 32) * (uint64_t) n;
+            resto = (uint32_t) m;
+        }
+    }
+    return (uint32_t) (m >> 32);
+}
+
+/**
+ * @brief Sorteia um real uniforme em [0, 1) com 53 bits de precisão.
+ */
+static inline double rngUniforme(struct Rng *rng) {
+    return (rngProximo(rng) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/**
+ * @brief Sorteia um dado de 6 faces (1 a 6).
+ */
+static inline int rngDado(struct Rng *rng) {
+    return (int) rngLimitado(rng, 6) + 1;
+}
+
+#endif // RNG_H
@@ -0,0 +1,442 @@
+/**
+ * @file roteiro.c
+ * @brief Implementação das partidas conduzidas por roteiro.
+ * @note As decisões que atacar() pede à política (dados, continuar, tropas a
+ *       mover) vêm do comando em execução, guardado em jogo->contexto.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "roteiro.h"
+#include "jogo.h"
+#include "simulacao.h"
+#include "tela.h"
+#include "estado.h"
+#include "historico.h"
+#include "eventos.h"
+#include "vista.h"
+
+// Separadores das palavras de uma linha do roteiro
+#define ROTEIRO_SEPARADORES " \t\r\n"
+
+// Leitor de linhas sobre blocos lidos com fread
+struct LeitorBlocos {
+    FILE *arquivo;                  // Roteiro aberto
+    char bloco[ROTEIRO_TAM_BLOCO];  // Último bloco lido
+    size_t inicio;                  // Início da próxima linha dentro do bloco
+    size_t fim;                     // Bytes válidos no bloco
+    int terminou;                   // 1 depois que fread chegou ao fim do arquivo
+    char pendente[ROTEIRO_TAM_LINHA]; // Comando lido antecipadamente e devolvido
+    int temPendente;                // 1 se há um comando pendente
+};
+
+/**
+ * @brief Imprime um erro do roteiro indicando a linha.
+ */
+static void erroRoteiro(const char *caminho, long numLinha, const char *mensagem, const char *palavra) {
+    printf("Erro no roteiro %s, linha %ld: %s%s%s\n", caminho, numLinha, mensagem,
+           palavra ? ": " : "", palavra ? palavra : "");
+}
+
+/**
+ * @brief Lê a próxima linha do roteiro, sem o '\n'.
+ * @note Só chama fread quando a linha não está inteira no bloco atual; a
+ *       parte já lida é movida para o início do bloco antes de completá-lo.
+ * @param leitor Leitor do roteiro
+ * @param linha Recebe a linha
+ * @param tamanho Tamanho de linha (ROTEIRO_TAM_LINHA)
+ * @return 1 se leu uma linha, 0 no fim do arquivo, -1 se a linha é longa demais
+ */
+static int lerLinha(struct LeitorBlocos *leitor, char *linha, size_t tamanho) {
+    for (;;) {
+        char *inicio = leitor->bloco + leitor->inicio;
+        size_t disponivel = leitor->fim - leitor->inicio;
+        char *quebra = (char *) memchr(inicio, '\n', disponivel);
+
+        // Linha inteira no bloco, ou a última linha do arquivo (sem '\n')
+        if (quebra != NULL || (leitor->terminou && disponivel > 0)) {
+            size_t n = quebra ? (size_t) (quebra - inicio) : disponivel;
+            if (n >= tamanho) return -1;
+            memcpy(linha, inicio, n);
+            linha[n] = '\0';
+            leitor->inicio += n + (quebra != NULL);
+            return 1;
+        }
+        if (leitor->terminou) return 0;
+        if (disponivel >= tamanho) return -1;
+
+        // Move o pedaço de linha para o início e completa o bloco
+        memmove(leitor->bloco, inicio, disponivel);
+        leitor->inicio = 0;
+        leitor->fim = disponivel;
+        size_t lidos = fread(leitor->bloco + leitor->fim, 1, sizeof(leitor->bloco) - leitor->fim, leitor->arquivo);
+        leitor->fim += lidos;
+        if (lidos == 0) leitor->terminou = 1;
+    }
+}
+
+/**
+ * @brief Lê o próximo comando do roteiro, pulando linhas vazias e comentários.
+ * @param leitor Leitor do roteiro
+ * @param linha Recebe o comando (ROTEIRO_TAM_LINHA posições)
+ * @param numLinha Número da última linha lida (atualizado)
+ * @return 1 se leu um comando, 0 no fim do arquivo, -1 se a linha é longa demais
+ */
+static int proximoComando(struct LeitorBlocos *leitor, char *linha, long *numLinha) {
+    if (leitor->temPendente) {
+        memcpy(linha, leitor->pendente, ROTEIRO_TAM_LINHA);
+        leitor->temPendente = 0;
+        return 1;
+    }
+
+    int lido;
+    while ((lido = lerLinha(leitor, linha, ROTEIRO_TAM_LINHA)) > 0) {
+        (*numLinha)++;
+        char *comentario = strchr(linha, '#');
+        if (comentario) *comentario = '\0';
+        if (linha[strspn(linha, ROTEIRO_SEPARADORES)] != '\0') return 1;
+    }
+    if (lido < 0) (*numLinha)++;
+    return lido;
+}
+
+/**
+ * @brief Converte uma palavra em inteiro dentro de [minimo, maximo].
+ * @return 1 se a palavra é um inteiro válido no intervalo, 0 caso contrário
+ */
+static int lerNumero(const char *palavra, long minimo, long maximo, int *valor) {
+    if (palavra == NULL) return 0;
+    char *fim;
+    long lido = strtol(palavra, &fim, 10);
+    if (fim == palavra || *fim != '\0' || lido < minimo || lido > maximo) return 0;
+    *valor = (int) lido;
+    return 1;
+}
+
+/**
+ * @brief Limita um pedido do roteiro a [1, maximo].
+ */
+static int limitar(int pedido, int maximo) {
+    if (pedido < 1) return 1;
+    return pedido > maximo ? maximo : pedido;
+}
+
+// --- Política do roteiro ---
+// atacar() repete as perguntas até receber um valor válido; o roteiro nunca
+// responde fora do intervalo, então o pedido é limitado aqui.
+
+static int roteiroEscolherAtaque(struct Jogo *jogo, struct Jogador *jogador, int *ataque, int *defesa) {
+    (void) jogo; (void) jogador; (void) ataque; (void) defesa;
+    return 0; // Os ataques vêm dos comandos, não da política
+}
+
+static int roteiroDadosAtaque(struct Jogo *jogo, int ataque, int defesa, int maxDados) {
+    (void) ataque; (void) defesa;
+    return limitar(((const struct ComandoAtaque *) jogo->contexto)->dadosAtaque, maxDados);
+}
+
+static int roteiroDadosDefesa(struct Jogo *jogo, int ataque, int defesa, int maxDados) {
+    (void) ataque; (void) defesa;
+    int pedido = ((const struct ComandoAtaque *) jogo->contexto)->dadosDefesa;
+    return pedido == 0 ? maxDados : limitar(pedido, maxDados);
+}
+
+static int roteiroContinuar(struct Jogo *jogo, int ataque, int defesa) {
+    (void) ataque; (void) defesa;
+    struct ComandoAtaque *comando = (struct ComandoAtaque *) jogo->contexto;
+    return comando->rodadas == 0 || ++comando->rodadasFeitas < comando->rodadas;
+}
+
+static int roteiroTropasMover(struct Jogo *jogo, int ataque, int defesa, int maxTropas) {
+    (void) ataque; (void) defesa;
+    return limitar(((const struct ComandoAtaque *) jogo->contexto)->tropasMover, maxTropas);
+}
+
+const struct Politica politicaRoteiro = {
+    "roteiro", 0, roteiroEscolherAtaque, roteiroDadosAtaque, roteiroDadosDefesa, roteiroContinuar, roteiroTropasMover
+};
+
+/**
+ * @brief Olha o comando seguinte a um 'ataque': se for 'mover', ele é
+ *        consumido; senão, fica pendente para a próxima leitura.
+ * @note atacar() pergunta as tropas a mover no meio da batalha, por isso o
+ *       valor precisa ser conhecido antes de o ataque começar.
+ * @param tropasMover Recebe as tropas do 'mover' (0 se não houver; a política move 1)
+ * @return 0 em caso de sucesso, 1 em caso de erro (a mensagem já foi impressa)
+ */
+static int lerMover(struct LeitorBlocos *leitor, const char *caminho, long *numLinha, int *tropasMover) {
+    char seguinte[ROTEIRO_TAM_LINHA];
+    *tropasMover = 0;
+    int lido = proximoComando(leitor, seguinte, numLinha);
+    if (lido < 0) {
+        erroRoteiro(caminho, *numLinha, "linha longa demais", NULL);
+        return 1;
+    }
+    if (lido == 0) return 0;
+
+    memcpy(leitor->pendente, seguinte, ROTEIRO_TAM_LINHA);
+    char *resto;
+    char *nome = strtok_r(seguinte, ROTEIRO_SEPARADORES, &resto);
+    if (strcmp(nome, "mover") != 0) {
+        leitor->temPendente = 1;
+        return 0;
+    }
+    if (!lerNumero(strtok_r(NULL, ROTEIRO_SEPARADORES, &resto), 1, 1000000, tropasMover)) {
+        erroRoteiro(caminho, *numLinha, "uso: mover TROPAS", NULL);
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Soma de verificação do estado da partida (tropas e donos, FNV-1a).
+ * @note Duas execuções do mesmo roteiro com a mesma semente devem terminar
+ *       com a mesma soma; uma mudança em atacar() que altere o resultado não.
+ */
+static uint64_t somaEstado(const struct Jogo *jogo) {
+    uint64_t hash = 1469598103934665603ULL;
+    for (int t = 0; t < jogo->numTerritorios; t++) {
+        uint32_t valor = (uint32_t) jogo->tropas[t] * 8u + (uint32_t) (jogo->dono[t] + 1);
+        for (int b = 0; b < 4; b++) {
+            hash ^= (valor >> (8 * b)) & 0xFF;
+            hash *= 1099511628211ULL;
+        }
+    }
+    return hash;
+}
+
+/**
+ * @brief Função para jogar uma partida a partir de um roteiro
+ * @note A partida termina no fim do roteiro ou quando alguém cumpre a missão
+ *       (os comandos seguintes são ignorados). O relatório traz o vencedor,
+ *       os contadores, comandos/s e a soma de verificação do estado final.
+ * @param mapa Mapa da partida
+ * @param caminho Arquivo do roteiro ou "-" para a entrada padrão
+ * @param semente Semente usada se o roteiro não tiver o comando 'semente'
+ * @param verboso 1 - narra as batalhas e desenha o mapa no comando 'mapa'
+ * @return 0 em caso de sucesso, 1 em caso de erro (a mensagem já foi impressa)
+ */
+int executarRoteiro(const struct Mapa *mapa, const char *caminho, uint64_t semente, int verboso) {
+    struct LeitorBlocos *leitor = (struct LeitorBlocos *) calloc(1, sizeof(struct LeitorBlocos));
+    struct Jogo jogo = {0};
+    struct Tela tela;
+    if (leitor == NULL || alocarJogo(&jogo, mapa) != 0 || criarTela(&tela, mapa->numTerritorios) != 0) {
+        printf("Erro na alocação de memória para o roteiro.\n");
+        free(leitor);
+        liberarJogo(&jogo);
+        return 1;
+    }
+    leitor->arquivo = strcmp(caminho, "-") == 0 ? stdin : fopen(caminho, "r");
+    if (leitor->arquivo == NULL) {
+        printf("Erro ao abrir o roteiro %s.\n", caminho);
+        free(leitor);
+        liberarJogo(&jogo);
+        liberarTela(&tela);
+        return 1;
+    }
+
+    struct ComandoAtaque comando = {0};
+    struct Historico historico = {0}; // Versões do turno, criadas no primeiro ataque (jogadores já cadastrados)
+    struct VistaMapa vistas = {0};    // Visões do mapa, criadas na primeira consulta e mantidas a cada escrita
+    jogo.contexto = &comando;
+    jogo.verboso = verboso;
+    jogo.diario = diarioAberto();
+    rngSemear(&jogo.rng, semente);
+    diarioPartida(&jogo, 0);
+
+    char linha[ROTEIRO_TAM_LINHA];
+    long numLinha = 0;
+    long comandos = 0, ataques = 0, conquistas = 0, turnos = 0;
+    int indiceJogador = 0;
+    int erro = 0;
+    int lido;
+
+    double inicio = relogioSegundos();
+    while (!erro && jogo.vencedor < 0 && (lido = proximoComando(leitor, linha, &numLinha)) != 0) {
+        if (lido < 0) {
+            erroRoteiro(caminho, numLinha, "linha longa demais", NULL);
+            erro = 1;
+            break;
+        }
+
+        char *resto;
+        char *nome = strtok_r(linha, ROTEIRO_SEPARADORES, &resto);
+        comandos++;
+
+        if (strcmp(nome, "semente") == 0) {
+            char *valor = strtok_r(NULL, ROTEIRO_SEPARADORES, &resto);
+            if (valor == NULL || jogo.numJogadores > 0) {
+                erroRoteiro(caminho, numLinha, "'semente' precisa de um valor e deve vir antes de 'jogadores'", NULL);
+                erro = 1;
+                break;
+            }
+            semente = (uint64_t) strtoull(valor, NULL, 10);
+            rngSemear(&jogo.rng, semente);
+        } else if (strcmp(nome, "carregar") == 0) {
+            char *arquivo = strtok_r(NULL, ROTEIRO_SEPARADORES, &resto);
+            if (arquivo == NULL || jogo.numJogadores > 0) {
+                erroRoteiro(caminho, numLinha, "'carregar' precisa de um arquivo e deve vir antes de 'jogadores'", NULL);
+                erro = 1;
+                break;
+            }
+            // A partida alocada dá lugar à partida mapeada do arquivo
+            liberarJogo(&jogo);
+            if (retomarPartida(&jogo, mapa, arquivo, &indiceJogador) != 0) {
+                erroRoteiro(caminho, numLinha, "não foi possível retomar a partida", arquivo);
+                erro = 1;
+                break;
+            }
+            for (int i = 0; i < jogo.numJogadores; i++) jogo.jogadores[i].politica = &politicaRoteiro;
+            jogo.contexto = &comando;
+            jogo.verboso = verboso;
+            jogo.diario = diarioAberto();
+        } else if (strcmp(nome, "jogadores") == 0) {
+            // Um segundo cadastro sortearia de novo as missões (inclusive as de uma partida carregada)
+            if (jogo.numJogadores > 0) {
+                erroRoteiro(caminho, numLinha, "jogadores já cadastrados", NULL);
+                erro = 1;
+                break;
+            }
+            char *palavra;
+            while ((palavra = strtok_r(NULL, ROTEIRO_SEPARADORES, &resto)) != NULL) {
+                int cor = buscarCorPorNome(palavra);
+                if (cor == SEM_COR || cor >= jogo.numCores || jogo.jogadorDaCor[cor] >= 0 || jogo.numJogadores >= jogo.numCores) {
+                    erroRoteiro(caminho, numLinha, "cor inválida, repetida ou jogadores demais", palavra);
+                    erro = 1;
+                    break;
+                }
+                definirCorJogador(&jogo, jogo.numJogadores, cor);
+                jogo.jogadores[jogo.numJogadores++].politica = &politicaRoteiro;
+            }
+            if (!erro && jogo.numJogadores == 0) {
+                erroRoteiro(caminho, numLinha, "'jogadores' precisa de ao menos uma cor", NULL);
+                erro = 1;
+            }
+            if (!erro) sortearMissoes(&jogo, Missoes, TOTAL_MISSOES);
+        } else if (jogo.numJogadores == 0) {
+            erroRoteiro(caminho, numLinha, "comando antes de 'jogadores'", nome);
+            erro = 1;
+        } else if (strcmp(nome, "distribuir") == 0) {
+            if (mapaDistribuido(&jogo)) {
+                erroRoteiro(caminho, numLinha, "territórios já distribuídos", NULL);
+                erro = 1;
+            } else {
+                distribuirTerritorios(&jogo);
+            }
+        } else if (strcmp(nome, "ataque") == 0) {
+            char *origem = strtok_r(NULL, ROTEIRO_SEPARADORES, &resto);
+            char *destino = strtok_r(NULL, ROTEIRO_SEPARADORES, &resto);
+            char *dados = strtok_r(NULL, ROTEIRO_SEPARADORES, &resto);
+            char *defesa = strtok_r(NULL, ROTEIRO_SEPARADORES, &resto);
+            char *rodadas = strtok_r(NULL, ROTEIRO_SEPARADORES, &resto);
+            int ataque = origem ? buscarTerritorioPorNome(&jogo, origem) : -1;
+            int alvo = destino ? buscarTerritorioPorNome(&jogo, destino) : -1;
+            comando.dadosDefesa = 0;
+            comando.rodadas = 0;
+            if (ataque < 0 || alvo < 0) {
+                erroRoteiro(caminho, numLinha, "território desconhecido", ataque < 0 ? origem : destino);
+                erro = 1;
+            } else if (!lerNumero(dados, 1, 3, &comando.dadosAtaque) ||
+                       (defesa && !lerNumero(defesa, 0, 3, &comando.dadosDefesa)) ||
+                       (rodadas && !lerNumero(rodadas, 0, 1000000, &comando.rodadas))) {
+                erroRoteiro(caminho, numLinha, "uso: ataque ORIGEM DESTINO DADOS [DEFESA [RODADAS]]", NULL);
+                erro = 1;
+            } else if (jogo.dono[ataque] != jogo.jogadores[indiceJogador].cor) {
+                erroRoteiro(caminho, numLinha, "a origem não pertence ao jogador da vez", origem);
+                erro = 1;
+            } else if (historico.jogo == NULL && criarHistorico(&historico, &jogo) != 0) {
+                erroRoteiro(caminho, numLinha, "sem memória para o histórico de versões", NULL);
+                erro = 1;
+            } else if ((erro = lerMover(leitor, caminho, &numLinha, &comando.tropasMover)) == 0) {
+                int donoAnterior = jogo.dono[alvo];
+                comando.rodadasFeitas = 0;
+                atacar(&jogo, ataque, alvo, &jogo.jogadores[indiceJogador]);
+                marcarVersao(&historico);
+                ataques++;
+                if (jogo.dono[alvo] != donoAnterior) conquistas++;
+                if (comando.tropasMover > 0) comandos++;
+            }
+        } else if (strcmp(nome, "mover") == 0) {
+            erroRoteiro(caminho, numLinha, "'mover' deve vir logo depois de um 'ataque'", NULL);
+            erro = 1;
+        } else if (strcmp(nome, "fim") == 0) {
+            indiceJogador = (indiceJogador + 1) % jogo.numJogadores;
+            turnos++;
+            if (historico.jogo != NULL) limparHistorico(&historico); // Só o turno da vez pode ser desfeito
+        } else if (strcmp(nome, "desfazer") == 0) {
+            if (historico.jogo == NULL || desfazerVersao(&historico) != 0) {
+                erroRoteiro(caminho, numLinha, "nenhum ataque a desfazer neste turno", NULL);
+                erro = 1;
+            }
+        } else if (strcmp(nome, "refazer") == 0) {
+            if (historico.jogo == NULL || refazerVersao(&historico) != 0) {
+                erroRoteiro(caminho, numLinha, "nenhum ataque desfeito a refazer", NULL);
+                erro = 1;
+            }
+        } else if (strcmp(nome, "salvar") == 0) {
+            char *arquivo = strtok_r(NULL, ROTEIRO_SEPARADORES, &resto);
+            if (arquivo == NULL || salvarPartida(&jogo, indiceJogador, arquivo) != 0) {
+                erroRoteiro(caminho, numLinha, "não foi possível salvar a partida", arquivo);
+                erro = 1;
+            }
+        } else if (strcmp(nome, "mapa") == 0) {
+            if (verboso) desenharMapa(&tela, &jogo, 1);
+        } else if (strcmp(nome, "vista") == 0) {
+            char *tipo = strtok_r(NULL, ROTEIRO_SEPARADORES, &resto);
+            int vista = tipo ? buscarVistaPorNome(tipo) : -1;
+            char *palavra = strtok_r(NULL, ROTEIRO_SEPARADORES, &resto);
+            int cor = SEM_COR;
+            if (vista == VISTA_COR || vista == VISTA_AMEACADOS) {
+                cor = palavra ? buscarCorPorNome(palavra) : SEM_COR;
+                palavra = strtok_r(NULL, ROTEIRO_SEPARADORES, &resto);
+            }
+            int pagina = 1;
+            if (vista < 0 || (vista != VISTA_TROPAS && (cor == SEM_COR || cor >= jogo.numCores)) ||
+                (palavra && !lerNumero(palavra, 1, 1000000000, &pagina))) {
+                erroRoteiro(caminho, numLinha, "uso: vista tropas|cor COR|ameacados COR [PAGINA]", tipo);
+                erro = 1;
+            } else if (vistas.jogo == NULL && criarVistas(&vistas, &jogo) != 0) {
+                erroRoteiro(caminho, numLinha, "sem memória para as visões do mapa", NULL);
+                erro = 1;
+            } else {
+                mostrarVista(&vistas, vista, cor, pagina);
+            }
+        } else {
+            erroRoteiro(caminho, numLinha, "comando desconhecido", nome);
+            erro = 1;
+        }
+    }
+    double duracao = relogioSegundos() - inicio;
+    diarioRegistrar(&jogo, EVENTO_FIM, 2, (uint64_t) (jogo.vencedor + 1), (uint64_t) turnos);
+    diarioConcluir(&jogo);
+
+    if (!erro) {
+        printf("========================================\n");
+        printf("======    PARTIDA POR ROTEIRO     ======\n");
+        printf("========================================\n");
+        printf("Roteiro         : %s\n", caminho);
+        printf("Semente         : %llu\n", (unsigned long long) semente);
+        printf("Comandos        : %ld (%ld linhas)\n", comandos, numLinha);
+        printf("Ataques         : %ld (%ld conquistas)\n", ataques, conquistas);
+        printf("Turnos          : %ld\n", turnos);
+        printf("Tempo           : %.6f s\n", duracao);
+        printf("Comandos/s      : %.0f\n", duracao > 0 ? comandos / duracao : 0.0);
+        if (jogo.vencedor >= 0) {
+            printf("Vencedor        : jogador %d (%s), missão: %s\n", jogo.vencedor + 1,
+                   nomeCor(jogo.jogadores[jogo.vencedor].cor), Missoes[jogo.jogadores[jogo.vencedor].missao].descricao);
+        } else {
+            printf("Vencedor        : nenhum\n");
+        }
+        printf("Estado final    : %016llx\n", (unsigned long long) somaEstado(&jogo));
+    }
+
+    if (leitor->arquivo != stdin) fclose(leitor->arquivo);
+    free(leitor);
+    liberarHistorico(&historico);
+    liberarVistas(&vistas);
+    liberarJogo(&jogo);
+    liberarTela(&tela);
+    return erro;
+}
@@ -0,0 +1,60 @@
+/**
+ * @file roteiro.h
+ * @brief Partidas conduzidas por um roteiro de comandos (arquivo ou pipe).
+ *
+ * Um roteiro descreve uma partida inteira em comandos curtos, um por linha,
+ * e é executado sobre o mesmo motor do jogo interativo (atacar(), missões e
+ * sorteios). Com a semente gravada no próprio roteiro a partida se repete
+ * exatamente, sem nenhuma pausa de entrada: serve de teste de regressão de
+ * atacar() (o relatório traz uma soma de verificação do estado final) e para
+ * medir o laço real do jogo. O jogo interativo grava roteiros com --record.
+ *
+ * A entrada é lida em blocos de ROTEIRO_TAM_BLOCO bytes com fread e
+ * dividida em linhas dentro do bloco, sem ler um caractere por vez.
+ *
+ * Comandos ('#' inicia um comentário):
+ * @code
+ * semente 42                 # Semente da partida (antes de 'jogadores'; sem ela vale --seed)
+ * carregar partida.est       # Retoma uma partida salva, no lugar de semente/jogadores/distribuir
+ * jogadores Vermelho Azul    # Cores dos jogadores, na ordem de jogo (uma única vez); sorteia as missões
+ * distribuir                 # Sorteia os territórios entre os jogadores
+ * ataque Brasil Peru 3 2 1   # Origem, destino, dados do ataque [, da defesa [, rodadas]]
+ * mover 2                    # Tropas movidas se o ataque anterior conquistou o destino
+ * desfazer                   # Volta ao estado antes do último ataque do turno (ver historico.h)
+ * refazer                    # Refaz o último ataque desfeito, com o mesmo resultado
+ * fim                        # Termina o turno do jogador da vez
+ * mapa                       # Desenha o mapa (só com --verbose)
+ * vista ameacados Azul 2     # Página (padrão 1) de uma visão ordenada: tropas, cor COR ou ameacados COR (ver vista.h)
+ * salvar partida.est         # Salva a partida (ver estado.h)
+ * @endcode
+ * Dados da defesa 0 ou omitidos = o máximo permitido; rodadas 0 ou omitidas =
+ * até a batalha terminar. Os dados pedidos são limitados ao máximo de cada rodada.
+ */
+#ifndef ROTEIRO_H
+#define ROTEIRO_H
+
+#include <stdint.h>
+
+#include "jogo.h"
+#include "mapa.h"
+
+#define ROTEIRO_TAM_BLOCO 65536  // Bytes lidos do roteiro por chamada a fread
+#define ROTEIRO_TAM_LINHA 256    // Tamanho máximo de uma linha do roteiro
+
+// Comando de ataque em execução (as respostas da política do roteiro)
+// A política do roteiro o lê de jogo->contexto; o servidor (servidor.h) a usa da mesma forma.
+struct ComandoAtaque {
+    int dadosAtaque;    // Dados pedidos para o ataque
+    int dadosDefesa;    // Dados pedidos para a defesa (0 = máximo)
+    int rodadas;        // Rodadas pedidas (0 = até o fim)
+    int rodadasFeitas;  // Rodadas já jogadas neste comando
+    int tropasMover;    // Tropas a mover em caso de conquista
+};
+
+// Política que responde a atacar() com o comando de jogo->contexto
+extern const struct Politica politicaRoteiro;
+
+// --- Protótipos das Funções ---
+int executarRoteiro(const struct Mapa *mapa, const char *caminho, uint64_t semente, int verboso); // Função para jogar uma partida a partir de um roteiro ("-" = entrada padrão)
+
+#endif // ROTEIRO_H
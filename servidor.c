@@ -0,0 +1,718 @@
+/**
+ * @file servidor.c
+ * @brief Implementação do servidor de partidas (socket Unix e laços epoll).
+ * @note Os sockets são não bloqueantes e os laços usam epoll por nível: uma
+ *       conexão com respostas pendentes deixa de pedir leitura (EPOLLIN) e
+ *       passa a pedir escrita (EPOLLOUT) até esvaziar a saída, de modo que um
+ *       cliente que não lê as respostas não faz o servidor acumular memória.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <errno.h>
+#include <signal.h>
+#include <time.h>
+#include <pthread.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/stat.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+
+#include "servidor.h"
+#include "jogo.h"
+#include "simulacao.h"
+#include "roteiro.h"
+#include "estado.h"
+#include "torneio.h"
+#include "arena.h"
+#include "batalha.h"
+#include "planejador.h"
+#include "historico.h"
+
+// Separadores das palavras de um comando
+#define SERVIDOR_SEPARADORES " \t\r\n"
+// Caracteres aceitos no nome de uma partida salva
+#define SERVIDOR_CARACTERES_NOME "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789_-"
+
+struct Servidor;
+
+// Uma conexão: a partida e os buffers de entrada e saída
+struct Sessao {
+    int fd;                          // Socket da conexão
+    struct Jogo jogo;                // Partida da conexão (alocada por novaPartida)
+    int indiceJogador;               // Jogador da vez
+    struct ComandoAtaque comando;    // Respostas da política do roteiro no ataque em execução
+    struct Historico historico;      // Versões do turno para desfazer (criadas no primeiro ataque da partida)
+    char entrada[4 * SERVIDOR_TAM_LINHA]; // Bytes recebidos e ainda não executados
+    size_t inicioEntrada;            // Início do próximo comando em entrada
+    size_t usadoEntrada;             // Bytes válidos em entrada
+    char *saida;                     // Respostas ainda não enviadas
+    size_t enviadoSaida;             // Bytes de saida já enviados
+    size_t usadoSaida;               // Bytes válidos em saida
+    size_t capacidadeSaida;          // Tamanho alocado de saida
+    int fimEntrada;                  // 1 depois que o cliente fechou o seu lado
+    int fechar;                      // 1 para fechar assim que a saída esvaziar
+    uint32_t interesse;              // Eventos registrados no epoll (EPOLLIN ou EPOLLOUT)
+    struct Sessao *anterior;         // Lista das sessões do laço
+    struct Sessao *proximo;
+};
+
+// Um laço epoll e as conexões que ele aceitou (só a sua thread as toca)
+struct LacoServidor {
+    struct Servidor *servidor;
+    int epoll;
+    pthread_t thread;
+    struct Sessao *sessoes;          // Conexões abertas
+    long abertas;                    // Conexões abertas agora
+    long maxAbertas;                 // Maior número de conexões abertas ao mesmo tempo
+    long conexoes;                   // Conexões aceitas (lido por 'estatisticas' com cargas atômicas)
+    long partidas;                   // Partidas começadas
+    long comandos;                   // Comandos executados
+    struct Planejador planejador;    // Planejador de ataques do comando 'plano' (capacidade 0 se faltou memória)
+    double segundosCpu;              // Tempo de CPU da thread (no fim)
+};
+
+// Estado compartilhado, só de leitura depois da criação dos laços
+struct Servidor {
+    const struct Mapa *mapa;
+    uint64_t semente;
+    int escuta;                      // Socket de escuta (compartilhado por todos os laços)
+    int desligar;                    // eventfd que acorda todos os laços no fim
+    long proximaConexao;             // Número da próxima conexão (semente da sua primeira partida)
+    int numLacos;
+    struct LacoServidor *lacos;
+};
+
+/**
+ * @brief Monta o caminho da partida salva com o comando 'salvar'.
+ * @note O cliente só escolhe o nome: o arquivo fica sempre em
+ *       SERVIDOR_DIR_SALVAS (criado se preciso), com a extensão
+ *       SERVIDOR_EXTENSAO_SALVA, e nomes com outros caracteres além de
+ *       letras, dígitos, '_' e '-' são recusados.
+ * @param nome Nome dado pelo cliente (NULL se faltou)
+ * @param caminho Recebe o caminho do arquivo
+ * @param tamanho Tamanho de caminho
+ * @return 0 em caso de sucesso, 1 se o nome não é aceito ou o diretório não pôde ser criado
+ */
+static int caminhoPartidaSalva(const char *nome, char *caminho, size_t tamanho) {
+    if (nome == NULL) return 1;
+    size_t comprimento = strlen(nome);
+    if (comprimento == 0 || comprimento > SERVIDOR_MAX_NOME || strspn(nome, SERVIDOR_CARACTERES_NOME) != comprimento) return 1;
+    if (mkdir(SERVIDOR_DIR_SALVAS, 0700) != 0 && errno != EEXIST) return 1;
+    snprintf(caminho, tamanho, "%s/%s%s", SERVIDOR_DIR_SALVAS, nome, SERVIDOR_EXTENSAO_SALVA);
+    return 0;
+}
+
+/**
+ * @brief Acrescenta uma resposta formatada à saída da sessão.
+ * @note Se faltar memória a conexão é fechada.
+ */
+static void responder(struct Sessao *sessao, const char *formato, ...) {
+    for (;;) {
+        size_t livre = sessao->capacidadeSaida - sessao->usadoSaida;
+        va_list argumentos;
+        va_start(argumentos, formato);
+        int n = vsnprintf(sessao->saida + sessao->usadoSaida, livre, formato, argumentos);
+        va_end(argumentos);
+        if (n < 0) return;
+        if ((size_t) n < livre) {
+            sessao->usadoSaida += (size_t) n;
+            return;
+        }
+
+        size_t capacidade = sessao->capacidadeSaida ? sessao->capacidadeSaida : 4096;
+        while (capacidade - sessao->usadoSaida <= (size_t) n) capacidade *= 2;
+        char *saida = (char *) realloc(sessao->saida, capacidade);
+        if (saida == NULL) {
+            sessao->fechar = 1;
+            return;
+        }
+        sessao->saida = saida;
+        sessao->capacidadeSaida = capacidade;
+    }
+}
+
+/**
+ * @brief Começa uma partida nova na sessão, descartando a anterior.
+ * @return 0 em caso de sucesso, 1 se faltou memória
+ */
+static int novaPartida(struct LacoServidor *laco, struct Sessao *sessao, uint64_t semente) {
+    liberarHistorico(&sessao->historico);
+    liberarJogo(&sessao->jogo);
+    memset(&sessao->jogo, 0, sizeof(sessao->jogo));
+    if (alocarJogo(&sessao->jogo, laco->servidor->mapa) != 0) return 1;
+    sessao->jogo.contexto = &sessao->comando;
+    sessao->jogo.verboso = 0;
+    rngSemear(&sessao->jogo.rng, semente);
+    sessao->indiceJogador = 0;
+    __atomic_fetch_add(&laco->partidas, 1, __ATOMIC_RELAXED);
+    return 0;
+}
+
+/**
+ * @brief Converte uma palavra em inteiro dentro de [minimo, maximo].
+ * @return 1 se a palavra é um inteiro válido no intervalo, 0 caso contrário
+ */
+static int lerNumero(const char *palavra, long minimo, long maximo, int *valor) {
+    if (palavra == NULL) return 0;
+    char *fim;
+    long lido = strtol(palavra, &fim, 10);
+    if (fim == palavra || *fim != '\0' || lido < minimo || lido > maximo) return 0;
+    *valor = (int) lido;
+    return 1;
+}
+
+/**
+ * @brief Informa o vencedor, se a partida acabou (linha de dados antes do "ok").
+ */
+static void responderVencedor(struct Sessao *sessao) {
+    const struct Jogo *jogo = &sessao->jogo;
+    if (jogo->vencedor >= 0) {
+        responder(sessao, "vencedor %d %s\n", jogo->vencedor + 1, nomeCor(jogo->jogadores[jogo->vencedor].cor));
+    }
+}
+
+/**
+ * @brief Executa o comando de ataque (opção 1 do menu).
+ */
+static void comandoAtaque(struct Sessao *sessao, char **resto) {
+    struct Jogo *jogo = &sessao->jogo;
+    struct Jogador *jogador = &jogo->jogadores[sessao->indiceJogador];
+    char *origem = strtok_r(NULL, SERVIDOR_SEPARADORES, resto);
+    char *destino = strtok_r(NULL, SERVIDOR_SEPARADORES, resto);
+    char *dados = strtok_r(NULL, SERVIDOR_SEPARADORES, resto);
+    char *defesa = strtok_r(NULL, SERVIDOR_SEPARADORES, resto);
+    char *rodadas = strtok_r(NULL, SERVIDOR_SEPARADORES, resto);
+    char *mover = strtok_r(NULL, SERVIDOR_SEPARADORES, resto);
+    int ataque = origem ? buscarTerritorioPorNome(jogo, origem) : -1;
+    int alvo = destino ? buscarTerritorioPorNome(jogo, destino) : -1;
+    struct ComandoAtaque *comando = &sessao->comando;
+    comando->dadosDefesa = 0;
+    comando->rodadas = 0;
+    comando->rodadasFeitas = 0;
+    comando->tropasMover = 0;
+
+    if (jogo->vencedor >= 0) {
+        responder(sessao, "erro partida encerrada (use nova)\n");
+    } else if (ataque < 0 || alvo < 0) {
+        responder(sessao, "erro território desconhecido: %s\n", ataque < 0 ? (origem ? origem : "") : destino);
+    } else if (!lerNumero(dados, 1, 3, &comando->dadosAtaque) ||
+               (defesa && !lerNumero(defesa, 0, 3, &comando->dadosDefesa)) ||
+               (rodadas && !lerNumero(rodadas, 0, 1000000, &comando->rodadas)) ||
+               (mover && !lerNumero(mover, 0, 1000000, &comando->tropasMover))) {
+        responder(sessao, "erro uso: ataque ORIGEM DESTINO DADOS [DEFESA [RODADAS [MOVER]]]\n");
+    } else if (jogo->dono[ataque] != jogador->cor) {
+        responder(sessao, "erro a origem não pertence ao jogador da vez: %s\n", origem);
+    } else if (jogo->dono[alvo] == jogador->cor) {
+        responder(sessao, "erro não é possível atacar países de mesma cor\n");
+    } else if (!fazFronteira(jogo->mapa, ataque, alvo)) {
+        responder(sessao, "erro %s não faz fronteira com %s\n", origem, destino);
+    } else if (jogo->tropas[ataque] < 2) {
+        responder(sessao, "erro tropas insuficientes para o ataque\n");
+    } else if (sessao->historico.jogo == NULL && criarHistorico(&sessao->historico, jogo) != 0) {
+        responder(sessao, "erro memória insuficiente\n");
+    } else {
+        atacar(jogo, ataque, alvo, jogador);
+        marcarVersao(&sessao->historico);
+        responderVencedor(sessao);
+        responder(sessao, "ok %d %d %s\n", jogo->tropas[ataque], jogo->tropas[alvo], nomeCor(jogo->dono[alvo]));
+    }
+}
+
+/**
+ * @brief Soma os contadores de todos os laços (comando 'estatisticas').
+ */
+static void comandoEstatisticas(struct LacoServidor *laco, struct Sessao *sessao) {
+    const struct Servidor *servidor = laco->servidor;
+    long conexoes = 0, partidas = 0, comandos = 0;
+    for (int i = 0; i < servidor->numLacos; i++) {
+        conexoes += __atomic_load_n(&servidor->lacos[i].conexoes, __ATOMIC_RELAXED);
+        partidas += __atomic_load_n(&servidor->lacos[i].partidas, __ATOMIC_RELAXED);
+        comandos += __atomic_load_n(&servidor->lacos[i].comandos, __ATOMIC_RELAXED);
+    }
+    struct timespec cpu;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &cpu);
+    responder(sessao, "ok conexoes %ld partidas %ld comandos %ld cpu_ns %llu\n", conexoes, partidas, comandos,
+              (unsigned long long) cpu.tv_sec * 1000000000ULL + (unsigned long long) cpu.tv_nsec);
+}
+
+/**
+ * @brief Executa um comando da sessão e acrescenta a resposta à saída.
+ * @param linha Comando, sem o '\n' (é modificado)
+ */
+static void executarComando(struct LacoServidor *laco, struct Sessao *sessao, char *linha) {
+    struct Jogo *jogo = &sessao->jogo;
+    char *resto;
+    char *nome = strtok_r(linha, SERVIDOR_SEPARADORES, &resto);
+    if (nome == NULL) return; // Linha vazia: nenhuma resposta
+    __atomic_store_n(&laco->comandos, laco->comandos + 1, __ATOMIC_RELAXED);
+
+    if (strcmp(nome, "nova") == 0) {
+        char *valor = strtok_r(NULL, SERVIDOR_SEPARADORES, &resto);
+        uint64_t semente = valor ? (uint64_t) strtoull(valor, NULL, 10)
+                                 : laco->servidor->semente + (uint64_t) __atomic_fetch_add(&laco->servidor->proximaConexao, 1, __ATOMIC_RELAXED);
+        if (novaPartida(laco, sessao, semente) != 0) {
+            responder(sessao, "erro memória insuficiente\n");
+            sessao->fechar = 1;
+        } else {
+            responder(sessao, "ok %llu\n", (unsigned long long) semente);
+        }
+    } else if (strcmp(nome, "sair") == 0 || strcmp(nome, "0") == 0) {
+        responder(sessao, "ok\n");
+        sessao->fechar = 1;
+    } else if (strcmp(nome, "estatisticas") == 0) {
+        comandoEstatisticas(laco, sessao);
+    } else if (strcmp(nome, "jogadores") == 0) {
+        if (jogo->numJogadores > 0) {
+            responder(sessao, "erro jogadores já cadastrados (use nova)\n");
+            return;
+        }
+        char *palavra;
+        while ((palavra = strtok_r(NULL, SERVIDOR_SEPARADORES, &resto)) != NULL) {
+            int cor = buscarCorPorNome(palavra);
+            if (cor == SEM_COR || cor >= jogo->numCores || jogo->jogadorDaCor[cor] >= 0 || jogo->numJogadores >= jogo->numCores) {
+                // Cadastro parcial desfeito: a partida volta a não ter jogadores
+                for (int i = 0; i < jogo->numJogadores; i++) jogo->jogadores[i].cor = SEM_COR;
+                jogo->numJogadores = 0;
+                reiniciarPosse(jogo);
+                responder(sessao, "erro cor inválida, repetida ou jogadores demais: %s\n", palavra);
+                return;
+            }
+            definirCorJogador(jogo, jogo->numJogadores, cor);
+            jogo->jogadores[jogo->numJogadores++].politica = &politicaRoteiro;
+        }
+        if (jogo->numJogadores == 0) {
+            responder(sessao, "erro 'jogadores' precisa de ao menos uma cor\n");
+            return;
+        }
+        sortearMissoes(jogo, Missoes, TOTAL_MISSOES);
+        responder(sessao, "ok %d\n", jogo->numJogadores);
+    } else if (jogo->numJogadores == 0) {
+        responder(sessao, "erro comando antes de 'jogadores': %s\n", nome);
+    } else if (strcmp(nome, "distribuir") == 0) {
+        if (jogo->vencedor >= 0) {
+            responder(sessao, "erro partida encerrada (use nova)\n");
+            return;
+        }
+        if (mapaDistribuido(jogo)) {
+            responder(sessao, "erro territórios já distribuídos (use nova)\n");
+            return;
+        }
+        distribuirTerritorios(jogo);
+        responderVencedor(sessao);
+        responder(sessao, "ok\n");
+    } else if (strcmp(nome, "ataque") == 0 || strcmp(nome, "1") == 0) {
+        comandoAtaque(sessao, &resto);
+    } else if (strcmp(nome, "mapa") == 0 || strcmp(nome, "2") == 0) {
+        for (int t = 0; t < jogo->numTerritorios; t++) {
+            const char *cor = nomeCor(jogo->dono[t]);
+            responder(sessao, "%s %s %d\n", nomeTerritorio(jogo->mapa, t), cor[0] ? cor : "-", jogo->tropas[t]);
+        }
+        responder(sessao, "ok %d\n", jogo->numTerritorios);
+    } else if (strcmp(nome, "missao") == 0 || strcmp(nome, "3") == 0) {
+        const struct Jogador *jogador = &jogo->jogadores[sessao->indiceJogador];
+        responder(sessao, "missao %s\n", Missoes[jogador->missao].descricao);
+        responder(sessao, "ok %s\n", jogador->missaoCumprida ? "cumprida" : "pendente");
+    } else if (strcmp(nome, "fim") == 0 || strcmp(nome, "4") == 0) {
+        sessao->indiceJogador = (sessao->indiceJogador + 1) % jogo->numJogadores;
+        if (sessao->historico.jogo != NULL) limparHistorico(&sessao->historico); // Só o turno da vez pode ser desfeito
+        responder(sessao, "ok vez %d %s\n", sessao->indiceJogador + 1, nomeCor(jogo->jogadores[sessao->indiceJogador].cor));
+    } else if (strcmp(nome, "salvar") == 0 || strcmp(nome, "5") == 0) {
+        char *nome = strtok_r(NULL, SERVIDOR_SEPARADORES, &resto);
+        char arquivo[sizeof(SERVIDOR_DIR_SALVAS) + SERVIDOR_MAX_NOME + sizeof(SERVIDOR_EXTENSAO_SALVA)];
+        if (caminhoPartidaSalva(nome, arquivo, sizeof(arquivo)) != 0) {
+            responder(sessao, "erro uso: salvar NOME (até %d letras, dígitos, '_' ou '-')\n", SERVIDOR_MAX_NOME);
+        } else if (salvarPartida(jogo, sessao->indiceJogador, arquivo) != 0) {
+            responder(sessao, "erro não foi possível salvar a partida\n");
+        } else {
+            responder(sessao, "ok\n");
+        }
+    } else if (strcmp(nome, "desfazer") == 0 || strcmp(nome, "6") == 0) {
+        if (sessao->historico.jogo == NULL || desfazerVersao(&sessao->historico) != 0) {
+            responder(sessao, "erro nenhum ataque a desfazer neste turno\n");
+        } else {
+            responder(sessao, "ok\n");
+        }
+    } else if (strcmp(nome, "refazer") == 0 || strcmp(nome, "7") == 0) {
+        if (sessao->historico.jogo == NULL || refazerVersao(&sessao->historico) != 0) {
+            responder(sessao, "erro nenhum ataque desfeito a refazer\n");
+        } else {
+            responder(sessao, "ok\n");
+        }
+    } else if (strcmp(nome, "plano") == 0) {
+        const struct Plano *plano = planejarAtaque(&laco->planejador, jogo, sessao->indiceJogador);
+        if (plano == NULL) {
+            responder(sessao, "erro planejador indisponível\n");
+            return;
+        }
+        for (int i = 0; i < plano->numPassos; i++) {
+            responder(sessao, "passo %s %s %.4f\n", nomeTerritorio(jogo->mapa, plano->passos[i].ataque),
+                      nomeTerritorio(jogo->mapa, plano->passos[i].defesa), plano->passos[i].chance);
+        }
+        responder(sessao, "ok %d %.4f %s\n", plano->numPassos, plano->chance, plano->completo ? "completo" : "parcial");
+    } else if (strcmp(nome, "sugerir") == 0) {
+        int ataque, defesa;
+        if (jogo->vencedor < 0 && politicaGulosa.escolherAtaque(jogo, &jogo->jogadores[sessao->indiceJogador], &ataque, &defesa)) {
+            responder(sessao, "ok %s %s\n", nomeTerritorio(jogo->mapa, ataque), nomeTerritorio(jogo->mapa, defesa));
+        } else {
+            responder(sessao, "ok nenhum\n");
+        }
+    } else {
+        responder(sessao, "erro comando desconhecido: %s\n", nome);
+    }
+}
+
+/**
+ * @brief Executa os comandos completos recebidos, enquanto a saída não encher.
+ */
+static void processarEntrada(struct LacoServidor *laco, struct Sessao *sessao) {
+    while (!sessao->fechar && sessao->usadoSaida - sessao->enviadoSaida < SERVIDOR_MAX_SAIDA) {
+        char *inicio = sessao->entrada + sessao->inicioEntrada;
+        size_t disponivel = sessao->usadoEntrada - sessao->inicioEntrada;
+        char *quebra = (char *) memchr(inicio, '\n', disponivel);
+        if (quebra == NULL) {
+            if (disponivel >= SERVIDOR_TAM_LINHA) {
+                responder(sessao, "erro linha longa demais\n");
+                sessao->fechar = 1;
+            }
+            break;
+        }
+        *quebra = '\0';
+        sessao->inicioEntrada += (size_t) (quebra - inicio) + 1;
+        executarComando(laco, sessao, inicio);
+    }
+
+    // O pedaço de comando que sobrou volta para o início do buffer
+    size_t restante = sessao->usadoEntrada - sessao->inicioEntrada;
+    memmove(sessao->entrada, sessao->entrada + sessao->inicioEntrada, restante);
+    sessao->inicioEntrada = 0;
+    sessao->usadoEntrada = restante;
+}
+
+/**
+ * @brief Lê o que o socket tem disponível, sem bloquear.
+ */
+static void lerSessao(struct Sessao *sessao) {
+    while (sessao->usadoEntrada < sizeof(sessao->entrada)) {
+        ssize_t n = read(sessao->fd, sessao->entrada + sessao->usadoEntrada, sizeof(sessao->entrada) - sessao->usadoEntrada);
+        if (n > 0) {
+            sessao->usadoEntrada += (size_t) n;
+        } else if (n == 0) {
+            sessao->fimEntrada = 1;
+            return;
+        } else if (errno == EINTR) {
+            continue;
+        } else {
+            if (errno != EAGAIN && errno != EWOULDBLOCK) sessao->fechar = 1;
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Envia as respostas pendentes, sem bloquear.
+ */
+static void enviarSaida(struct Sessao *sessao) {
+    while (sessao->enviadoSaida < sessao->usadoSaida) {
+        ssize_t n = send(sessao->fd, sessao->saida + sessao->enviadoSaida,
+                         sessao->usadoSaida - sessao->enviadoSaida, MSG_NOSIGNAL);
+        if (n >= 0) {
+            sessao->enviadoSaida += (size_t) n;
+        } else if (errno == EINTR) {
+            continue;
+        } else {
+            // Cliente que não lê mais: as respostas pendentes são descartadas
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                sessao->fechar = 1;
+                sessao->enviadoSaida = sessao->usadoSaida;
+            }
+            break;
+        }
+    }
+    if (sessao->enviadoSaida == sessao->usadoSaida) sessao->enviadoSaida = sessao->usadoSaida = 0;
+}
+
+/**
+ * @brief Fecha a conexão e libera a partida.
+ */
+static void fecharSessao(struct LacoServidor *laco, struct Sessao *sessao) {
+    if (sessao->anterior != NULL) sessao->anterior->proximo = sessao->proximo;
+    else laco->sessoes = sessao->proximo;
+    if (sessao->proximo != NULL) sessao->proximo->anterior = sessao->anterior;
+    laco->abertas--;
+
+    close(sessao->fd);
+    liberarHistorico(&sessao->historico);
+    liberarJogo(&sessao->jogo);
+    free(sessao->saida);
+    free(sessao);
+}
+
+/**
+ * @brief Trata os eventos de uma conexão: lê, executa, responde e ajusta
+ *        os eventos pedidos ao epoll.
+ */
+static void atenderSessao(struct LacoServidor *laco, struct Sessao *sessao, uint32_t eventos) {
+    if (eventos & (EPOLLIN | EPOLLHUP | EPOLLERR)) lerSessao(sessao);
+
+    // Executa enquanto a saída esvaziar e houver comandos completos
+    for (;;) {
+        processarEntrada(laco, sessao);
+        enviarSaida(sessao);
+        if (sessao->usadoSaida > 0 || sessao->fechar ||
+            memchr(sessao->entrada, '\n', sessao->usadoEntrada) == NULL) break;
+    }
+
+    int pendente = sessao->usadoSaida > 0;
+    if (!pendente && (sessao->fechar || sessao->fimEntrada)) {
+        fecharSessao(laco, sessao);
+        return;
+    }
+
+    // Com respostas pendentes, só interessa poder escrever
+    uint32_t interesse = pendente ? EPOLLOUT : EPOLLIN;
+    if (interesse != sessao->interesse) {
+        struct epoll_event evento = {0};
+        evento.events = interesse;
+        evento.data.ptr = sessao;
+        epoll_ctl(laco->epoll, EPOLL_CTL_MOD, sessao->fd, &evento);
+        sessao->interesse = interesse;
+    }
+}
+
+/**
+ * @brief Aceita uma conexão pendente e começa uma partida nela.
+ * @note Uma só por evento: com o epoll por nível, as que sobram na fila
+ *       acordam o próximo laço livre, e as conexões se espalham pelos laços.
+ */
+static void aceitarConexao(struct LacoServidor *laco) {
+    struct Servidor *servidor = laco->servidor;
+    for (;;) {
+        int fd = accept(servidor->escuta, NULL, NULL);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            return; // EAGAIN: outro laço levou a conexão
+        }
+
+        struct Sessao *sessao = (struct Sessao *) calloc(1, sizeof(struct Sessao));
+        uint64_t semente = servidor->semente + (uint64_t) __atomic_fetch_add(&servidor->proximaConexao, 1, __ATOMIC_RELAXED);
+        if (sessao == NULL || fcntl(fd, F_SETFL, O_NONBLOCK) != 0 || novaPartida(laco, sessao, semente) != 0) {
+            if (sessao != NULL) liberarJogo(&sessao->jogo);
+            free(sessao);
+            close(fd);
+            continue;
+        }
+        sessao->fd = fd;
+        sessao->interesse = EPOLLIN;
+
+        struct epoll_event evento = {0};
+        evento.events = EPOLLIN;
+        evento.data.ptr = sessao;
+        if (epoll_ctl(laco->epoll, EPOLL_CTL_ADD, fd, &evento) != 0) {
+            liberarJogo(&sessao->jogo);
+            free(sessao);
+            close(fd);
+            continue;
+        }
+
+        sessao->proximo = laco->sessoes;
+        if (laco->sessoes != NULL) laco->sessoes->anterior = sessao;
+        laco->sessoes = sessao;
+        if (++laco->abertas > laco->maxAbertas) laco->maxAbertas = laco->abertas;
+        __atomic_store_n(&laco->conexoes, laco->conexoes + 1, __ATOMIC_RELAXED);
+        return;
+    }
+}
+
+/**
+ * @brief Laço epoll de uma thread, até o eventfd de desligar disparar.
+ * @note data.ptr identifica a origem do evento: NULL é o socket de escuta,
+ *       o próprio laço é o eventfd de desligar e o resto são sessões.
+ */
+static void *executarLaco(void *argumento) {
+    struct LacoServidor *laco = (struct LacoServidor *) argumento;
+    struct epoll_event eventos[SERVIDOR_EVENTOS];
+    int terminar = 0;
+    criarPlanejador(&laco->planejador, laco->servidor->mapa->numTerritorios);
+
+    while (!terminar) {
+        int n = epoll_wait(laco->epoll, eventos, SERVIDOR_EVENTOS, -1);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            perror("epoll_wait");
+            break;
+        }
+        for (int i = 0; i < n; i++) {
+            void *origem = eventos[i].data.ptr;
+            if (origem == NULL) aceitarConexao(laco);
+            else if (origem == laco) terminar = 1;
+            else atenderSessao(laco, (struct Sessao *) origem, eventos[i].events);
+        }
+    }
+
+    while (laco->sessoes != NULL) fecharSessao(laco, laco->sessoes);
+    liberarPlanejador(&laco->planejador);
+    liberarPoolArenas();
+
+    struct timespec cpu;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpu);
+    laco->segundosCpu = cpu.tv_sec + cpu.tv_nsec / 1e9;
+    return NULL;
+}
+
+/**
+ * @brief Cria o socket de escuta não bloqueante no caminho dado.
+ * @note Um socket antigo no mesmo caminho é removido; outro tipo de arquivo não.
+ * @return Descritor do socket ou -1 em caso de erro (a mensagem já foi impressa)
+ */
+static int criarEscuta(const char *caminho) {
+    struct sockaddr_un endereco = {0};
+    if (strlen(caminho) >= sizeof(endereco.sun_path)) {
+        printf("Caminho do socket longo demais: %s\n", caminho);
+        return -1;
+    }
+    endereco.sun_family = AF_UNIX;
+    strcpy(endereco.sun_path, caminho);
+
+    struct stat info;
+    if (stat(caminho, &info) == 0) {
+        if (!S_ISSOCK(info.st_mode)) {
+            printf("%s já existe e não é um socket.\n", caminho);
+            return -1;
+        }
+        unlink(caminho);
+    }
+
+    int escuta = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (escuta < 0 || fcntl(escuta, F_SETFL, O_NONBLOCK) != 0 ||
+        bind(escuta, (const struct sockaddr *) &endereco, sizeof(endereco)) != 0 ||
+        listen(escuta, SERVIDOR_FILA_ESCUTA) != 0) {
+        perror(caminho);
+        if (escuta >= 0) close(escuta);
+        return -1;
+    }
+    return escuta;
+}
+
+/**
+ * @brief Função para atender partidas no socket Unix até SIGINT ou SIGTERM
+ * @note No fim, relata por laço as conexões, partidas, comandos e o tempo de
+ *       CPU gasto (comandos por segundo de CPU).
+ * @param mapa Mapa de todas as partidas
+ * @param caminho Caminho do socket
+ * @param semente Semente base (a primeira partida da conexão c usa semente + c)
+ * @param numLacos Laços epoll (threads)
+ * @return 0 em caso de sucesso, 1 em caso de erro (a mensagem já foi impressa)
+ */
+int executarServidor(const struct Mapa *mapa, const char *caminho, uint64_t semente, int numLacos) {
+    if (numLacos < 1 || numLacos > TORNEIO_MAX_THREADS) {
+        printf("Número de threads deve estar entre 1 e %d.\n", TORNEIO_MAX_THREADS);
+        return 1;
+    }
+
+    // A tabela de batalhas do planejador é construída antes de existirem laços
+    if (inicializarTabelaBatalhas() != 0) {
+        printf("Erro na alocação de memória para a tabela de batalhas.\n");
+        return 1;
+    }
+
+    struct Servidor servidor = {0};
+    servidor.mapa = mapa;
+    servidor.semente = semente;
+    servidor.numLacos = numLacos;
+    servidor.escuta = criarEscuta(caminho);
+    if (servidor.escuta < 0) {
+        liberarTabelaBatalhas();
+        return 1;
+    }
+    servidor.desligar = eventfd(0, 0);
+    servidor.lacos = (struct LacoServidor *) calloc((size_t) numLacos, sizeof(struct LacoServidor));
+    if (servidor.desligar < 0 || servidor.lacos == NULL) {
+        printf("Erro ao preparar o servidor.\n");
+        if (servidor.desligar >= 0) close(servidor.desligar);
+        free(servidor.lacos);
+        liberarTabelaBatalhas();
+        close(servidor.escuta);
+        unlink(caminho);
+        return 1;
+    }
+
+    // SIGINT e SIGTERM são atendidos por sigwait nesta thread; os laços os herdam bloqueados
+    sigset_t sinais;
+    sigemptyset(&sinais);
+    sigaddset(&sinais, SIGINT);
+    sigaddset(&sinais, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &sinais, NULL);
+
+    int criados = 0;
+    for (; criados < numLacos; criados++) {
+        struct LacoServidor *laco = &servidor.lacos[criados];
+        laco->servidor = &servidor;
+        laco->epoll = epoll_create1(0);
+        struct epoll_event escuta = {0};
+        escuta.events = EPOLLIN | EPOLLEXCLUSIVE; // Um só laço acorda por conexão nova
+        escuta.data.ptr = NULL;
+        struct epoll_event desligar = {0};
+        desligar.events = EPOLLIN;
+        desligar.data.ptr = laco;
+        if (laco->epoll < 0 ||
+            epoll_ctl(laco->epoll, EPOLL_CTL_ADD, servidor.escuta, &escuta) != 0 ||
+            epoll_ctl(laco->epoll, EPOLL_CTL_ADD, servidor.desligar, &desligar) != 0 ||
+            pthread_create(&laco->thread, NULL, executarLaco, laco) != 0) {
+            perror("Erro ao criar o laço do servidor");
+            if (laco->epoll >= 0) close(laco->epoll);
+            break;
+        }
+    }
+
+    double inicio = relogioSegundos();
+    if (criados == numLacos) {
+        printf("Servidor atendendo em %s com %d laço(s) epoll. Termine com Ctrl+C (SIGINT) ou SIGTERM.\n",
+               caminho, numLacos);
+        fflush(stdout);
+        int sinal;
+        sigwait(&sinais, &sinal);
+    }
+    double duracao = relogioSegundos() - inicio;
+
+    // O eventfd fica legível para sempre e acorda todos os laços
+    uint64_t um = 1;
+    if (write(servidor.desligar, &um, sizeof(um)) != (ssize_t) sizeof(um)) perror("eventfd");
+    for (int i = 0; i < criados; i++) {
+        pthread_join(servidor.lacos[i].thread, NULL);
+        close(servidor.lacos[i].epoll);
+    }
+
+    if (criados == numLacos) {
+        printf("\n========================================\n");
+        printf("======          SERVIDOR          ======\n");
+        printf("========================================\n");
+        printf("Tempo           : %.3f s\n", duracao);
+        printf("%-6s %11s %10s %12s %10s %18s %13s\n", "Laço", "Conexões", "Partidas", "Comandos",
+               "CPU (s)", "Comandos/s de CPU", "Simultâneas");
+        long comandos = 0;
+        double cpu = 0.0;
+        for (int i = 0; i < numLacos; i++) {
+            const struct LacoServidor *laco = &servidor.lacos[i];
+            printf("%-5d %10ld %10ld %12ld %10.3f %18.0f %12ld\n", i, laco->conexoes, laco->partidas, laco->comandos,
+                   laco->segundosCpu, laco->segundosCpu > 0 ? laco->comandos / laco->segundosCpu : 0.0, laco->maxAbertas);
+            comandos += laco->comandos;
+            cpu += laco->segundosCpu;
+        }
+        printf("Total: %ld comandos, %.3f s de CPU (%.0f comandos/s de CPU)\n", comandos, cpu,
+               cpu > 0 ? comandos / cpu : 0.0);
+    }
+
+    close(servidor.desligar);
+    close(servidor.escuta);
+    unlink(caminho);
+    free(servidor.lacos);
+    liberarTabelaBatalhas();
+    pthread_sigmask(SIG_UNBLOCK, &sinais, NULL);
+    return criados == numLacos ? 0 : 1;
+}
@@ -0,0 +1,59 @@
+/**
+ * @file servidor.h
+ * @brief Servidor de muitas partidas simultâneas num socket Unix local.
+ *
+ * Cada conexão ao socket é uma partida própria (struct Sessao), com o seu
+ * struct Jogo, o jogador da vez e o comando de ataque em execução; nada do
+ * estado da partida fica em variáveis globais, então centenas de partidas
+ * convivem no mesmo processo. As conexões são atendidas por um pequeno
+ * conjunto de laços epoll (um por thread, --threads); cada laço aceita as
+ * suas conexões no socket de escuta compartilhado (EPOLLEXCLUSIVE) e só ele
+ * mexe nas partidas que aceitou, sem travas.
+ *
+ * O protocolo é de linhas de texto e segue as opções de exibirMenuPrincipal()
+ * (os números do menu também são aceitos). Cada comando recebe zero ou mais
+ * linhas de dados e termina com uma linha "ok ..." ou "erro MENSAGEM":
+ * @code
+ * nova [SEMENTE]                 # Nova partida nesta conexão       -> ok SEMENTE
+ * jogadores Vermelho Azul        # Cores, na ordem de jogo; sorteia as missões -> ok N
+ * distribuir                     # Sorteia os territórios            -> ok
+ * 1 ORIGEM DESTINO DADOS [DEFESA [RODADAS [MOVER]]]   # Atacar (ou 'ataque')
+ *                                # -> [vencedor N COR] ok TROPAS_ORIGEM TROPAS_DESTINO COR_DESTINO
+ * 2                              # Ver mapa (ou 'mapa'): NOME COR TROPAS por linha -> ok N
+ * 3                              # Verificar missão (ou 'missao'): missao TEXTO -> ok cumprida|pendente
+ * 4                              # Terminar ataque (ou 'fim')        -> ok vez N COR
+ * 5 NOME                         # Salvar partida (ou 'salvar') em partidas/NOME.estado -> ok
+ * 6                              # Desfazer o último ataque do turno (ou 'desfazer'; ver historico.h) -> ok
+ * 7                              # Refazer o último ataque desfeito (ou 'refazer') -> ok
+ * 0                              # Sair (ou 'sair'): fecha a conexão -> ok
+ * sugerir                        # Ataque da política gulosa para o jogador da vez -> ok ORIGEM DESTINO | ok nenhum
+ * plano                          # Conquistas mais prováveis até o alvo da missão (ver planejador.h)
+ *                                # -> linhas "passo ORIGEM DESTINO CHANCE" e ok N CHANCE completo|parcial
+ * estatisticas                   # -> ok conexoes N partidas N comandos N cpu_ns N
+ * @endcode
+ * Dados, rodadas e tropas seguem o comando 'ataque' dos roteiros (roteiro.h).
+ * O nome de uma partida salva só tem letras, dígitos, '_' e '-', e o arquivo
+ * fica sempre em SERVIDOR_DIR_SALVAS: o cliente não escolhe caminhos.
+ * A conexão começa com uma partida nova (semente --seed mais o número da
+ * conexão); o servidor termina com SIGINT ou SIGTERM e relata os comandos
+ * atendidos e o tempo de CPU de cada laço.
+ */
+#ifndef SERVIDOR_H
+#define SERVIDOR_H
+
+#include <stdint.h>
+
+#include "mapa.h"
+
+#define SERVIDOR_TAM_LINHA 256      // Tamanho máximo de um comando
+#define SERVIDOR_MAX_SAIDA 65536    // Respostas pendentes acima das quais a conexão para de ler comandos
+#define SERVIDOR_EVENTOS 256        // Eventos tratados por chamada a epoll_wait
+#define SERVIDOR_FILA_ESCUTA 1024   // Conexões aguardando accept
+#define SERVIDOR_DIR_SALVAS "partidas" // Diretório das partidas salvas com 'salvar' (relativo ao do servidor)
+#define SERVIDOR_EXTENSAO_SALVA ".estado" // Extensão dos arquivos de partidas salvas
+#define SERVIDOR_MAX_NOME 64        // Tamanho máximo do nome de uma partida salva
+
+// --- Protótipos das Funções ---
+int executarServidor(const struct Mapa *mapa, const char *caminho, uint64_t semente, int numLacos); // Função para atender partidas no socket Unix até SIGINT/SIGTERM
+
+#endif // SERVIDOR_H
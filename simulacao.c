@@ -0,0 +1,533 @@
+/**
+ * @file simulacao.c
+ * @brief Implementação do modo de simulação em lote.
+ * @note As partidas reaproveitam a mesma memória de mapa e jogadores, de modo
+ *       que milhões de partidas podem ser jogadas sem pressionar o alocador.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "simulacao.h"
+#include "batalha.h"
+#include "torneio.h"
+#include "eventos.h"
+
+// --- Motor compacto ---
+// No mapa de MOTOR_TERRITORIOS_COMPACTO territórios a posse de cada cor e os
+// vizinhos de cada território cabem numa palavra: os alvos de um atacante
+// são vizinhanca & ~posse, e o laço sobre os territórios tem tamanho fixo e
+// é desenrolado pelo compilador. Os alvos saem em ordem crescente, a mesma
+// do CSR, então as políticas fazem as mesmas escolhas (e os mesmos
+// sorteios) que no motor genérico.
+
+/**
+ * @brief Territórios de onde a cor pode atacar: os seus com ao menos 2 tropas.
+ */
+static inline uint64_t atacantesCompacto(const struct Jogo *jogo, uint64_t meus) {
+    uint64_t atacantes = 0;
+#pragma GCC unroll 8
+    for (int a = 0; a < MOTOR_TERRITORIOS_COMPACTO; a++) atacantes |= (uint64_t) (jogo->tropas[a] >= 2) << a;
+    return atacantes & meus;
+}
+
+/**
+ * @brief gulosaEscolherAtaque no motor compacto.
+ */
+static int gulosaEscolherCompacto(const struct Jogo *jogo, const struct Jogador *jogador, int *ataque, int *defesa) {
+    const int32_t *tropas = jogo->tropas;
+    const uint64_t meus = jogo->posse[jogador->cor];
+    int melhorVantagem = 0;
+    *ataque = -1;
+    *defesa = -1;
+
+    for (uint64_t atacantes = atacantesCompacto(jogo, meus); atacantes != 0; atacantes &= atacantes - 1) {
+        int a = __builtin_ctzll(atacantes);
+        for (uint64_t alvos = jogo->vizinhancaCompacta[a] & ~meus; alvos != 0; alvos &= alvos - 1) {
+            int d = __builtin_ctzll(alvos);
+            int vantagem = tropas[a] - tropas[d];
+            if (vantagem > melhorVantagem) {
+                melhorVantagem = vantagem;
+                *ataque = a;
+                *defesa = d;
+            }
+        }
+    }
+    return *ataque >= 0;
+}
+
+/**
+ * @brief aleatoriaEscolherAtaque no motor compacto.
+ */
+static int aleatoriaEscolherCompacto(struct Jogo *jogo, const struct Jogador *jogador, int *ataque, int *defesa) {
+    const uint64_t meus = jogo->posse[jogador->cor];
+    int candidatos = 0;
+    *ataque = -1;
+    *defesa = -1;
+
+    for (uint64_t atacantes = atacantesCompacto(jogo, meus); atacantes != 0; atacantes &= atacantes - 1) {
+        int a = __builtin_ctzll(atacantes);
+        for (uint64_t alvos = jogo->vizinhancaCompacta[a] & ~meus; alvos != 0; alvos &= alvos - 1) {
+            candidatos++;
+            if (rngLimitado(&jogo->rng, candidatos) == 0) {
+                *ataque = a;
+                *defesa = __builtin_ctzll(alvos);
+            }
+        }
+    }
+
+    if (candidatos == 0 || rngLimitado(&jogo->rng, candidatos + 1) == 0) return 0;
+    return 1;
+}
+
+// --- Política gulosa ---
+// Ataca sempre o inimigo com a maior vantagem de tropas, rola o máximo de
+// dados e move todas as tropas possíveis para o território conquistado.
+// Como sempre luta até o fim, suas batalhas são resolvidas pela tabela blitz.
+
+/**
+ * @brief Escolhe o par atacante/defensor com a maior vantagem de tropas.
+ * @return 1 se existe um ataque vantajoso, 0 para terminar o turno
+ */
+static int gulosaEscolherAtaque(struct Jogo *jogo, struct Jogador *jogador,
+                                int *ataque, int *defesa) {
+    if (jogo->motor == MOTOR_COMPACTO) return gulosaEscolherCompacto(jogo, jogador, ataque, defesa);
+
+    int melhorVantagem = 0;
+    const struct Mapa *mapa = jogo->mapa;
+    const int32_t *tropas = jogo->tropas;
+    *ataque = -1;
+    *defesa = -1;
+
+    for (int a = 0; a < jogo->numTerritorios; a++) {
+        if (tropas[a] < 2 || !possuiTerritorio(jogo, jogador->cor, a)) continue;
+
+        // Só os vizinhos de a podem ser atacados
+        for (int k = mapa->inicioVizinhos[a]; k < mapa->inicioVizinhos[a + 1]; k++) {
+            int d = mapa->vizinhos[k];
+            if (possuiTerritorio(jogo, jogador->cor, d)) continue;
+
+            int vantagem = tropas[a] - tropas[d];
+            if (vantagem > melhorVantagem) {
+                melhorVantagem = vantagem;
+                *ataque = a;
+                *defesa = d;
+            }
+        }
+    }
+    return *ataque >= 0;
+}
+
+static int gulosaDados(struct Jogo *jogo, int ataque, int defesa, int maxDados) {
+    (void) jogo; (void) ataque; (void) defesa;
+    return maxDados;
+}
+
+static int gulosaContinuar(struct Jogo *jogo, int ataque, int defesa) {
+    (void) jogo; (void) ataque; (void) defesa;
+    return 1;
+}
+
+static int gulosaTropasMover(struct Jogo *jogo, int ataque, int defesa, int maxTropas) {
+    (void) jogo; (void) ataque; (void) defesa;
+    return maxTropas;
+}
+
+const struct Politica politicaGulosa = {
+    "gulosa", 1, gulosaEscolherAtaque, gulosaDados, gulosaDados, gulosaContinuar, gulosaTropasMover
+};
+
+// --- Política aleatória ---
+// Escolhe uniformemente entre as jogadas válidas; útil como linha de base.
+
+/**
+ * @brief Sorteia um par atacante/defensor válido (ou termina o turno).
+ * @return 1 se um ataque foi escolhido, 0 para terminar o turno
+ */
+static int aleatoriaEscolherAtaque(struct Jogo *jogo, struct Jogador *jogador,
+                                   int *ataque, int *defesa) {
+    if (jogo->motor == MOTOR_COMPACTO) return aleatoriaEscolherCompacto(jogo, jogador, ataque, defesa);
+
+    int candidatos = 0;
+    const struct Mapa *mapa = jogo->mapa;
+    *ataque = -1;
+    *defesa = -1;
+
+    // Amostragem por reservatório sobre todos os pares válidos
+    for (int a = 0; a < jogo->numTerritorios; a++) {
+        if (jogo->tropas[a] < 2 || !possuiTerritorio(jogo, jogador->cor, a)) continue;
+
+        // Só os vizinhos de a podem ser atacados
+        for (int k = mapa->inicioVizinhos[a]; k < mapa->inicioVizinhos[a + 1]; k++) {
+            int d = mapa->vizinhos[k];
+            if (possuiTerritorio(jogo, jogador->cor, d)) continue;
+
+            candidatos++;
+            if (rngLimitado(&jogo->rng, candidatos) == 0) {
+                *ataque = a;
+                *defesa = d;
+            }
+        }
+    }
+
+    // Termina o turno com probabilidade 1 / (candidatos + 1)
+    if (candidatos == 0 || rngLimitado(&jogo->rng, candidatos + 1) == 0) return 0;
+    return 1;
+}
+
+static int aleatoriaDados(struct Jogo *jogo, int ataque, int defesa, int maxDados) {
+    (void) ataque; (void) defesa;
+    return (int) rngLimitado(&jogo->rng, maxDados) + 1;
+}
+
+static int aleatoriaContinuar(struct Jogo *jogo, int ataque, int defesa) {
+    (void) ataque; (void) defesa;
+    return (int) rngLimitado(&jogo->rng, 2);
+}
+
+static int aleatoriaTropasMover(struct Jogo *jogo, int ataque, int defesa, int maxTropas) {
+    (void) ataque; (void) defesa;
+    return (int) rngLimitado(&jogo->rng, maxTropas) + 1;
+}
+
+const struct Politica politicaAleatoria = {
+    "aleatoria", 0, aleatoriaEscolherAtaque, aleatoriaDados, aleatoriaDados, aleatoriaContinuar, aleatoriaTropasMover
+};
+
+/**
+ * @brief Função para buscar uma política automática pelo nome
+ * @param nome Nome da política ("gulosa" ou "aleatoria")
+ * @return Ponteiro para a política ou NULL se o nome for desconhecido
+ */
+const struct Politica *buscarPolitica(const char *nome) {
+    static const struct Politica *politicas[] = {&politicaGulosa, &politicaAleatoria};
+    for (size_t i = 0; i < sizeof(politicas) / sizeof(politicas[0]); i++) {
+        if (strcmp(politicas[i]->nome, nome) == 0) return politicas[i];
+    }
+    return NULL;
+}
+
+/**
+ * @brief Função para ler o relógio monotônico
+ * @return Tempo em segundos desde um ponto arbitrário
+ */
+double relogioSegundos(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/**
+ * @brief Joga uma partida inteira sem nenhuma interação com o usuário.
+ * @note Os jogadores se revezam em turnos; cada um ataca enquanto sua política
+ *       quiser. A partida termina quando alguém cumpre a missão, quando uma
+ *       rodada inteira passa sem ataques ou ao atingir SIM_MAX_TURNOS.
+ * @param jogo Partida já cadastrada (cores, missões e territórios)
+ * @param turnos Recebe o número de turnos jogados
+ * @return Índice do jogador vencedor ou -1 em caso de empate
+ */
+int simularPartida(struct Jogo *jogo, int *turnos) {
+    int indiceJogador = 0;
+    int turnosSemAtaque = 0;
+
+    for (int turno = 0; turno < SIM_MAX_TURNOS; turno++) {
+        struct Jogador *jogador = &jogo->jogadores[indiceJogador];
+        int paisAtaque;
+        int paisDefesa;
+        int ataques = 0;
+
+        while (ataques < SIM_MAX_ATAQUES_TURNO &&
+               jogador->politica->escolherAtaque(jogo, jogador, &paisAtaque, &paisDefesa)) {
+            atacar(jogo, paisAtaque, paisDefesa, jogador);
+            ataques++;
+
+            // A missão cumprida pode ser de outro jogador (destruição de um exército)
+            if (jogo->vencedor >= 0) {
+                *turnos = turno + 1;
+                return jogo->vencedor;
+            }
+        }
+
+        // Se ninguém atacou durante uma rodada inteira, a partida travou
+        turnosSemAtaque = (ataques == 0) ? turnosSemAtaque + 1 : 0;
+        if (turnosSemAtaque >= jogo->numJogadores) {
+            *turnos = turno + 1;
+            return -1;
+        }
+
+        indiceJogador = (indiceJogador + 1) % jogo->numJogadores;
+    }
+
+    *turnos = SIM_MAX_TURNOS;
+    return -1;
+}
+
+/**
+ * @brief Corpo de prepararPartida para n territórios.
+ * @note Instanciado com n constante no motor compacto (os vetores são zerados
+ *       e o layout é calculado sem laços) e com jogo->numTerritorios no genérico.
+ */
+static inline __attribute__((always_inline)) int prepararEmN(struct Jogo *jogo, const struct Politica *politica, const int n) {
+    memset(jogo->tropas, 0, (size_t) n * sizeof(int32_t));
+    memset(jogo->dono, SEM_COR, (size_t) n);
+    memset(jogo->jogadores, 0, (size_t) jogo->numCores * sizeof(struct Jogador));
+    for (int i = 0; i < jogo->numCores; i++) jogo->jogadores[i].cor = SEM_COR;
+    reiniciarPosse(jogo);
+
+    // Sorteia cores distintas para os jogadores (Fisher-Yates parcial)
+    int indicesCores[MAX_CORES];
+    for (int c = 0; c < jogo->numCores; c++) indicesCores[c] = c;
+    for (int i = 0; i < jogo->numJogadores; i++) {
+        int j = i + (int) rngLimitado(&jogo->rng, (uint32_t) (jogo->numCores - i));
+        int tmp = indicesCores[i];
+        indicesCores[i] = indicesCores[j];
+        indicesCores[j] = tmp;
+
+        definirCorJogador(jogo, i, indicesCores[i]);
+        jogo->jogadores[i].politica = politica;
+    }
+
+    sortearMissoes(jogo, Missoes, TOTAL_MISSOES);
+    distribuirTerritorios(jogo);
+
+    // Layout: a posição do dono de cada território, em base JOGADORES_CLASSICO
+    if (n > SIM_MAX_TERRITORIOS_LAYOUT || jogo->numJogadores > JOGADORES_CLASSICO) return -1;
+    int layout = 0;
+    for (int t = 0; t < n; t++) {
+        int cor = jogo->dono[t];
+        layout = layout * JOGADORES_CLASSICO + (cor != SEM_COR ? jogo->jogadorDaCor[cor] : 0);
+    }
+    return layout;
+}
+
+/**
+ * @brief Prepara uma nova partida: sorteia cores, missões e territórios.
+ * @param jogo Partida a ser reinicializada (memória já alocada)
+ * @param politica Política usada por todos os jogadores
+ * @return Código do layout inicial (dono de cada território) ou -1 se o mapa
+ *         for grande demais para ser classificado
+ */
+int prepararPartida(struct Jogo *jogo, const struct Politica *politica) {
+    if (jogo->motor == MOTOR_COMPACTO) return prepararEmN(jogo, politica, MOTOR_TERRITORIOS_COMPACTO);
+    return prepararEmN(jogo, politica, jogo->numTerritorios);
+}
+
+/**
+ * @brief Joga a partida de índice p de um lote e acumula o resultado.
+ * @note A partida usa o fluxo (semente, p) do gerador, então o resultado não
+ *       depende de qual thread a jogou nem em que ordem.
+ * @param jogo Memória da partida (reaproveitada entre partidas)
+ * @param politica Política usada por todos os jogadores
+ * @param semente Semente do lote
+ * @param p Índice da partida no lote
+ * @param est Estatísticas onde o resultado é acumulado
+ */
+void jogarPartida(struct Jogo *jogo, const struct Politica *politica, uint64_t semente, long p,
+                  struct EstatisticasSimulacao *est) {
+    rngSemearFluxo(&jogo->rng, semente, (uint64_t) p);
+    diarioPartida(jogo, p);
+    int layout = prepararPartida(jogo, politica);
+
+    for (int i = 0; i < jogo->numJogadores; i++) {
+        est->sorteadas[jogo->jogadores[i].missao]++;
+        est->partidasCor[jogo->jogadores[i].cor]++;
+    }
+    if (layout >= 0) est->partidasLayout[layout]++;
+
+    int turnos;
+    int vencedor = simularPartida(jogo, &turnos);
+    diarioRegistrar(jogo, EVENTO_FIM, 2, (uint64_t) (vencedor + 1), (uint64_t) turnos);
+    est->partidas++;
+    est->turnos += turnos;
+
+    if (vencedor < 0) {
+        est->empates++;
+    } else {
+        est->vitoriasPosicao[vencedor]++;
+        est->vitoriasMissao[jogo->jogadores[vencedor].missao]++;
+        est->vitoriasCor[jogo->jogadores[vencedor].cor]++;
+        if (layout >= 0) est->vitoriasLayout[layout][vencedor]++;
+    }
+}
+
+/**
+ * @brief Soma as estatísticas parciais de uma thread ao total do lote.
+ */
+void somarEstatisticas(struct EstatisticasSimulacao *total, const struct EstatisticasSimulacao *parcial) {
+    total->partidas += parcial->partidas;
+    total->empates += parcial->empates;
+    total->turnos += parcial->turnos;
+    for (int m = 0; m < TOTAL_MISSOES; m++) {
+        total->sorteadas[m] += parcial->sorteadas[m];
+        total->vitoriasMissao[m] += parcial->vitoriasMissao[m];
+    }
+    for (int c = 0; c < MAX_CORES; c++) {
+        total->partidasCor[c] += parcial->partidasCor[c];
+        total->vitoriasCor[c] += parcial->vitoriasCor[c];
+    }
+    for (int j = 0; j < MAX_JOGADORES; j++) total->vitoriasPosicao[j] += parcial->vitoriasPosicao[j];
+    for (int l = 0; l < SIM_NUM_LAYOUTS; l++) {
+        total->partidasLayout[l] += parcial->partidasLayout[l];
+        for (int j = 0; j < JOGADORES_CLASSICO; j++) total->vitoriasLayout[l][j] += parcial->vitoriasLayout[l][j];
+    }
+}
+
+/**
+ * @brief Imprime os layouts iniciais mais desequilibrados do lote.
+ * @note Desequilíbrio = maior taxa de vitória de uma mesma posição no layout.
+ */
+static void mostrarLayouts(const struct Mapa *mapa, const struct EstatisticasSimulacao *est, int numJogadores) {
+    if (mapa->numTerritorios > SIM_MAX_TERRITORIOS_LAYOUT || numJogadores > JOGADORES_CLASSICO) return;
+
+    const int mostrar = 10;
+    double taxa[SIM_NUM_LAYOUTS];
+
+    for (int l = 0; l < SIM_NUM_LAYOUTS; l++) {
+        taxa[l] = -1.0; // Layout que não apareceu no lote
+        if (est->partidasLayout[l] == 0) continue;
+        long maxVitorias = 0;
+        for (int j = 0; j < numJogadores; j++) {
+            if (est->vitoriasLayout[l][j] > maxVitorias) maxVitorias = est->vitoriasLayout[l][j];
+        }
+        taxa[l] = (double) maxVitorias / est->partidasLayout[l];
+    }
+
+    printf("\nLayouts iniciais mais desequilibrados (dono de");
+    for (int t = 0; t < mapa->numTerritorios; t++) printf("%s %s", t > 0 ? "," : "", nomeTerritorio(mapa, t));
+    printf("):\n");
+    printf("| %-7s | %-10s |", "Layout", "Partidas");
+    for (int j = 0; j < numJogadores; j++) printf(" Vit. J%d |", j + 1);
+    printf("\n");
+    for (int e = 0; e < mostrar; e++) {
+        // Seleciona o layout restante mais desequilibrado
+        int l = 0;
+        for (int k = 1; k < SIM_NUM_LAYOUTS; k++) {
+            if (taxa[k] > taxa[l]) l = k;
+        }
+        if (taxa[l] < 0) break;
+        taxa[l] = -1.0;
+
+        char donos[SIM_MAX_TERRITORIOS_LAYOUT + 1];
+        int codigo = l;
+        for (int t = mapa->numTerritorios - 1; t >= 0; t--) {
+            donos[t] = (char) ('1' + codigo % JOGADORES_CLASSICO);
+            codigo /= JOGADORES_CLASSICO;
+        }
+        donos[mapa->numTerritorios] = '\0';
+        printf("| %-7s | %-10ld |", donos, est->partidasLayout[l]);
+        for (int j = 0; j < numJogadores; j++) {
+            printf(" %6.2f%% |", 100.0 * est->vitoriasLayout[l][j] / est->partidasLayout[l]);
+        }
+        printf("\n");
+    }
+}
+
+/**
+ * @brief Roda um lote de partidas sem interação e imprime o relatório.
+ * @param mapa Mapa das partidas
+ * @param numPartidas Número de partidas a jogar
+ * @param semente Semente do gerador de números aleatórios
+ * @param numJogadores Número de jogadores em cada partida (2 a MAX_JOGADORES)
+ * @param politica Política de decisão usada por todos os jogadores
+ * @param numThreads Número de threads do torneio
+ * @return 0 em caso de sucesso, 1 em caso de erro
+ */
+int executarSimulacao(const struct Mapa *mapa, long numPartidas, uint64_t semente, int numJogadores, const struct Politica *politica, int numThreads) {
+    struct EstatisticasSimulacao *est = (struct EstatisticasSimulacao *) calloc(1, sizeof(struct EstatisticasSimulacao));
+    struct ResultadoTorneio resultado;
+
+    if (est == NULL || inicializarTabelaBatalhas() != 0 ||
+        executarTorneio(mapa, numPartidas, semente, numJogadores, politica, numThreads, est, &resultado) != 0) {
+        printf("Erro na alocação de memória para a simulação.\n");
+        free(est);
+        liberarTabelaBatalhas();
+        return 1;
+    }
+
+    double duracao = resultado.duracao;
+
+    printf("========================================\n");
+    printf("======   SIMULAÇÃO EM LOTE - WAR   ======\n");
+    printf("========================================\n");
+    printf("Partidas        : %ld\n", est->partidas);
+    printf("Mapa            : %d territórios, %ld fronteiras\n", mapa->numTerritorios, mapa->numFronteiras);
+    printf("Jogadores       : %d\n", numJogadores);
+    printf("Política        : %s\n", politica->nome);
+    printf("Batalhas        : %s\n", politica->blitz ? "blitz (tabela de Markov)" : "rodada a rodada");
+    printf("Motor           : %s\n", nomeMotor(escolherMotor(mapa)));
+    printf("Semente         : %llu\n", (unsigned long long) semente);
+    printf("Threads         : %d (roubos de trabalho: %ld, partidas por thread: %ld a %ld)\n",
+           numThreads, resultado.roubos, resultado.minPartidasThread, resultado.maxPartidasThread);
+    printf("Tempo           : %.3f s\n", duracao);
+    printf("Partidas/s      : %.0f\n", duracao > 0 ? est->partidas / duracao : 0.0);
+    printf("Turnos/partida  : %.2f\n", est->partidas > 0 ? (double) est->turnos / est->partidas : 0.0);
+    printf("Empates         : %ld (%.2f%%)\n", est->empates, est->partidas > 0 ? 100.0 * est->empates / est->partidas : 0.0);
+
+    printf("\n| %-4s | %-45s | %-10s | %-8s |\n", "Cód.", "Missão", "Sorteada", "Vitória");
+    for (int m = 0; m < TOTAL_MISSOES; m++) {
+        if (m >= MISSOES_CLASSICAS && est->sorteadas[m] == 0) continue; // Missão de uma cor que não entrou no lote
+        printf("| %-4d | %-45.45s | %-10ld | %7.2f%% |\n", Missoes[m].codigo, Missoes[m].descricao, est->sorteadas[m],
+               est->sorteadas[m] > 0 ? 100.0 * est->vitoriasMissao[m] / est->sorteadas[m] : 0.0);
+    }
+
+    printf("\n| %-10s | %-10s | %-8s |\n", "Cor", "Partidas", "Vitória");
+    for (int c = 0; c < coresParaJogadores(numJogadores); c++) {
+        printf("| %-10s | %-10ld | %7.2f%% |\n", cores[c], est->partidasCor[c],
+               est->partidasCor[c] > 0 ? 100.0 * est->vitoriasCor[c] / est->partidasCor[c] : 0.0);
+    }
+
+    printf("\n| %-9s | %-8s |\n", "Posição", "Vitória");
+    for (int i = 0; i < numJogadores; i++) {
+        printf("| %-8d | %7.2f%% |\n", i + 1, est->partidas > 0 ? 100.0 * est->vitoriasPosicao[i] / est->partidas : 0.0);
+    }
+
+    mostrarLayouts(mapa, est, numJogadores);
+
+    free(est);
+    liberarTabelaBatalhas();
+    return 0;
+}
+
+/**
+ * @brief Mede como o torneio escala com o número de threads.
+ * @note Roda o mesmo lote com 1, 2, 4, ... threads até maxThreads e reporta
+ *       partidas/s, aceleração em relação a 1 thread e eficiência.
+ * @return 0 em caso de sucesso, 1 em caso de erro
+ */
+int medirEscalabilidade(const struct Mapa *mapa, long numPartidas, uint64_t semente, int numJogadores, const struct Politica *politica, int maxThreads) {
+    struct EstatisticasSimulacao *est = (struct EstatisticasSimulacao *) malloc(sizeof(struct EstatisticasSimulacao));
+    if (est == NULL || inicializarTabelaBatalhas() != 0) {
+        printf("Erro na alocação de memória para a simulação.\n");
+        free(est);
+        return 1;
+    }
+
+    printf("========================================\n");
+    printf("======  ESCALABILIDADE DO TORNEIO  ======\n");
+    printf("========================================\n");
+    printf("Partidas por medição: %ld | Núcleos disponíveis: %d\n\n", numPartidas, numeroDeNucleos());
+    printf("| %-7s | %-12s | %-10s | %-10s |\n", "Threads", "Partidas/s", "Aceleração", "Eficiência");
+
+    double base = 0.0;
+    int erro = 0;
+    for (int t = 1; t <= maxThreads; t = (t < maxThreads && t * 2 > maxThreads) ? maxThreads : t * 2) {
+        struct ResultadoTorneio resultado;
+        memset(est, 0, sizeof(*est));
+        if (executarTorneio(mapa, numPartidas, semente, numJogadores, politica, t, est, &resultado) != 0) {
+            printf("Erro ao executar o torneio com %d threads.\n", t);
+            erro = 1;
+            break;
+        }
+        double taxa = resultado.duracao > 0 ? numPartidas / resultado.duracao : 0.0;
+        if (t == 1) base = taxa;
+        double aceleracao = base > 0 ? taxa / base : 0.0;
+        printf("| %-7d | %12.0f | %9.2fx | %9.1f%% |\n", t, taxa, aceleracao, 100.0 * aceleracao / t);
+    }
+
+    free(est);
+    liberarTabelaBatalhas();
+    return erro;
+}
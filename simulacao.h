@@ -0,0 +1,49 @@
+/**
+ * @file simulacao.h
+ * @brief Modo de simulação em lote (sem interação com o usuário).
+ *
+ * Joga partidas completas usando políticas automáticas de decisão e
+ * reporta estatísticas para análise de balanceamento das regras de
+ * atacar() e da tabela Missoes[].
+ */
+#ifndef SIMULACAO_H
+#define SIMULACAO_H
+
+#include <stdint.h>
+
+#include "jogo.h"
+
+#define SIM_MAX_TURNOS 1000        // Limite de turnos por partida antes de declarar empate
+#define SIM_MAX_ATAQUES_TURNO 100  // Limite de ataques de um jogador em um único turno
+#define SIM_MAX_TERRITORIOS_LAYOUT 5 // Layouts só são registrados em mapas com até 5 territórios
+#define SIM_NUM_LAYOUTS 243        // JOGADORES_CLASSICO ^ SIM_MAX_TERRITORIOS_LAYOUT: dono de cada território no início
+
+// Estatísticas acumuladas de um lote de partidas (uma por thread, somadas no fim)
+struct EstatisticasSimulacao {
+    long partidas;                               // Partidas jogadas
+    long empates;                                // Partidas sem vencedor
+    long turnos;                                 // Soma dos turnos de todas as partidas
+    long sorteadas[TOTAL_MISSOES];               // Quantas vezes cada missão foi sorteada
+    long vitoriasMissao[TOTAL_MISSOES];          // Vitórias por missão
+    long partidasCor[MAX_CORES];                 // Partidas disputadas por cada cor
+    long vitoriasCor[MAX_CORES];                 // Vitórias por cor
+    long vitoriasPosicao[MAX_JOGADORES];         // Vitórias por posição na ordem de jogo
+    long partidasLayout[SIM_NUM_LAYOUTS];        // Partidas iniciadas em cada layout (até JOGADORES_CLASSICO jogadores)
+    long vitoriasLayout[SIM_NUM_LAYOUTS][JOGADORES_CLASSICO]; // Vitórias de cada posição em cada layout
+};
+
+// Políticas automáticas disponíveis
+extern const struct Politica politicaGulosa;
+extern const struct Politica politicaAleatoria;
+
+// --- Protótipos das Funções ---
+const struct Politica *buscarPolitica(const char *nome); // Função para buscar uma política automática pelo nome
+int simularPartida(struct Jogo *jogo, int *turnos);      // Função para jogar uma partida inteira sem interação
+int prepararPartida(struct Jogo *jogo, const struct Politica *politica); // Função para sortear cores, missões e territórios
+void jogarPartida(struct Jogo *jogo, const struct Politica *politica, uint64_t semente, long p, struct EstatisticasSimulacao *est); // Função para jogar e registrar a partida p de um lote
+void somarEstatisticas(struct EstatisticasSimulacao *total, const struct EstatisticasSimulacao *parcial); // Função para juntar as estatísticas das threads
+int executarSimulacao(const struct Mapa *mapa, long numPartidas, uint64_t semente, int numJogadores, const struct Politica *politica, int numThreads); // Função para rodar e reportar um lote de partidas
+int medirEscalabilidade(const struct Mapa *mapa, long numPartidas, uint64_t semente, int numJogadores, const struct Politica *politica, int maxThreads); // Função para medir partidas/s com 1, 2, 4... threads
+double relogioSegundos(void);                            // Função para ler o relógio monotônico em segundos
+
+#endif // SIMULACAO_H
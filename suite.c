@@ -0,0 +1,434 @@
+/**
+ * @file suite.c
+ * @brief Implementação da suíte de microbenchmarks.
+ * @note Cada caso acumula os seus resultados em estado->soma, impressa no fim,
+ *       para que o compilador não descarte o trabalho medido.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "suite.h"
+#include "jogo.h"
+#include "mapa.h"
+#include "tela.h"
+#include "simulacao.h"
+#include "lote.h"
+#include "missao.h"
+#include "batalha.h"
+#include "planejador.h"
+#include "historico.h"
+
+#define SUITE_CONSULTAS 1024 // Nomes distintos buscados (reaproveitados em ciclo)
+#define SUITE_JOGADORES_CHEIO 64 // Jogadores da partida cheia (sorteio de missões com muitas cores)
+#define SUITE_TERRITORIOS_PLANO 10000 // Territórios do mapa do planejador de ataques
+
+// Dados de entrada compartilhados pelos casos
+struct EstadoSuite {
+    struct Rng rng;                 // Gerador dos casos (semeado com --seed)
+    struct Mapa *mapaClassico;      // Mapa clássico de 5 países
+    struct Mapa *mapaGrande;        // Grade de SUITE_TERRITORIOS_GRANDE territórios
+    struct Jogo jogoClassico;       // Partida de 3 jogadores no mapa clássico
+    struct Jogo jogoGrande;         // Partida de 3 jogadores no mapa grande
+    struct Jogo jogoCheio;          // Partida de SUITE_JOGADORES_CHEIO jogadores no mapa grande
+    struct Mapa *mapaPlano;         // Grade de SUITE_TERRITORIOS_PLANO territórios
+    struct Jogo jogoPlano;          // Partida de 3 jogadores com missões de destruição no mapa do planejador
+    struct Planejador planejador;   // Planejador de ataques do jogoPlano
+    struct Historico historico;     // Versões do jogoGrande (cada ataque medido é desfeito)
+    struct Tela telaClassica;       // Telas escritas em /dev/null
+    struct Tela telaGrande;
+    int dadosSorteados[SUITE_CONSULTAS][3]; // Dados a ordenar
+    int32_t tropasLote[2][LOTE_BLOCO];      // Tropas iniciais das batalhas em lote (atacante e defensor)
+    const char *nomesClassico[SUITE_CONSULTAS]; // Nomes buscados em cada mapa
+    const char *nomesGrande[SUITE_CONSULTAS];
+    long proximo;                   // Posição em ciclo nas entradas acima
+    long soma;                      // Soma de verificação dos resultados
+};
+
+// Caso da suíte: executa 'iteracoes' operações medidas
+struct CasoSuite {
+    const char *nome;        // Identificador (estável: usado nos arquivos de resultados)
+    const char *descricao;   // Função medida
+    void (*executar)(struct EstadoSuite *estado, long iteracoes);
+};
+
+// Resultado de um caso, em nanossegundos por operação
+struct ResultadoSuite {
+    const struct CasoSuite *caso;
+    long lote;               // Operações em cada amostra
+    double p50, p90, p99;    // Percentis das amostras
+    double minimo, media;
+};
+
+// --- Casos ---
+
+static void casoRodada3x2(struct EstadoSuite *estado, long iteracoes) {
+    int dadosAtaque[3];
+    int dadosDefesa[3];
+    for (long i = 0; i < iteracoes; i++) estado->soma += rodadaDeDados(&estado->rng, 3, 2, dadosAtaque, dadosDefesa);
+}
+
+static void casoRodadaMista(struct EstadoSuite *estado, long iteracoes) {
+    int dadosAtaque[3];
+    int dadosDefesa[3];
+    for (long i = 0; i < iteracoes; i++) {
+        long r = estado->proximo++;
+        estado->soma += rodadaDeDados(&estado->rng, (int) (r % 3) + 1, (int) ((r / 3) % 3) + 1, dadosAtaque, dadosDefesa);
+    }
+}
+
+static void casoOrdenarDados(struct EstadoSuite *estado, long iteracoes) {
+    for (long i = 0; i < iteracoes; i++) {
+        int dados[3];
+        memcpy(dados, estado->dadosSorteados[estado->proximo++ % SUITE_CONSULTAS], sizeof(dados));
+        ordenarDados(dados, 3);
+        estado->soma += dados[0];
+    }
+}
+
+static void casoBuscarClassico(struct EstadoSuite *estado, long iteracoes) {
+    for (long i = 0; i < iteracoes; i++) {
+        estado->soma += buscarTerritorioPorNome(&estado->jogoClassico, estado->nomesClassico[estado->proximo++ % SUITE_CONSULTAS]);
+    }
+}
+
+static void casoBuscarGrande(struct EstadoSuite *estado, long iteracoes) {
+    for (long i = 0; i < iteracoes; i++) {
+        estado->soma += buscarTerritorioPorNome(&estado->jogoGrande, estado->nomesGrande[estado->proximo++ % SUITE_CONSULTAS]);
+    }
+}
+
+static void sortearMissoesSuite(struct EstadoSuite *estado, struct Jogo *jogo, long iteracoes) {
+    for (long i = 0; i < iteracoes; i++) {
+        // Como no cadastro: nenhuma missão cumprida antes do sorteio
+        for (int j = 0; j < jogo->numJogadores; j++) jogo->jogadores[j].missaoCumprida = 0;
+        jogo->vencedor = -1;
+        sortearMissoes(jogo, Missoes, TOTAL_MISSOES);
+        estado->soma += jogo->jogadores[0].missao;
+    }
+}
+
+static void casoSortearMissoes(struct EstadoSuite *estado, long iteracoes) {
+    sortearMissoesSuite(estado, &estado->jogoClassico, iteracoes);
+}
+
+static void casoSortearMissoesCheio(struct EstadoSuite *estado, long iteracoes) {
+    sortearMissoesSuite(estado, &estado->jogoCheio, iteracoes);
+}
+
+static void casoDesenharClassico(struct EstadoSuite *estado, long iteracoes) {
+    for (long i = 0; i < iteracoes; i++) desenharMapa(&estado->telaClassica, &estado->jogoClassico, 1);
+    estado->soma += (long) estado->telaClassica.capacidade;
+}
+
+static void casoDesenharGrandeCompleto(struct EstadoSuite *estado, long iteracoes) {
+    for (long i = 0; i < iteracoes; i++) desenharMapa(&estado->telaGrande, &estado->jogoGrande, 1);
+    estado->soma += (long) estado->telaGrande.capacidade;
+}
+
+static void casoDesenharGrandeAlterado(struct EstadoSuite *estado, long iteracoes) {
+    struct Jogo *jogo = &estado->jogoGrande;
+    for (long i = 0; i < iteracoes; i++) {
+        // Uma batalha altera dois territórios entre dois quadros
+        int t = (int) (estado->proximo++ % jogo->numTerritorios);
+        jogo->tropas[t]++;
+        jogo->tropas[(t + 1) % jogo->numTerritorios]--;
+        desenharMapa(&estado->telaGrande, jogo, 0);
+    }
+    estado->soma += (long) estado->telaGrande.capacidade;
+}
+
+static void casoBatalhasLote(struct EstadoSuite *estado, long iteracoes) {
+    int32_t ataque[LOTE_BLOCO], defesa[LOTE_BLOCO];
+    for (long i = 0; i < iteracoes; i++) {
+        memcpy(ataque, estado->tropasLote[0], sizeof(ataque));
+        memcpy(defesa, estado->tropasLote[1], sizeof(defesa));
+        estado->soma += batalhasEmLote(&estado->rng, ataque, defesa, LOTE_BLOCO, LOTE_AUTOMATICO);
+    }
+}
+
+static void casoPlanejarAtaque(struct EstadoSuite *estado, long iteracoes) {
+    for (long i = 0; i < iteracoes; i++) {
+        esquecerPlano(&estado->planejador);
+        estado->soma += planejarAtaque(&estado->planejador, &estado->jogoPlano, (int) (i % JOGADORES_CLASSICO))->numPassos;
+    }
+}
+
+static void casoPlanejarAtaqueAlterado(struct EstadoSuite *estado, long iteracoes) {
+    struct Jogo *jogo = &estado->jogoPlano;
+    for (long i = 0; i < iteracoes; i++) {
+        // Um território muda entre duas consultas: o plano só é refeito se a busca o leu
+        int t = (int) (estado->proximo++ % jogo->numTerritorios);
+        jogo->tropas[t] ^= 1;
+        estado->soma += planejarAtaque(&estado->planejador, jogo, 0)->numPassos;
+    }
+}
+
+static void casoDesfazerAtaque(struct EstadoSuite *estado, long iteracoes) {
+    struct Jogo *jogo = &estado->jogoGrande;
+    const struct Mapa *mapa = jogo->mapa;
+    for (long i = 0; i < iteracoes; i++) {
+        // O primeiro vizinho inimigo de um território em ciclo; o ataque é desfeito em seguida
+        int a = (int) (estado->proximo++ % jogo->numTerritorios);
+        for (int k = mapa->inicioVizinhos[a]; k < mapa->inicioVizinhos[a + 1]; k++) {
+            int d = mapa->vizinhos[k];
+            if (jogo->dono[d] == jogo->dono[a] || jogo->tropas[a] < 2) continue;
+            atacar(jogo, a, d, buscarJogadorPorCor(jogo, jogo->dono[a]));
+            estado->soma += jogo->tropas[d] + desfazerVersao(&estado->historico);
+            break;
+        }
+    }
+}
+
+static const struct CasoSuite CasosSuite[] = {
+    {"rodada_dados_3x2", "rodadaDeDados (atacar), 3 contra 2 dados", casoRodada3x2},
+    {"rodada_dados_mista", "rodadaDeDados (atacar), 1 a 3 dados de cada lado", casoRodadaMista},
+    {"ordenar_dados", "ordenarDados com 3 dados", casoOrdenarDados},
+    {"batalhas_lote", "batalhasEmLote, 256 batalhas blitz de até 20 tropas", casoBatalhasLote},
+    {"buscar_nome_classico", "buscarTerritorioPorNome, mapa clássico", casoBuscarClassico},
+    {"buscar_nome_grande", "buscarTerritorioPorNome, mapa grande", casoBuscarGrande},
+    {"sortear_missoes", "sortearMissoes (cadastroJogadores), 3 jogadores", casoSortearMissoes},
+    {"sortear_missoes_64", "sortearMissoes, 64 jogadores (cores numeradas)", casoSortearMissoesCheio},
+    {"planejar_ataque_10k", "planejarAtaque, busca completa, 10 mil territórios", casoPlanejarAtaque},
+    {"planejar_ataque_10k_alterado", "planejarAtaque com um território alterado, 10 mil territórios", casoPlanejarAtaqueAlterado},
+    {"desfazer_ataque_grande", "atacar seguido de desfazerVersao, mapa grande", casoDesfazerAtaque},
+    {"desenhar_mapa_classico", "mostrarMapa completo, mapa clássico, /dev/null", casoDesenharClassico},
+    {"desenhar_mapa_grande", "mostrarMapa completo, mapa grande, /dev/null", casoDesenharGrandeCompleto},
+    {"desenhar_mapa_grande_alterado", "mostrarMapa só com as alterações, mapa grande, /dev/null", casoDesenharGrandeAlterado},
+};
+
+#define SUITE_NUM_CASOS ((int) (sizeof(CasosSuite) / sizeof(CasosSuite[0])))
+
+// --- Preparação ---
+
+/**
+ * @brief Prepara uma partida de numJogadores jogadores com territórios distribuídos.
+ * @return 0 em caso de sucesso, 1 se faltou memória
+ */
+static int prepararJogoSuite(struct Jogo *jogo, const struct Mapa *mapa, int numJogadores, uint64_t semente) {
+    if (mapa == NULL || alocarJogoComCores(jogo, mapa, coresParaJogadores(numJogadores)) != 0) return 1;
+    rngSemear(&jogo->rng, semente);
+    jogo->numJogadores = numJogadores;
+    prepararPartida(jogo, &politicaGulosa);
+    jogo->verboso = 0;
+    return 0;
+}
+
+/**
+ * @brief Prepara a partida do planejador: cada jogador caça a cor do seguinte.
+ * @note Missões de territórios já estariam cumpridas no mapa grande.
+ * @return 0 em caso de sucesso, 1 se faltou memória
+ */
+static int prepararJogoPlano(struct EstadoSuite *estado, uint64_t semente) {
+    struct Jogo *jogo = &estado->jogoPlano;
+    if (estado->mapaPlano == NULL || alocarJogo(jogo, estado->mapaPlano) != 0) return 1;
+    rngSemear(&jogo->rng, semente);
+    jogo->numJogadores = JOGADORES_CLASSICO;
+    for (int i = 0; i < JOGADORES_CLASSICO; i++) definirCorJogador(jogo, i, i);
+    for (int i = 0; i < JOGADORES_CLASSICO; i++) {
+        jogo->jogadores[i].missao = missaoDestruirCor((i + 1) % JOGADORES_CLASSICO);
+        registrarAlvoMissao(jogo, i);
+    }
+    distribuirTerritorios(jogo);
+    jogo->verboso = 0;
+    return criarPlanejador(&estado->planejador, estado->mapaPlano->numTerritorios);
+}
+
+/**
+ * @brief Aloca os mapas, as partidas, as telas e as entradas dos casos.
+ * @return 0 em caso de sucesso, 1 em caso de erro
+ */
+static int prepararSuite(struct EstadoSuite *estado, uint64_t semente) {
+    memset(estado, 0, sizeof(*estado));
+    rngSemear(&estado->rng, semente);
+    estado->mapaClassico = criarMapaClassico();
+    estado->mapaGrande = criarMapaGrade(SUITE_TERRITORIOS_GRANDE);
+    estado->mapaPlano = criarMapaGrade(SUITE_TERRITORIOS_PLANO);
+    if (prepararJogoSuite(&estado->jogoClassico, estado->mapaClassico, JOGADORES_CLASSICO, semente) != 0 ||
+        prepararJogoSuite(&estado->jogoGrande, estado->mapaGrande, JOGADORES_CLASSICO, semente) != 0 ||
+        prepararJogoSuite(&estado->jogoCheio, estado->mapaGrande, SUITE_JOGADORES_CHEIO, semente) != 0 ||
+        prepararJogoPlano(estado, semente) != 0 ||
+        criarHistorico(&estado->historico, &estado->jogoGrande) != 0 ||
+        criarTela(&estado->telaClassica, estado->mapaClassico->numTerritorios) != 0 ||
+        criarTela(&estado->telaGrande, estado->mapaGrande->numTerritorios) != 0) {
+        return 1;
+    }
+
+    // Desenho para uma saída nula: mede a montagem do quadro e a chamada a write
+    estado->telaClassica.saida = open("/dev/null", O_WRONLY);
+    estado->telaGrande.saida = estado->telaClassica.saida;
+    if (estado->telaClassica.saida < 0) return 1;
+
+    for (int k = 0; k < SUITE_CONSULTAS; k++) {
+        rngDados(&estado->rng, estado->dadosSorteados[k], 3);
+        estado->nomesClassico[k] = nomeTerritorio(estado->mapaClassico, (int) rngLimitado(&estado->rng, TERRITORIOS_CLASSICO));
+        estado->nomesGrande[k] = nomeTerritorio(estado->mapaGrande, (int) rngLimitado(&estado->rng, SUITE_TERRITORIOS_GRANDE));
+    }
+    for (int i = 0; i < LOTE_BLOCO; i++) {
+        estado->tropasLote[0][i] = 2 + (int32_t) rngLimitado(&estado->rng, 19);
+        estado->tropasLote[1][i] = 1 + (int32_t) rngLimitado(&estado->rng, 20);
+    }
+    return 0;
+}
+
+static void liberarSuite(struct EstadoSuite *estado) {
+    if (estado->telaClassica.saida > STDERR_FILENO) close(estado->telaClassica.saida);
+    liberarTela(&estado->telaClassica);
+    liberarTela(&estado->telaGrande);
+    if (estado->jogoClassico.jogadores != NULL) liberarJogo(&estado->jogoClassico);
+    liberarHistorico(&estado->historico);
+    if (estado->jogoGrande.jogadores != NULL) liberarJogo(&estado->jogoGrande);
+    if (estado->jogoCheio.jogadores != NULL) liberarJogo(&estado->jogoCheio);
+    if (estado->jogoPlano.jogadores != NULL) liberarJogo(&estado->jogoPlano);
+    liberarPlanejador(&estado->planejador);
+    liberarTabelaBatalhas();
+    liberarMapa(estado->mapaClassico);
+    liberarMapa(estado->mapaGrande);
+    liberarMapa(estado->mapaPlano);
+}
+
+// --- Medição ---
+
+static int compararDoubles(const void *a, const void *b) {
+    double x = *(const double *) a;
+    double y = *(const double *) b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Percentil p (0 a 100) de amostras ordenadas, pelo posto mais próximo.
+ */
+static double percentil(const double *ordenadas, int n, double p) {
+    int posto = (int) (p / 100.0 * n + 0.999999);
+    if (posto < 1) posto = 1;
+    if (posto > n) posto = n;
+    return ordenadas[posto - 1];
+}
+
+/**
+ * @brief Aquece um caso, calibra o lote e mede as amostras.
+ * @note O lote dobra durante o aquecimento até uma execução levar ao menos
+ *       SUITE_DURACAO_AMOSTRA_S; o aquecimento continua com esse lote até
+ *       completar SUITE_AQUECIMENTO_S.
+ */
+static void medirCaso(struct EstadoSuite *estado, const struct CasoSuite *caso, struct ResultadoSuite *resultado) {
+    long lote = 1;
+    double inicioAquecimento = relogioSegundos();
+    for (;;) {
+        double inicio = relogioSegundos();
+        caso->executar(estado, lote);
+        double agora = relogioSegundos();
+        if (agora - inicio < SUITE_DURACAO_AMOSTRA_S) {
+            lote *= 2;
+        } else if (agora - inicioAquecimento >= SUITE_AQUECIMENTO_S) {
+            break;
+        }
+    }
+
+    double amostras[SUITE_AMOSTRAS];
+    double total = 0.0;
+    for (int a = 0; a < SUITE_AMOSTRAS; a++) {
+        double inicio = relogioSegundos();
+        caso->executar(estado, lote);
+        amostras[a] = (relogioSegundos() - inicio) * 1e9 / lote;
+        total += amostras[a];
+    }
+    qsort(amostras, SUITE_AMOSTRAS, sizeof(double), compararDoubles);
+
+    resultado->caso = caso;
+    resultado->lote = lote;
+    resultado->p50 = percentil(amostras, SUITE_AMOSTRAS, 50.0);
+    resultado->p90 = percentil(amostras, SUITE_AMOSTRAS, 90.0);
+    resultado->p99 = percentil(amostras, SUITE_AMOSTRAS, 99.0);
+    resultado->minimo = amostras[0];
+    resultado->media = total / SUITE_AMOSTRAS;
+}
+
+/**
+ * @brief Grava os resultados em JSON ou, se o nome terminar em ".csv", em CSV.
+ * @return 0 em caso de sucesso, 1 em caso de erro
+ */
+static int gravarResultados(const char *caminho, const struct ResultadoSuite *resultados, uint64_t semente) {
+    FILE *arquivo = fopen(caminho, "w");
+    if (arquivo == NULL) {
+        printf("Erro ao criar o arquivo de resultados %s.\n", caminho);
+        return 1;
+    }
+
+    size_t tamanho = strlen(caminho);
+    if (tamanho >= 4 && strcmp(caminho + tamanho - 4, ".csv") == 0) {
+        fprintf(arquivo, "perfil,caso,amostras,lote,p50_ns,p90_ns,p99_ns,min_ns,media_ns,ops_por_s\n");
+        for (int c = 0; c < SUITE_NUM_CASOS; c++) {
+            const struct ResultadoSuite *r = &resultados[c];
+            fprintf(arquivo, "%s,%s,%d,%ld,%.3f,%.3f,%.3f,%.3f,%.3f,%.0f\n", WAR_PERFIL, r->caso->nome, SUITE_AMOSTRAS,
+                    r->lote, r->p50, r->p90, r->p99, r->minimo, r->media, r->p50 > 0 ? 1e9 / r->p50 : 0.0);
+        }
+    } else {
+        fprintf(arquivo, "{\n  \"perfil\": \"%s\",\n  \"semente\": %llu,\n  \"amostras\": %d,\n  \"casos\": [\n",
+                WAR_PERFIL, (unsigned long long) semente, SUITE_AMOSTRAS);
+        for (int c = 0; c < SUITE_NUM_CASOS; c++) {
+            const struct ResultadoSuite *r = &resultados[c];
+            fprintf(arquivo, "    {\"caso\": \"%s\", \"lote\": %ld, \"p50_ns\": %.3f, \"p90_ns\": %.3f, \"p99_ns\": %.3f, "
+                    "\"min_ns\": %.3f, \"media_ns\": %.3f, \"ops_por_s\": %.0f}%s\n",
+                    r->caso->nome, r->lote, r->p50, r->p90, r->p99, r->minimo, r->media,
+                    r->p50 > 0 ? 1e9 / r->p50 : 0.0, c + 1 < SUITE_NUM_CASOS ? "," : "");
+        }
+        fprintf(arquivo, "  ]\n}\n");
+    }
+
+    int erro = ferror(arquivo);
+    if (fclose(arquivo) != 0) erro = 1;
+    if (erro) printf("Erro ao gravar o arquivo de resultados %s.\n", caminho);
+    return erro;
+}
+
+/**
+ * @brief Função para rodar a suíte de microbenchmarks
+ * @note Imprime a tabela dos percentis de cada caso e, com um caminho, grava
+ *       os mesmos resultados em JSON ou CSV.
+ * @param semente Semente das entradas dos casos
+ * @param caminhoResultados Arquivo de resultados (.json ou .csv) ou NULL
+ * @return 0 em caso de sucesso, 1 em caso de erro
+ */
+int executarSuite(uint64_t semente, const char *caminhoResultados) {
+    struct EstadoSuite *estado = (struct EstadoSuite *) malloc(sizeof(struct EstadoSuite));
+    if (estado == NULL || prepararSuite(estado, semente) != 0) {
+        printf("Erro ao preparar a suíte de microbenchmarks.\n");
+        if (estado != NULL) liberarSuite(estado);
+        free(estado);
+        return 1;
+    }
+
+    printf("========================================\n");
+    printf("======  SUÍTE DE MICROBENCHMARKS  ======\n");
+    printf("========================================\n");
+    printf("Perfil: %s | semente: %llu | %d amostras por caso | mapa grande: %d territórios\n\n",
+           WAR_PERFIL, (unsigned long long) semente, SUITE_AMOSTRAS, SUITE_TERRITORIOS_GRANDE);
+    printf("| %-29s | %-9s | %-12s | %-12s | %-12s | %-13s | %s\n",
+           "Caso", "Lote", "p50 (ns/op)", "p90 (ns/op)", "p99 (ns/op)", "Mín (ns/op)", "Op/s (p50)");
+
+    struct ResultadoSuite resultados[SUITE_NUM_CASOS];
+    for (int c = 0; c < SUITE_NUM_CASOS; c++) {
+        medirCaso(estado, &CasosSuite[c], &resultados[c]);
+        const struct ResultadoSuite *r = &resultados[c];
+        printf("| %-29s | %9ld | %12.1f | %12.1f | %12.1f | %12.1f | %.0f\n", r->caso->nome, r->lote,
+               r->p50, r->p90, r->p99, r->minimo, r->p50 > 0 ? 1e9 / r->p50 : 0.0);
+        fflush(stdout);
+    }
+    printf("\nCasos:\n");
+    for (int c = 0; c < SUITE_NUM_CASOS; c++) printf("  %-29s %s\n", CasosSuite[c].nome, CasosSuite[c].descricao);
+    printf("Soma de verificação: %ld\n", estado->soma);
+
+    int erro = 0;
+    if (caminhoResultados != NULL) {
+        erro = gravarResultados(caminhoResultados, resultados, semente);
+        if (!erro) printf("Resultados gravados em %s\n", caminhoResultados);
+    }
+
+    liberarSuite(estado);
+    free(estado);
+    return erro;
+}
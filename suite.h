@@ -0,0 +1,42 @@
+/**
+ * @file suite.h
+ * @brief Suíte repetível de microbenchmarks (make bench).
+ *
+ * Mede as funções mais quentes do jogo, uma por caso: a rodada de dados de
+ * atacar(), ordenarDados(), as batalhas em lote (batalhasEmLote, com o núcleo
+ * SIMD do processador), buscarTerritorioPorNome(), o sorteio das missões
+ * do cadastro dos jogadores (com 3 e com 64 jogadores), o planejador de
+ * ataques (planejarAtaque) num mapa de 10 mil territórios, um ataque desfeito
+ * pelo histórico de versões (desfazerVersao) e o desenho do mapa (mostrarMapa)
+ * para uma saída nula (/dev/null).
+ *
+ * Cada caso é aquecido por SUITE_AQUECIMENTO_S segundos, que também calibram
+ * um lote de iterações com cerca de SUITE_DURACAO_AMOSTRA_S segundos; depois
+ * são medidas SUITE_AMOSTRAS amostras de um lote cada. O relatório traz o
+ * tempo por operação na mediana, nos percentis 90 e 99, o mínimo e a média.
+ * Os dados de entrada saem da semente (--seed), então duas execuções medem
+ * exatamente o mesmo trabalho.
+ *
+ * Além da tabela, os resultados podem ser gravados para máquinas em JSON ou
+ * CSV (pela extensão do arquivo), junto com o perfil de compilação medido
+ * (WAR_PERFIL: release, lto, pgo...), para comparar perfis e versões.
+ */
+#ifndef SUITE_H
+#define SUITE_H
+
+#include <stdint.h>
+
+#define SUITE_AMOSTRAS 101            // Amostras medidas de cada caso
+#define SUITE_AQUECIMENTO_S 0.05      // Aquecimento de cada caso, em segundos
+#define SUITE_DURACAO_AMOSTRA_S 0.002 // Duração desejada de cada amostra, em segundos
+#define SUITE_TERRITORIOS_GRANDE 100000 // Territórios do mapa grande das buscas e do desenho
+
+// Perfil de compilação informado no relatório (o Makefile o define em cada perfil)
+#ifndef WAR_PERFIL
+#define WAR_PERFIL "padrao"
+#endif
+
+// --- Protótipos das Funções ---
+int executarSuite(uint64_t semente, const char *caminhoResultados); // Função para rodar a suíte e gravar os resultados (NULL = só a tabela)
+
+#endif // SUITE_H
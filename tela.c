@@ -0,0 +1,199 @@
+/**
+ * @file tela.c
+ * @brief Implementação do desenho do mapa em quadros com um único write.
+ * @note As linhas são formatadas à mão (sem snprintf) com a mesma largura das
+ *       colunas do antigo printf("| %-13s | %-10s | %-7d |").
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "tela.h"
+#include "metricas.h"
+
+#define TELA_LINHA_MAXIMA (MAPA_TAM_NOME + 64) // Maior linha possível de um quadro
+
+#ifndef WAR_SILENCIOSO
+
+/**
+ * @brief Garante espaço para mais 'tamanho' bytes no quadro.
+ * @return 0 em caso de sucesso, 1 se faltou memória
+ */
+static int reservar(struct Tela *tela, size_t tamanho) {
+    if (tela->usado + tamanho <= tela->capacidade) return 0;
+    size_t capacidade = tela->capacidade ? tela->capacidade : 4096;
+    while (capacidade < tela->usado + tamanho) capacidade *= 2;
+    char *buffer = (char *) realloc(tela->buffer, capacidade);
+    if (buffer == NULL) return 1;
+    tela->buffer = buffer;
+    tela->capacidade = capacidade;
+    METRICA_CONTAR(METRICA_ALOCACOES);
+    return 0;
+}
+
+/**
+ * @brief Acrescenta um texto ao quadro, completando com espaços até 'largura' bytes.
+ * @note Como o %-Ns do printf: conta bytes e não corta textos maiores.
+ */
+static void anexarCampo(struct Tela *tela, const char *texto, size_t largura) {
+    size_t tamanho = strlen(texto);
+    memcpy(tela->buffer + tela->usado, texto, tamanho);
+    tela->usado += tamanho;
+    while (tamanho++ < largura) tela->buffer[tela->usado++] = ' ';
+}
+
+/**
+ * @brief Acrescenta um inteiro ao quadro, alinhado à esquerda em 'largura' bytes.
+ */
+static void anexarInteiro(struct Tela *tela, int32_t valor, size_t largura) {
+    char digitos[12];
+    int n = 0;
+    uint32_t v = valor < 0 ? 0u - (uint32_t) valor : (uint32_t) valor;
+    do {
+        digitos[n++] = (char) ('0' + v % 10);
+        v /= 10;
+    } while (v);
+    if (valor < 0) digitos[n++] = '-';
+
+    size_t tamanho = (size_t) n;
+    while (n > 0) tela->buffer[tela->usado++] = digitos[--n];
+    while (tamanho++ < largura) tela->buffer[tela->usado++] = ' ';
+}
+
+/**
+ * @brief Acrescenta um texto fixo ao quadro.
+ */
+static void anexarTexto(struct Tela *tela, const char *texto) {
+    anexarCampo(tela, texto, 0);
+}
+
+/**
+ * @brief Acrescenta a linha de um território ao quadro e guarda o seu estado.
+ */
+static void anexarLinha(struct Tela *tela, const struct Jogo *jogo, int t) {
+    anexarTexto(tela, "| ");
+    anexarCampo(tela, nomeTerritorio(jogo->mapa, t), 13);
+    anexarTexto(tela, " | ");
+    anexarCampo(tela, nomeCor(jogo->dono[t]), 10);
+    anexarTexto(tela, " | ");
+    anexarInteiro(tela, jogo->tropas[t], 7);
+    anexarTexto(tela, " |\n");
+
+    tela->tropas[t] = jogo->tropas[t];
+    tela->dono[t] = jogo->dono[t];
+}
+
+/**
+ * @brief Envia o quadro montado com uma única chamada a write (repetida só se
+ *        a escrita for parcial) e esvazia o buffer.
+ * @note O que já foi escrito com printf sai antes, para manter a ordem na tela.
+ */
+static void enviarQuadro(struct Tela *tela) {
+    fflush(stdout);
+    size_t enviado = 0;
+    while (enviado < tela->usado) {
+        ssize_t n = write(tela->saida, tela->buffer + enviado, tela->usado - enviado);
+        if (n <= 0) break;
+        enviado += (size_t) n;
+    }
+    tela->usado = 0;
+}
+#endif // WAR_SILENCIOSO
+
+/**
+ * @brief Função para alocar a tela de um mapa
+ * @param tela Tela a preparar
+ * @param numTerritorios Número de territórios do mapa
+ * @return 0 em caso de sucesso, 1 se faltou memória (nada fica alocado)
+ */
+int criarTela(struct Tela *tela, int numTerritorios) {
+    memset(tela, 0, sizeof(*tela));
+    tela->numTerritorios = numTerritorios;
+    tela->saida = STDOUT_FILENO;
+    tela->tropas = (int32_t *) malloc((size_t) numTerritorios * sizeof(int32_t));
+    tela->dono = (int8_t *) malloc((size_t) numTerritorios);
+    METRICA_SOMAR(METRICA_ALOCACOES, 2);
+    if (tela->tropas == NULL || tela->dono == NULL) {
+        liberarTela(tela);
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Função para liberar a memória da tela
+ * @param tela Tela criada por criarTela
+ */
+void liberarTela(struct Tela *tela) {
+    free(tela->buffer);
+    free(tela->tropas);
+    free(tela->dono);
+    tela->buffer = NULL;
+    tela->tropas = NULL;
+    tela->dono = NULL;
+    tela->usado = 0;
+    tela->capacidade = 0;
+}
+
+/**
+ * @brief Função para desenhar o mapa com os territórios, suas cores e número de tropas.
+ * @note Um quadro incremental mostra somente os territórios cujas tropas ou
+ *       dono mudaram desde o último quadro; o primeiro quadro é sempre completo.
+ * @param tela Tela do mapa
+ * @param jogo Partida a desenhar
+ * @param completo 1 - desenha todos os territórios, 0 - só os alterados
+ */
+void desenharMapa(struct Tela *tela, const struct Jogo *jogo, int completo) {
+#ifdef WAR_SILENCIOSO
+    (void) tela;
+    (void) jogo;
+    (void) completo;
+#else
+    if (tela->silenciosa) return;
+    if (!tela->desenhada) completo = 1;
+
+    // Espaço para o cabeçalho; as linhas reservam o seu à medida que entram
+    if (reservar(tela, 8 * TELA_LINHA_MAXIMA) != 0) return;
+
+    anexarTexto(tela, "\n+-----------------------------------------+\n");
+    anexarTexto(tela, completo ? "|               MAPA ATUAL               |\n"
+                               : "|         MAPA ATUAL (ALTERAÇÕES)        |\n");
+    anexarTexto(tela, "+-----------------------------------------+\n");
+    anexarTexto(tela, "| ");
+    anexarCampo(tela, "Território", 15);
+    anexarTexto(tela, " | ");
+    anexarCampo(tela, "Cor", 10);
+    anexarTexto(tela, " | ");
+    anexarCampo(tela, "Tropas", 8);
+    anexarTexto(tela, " |\n");
+    anexarTexto(tela, "+-----------------------------------------+\n");
+
+    int alterados = 0;
+    for (int t = 0; t < jogo->numTerritorios; t++) {
+        if (completo || tela->tropas[t] != jogo->tropas[t] || tela->dono[t] != jogo->dono[t]) {
+            // Sem memória para crescer, envia o que já foi montado e continua
+            if (reservar(tela, 4 * TELA_LINHA_MAXIMA) != 0) enviarQuadro(tela);
+            anexarLinha(tela, jogo, t);
+            alterados++;
+        }
+    }
+    anexarTexto(tela, "+-----------------------------------------+\n");
+
+    if (!completo && alterados == 0) {
+        // Nada mudou: uma linha no lugar da tabela vazia
+        tela->usado = 0;
+        anexarTexto(tela, "\nMapa sem alterações desde o último desenho (opção 2 mostra o mapa inteiro).\n");
+    } else if (!completo) {
+        anexarTexto(tela, "Territórios alterados: ");
+        anexarInteiro(tela, alterados, 0);
+        anexarTexto(tela, " de ");
+        anexarInteiro(tela, jogo->numTerritorios, 0);
+        anexarTexto(tela, " (opção 2 mostra o mapa inteiro)\n");
+    }
+
+    tela->desenhada = 1;
+    enviarQuadro(tela);
+#endif
+}
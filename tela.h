@@ -0,0 +1,41 @@
+/**
+ * @file tela.h
+ * @brief Desenho do mapa em quadros montados num buffer e enviados com um único write.
+ *
+ * Cada quadro é montado inteiro num buffer reaproveitado entre quadros (ele
+ * só cresce) e vai para a saída com uma única chamada a write, em vez de um
+ * printf por linha. A tela guarda as tropas e o dono de cada território no
+ * último quadro desenhado; um quadro incremental traz apenas as linhas que
+ * mudaram desde então, o que num mapa grande é a diferença entre imprimir
+ * milhões de linhas antes de cada ataque e imprimir as duas que a batalha alterou.
+ *
+ * Compilado com -DWAR_SILENCIOSO (make quiet), o desenho não gera saída
+ * nenhuma, assim como JOGO_PRINTF (ver jogo.h).
+ */
+#ifndef TELA_H
+#define TELA_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "jogo.h"
+
+// Definição da estrutura da tela do mapa
+struct Tela {
+    char *buffer;          // Quadro em montagem (reaproveitado entre quadros)
+    size_t usado;          // Bytes já escritos no quadro atual
+    size_t capacidade;     // Tamanho alocado do buffer
+    int32_t *tropas;       // Tropas de cada território no último quadro desenhado
+    int8_t *dono;          // Dono de cada território no último quadro desenhado
+    int numTerritorios;    // Número de territórios acompanhados
+    int desenhada;         // 1 depois do primeiro quadro completo
+    int silenciosa;        // 1 - não desenha nada (--quiet)
+    int saida;             // Descritor onde os quadros são escritos (STDOUT_FILENO por padrão)
+};
+
+// --- Protótipos das Funções ---
+int criarTela(struct Tela *tela, int numTerritorios);  // Função para alocar a tela de um mapa (0 em caso de sucesso)
+void liberarTela(struct Tela *tela);                   // Função para liberar a memória da tela
+void desenharMapa(struct Tela *tela, const struct Jogo *jogo, int completo); // Função para desenhar o mapa inteiro ou só as linhas alteradas
+
+#endif // TELA_H
@@ -0,0 +1,216 @@
+/**
+ * @file torneio.c
+ * @brief Torneio de Monte Carlo em várias threads com roubo de trabalho.
+ * @note A tabela de batalhas (batalha.h) deve ser inicializada antes: ela é
+ *       somente leitura durante o torneio e compartilhada por todas as threads.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "torneio.h"
+#include "simulacao.h"
+#include "arena.h"
+#include "eventos.h"
+
+// Fila de trabalho de uma thread: a faixa [inicio, fim) de partidas ainda não jogadas.
+// O dono retira lotes do início; quem rouba leva a metade final.
+struct FilaTrabalho {
+    pthread_mutex_t trava;
+    long inicio;
+    long fim;
+};
+
+// Contexto de cada thread do torneio
+struct Trabalhador {
+    int indice;                         // Posição da thread no torneio
+    struct Torneio *torneio;            // Dados compartilhados
+    struct FilaTrabalho fila;           // Partidas atribuídas a esta thread (travada também por quem rouba)
+    char separacao[64];                 // Contadores fora da linha da fila, que os ladrões disputam
+    struct EstatisticasSimulacao *est;  // Estatísticas próprias (somadas no fim)
+    long partidas;                      // Partidas jogadas por esta thread
+    long roubos;                        // Faixas roubadas por esta thread
+    int erro;                           // 1 se faltou memória
+    char preenchimento[64];             // Contadores fora da linha da fila do trabalhador seguinte
+};
+
+// Dados compartilhados (somente leitura) por todas as threads
+struct Torneio {
+    const struct Mapa *mapa;
+    uint64_t semente;
+    int numJogadores;
+    const struct Politica *politica;
+    int numThreads;
+    struct Trabalhador *trabalhadores;
+};
+
+/**
+ * @brief Função para consultar o número de núcleos disponíveis
+ * @return Núcleos online (no mínimo 1)
+ */
+int numeroDeNucleos(void) {
+    long nucleos = sysconf(_SC_NPROCESSORS_ONLN);
+    return nucleos > 0 ? (int) nucleos : 1;
+}
+
+/**
+ * @brief Retira um lote de partidas do início da própria fila.
+ * @return 1 se conseguiu um lote, 0 se a fila está vazia
+ */
+static int retirarLote(struct FilaTrabalho *fila, long *inicio, long *fim) {
+    int conseguiu = 0;
+    pthread_mutex_lock(&fila->trava);
+    if (fila->inicio < fila->fim) {
+        *inicio = fila->inicio;
+        *fim = (fila->fim - fila->inicio > TORNEIO_LOTE) ? fila->inicio + TORNEIO_LOTE : fila->fim;
+        fila->inicio = *fim;
+        conseguiu = 1;
+    }
+    pthread_mutex_unlock(&fila->trava);
+    return conseguiu;
+}
+
+/**
+ * @brief Rouba metade das partidas restantes de outra thread.
+ * @note As vítimas são visitadas a partir da thread seguinte; a faixa roubada
+ *       passa a ser a fila do ladrão (que estava vazia).
+ * @return 1 se conseguiu roubar, 0 se todas as filas estão vazias
+ */
+static int roubarTrabalho(struct Trabalhador *ladrao) {
+    struct Torneio *torneio = ladrao->torneio;
+
+    for (int k = 1; k < torneio->numThreads; k++) {
+        struct Trabalhador *vitima = &torneio->trabalhadores[(ladrao->indice + k) % torneio->numThreads];
+        long inicio = 0, fim = 0;
+
+        pthread_mutex_lock(&vitima->fila.trava);
+        long restante = vitima->fila.fim - vitima->fila.inicio;
+        if (restante > 0) {
+            fim = vitima->fila.fim;
+            inicio = fim - (restante + 1) / 2;
+            vitima->fila.fim = inicio;
+        }
+        pthread_mutex_unlock(&vitima->fila.trava);
+
+        if (fim > inicio) {
+            pthread_mutex_lock(&ladrao->fila.trava);
+            ladrao->fila.inicio = inicio;
+            ladrao->fila.fim = fim;
+            pthread_mutex_unlock(&ladrao->fila.trava);
+            ladrao->roubos++;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Laço de uma thread: joga partidas da própria fila e rouba quando ela acaba.
+ */
+static void *executarTrabalhador(void *arg) {
+    struct Trabalhador *eu = (struct Trabalhador *) arg;
+    struct Torneio *torneio = eu->torneio;
+
+    // Cada thread tem a sua própria partida, reaproveitada entre as partidas
+    struct Jogo jogo = {0};
+    if (alocarJogoComCores(&jogo, torneio->mapa, coresParaJogadores(torneio->numJogadores)) != 0) {
+        eu->erro = 1;
+        return NULL;
+    }
+    jogo.numJogadores = torneio->numJogadores;
+    jogo.verboso = 0;
+    jogo.diario = diarioAberto();
+
+    long inicio, fim;
+    for (;;) {
+        if (!retirarLote(&eu->fila, &inicio, &fim)) {
+            // Fila vazia: rouba de outra thread e volta a retirar lotes
+            if (roubarTrabalho(eu)) continue;
+            break;
+        }
+        for (long p = inicio; p < fim; p++) {
+            jogarPartida(&jogo, torneio->politica, torneio->semente, p, eu->est);
+        }
+        eu->partidas += fim - inicio;
+    }
+
+    liberarJogo(&jogo);
+    liberarPoolArenas();
+    return NULL;
+}
+
+/**
+ * @brief Joga um lote de partidas em várias threads e soma as estatísticas.
+ * @note O resultado é o mesmo para qualquer número de threads: a partida p
+ *       sempre usa o fluxo (semente, p) do gerador.
+ * @param mapa Mapa das partidas (compartilhado, somente leitura)
+ * @param numPartidas Número de partidas do lote
+ * @param semente Semente do lote
+ * @param numJogadores Jogadores por partida
+ * @param politica Política usada por todos os jogadores
+ * @param numThreads Threads do torneio (1 a TORNEIO_MAX_THREADS)
+ * @param total Recebe a soma das estatísticas (deve chegar zerada)
+ * @param resultado Recebe tempo, roubos e distribuição das partidas por thread
+ * @return 0 em caso de sucesso, 1 em caso de erro
+ */
+int executarTorneio(const struct Mapa *mapa, long numPartidas, uint64_t semente, int numJogadores, const struct Politica *politica,
+                    int numThreads, struct EstatisticasSimulacao *total, struct ResultadoTorneio *resultado) {
+    if (numThreads < 1) numThreads = 1;
+    if (numThreads > TORNEIO_MAX_THREADS) numThreads = TORNEIO_MAX_THREADS;
+
+    struct Torneio torneio = {mapa, semente, numJogadores, politica, numThreads, NULL};
+    torneio.trabalhadores = (struct Trabalhador *) calloc(numThreads, sizeof(struct Trabalhador));
+    pthread_t *threads = (pthread_t *) calloc(numThreads, sizeof(pthread_t));
+    if (torneio.trabalhadores == NULL || threads == NULL) {
+        free(torneio.trabalhadores);
+        free(threads);
+        return 1;
+    }
+
+    // Divide as partidas em faixas contíguas de tamanho quase igual
+    int erro = 0;
+    for (int t = 0; t < numThreads; t++) {
+        struct Trabalhador *trab = &torneio.trabalhadores[t];
+        trab->indice = t;
+        trab->torneio = &torneio;
+        trab->fila.inicio = numPartidas * t / numThreads;
+        trab->fila.fim = numPartidas * (t + 1) / numThreads;
+        trab->est = (struct EstatisticasSimulacao *) calloc(1, sizeof(struct EstatisticasSimulacao));
+        pthread_mutex_init(&trab->fila.trava, NULL);
+        if (trab->est == NULL) erro = 1;
+    }
+
+    double inicio = relogioSegundos();
+    int criadas = 0;
+    for (int t = 0; t < numThreads && !erro; t++) {
+        if (pthread_create(&threads[t], NULL, executarTrabalhador, &torneio.trabalhadores[t]) != 0) {
+            erro = 1;
+            break;
+        }
+        criadas++; // Só as threads criadas são esperadas
+    }
+    for (int t = 0; t < criadas; t++) pthread_join(threads[t], NULL);
+    resultado->duracao = relogioSegundos() - inicio;
+
+    // Junta as estatísticas de cada thread
+    resultado->roubos = 0;
+    resultado->minPartidasThread = numPartidas;
+    resultado->maxPartidasThread = 0;
+    for (int t = 0; t < numThreads; t++) {
+        struct Trabalhador *trab = &torneio.trabalhadores[t];
+        if (trab->est != NULL) somarEstatisticas(total, trab->est);
+        if (trab->erro) erro = 1;
+        resultado->roubos += trab->roubos;
+        if (trab->partidas < resultado->minPartidasThread) resultado->minPartidasThread = trab->partidas;
+        if (trab->partidas > resultado->maxPartidasThread) resultado->maxPartidasThread = trab->partidas;
+        pthread_mutex_destroy(&trab->fila.trava);
+        free(trab->est);
+    }
+
+    free(torneio.trabalhadores);
+    free(threads);
+    return erro;
+}
@@ -0,0 +1,35 @@
+/**
+ * @file torneio.h
+ * @brief Execução de lotes de partidas em várias threads com roubo de trabalho.
+ *
+ * As N partidas são divididas em faixas contíguas, uma por thread. Cada
+ * thread consome a própria faixa em pequenos lotes; quando ela acaba, a
+ * thread rouba metade do que resta da faixa de outra. Como a duração das
+ * partidas varia muito com as missões sorteadas, isso evita que uma thread
+ * fique parada enquanto outra ainda tem muito trabalho.
+ */
+#ifndef TORNEIO_H
+#define TORNEIO_H
+
+#include <stdint.h>
+
+#include "jogo.h"
+#include "simulacao.h"
+
+#define TORNEIO_LOTE 64          // Partidas retiradas da própria fila de cada vez
+#define TORNEIO_MAX_THREADS 256  // Limite de threads de um torneio
+
+// Resumo da execução de um torneio
+struct ResultadoTorneio {
+    double duracao;          // Tempo total em segundos
+    long roubos;             // Quantas faixas foram roubadas entre threads
+    long minPartidasThread;  // Menor número de partidas jogadas por uma thread
+    long maxPartidasThread;  // Maior número de partidas jogadas por uma thread
+};
+
+// --- Protótipos das Funções ---
+int numeroDeNucleos(void); // Função para consultar os núcleos disponíveis
+int executarTorneio(const struct Mapa *mapa, long numPartidas, uint64_t semente, int numJogadores, const struct Politica *politica,
+                    int numThreads, struct EstatisticasSimulacao *total, struct ResultadoTorneio *resultado); // Função para jogar um lote em paralelo
+
+#endif // TORNEIO_H
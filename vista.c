@@ -0,0 +1,353 @@
+/**
+ * @file vista.c
+ * @brief Implementação das visões ordenadas do mapa sobre treaps com tamanho de subárvore.
+ * @note Os nós das treaps são os próprios territórios (vetores paralelos
+ *       indexados pelo território), então nenhuma atualização aloca memória.
+ *       As prioridades saem de um hash do território: a forma das árvores
+ *       não depende da ordem das atualizações e a profundidade esperada é O(log n).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "vista.h"
+
+// Nomes das visões (enum TipoVista), usados pelo roteiro
+static const char *NomesVistas[TOTAL_VISTAS] = {"tropas", "cor", "ameacados"};
+
+/**
+ * @brief Prioridade do nó do território t na treap (finalizador do MurmurHash3).
+ */
+static uint32_t prioridadeNo(int t) {
+    uint32_t h = (uint32_t) t + 0x9e3779b9u;
+    h ^= h >> 16;
+    h *= 0x85ebca6bu;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35u;
+    h ^= h >> 16;
+    return h;
+}
+
+/**
+ * @brief Nós da subárvore de no (0 para uma subárvore vazia).
+ */
+static int tamanhoNo(const struct FlorestaOrdenada *floresta, int no) {
+    return no < 0 ? 0 : floresta->tamanho[no];
+}
+
+/**
+ * @brief Recalcula o tamanho da subárvore de no a partir dos filhos.
+ */
+static void recontarNo(struct FlorestaOrdenada *floresta, int no) {
+    floresta->tamanho[no] = 1 + tamanhoNo(floresta, floresta->esquerdo[no]) + tamanhoNo(floresta, floresta->direito[no]);
+}
+
+/**
+ * @brief Informa se o nó a vem antes do nó b (maior valor primeiro; no empate, o menor território).
+ */
+static int precede(const struct FlorestaOrdenada *floresta, int a, int b) {
+    if (floresta->valor[a] != floresta->valor[b]) return floresta->valor[a] > floresta->valor[b];
+    return a < b;
+}
+
+/**
+ * @brief Une duas treaps em que todos os nós de a vêm antes dos de b.
+ * @return Raiz da treap unida
+ */
+static int unirArvores(struct FlorestaOrdenada *floresta, int a, int b) {
+    if (a < 0) return b;
+    if (b < 0) return a;
+    if (prioridadeNo(a) > prioridadeNo(b)) {
+        floresta->direito[a] = unirArvores(floresta, floresta->direito[a], b);
+        recontarNo(floresta, a);
+        return a;
+    }
+    floresta->esquerdo[b] = unirArvores(floresta, a, floresta->esquerdo[b]);
+    recontarNo(floresta, b);
+    return b;
+}
+
+/**
+ * @brief Divide a treap de raiz no entre os nós que vêm antes do nó pivo e os demais.
+ */
+static void dividirArvore(struct FlorestaOrdenada *floresta, int no, int pivo, int *antes, int *depois) {
+    if (no < 0) {
+        *antes = -1;
+        *depois = -1;
+        return;
+    }
+    if (precede(floresta, no, pivo)) {
+        dividirArvore(floresta, floresta->direito[no], pivo, &floresta->direito[no], depois);
+        *antes = no;
+    } else {
+        dividirArvore(floresta, floresta->esquerdo[no], pivo, antes, &floresta->esquerdo[no]);
+        *depois = no;
+    }
+    recontarNo(floresta, no);
+}
+
+/**
+ * @brief Tira o nó t da subárvore de raiz no.
+ * @return Nova raiz da subárvore
+ */
+static int removerDaArvore(struct FlorestaOrdenada *floresta, int no, int t) {
+    if (no < 0) return -1;
+    if (no == t) return unirArvores(floresta, floresta->esquerdo[t], floresta->direito[t]);
+    if (precede(floresta, t, no)) {
+        floresta->esquerdo[no] = removerDaArvore(floresta, floresta->esquerdo[no], t);
+    } else {
+        floresta->direito[no] = removerDaArvore(floresta, floresta->direito[no], t);
+    }
+    recontarNo(floresta, no);
+    return no;
+}
+
+/**
+ * @brief Põe o território t na árvore 'arvore' com a chave 'valor' (arvore -1 = em nenhuma).
+ * @note Não faz nada se t já está lá com a mesma chave; senão sai da árvore
+ *       antiga e entra na nova, em O(log n) cada.
+ */
+static void posicionarNo(struct FlorestaOrdenada *floresta, int t, int arvore, int32_t valor) {
+    int atual = floresta->arvore[t];
+    if (atual == arvore && (arvore < 0 || floresta->valor[t] == valor)) return;
+
+    if (atual >= 0) floresta->raiz[atual] = removerDaArvore(floresta, floresta->raiz[atual], t);
+    floresta->arvore[t] = arvore;
+    if (arvore < 0) return;
+
+    int antes, depois;
+    floresta->valor[t] = valor;
+    floresta->esquerdo[t] = -1;
+    floresta->direito[t] = -1;
+    floresta->tamanho[t] = 1;
+    dividirArvore(floresta, floresta->raiz[arvore], t, &antes, &depois);
+    floresta->raiz[arvore] = unirArvores(floresta, unirArvores(floresta, antes, t), depois);
+}
+
+/**
+ * @brief Escreve em saida os nós das posições [inicio, fim) da subárvore de no, em ordem.
+ * @note Só desce nas subárvores que cruzam a faixa: O(log n + fim - inicio).
+ */
+static void listarFaixa(const struct FlorestaOrdenada *floresta, int no, int inicio, int fim, int *saida, int *escritos) {
+    if (no < 0 || inicio >= fim) return;
+    int esquerda = tamanhoNo(floresta, floresta->esquerdo[no]);
+    if (inicio < esquerda) listarFaixa(floresta, floresta->esquerdo[no], inicio, fim < esquerda ? fim : esquerda, saida, escritos);
+    if (inicio <= esquerda && esquerda < fim) saida[(*escritos)++] = no;
+    if (fim > esquerda + 1) {
+        listarFaixa(floresta, floresta->direito[no], inicio > esquerda + 1 ? inicio - esquerda - 1 : 0, fim - esquerda - 1,
+                    saida, escritos);
+    }
+}
+
+/**
+ * @brief Aloca uma floresta de numNos nós e numArvores árvores vazias.
+ * @return 0 em caso de sucesso, 1 se faltou memória
+ */
+static int criarFloresta(struct FlorestaOrdenada *floresta, int numNos, int numArvores) {
+    size_t n = (size_t) numNos;
+    floresta->esquerdo = (int *) malloc(n * sizeof(int));
+    floresta->direito = (int *) malloc(n * sizeof(int));
+    floresta->tamanho = (int *) malloc(n * sizeof(int));
+    floresta->valor = (int32_t *) malloc(n * sizeof(int32_t));
+    floresta->arvore = (int *) malloc(n * sizeof(int));
+    floresta->raiz = (int *) malloc((size_t) numArvores * sizeof(int));
+    floresta->numArvores = numArvores;
+    if (floresta->esquerdo == NULL || floresta->direito == NULL || floresta->tamanho == NULL ||
+        floresta->valor == NULL || floresta->arvore == NULL || floresta->raiz == NULL) return 1;
+    memset(floresta->arvore, 0xff, n * sizeof(int));
+    memset(floresta->raiz, 0xff, (size_t) numArvores * sizeof(int));
+    return 0;
+}
+
+/**
+ * @brief Libera os vetores de uma floresta (uma floresta zerada também é aceita).
+ */
+static void liberarFloresta(struct FlorestaOrdenada *floresta) {
+    free(floresta->esquerdo);
+    free(floresta->direito);
+    free(floresta->tamanho);
+    free(floresta->valor);
+    free(floresta->arvore);
+    free(floresta->raiz);
+}
+
+/**
+ * @brief Recalcula a ameaça sobre o território t e a sua posição em VISTA_AMEACADOS.
+ * @note A ameaça é o maior exército vizinho de outra cor; a fronteira está
+ *       ameaçada se ele pode atacar (2 tropas ou mais) e é maior que o de t.
+ */
+static void posicionarAmeaca(struct VistaMapa *vistas, int t) {
+    const struct Jogo *jogo = vistas->jogo;
+    const struct Mapa *mapa = jogo->mapa;
+    int cor = jogo->dono[t];
+    int32_t maior = 0;
+    if (cor != SEM_COR) {
+        for (int k = mapa->inicioVizinhos[t]; k < mapa->inicioVizinhos[t + 1]; k++) {
+            int d = mapa->vizinhos[k];
+            if (jogo->dono[d] != SEM_COR && jogo->dono[d] != cor && jogo->tropas[d] > maior) maior = jogo->tropas[d];
+        }
+    }
+    vistas->ameaca[t] = maior;
+    int ameacado = cor != SEM_COR && maior >= 2 && maior > jogo->tropas[t];
+    posicionarNo(&vistas->ameacas, t, ameacado ? cor : -1, maior - jogo->tropas[t]);
+}
+
+/**
+ * @brief Função para indexar a partida e passar a manter as visões
+ * @note Os jogadores e as cores da partida já devem estar definidos. Indexar
+ *       custa O(n log n); daqui em diante cada escrita de tropas ou dono
+ *       reposiciona só o território e os vizinhos (ver depoisDeAlterar).
+ * @param vistas Visões a preparar
+ * @param jogo Partida indexada (recebe jogo->vistas)
+ * @return 0 em caso de sucesso, 1 se faltou memória (nada fica alocado)
+ */
+int criarVistas(struct VistaMapa *vistas, struct Jogo *jogo) {
+    memset(vistas, 0, sizeof(*vistas));
+    vistas->jogo = jogo;
+    vistas->ameaca = (int32_t *) calloc((size_t) jogo->numTerritorios, sizeof(int32_t));
+    if (vistas->ameaca == NULL || criarFloresta(&vistas->tropas, jogo->numTerritorios, 1) != 0 ||
+        criarFloresta(&vistas->cores, jogo->numTerritorios, jogo->numCores) != 0 ||
+        criarFloresta(&vistas->ameacas, jogo->numTerritorios, jogo->numCores) != 0) {
+        liberarVistas(vistas);
+        return 1;
+    }
+
+    for (int t = 0; t < jogo->numTerritorios; t++) {
+        posicionarNo(&vistas->tropas, t, 0, jogo->tropas[t]);
+        posicionarNo(&vistas->cores, t, jogo->dono[t], jogo->tropas[t]);
+        posicionarAmeaca(vistas, t);
+    }
+    jogo->vistas = vistas;
+    return 0;
+}
+
+/**
+ * @brief Função para parar de manter as visões e liberar os índices
+ * @param vistas Visões criadas por criarVistas (visões zeradas também são aceitas)
+ */
+void liberarVistas(struct VistaMapa *vistas) {
+    if (vistas->jogo != NULL && vistas->jogo->vistas == vistas) vistas->jogo->vistas = NULL;
+    liberarFloresta(&vistas->tropas);
+    liberarFloresta(&vistas->cores);
+    liberarFloresta(&vistas->ameacas);
+    free(vistas->ameaca);
+    memset(vistas, 0, sizeof(*vistas));
+}
+
+/**
+ * @brief Função para reposicionar um território depois de uma escrita
+ * @note Chamada por depoisDeAlterar. As tropas e o dono de t mudam a sua
+ *       posição nas visões de tropas e de cor e a ameaça sobre ele e sobre
+ *       cada vizinho.
+ * @param vistas Visões da partida
+ * @param t Território cujas tropas ou dono mudaram
+ */
+void atualizarVistas(struct VistaMapa *vistas, int t) {
+    const struct Jogo *jogo = vistas->jogo;
+    const struct Mapa *mapa = jogo->mapa;
+    posicionarNo(&vistas->tropas, t, 0, jogo->tropas[t]);
+    posicionarNo(&vistas->cores, t, jogo->dono[t], jogo->tropas[t]);
+    posicionarAmeaca(vistas, t);
+    for (int k = mapa->inicioVizinhos[t]; k < mapa->inicioVizinhos[t + 1]; k++) posicionarAmeaca(vistas, mapa->vizinhos[k]);
+    vistas->atualizacoes++;
+}
+
+/**
+ * @brief Árvore de uma visão (NULL se a cor não vale para a partida).
+ */
+static const struct FlorestaOrdenada *florestaDaVista(const struct VistaMapa *vistas, int tipo, int cor, int *raiz) {
+    const struct FlorestaOrdenada *floresta;
+    int arvore = 0;
+    if (tipo == VISTA_TROPAS) {
+        floresta = &vistas->tropas;
+    } else if (tipo == VISTA_COR || tipo == VISTA_AMEACADOS) {
+        floresta = tipo == VISTA_COR ? &vistas->cores : &vistas->ameacas;
+        arvore = cor;
+    } else {
+        return NULL;
+    }
+    if (arvore < 0 || arvore >= floresta->numArvores) return NULL;
+    *raiz = floresta->raiz[arvore];
+    return floresta;
+}
+
+/**
+ * @brief Função para contar os territórios de uma visão
+ * @param vistas Visões da partida
+ * @param tipo Visão (enum TipoVista)
+ * @param cor Cor filtrada (ignorada em VISTA_TROPAS)
+ * @return Territórios da visão (0 se o tipo ou a cor forem inválidos)
+ */
+int totalVista(const struct VistaMapa *vistas, int tipo, int cor) {
+    int raiz;
+    const struct FlorestaOrdenada *floresta = florestaDaVista(vistas, tipo, cor, &raiz);
+    return floresta != NULL ? tamanhoNo(floresta, raiz) : 0;
+}
+
+/**
+ * @brief Função para obter uma página de uma visão
+ * @note O(log n + quantidade): desce pelos tamanhos das subárvores até a
+ *       posição inicio e percorre só os territórios da página.
+ * @param vistas Visões da partida
+ * @param tipo Visão (enum TipoVista)
+ * @param cor Cor filtrada (ignorada em VISTA_TROPAS)
+ * @param inicio Posição do primeiro território na ordem da visão (a partir de 0)
+ * @param quantidade Territórios pedidos
+ * @param territorios Recebe os territórios da página, em ordem
+ * @return Territórios escritos (menos que quantidade no fim da visão)
+ */
+int consultarVista(const struct VistaMapa *vistas, int tipo, int cor, int inicio, int quantidade, int *territorios) {
+    int raiz;
+    int escritos = 0;
+    const struct FlorestaOrdenada *floresta = florestaDaVista(vistas, tipo, cor, &raiz);
+    if (floresta == NULL || inicio < 0 || quantidade <= 0) return 0;
+    int fim = tamanhoNo(floresta, raiz);
+    if (quantidade < fim - inicio) fim = inicio + quantidade;
+    listarFaixa(floresta, raiz, inicio, fim, territorios, &escritos);
+    return escritos;
+}
+
+/**
+ * @brief Função para imprimir uma página de uma visão
+ * @param vistas Visões da partida
+ * @param tipo Visão (enum TipoVista)
+ * @param cor Cor filtrada (ignorada em VISTA_TROPAS)
+ * @param pagina Página de VISTA_PAGINA territórios (a partir de 1; uma página depois da última mostra a última)
+ */
+void mostrarVista(const struct VistaMapa *vistas, int tipo, int cor, int pagina) {
+    const struct Jogo *jogo = vistas->jogo;
+    int territorios[VISTA_PAGINA];
+    int total = totalVista(vistas, tipo, cor);
+    int paginas = total > 0 ? (total + VISTA_PAGINA - 1) / VISTA_PAGINA : 1;
+    if (pagina < 1) pagina = 1;
+    if (pagina > paginas) pagina = paginas; // Antes da multiplicação: a página pedida vai até 1000000000
+    int n = consultarVista(vistas, tipo, cor, (pagina - 1) * VISTA_PAGINA, VISTA_PAGINA, territorios);
+
+    if (tipo == VISTA_TROPAS) {
+        printf("\n--- Maiores exércitos (página %d de %d, %d territórios) ---\n", pagina, paginas, total);
+    } else if (tipo == VISTA_COR) {
+        printf("\n--- Territórios %s (página %d de %d, %d territórios) ---\n", nomeCor(cor), pagina, paginas, total);
+    } else {
+        printf("\n--- Fronteiras ameaçadas de %s (página %d de %d, %d territórios) ---\n", nomeCor(cor), pagina, paginas, total);
+    }
+    printf("| %-6s | %-21s | %-10s | %-7s | %-7s |\n", "Posição", "Território", "Cor", "Tropas", "Inimigo");
+    for (int i = 0; i < n; i++) {
+        int t = territorios[i];
+        printf("| %-7d | %-20.20s | %-10s | %7d | %7d |\n", (pagina - 1) * VISTA_PAGINA + i + 1,
+               nomeTerritorio(jogo->mapa, t), nomeCor(jogo->dono[t]), jogo->tropas[t], vistas->ameaca[t]);
+    }
+    if (n == 0) printf("(nenhum território nesta página)\n");
+}
+
+/**
+ * @brief Função para converter o nome de uma visão em seu tipo
+ * @param nome "tropas", "cor" ou "ameacados"
+ * @return Tipo da visão (enum TipoVista) ou -1 se o nome for desconhecido
+ */
+int buscarVistaPorNome(const char *nome) {
+    for (int v = 0; v < TOTAL_VISTAS; v++) {
+        if (strcmp(NomesVistas[v], nome) == 0) return v;
+    }
+    return -1;
+}
@@ -0,0 +1,80 @@
+/**
+ * @file vista.h
+ * @brief Visões ordenadas e filtradas do mapa (maiores exércitos, territórios de uma cor e fronteiras ameaçadas).
+ *
+ * Cada visão é servida por um índice de ordem (order statistic): uma treap
+ * em que cada nó é um território e guarda o tamanho da sua subárvore. A
+ * página que começa na posição p sai descendo pelos tamanhos até p e
+ * percorrendo os k territórios seguintes, em O(log n + k), sem varrer nem
+ * ordenar o mapa a cada desenho.
+ *
+ * Índices mantidos:
+ * - VISTA_TROPAS    : todos os territórios, do maior para o menor exército;
+ * - VISTA_COR       : os territórios de cada cor, do maior para o menor exército;
+ * - VISTA_AMEACADOS : as fronteiras ameaçadas de cada cor: territórios com um
+ *                     vizinho inimigo de ao menos 2 tropas e mais tropas que
+ *                     eles, da maior para a menor diferença.
+ * Empates ficam na ordem dos territórios no mapa.
+ *
+ * Os índices são atualizados a cada escrita de tropas ou de dono
+ * (depoisDeAlterar, chamada por atacar() a cada baixa e conquista, pela
+ * distribuição e pelo histórico ao desfazer): O(log n) para as tropas e a
+ * cor do território e O(grau²) para recalcular a ameaça dele e dos vizinhos.
+ * Sem visões na partida (jogo->vistas NULL), a chamada custa uma comparação.
+ */
+#ifndef VISTA_H
+#define VISTA_H
+
+#include <stdint.h>
+
+#include "jogo.h"
+
+#define VISTA_PAGINA 10 // Territórios de cada página das visões no jogo interativo e no roteiro
+
+// Visões disponíveis
+enum TipoVista {
+    VISTA_TROPAS,    // Maiores exércitos do mapa
+    VISTA_COR,       // Territórios de uma cor
+    VISTA_AMEACADOS, // Fronteiras ameaçadas de uma cor
+    TOTAL_VISTAS
+};
+
+// Conjunto de treaps com um nó por território (cada território fica em no máximo uma árvore)
+struct FlorestaOrdenada {
+    int *esquerdo;   // Filho esquerdo de cada nó (-1 se nenhum)
+    int *direito;    // Filho direito de cada nó (-1 se nenhum)
+    int *tamanho;    // Nós da subárvore de cada nó
+    int32_t *valor;  // Chave com que o nó foi inserido (ordem decrescente de valor, depois crescente de território)
+    int *arvore;     // Árvore onde está cada território (-1 se em nenhuma)
+    int *raiz;       // Raiz de cada árvore (-1 se vazia)
+    int numArvores;
+};
+
+// Índices das visões de uma partida (ligados a ela por jogo->vistas)
+struct VistaMapa {
+    struct Jogo *jogo;                // Partida indexada
+    struct FlorestaOrdenada tropas;   // VISTA_TROPAS: uma árvore
+    struct FlorestaOrdenada cores;    // VISTA_COR: uma árvore por cor
+    struct FlorestaOrdenada ameacas;  // VISTA_AMEACADOS: uma árvore por cor
+    int32_t *ameaca;                  // Maior exército inimigo vizinho de cada território (0 se nenhum)
+    long atualizacoes;                // Territórios reposicionados desde a criação
+};
+
+// --- Protótipos das Funções ---
+int criarVistas(struct VistaMapa *vistas, struct Jogo *jogo); // Função para indexar a partida e passar a manter as visões (0 em caso de sucesso)
+void liberarVistas(struct VistaMapa *vistas);                 // Função para parar de manter as visões e liberar os índices
+void atualizarVistas(struct VistaMapa *vistas, int t);        // Função para reposicionar um território e os vizinhos depois de uma escrita (ver depoisDeAlterar)
+int totalVista(const struct VistaMapa *vistas, int tipo, int cor); // Função para contar os territórios de uma visão
+int consultarVista(const struct VistaMapa *vistas, int tipo, int cor, int inicio, int quantidade, int *territorios); // Função para obter uma página de uma visão (retorna os territórios escritos)
+void mostrarVista(const struct VistaMapa *vistas, int tipo, int cor, int pagina); // Função para imprimir uma página de VISTA_PAGINA territórios
+int buscarVistaPorNome(const char *nome);                     // Função para converter o nome de uma visão em seu tipo (-1 se desconhecido)
+
+/**
+ * @brief Avisa as visões de que as tropas ou o dono do território t mudaram.
+ * @note Sem visões, custa uma comparação.
+ */
+static inline void depoisDeAlterar(struct Jogo *jogo, int t) {
+    if (jogo->vistas != NULL) atualizarVistas(jogo->vistas, t);
+}
+
+#endif // VISTA_H
@@ -11,13 +11,43 @@
  *   passagem por valor/referência constante (const) para apenas ler.
  * - Foco em: Design de software, modularização, const correctness, lógica de jogo.
  *
+ * @section modules Módulos
+ * - war.c       : Interface com o usuário (menus, cadastro e leitura do teclado)
+ * - jogo.c      : Regras do jogo (batalhas, conquistas e missões)
+ * - simulacao.c : Partidas automáticas em lote para análise de balanceamento
+ * - batalha.c   : Tabela de Markov para resolver uma batalha inteira de uma vez
+ * - bench.c     : Microbenchmarks das funções mais quentes
+ * - suite.c     : Suíte repetível de microbenchmarks com percentis (make bench)
+ * - rng.c       : Gerador de números aleatórios com estado por partida (xoshiro256**)
+ * - torneio.c   : Lotes de partidas em várias threads com roubo de trabalho
+ * - mapa.c      : Mapas carregados de arquivo (territórios, continentes e fronteiras)
+ * - missao.c    : Avaliação das missões a cada troca de dono de território
+ * - tela.c      : Desenho do mapa em quadros com um único write (só as linhas alteradas)
+ * - roteiro.c   : Partidas conduzidas por um roteiro de comandos (repetição e regressão)
+ * - estado.c    : Arquivos de estado para salvar e retomar partidas (mmap)
+ * - mcts.c      : Jogador automático por busca em árvore de Monte Carlo
+ * - metricas.c  : Contadores dos pontos quentes gravados para o Prometheus e em JSON
+ * - servidor.c  : Servidor de muitas partidas num socket Unix (laços epoll)
+ * - carga.c     : Cliente de carga do servidor (latência e partidas por núcleo)
+ * - arena.c     : Arenas de memória reaproveitadas pelas partidas de vida curta
+ * - lote.c      : Rodadas de dados de muitas batalhas de uma vez (SIMD)
+ * - planejador.c : Sequência de conquistas mais provável até o alvo da missão (Dijkstra)
+ * - historico.c : Versões da partida com cópia na escrita (desfazer, refazer e ramos do MCTS)
+ * - eventos.c   : Diário binário dos eventos das partidas (anéis por thread e gravação em segundo plano)
+ * - vista.c     : Visões ordenadas do mapa (maiores exércitos, cores e fronteiras ameaçadas) com índices de ordem
+ *
  * @section compilation Compilação
  * Para compilar este projeto, você pode usar os seguintes comandos make:
  *
  * - make all       : Compila o projeto
  * - make run      : Compila e executa o programa
  * - make valgrind : Executa com verificação de vazamento de memória
+ *                   (make valgrind ARGS="--simulate 10000 --seed 1" roda sem interação)
  * - make debug    : Compila com flags de depuração adicionais
+ * - make quiet    : Compila sem narração das partidas nem desenho do mapa (-DWAR_SILENCIOSO)
+ * - make metrics  : Compila com os contadores dos pontos quentes (-DWAR_METRICAS; ver --metrics)
+ * - make release  : Compila otimizado (-O2); make lto e make pgo acrescentam LTO e otimização guiada por perfil
+ * - make bench    : Compila um perfil otimizado (PERFIL_BENCH, padrão release) e roda a suíte de microbenchmarks
  * - make clean    : Remove arquivos compilados
  *
  * Exemplo de uso:
@@ -25,7 +55,43 @@
  * $ make clean    # Limpa compilações anteriores
  * $ make         # Compila o projeto
  * $ make run     # Executa o programa
+ * $ bin/war --simulate 1000000 --seed 42   # Simula um milhão de partidas sem interação
  * @endcode
+ *
+ * @section options Opções de linha de comando
+ * - --simulate N : Joga N partidas automáticas e reporta partidas/s
+ * - --seed S     : Semente do gerador de números aleatórios (repete a partida exatamente)
+ * - --players N  : Número de jogadores nas partidas simuladas (padrão 3, até 96;
+ *                  acima de 6 entram as cores numeradas Cor7, Cor8...)
+ * - --policy P   : Política das partidas simuladas: gulosa (padrão) ou aleatoria
+ * - --threads T  : Threads da simulação (padrão: todos os núcleos)
+ * - --scaling    : Mede partidas/s da simulação com 1, 2, 4... threads até --threads
+ * - --bench [N]  : Mede rodadas de dados/s (N rodadas, padrão BENCH_RODADAS_PADRAO)
+ * - --bench-suite [ARQ] : Roda a suíte de microbenchmarks (percentis); grava os resultados
+ *                  em ARQ, em JSON ou CSV pela extensão (formato em suite.h)
+ * - --map ARQ    : Joga (ou simula) no mapa do arquivo ARQ em vez do mapa clássico
+ *                  (formato em mapa.h; exemplo em mapas/classico.map)
+ * - --generate-map N ARQ : Grava em ARQ um mapa em grade com N territórios e sai
+ * - --quiet      : Jogo interativo sem desenho do mapa nem narração das batalhas
+ * - --script ARQ : Joga a partida descrita no roteiro ARQ ("-" = entrada padrão) e
+ *                  imprime o resultado (formato em roteiro.h)
+ * - --verbose    : Com --script, narra as batalhas e desenha o mapa no comando 'mapa'
+ * - --record ARQ : Grava o jogo interativo em ARQ como um roteiro (repete com --script)
+ * - --resume ARQ : Retoma a partida salva em ARQ (opção 5 do menu) em vez de cadastrar uma nova
+ * - --ai-budget MS : Tempo de cada decisão do computador em ms (padrão 50; usa --threads threads)
+ * - --serve SOCKET : Atende partidas simultâneas no socket Unix SOCKET com --threads laços
+ *                  epoll até SIGINT/SIGTERM (protocolo em servidor.h)
+ * - --load SOCKET N [TAXA] : Joga N partidas simultâneas no servidor de SOCKET, TAXA
+ *                  comandos/s cada (padrão 10; 0 = sem pausa), e mede latência e partidas/núcleo
+ * - --metrics PREFIXO : Com make metrics, grava os contadores em PREFIXO.prom (Prometheus) e
+ *                  PREFIXO.json na saída do programa e a cada SIGUSR1 (formato em metricas.h)
+ * - --event-log ARQ : Registra dados, baixas, conquistas, movimentos e missões de --simulate,
+ *                  --script ou do jogo interativo no diário binário ARQ (formato em eventos.h)
+ * - --decode-log ARQ [texto|csv] : Converte o diário ARQ em texto (padrão) ou CSV na saída
+ *                  padrão e sai (use o mesmo --map da gravação)
+ * - --engine M   : Motor das partidas: automatico (padrão: o compacto no mapa clássico, o
+ *                  genérico nos demais), generico ou compacto (só em mapas de 5 territórios);
+ *                  todos chegam ao mesmo resultado
  */
 
 // Inclusão das bibliotecas padrão necessárias para entrada/saída, alocação de memória, manipulação de strings e tempo.
@@ -33,180 +99,478 @@
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
-
-// --- Constantes Globais ---
-// Definem valores fixos para o número de territórios, missões e tamanho máximo de strings, facilitando a manutenção.
-#define MAX_TERRITORIOS 5  // Definição do número máximo de países
-#define MAX_MISSOES 9      // Definição do número máximo de missões
-#define MAX_JOGADORES 3    // Definição do número máximo de jogadores
-#define TAM_STRING 100     // Definição do tamanho máximo das strings (aumentado para evitar erro de inicialização)
-
-// Define o vetor de cores disponíveis para os jogadores
-const char *cores[] = {"Vermelho", "Azul", "Verde", "Amarelo", "Preto", "Branco"};
-
-// --- Estrutura de Dados ---
-// Define a estrutura para um território, contendo seu nome, a cor do exército que o domina e o número de tropas.
-// Definição da Estrutura do Território do Jogo
-
-// Definição da estrutura para os territórios/países
-// definindo o nome, a cor predominante e a quantidade de tropas do território
-struct Territorio {
-    char nome[TAM_STRING]; // Nome do território
-    char cor[10];          // Cor dominante do território
-    int tropas;            // Número de tropas no território
-};
-
-// Definição do vetor País, para os países, do tipo struct Territorio
-struct Territorio *Pais;
-
-// Definição da estrutura para os jogadores
-// definindo a cor do exército e a missão secreta do jogador
-struct Jogador {
-    char cor[10];       // Cor do exército do jogador
-    int territorios;    // Número de territórios conquistados pelo jogador
-    int missaoCumprida; // 1 - Sim e 0 - Não
-    int missao;         // Código da missão secreta do jogador
-};
-
-// Definição do vetor Jogadores, para os jogadores, do tipo struct Jogador
-struct Jogador *Jogadores;
-
-// Definição da estrutura para as missões
-// definindo o nome, a descrição da missão
-struct Missao {
-    int codigo;                 // Número da missão
-    char cor[10];               // Cor do exército a ser destruído
-    char descricao[TAM_STRING]; // Descrição da missão
-};
-
-int numJogadores; // Variável global para armazenar o número de jogadores
-
-// Definição do vetor Missões, para as missões, do tipo struct Missao
-const struct Missao Missoes[] = {
-    {0, "Branco", "Destruir o exército Branco. Caso não exista ou é sua própria cor, conquistar 5 territórios"},
-    {1, "Preto", "Destruir o exército Preto. Caso não exista ou é sua própria cor, conquistar 5 territórios"},
-    {2, "Verde", "Destruir o exército Verde. Caso não exista ou é sua própria cor, conquistar 5 territórios"},
-    {3, "Azul", "Destruir o exército Azul. Caso não exista ou é sua própria cor, conquistar 5 territórios"},
-    {4, "Amarelo", "Destruir o exército Amarelo. Caso não exista ou é sua própria cor, conquistar 5 territórios"},
-    {5, "Vermelho", "Destruir o exército Vermelho. Caso não exista ou é sua própria cor, conquistar 5 territórios"},
-    {6, "", "Conquistar 3 territórios"},
-    {7, "", "Conquistar 4 territórios"},
-    {8, "", "Conquistar 5 territórios"}
-};
-
-#define TOTAL_MISSOES (sizeof(Missoes) / sizeof(Missoes[0]))       // Calcula o número de missões disponíveis
+#include <stdint.h>
+#include <stdarg.h>
+
+#include "jogo.h"
+#include "simulacao.h"
+#include "bench.h"
+#include "suite.h"
+#include "torneio.h"
+#include "mapa.h"
+#include "tela.h"
+#include "roteiro.h"
+#include "estado.h"
+#include "mcts.h"
+#include "batalha.h"
+#include "metricas.h"
+#include "servidor.h"
+#include "carga.h"
+#include "arena.h"
+#include "planejador.h"
+#include "historico.h"
+#include "eventos.h"
+#include "vista.h"
+
+// O estado da partida fica todo em struct Jogo (jogadores, territórios e
+// número de jogadores); aqui ficam só os recursos do terminal, que existe um
+// por processo. O servidor (servidor.h) guarda cada partida na sua sessão.
+
+// Tela onde o mapa da partida interativa é desenhado
+static struct Tela TelaMapa;
+
+// Roteiro onde a partida interativa é gravada (NULL se não houver --record)
+static FILE *Gravacao;
+
+// Configuração e estatísticas dos jogadores controlados pelo computador
+static struct ContextoMcts ContextoIA;
+
+// Planejador que sugere a sequência de conquistas ao jogador humano
+static struct Planejador PlanejadorAtaque;
+
+// Versões do turno em andamento (opções desfazer e refazer ataque do menu)
+static struct Historico HistoricoTurno;
+
+// 1 depois que a entrada padrão acabou (ver limparBufferEntrada): as perguntas
+// seguintes recebem respostas padrão e o jogo sai pela limpeza normal
+static int FimDaEntrada;
+
+// Índices das visões ordenadas do mapa (opção consultar o mapa do menu)
+static struct VistaMapa VistasMapa;
 
 // --- Protótipos das Funções ---
 // Declarações antecipadas de todas as funções que serão usadas no programa, organizadas por categoria.
 // Funções de setup e gerenciamento de memória:
-struct Territorio *alocarMemoriaMapa();   // Função para alocar dinamicamente o mapa do mundo
-struct Jogador *alocarMemoriaJogadores(); // Função para alocar dinamicamente os jogadores
-void liberarMemoria();                    // Função para liberar a memória alocada para o mapa
+void liberarMemoria(struct Jogo *jogo);   // Função para liberar a memória alocada para o mapa
+int encerrarPrograma(struct Jogo *jogo, struct Mapa *mapa, int status); // Função para liberar a partida interativa, o mapa e a tabela de batalhas
+struct Mapa *prepararMapa(const char *caminho); // Função para carregar o mapa escolhido e reportar tempo e memória
 
 // Funções de interface com o usuário:
-void cadastroTerritorios(struct Territorio **Pais, struct Jogador **Jogadores, int totalJogadores);               // Função de inicialização (cadastro) dos países
-void cadastroJogadores(struct Jogador **Jogadores, const struct Missao *Missoes, int totalMissoes, int *numJogadores); // Função de inicialização (cadastro) dos jogadores
-void atacar(struct Territorio* ataque, struct Territorio* defesa, struct Jogador *Jogador, const struct Missao *Missoes); // Função para realizar um ataque entre dois países
-void ordenarDados(int* dados, int n);     // Função auxiliar para ordenar os dados
-void mostrarMapa(const struct Territorio* mapa, int totalTerritorios); // Função para mostrar o mapa atual
-void definirAtaqueDefesa(struct Territorio **paisAtaque, struct Territorio **paisDefesa, const char *corJogador); // Função para definir os países de ataque e defesa
-struct Territorio *buscarTerritorioPorNome(const char *nome); // Função para buscar um território pelo nome
+void cadastroTerritorios(struct Jogo *jogo);  // Função de inicialização (cadastro) dos países
+void cadastroJogadores(struct Jogo *jogo, const struct Missao *Missoes, int totalMissoes, int *numJogadores); // Função de inicialização (cadastro) dos jogadores
+void mostrarMapa(const struct Jogo *jogo, int completo); // Função para mostrar o mapa atual (inteiro ou só o que mudou)
+int definirAtaqueDefesa(struct Jogo *jogo, int *paisAtaque, int *paisDefesa, int corJogador); // Função para definir os países de ataque e defesa (0 se cancelado)
+int podeAtacarDe(const struct Jogo *jogo, int t); // Função para saber se um território tem tropas e um vizinho inimigo para atacar
+void mostrarPlano(const struct Jogo *jogo, int indiceJogador); // Função para mostrar a sequência de conquistas mais provável para a missão
+void consultarVistas(const struct Jogo *jogo);              // Função para mostrar uma página de uma visão ordenada do mapa
+int buscarTerritorioDigitado(const struct Jogo *jogo, const char *nome); // Função para achar o território digitado (aceita maiúsculas diferentes e prefixos)
 void exibirMenuPrincipal(int indiceJogador);               // Função para exibir o menu principal
-void visualizarMissao(struct Jogador *jogador, int indiceJogador, const struct Missao *missoes); // Função para visualizar a missão do jogador
+void visualizarMissao(const struct Jogo *jogo, int indiceJogador, const struct Missao *missoes); // Função para visualizar a missão do jogador
+int anunciarVencedor(const struct Jogo *jogo, int indiceJogador); // Função para anunciar o vencedor, se alguém já cumpriu a missão
+void salvarPartidaDigitada(const struct Jogo *jogo, int indiceJogador); // Função para salvar a partida no arquivo digitado
+int jogarTurnoComputador(struct Jogo *jogo, int indiceJogador); // Função para jogar o turno de um jogador controlado pelo computador
 
-// Funções de lógica principal do jogo:
 // Função utilitária:
-void limparBufferEntrada();               // Função para limpar o buffer de entrada
+int limparBufferEntrada();                // Função para limpar o buffer de entrada (1 no fim da entrada)
+void gravarComando(const char *formato, ...); // Função para gravar um comando no roteiro da partida
+
+// Política de decisão que lê as escolhas do teclado
+extern const struct Politica politicaHumana;
+
+// Gravador das rodadas e movimentos de atacar() no roteiro (--record)
+extern const struct GravadorAtaque gravadorRoteiro;
 
 // --- Função Principal (main) ---
 // Função principal que orquestra o fluxo do jogo, chamando as outras funções em ordem.
-int main() {
-    //(Setup):
-    // - Define o locale para português.
-    // - Inicializa a semente para geração de números aleatórios com base no tempo atual.
-    srand(time(NULL));
+int main(int argc, char *argv[]) {
+    // Opções de linha de comando
+    long partidasSimuladas = 0;              // 0 = jogo interativo
+    long rodadasBench = 0;                   // 0 = sem microbenchmark
+    int suite = 0;                           // 1 = suíte de microbenchmarks
+    const char *resultadosSuite = NULL;      // Arquivo de resultados da suíte (JSON ou CSV)
+    uint64_t semente = (uint64_t) time(NULL);
+    int jogadoresSimulados = JOGADORES_CLASSICO;
+    const struct Politica *politicaSimulada = &politicaGulosa;
+    int threads = numeroDeNucleos();
+    int medirThreads = 0;                    // 1 = relatório de escalabilidade
+    const char *caminhoMapa = NULL;          // NULL = mapa clássico embutido
+    int silencioso = 0;                      // 1 = sem desenho do mapa nem narração
+    const char *caminhoRoteiro = NULL;       // Roteiro a executar (--script)
+    const char *caminhoGravacao = NULL;      // Roteiro a gravar (--record)
+    const char *caminhoEstado = NULL;        // Partida salva a retomar (--resume)
+    int roteiroVerboso = 0;                  // 1 = narra a partida do roteiro
+    double orcamentoIA = MCTS_ORCAMENTO_PADRAO_MS; // Tempo de cada decisão do computador (ms)
+    const char *prefixoMetricas = NULL;      // Arquivos de métricas (--metrics)
+    const char *socketServidor = NULL;       // Socket do servidor de partidas (--serve)
+    const char *socketCarga = NULL;          // Socket medido pelo cliente de carga (--load)
+    int partidasCarga = 0;                   // Partidas simultâneas do cliente de carga
+    double taxaCarga = CARGA_TAXA_PADRAO;    // Comandos/s de cada partida do cliente de carga
+    const char *caminhoDiario = NULL;        // Diário binário de eventos (--event-log)
+    const char *diarioDecodificar = NULL;    // Diário a converter em texto ou CSV (--decode-log)
+    int diarioCsv = 0;                       // 1 = --decode-log em CSV
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--simulate") == 0 && i + 1 < argc) {
+            partidasSimuladas = atol(argv[++i]);
+        } else if (strcmp(argv[i], "--bench") == 0) {
+            rodadasBench = (i + 1 < argc && argv[i + 1][0] != '-') ? atol(argv[++i]) : BENCH_RODADAS_PADRAO;
+        } else if (strcmp(argv[i], "--bench-suite") == 0) {
+            suite = 1;
+            if (i + 1 < argc && argv[i + 1][0] != '-') resultadosSuite = argv[++i];
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            semente = (uint64_t) strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--scaling") == 0) {
+            medirThreads = 1;
+        } else if (strcmp(argv[i], "--players") == 0 && i + 1 < argc) {
+            jogadoresSimulados = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--quiet") == 0) {
+            silencioso = 1;
+        } else if (strcmp(argv[i], "--verbose") == 0) {
+            roteiroVerboso = 1;
+        } else if (strcmp(argv[i], "--script") == 0 && i + 1 < argc) {
+            caminhoRoteiro = argv[++i];
+        } else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            caminhoGravacao = argv[++i];
+        } else if (strcmp(argv[i], "--resume") == 0 && i + 1 < argc) {
+            caminhoEstado = argv[++i];
+        } else if (strcmp(argv[i], "--ai-budget") == 0 && i + 1 < argc) {
+            orcamentoIA = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--serve") == 0 && i + 1 < argc) {
+            socketServidor = argv[++i];
+        } else if (strcmp(argv[i], "--load") == 0 && i + 2 < argc) {
+            socketCarga = argv[++i];
+            partidasCarga = atoi(argv[++i]);
+            if (i + 1 < argc && argv[i + 1][0] != '-') taxaCarga = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--metrics") == 0 && i + 1 < argc) {
+            prefixoMetricas = argv[++i];
+        } else if (strcmp(argv[i], "--event-log") == 0 && i + 1 < argc) {
+            caminhoDiario = argv[++i];
+        } else if (strcmp(argv[i], "--decode-log") == 0 && i + 1 < argc) {
+            diarioDecodificar = argv[++i];
+            if (i + 1 < argc && argv[i + 1][0] != '-') {
+                const char *formato = argv[++i];
+                if (strcmp(formato, "texto") != 0 && strcmp(formato, "csv") != 0) {
+                    printf("Formato desconhecido: %s (use texto ou csv)\n", formato);
+                    return 1;
+                }
+                diarioCsv = strcmp(formato, "csv") == 0;
+            }
+        } else if (strcmp(argv[i], "--map") == 0 && i + 1 < argc) {
+            caminhoMapa = argv[++i];
+        } else if (strcmp(argv[i], "--generate-map") == 0 && i + 2 < argc) {
+            int territorios = atoi(argv[i + 1]);
+            struct Mapa *grade = criarMapaGrade(territorios);
+            int erro = (grade == NULL || gravarMapa(grade, argv[i + 2]) != 0);
+            liberarMapa(grade);
+            if (erro) {
+                printf("Erro ao gerar o mapa %s (são necessários ao menos 2 territórios).\n", argv[i + 2]);
+                return 1;
+            }
+            printf("Mapa com %d territórios gravado em %s.\n", territorios, argv[i + 2]);
+            return 0;
+        } else if (strcmp(argv[i], "--engine") == 0 && i + 1 < argc) {
+            if (preferirMotor(argv[++i]) != 0) {
+                printf("Motor desconhecido: %s (use automatico, generico ou compacto)\n", argv[i]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--policy") == 0 && i + 1 < argc) {
+            politicaSimulada = buscarPolitica(argv[++i]);
+            if (politicaSimulada == NULL) {
+                printf("Política desconhecida: %s\n", argv[i]);
+                return 1;
+            }
+        } else {
+            printf("Uso: %s [--simulate N] [--seed S] [--players N] [--policy gulosa|aleatoria]\n"
+                   "       [--threads T] [--scaling] [--bench [N]] [--bench-suite [ARQ]] [--map ARQ] [--generate-map N ARQ] [--quiet]\n"
+                   "       [--script ARQ [--verbose]] [--record ARQ] [--resume ARQ] [--ai-budget MS] [--metrics PREFIXO]\n"
+                   "       [--serve SOCKET] [--load SOCKET N [TAXA]] [--event-log ARQ] [--decode-log ARQ [texto|csv]]\n"
+                   "       [--engine automatico|generico|compacto]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    // Contadores dos pontos quentes (só com make metrics); antes de qualquer thread
+    if (prefixoMetricas != NULL && iniciarMetricas(prefixoMetricas) != 0) {
+        return 1;
+    }
+
+    // As arenas que sobrarem no pool da thread principal são liberadas na saída
+    atexit(liberarPoolArenas);
 
-    // Aloca a memória para o mapa do mundo e verifica se a alocação foi bem-sucedida.
-    Pais = alocarMemoriaMapa();
+    // Conversão de um diário de eventos (o mapa só dá nome aos territórios; nada é impresso antes)
+    if (diarioDecodificar != NULL) {
+        struct Mapa *mapa = caminhoMapa != NULL ? carregarMapa(caminhoMapa) : criarMapaClassico();
+        if (mapa == NULL) {
+            printf("Erro ao carregar o mapa.\n");
+            return 1;
+        }
+        int resultado = decodificarDiario(diarioDecodificar, mapa, diarioCsv);
+        liberarMapa(mapa);
+        return resultado;
+    }
+
+    // Microbenchmarks
+    if (rodadasBench > 0) {
+        return executarBenchmarks(rodadasBench, semente);
+    }
+
+    // Suíte de microbenchmarks (make bench)
+    if (suite) {
+        return executarSuite(semente, resultadosSuite);
+    }
+
+    // Cliente de carga: mede um servidor já em execução
+    if (socketCarga != NULL) {
+        return executarCarga(socketCarga, partidasCarga, taxaCarga, semente);
+    }
+
+    // Servidor de partidas: cada conexão ao socket joga a sua partida
+    if (socketServidor != NULL) {
+        struct Mapa *mapa = prepararMapa(caminhoMapa);
+        if (mapa == NULL) return 1;
+        int resultado = executarServidor(mapa, socketServidor, semente, threads);
+        liberarMapa(mapa);
+        return resultado;
+    }
 
-    if (Pais == NULL){
+    // Partida conduzida por roteiro: os comandos vêm do arquivo, não do teclado
+    if (caminhoRoteiro != NULL) {
+        struct Mapa *mapa = prepararMapa(caminhoMapa);
+        if (mapa == NULL) return 1;
+        if (caminhoDiario != NULL && abrirDiario(caminhoDiario, mapa) != 0) {
+            liberarMapa(mapa);
+            return 1;
+        }
+        int resultado = executarRoteiro(mapa, caminhoRoteiro, semente, roteiroVerboso);
+        if (fecharDiario(NULL) != 0) resultado = 1;
+        liberarMapa(mapa);
+        return resultado;
+    }
+
+    // Modo de simulação: nenhuma entrada do usuário é lida
+    if (partidasSimuladas > 0) {
+        if (jogadoresSimulados < 2 || jogadoresSimulados > MAX_JOGADORES) {
+            printf("Número de jogadores deve estar entre 2 e %d.\n", MAX_JOGADORES);
+            return 1;
+        }
+        if (threads < 1 || threads > TORNEIO_MAX_THREADS) {
+            printf("Número de threads deve estar entre 1 e %d.\n", TORNEIO_MAX_THREADS);
+            return 1;
+        }
+        struct Mapa *mapa = prepararMapa(caminhoMapa);
+        if (mapa == NULL) return 1;
+        if (caminhoDiario != NULL && abrirDiario(caminhoDiario, mapa) != 0) {
+            liberarMapa(mapa);
+            return 1;
+        }
+        int resultado = medirThreads
+            ? medirEscalabilidade(mapa, partidasSimuladas, semente, jogadoresSimulados, politicaSimulada, threads)
+            : executarSimulacao(mapa, partidasSimuladas, semente, jogadoresSimulados, politicaSimulada, threads);
+        if (fecharDiario(NULL) != 0) resultado = 1;
+        liberarMapa(mapa);
+        return resultado;
+    }
+
+    // Carrega o mapa do mundo (do arquivo ou o clássico)
+    struct Mapa *mapa = prepararMapa(caminhoMapa);
+    if (mapa == NULL) return 1;
+
+    // Aloca a memória para os territórios e jogadores e verifica se a alocação foi bem-sucedida.
+    // Partida interativa: o estado fica em jogo; só a tela, o planejador, o
+    // histórico, as visões e o contexto do computador são globais deste arquivo
+    struct Jogo jogo = {0};
+    int indiceJogador = 0; // Índice do jogador atual (para múltiplos jogadores)
+    int numJogadores = 0;  // Número de jogadores da partida
+    if (caminhoEstado != NULL) {
+        // Partida salva: o arquivo é mapeado, sem refazer o cadastro
+        double inicio = relogioSegundos();
+        if (retomarPartida(&jogo, mapa, caminhoEstado, &indiceJogador) != 0) {
+            liberarMapa(mapa);
+            return 1;
+        }
+        printf("Partida %s retomada em %.3f ms (jogador da vez: %d)\n\n", caminhoEstado,
+               (relogioSegundos() - inicio) * 1000.0, indiceJogador + 1);
+    } else if (alocarJogo(&jogo, mapa) != 0) {
         printf("Erro na alocação de memória para o mapa.\n");
-        liberarMemoria();
+        liberarMapa(mapa);
         return 1;
     }
+    if (criarTela(&TelaMapa, mapa->numTerritorios) != 0 || criarPlanejador(&PlanejadorAtaque, mapa->numTerritorios) != 0) {
+        printf("Erro na alocação de memória para o mapa.\n");
+        liberarMemoria(&jogo);
+        liberarMapa(mapa);
+        return 1;
+    }
+    if (caminhoDiario != NULL && abrirDiario(caminhoDiario, mapa) != 0) {
+        liberarMemoria(&jogo);
+        liberarMapa(mapa);
+        return 1;
+    }
+    struct Jogador *Jogadores = jogo.jogadores;
+    jogo.verboso = !silencioso;
+    jogo.diario = diarioAberto();
+    diarioPartida(&jogo, 0);
+    TelaMapa.silenciosa = silencioso;
+
+    // Jogadores do computador: a busca usa fluxos próprios, sem tocar no gerador da partida
+    if (iniciarContextoMcts(&ContextoIA, orcamentoIA, threads, semente) != 0) {
+        printf("Erro na alocação de memória para o mapa.\n");
+        return encerrarPrograma(&jogo, mapa, 1);
+    }
+    jogo.contexto = &ContextoIA;
+
+    // Grava a partida como roteiro, começando pela semente
+    if (caminhoGravacao != NULL && (Gravacao = fopen(caminhoGravacao, "w")) == NULL) {
+        printf("Erro ao criar o roteiro %s.\n", caminhoGravacao);
+        return encerrarPrograma(&jogo, mapa, 1);
+    }
+    gravarComando("# Partida gravada por war --record; repita com: war --script %s\n", caminhoGravacao ? caminhoGravacao : "");
+    if (Gravacao != NULL) jogo.gravador = &gravadorRoteiro;
 
     // 1. Configuração Inicial
     printf("========================================\n");
     printf("======       WAR ESTRUTURADO      ======\n");
     printf("========================================\n\n");
 
-    // Cadastro dos jogadores
-    // Aloca a memória para os jogadores
-    Jogadores = alocarMemoriaJogadores();
+    if (caminhoEstado != NULL) {
+        // Jogadores, missões, territórios e gerador vêm do arquivo
+        numJogadores = jogo.numJogadores;
+        for (int i = 0; i < numJogadores; i++) Jogadores[i].politica = &politicaHumana;
+        gravarComando("carregar %s\n", caminhoEstado);
+        mostrarMapa(&jogo, 1);
+    } else {
+        // Inicializa o gerador da partida; a mesma semente repete a partida exatamente
+        rngSemear(&jogo.rng, semente);
+        printf("Semente da partida: %llu (use --seed para repetir)\n\n", (unsigned long long) semente);
+        gravarComando("semente %llu\n", (unsigned long long) semente);
 
-    if (Jogadores == NULL) {
-        printf("Erro na alocação de memória para os jogadores.\n");
-        liberarMemoria();
-        return 1;
+        // Define a cor do jogador e sorteia sua missão secreta.
+        cadastroJogadores(&jogo, Missoes, TOTAL_MISSOES, &numJogadores);
+
+        // Cadastro dos territórios
+        // Preenche os territórios com seus dados iniciais (tropas, donos, etc.).
+        if (!FimDaEntrada) cadastroTerritorios(&jogo);
     }
 
-    // Define a cor do jogador e sorteia sua missão secreta.
-    cadastroJogadores(&Jogadores, Missoes, TOTAL_MISSOES, &numJogadores);
+    // Variável de opção do menu
+    int opcao = -1;
+    int turnosSemAtaque = 0; // Turnos seguidos do computador sem nenhum ataque
 
-    // Cadastro dos territórios
-    // Preenche os territórios com seus dados iniciais (tropas, donos, etc.).
-    cadastroTerritorios(&Pais, &Jogadores, numJogadores);
+    // Uma partida carregada pode já ter um vencedor
+    if (anunciarVencedor(&jogo, indiceJogador)) return encerrarPrograma(&jogo, mapa, 0);
 
-    // Variável de opção do menu
-    int opcao;
-    int indiceJogador = 0; // Índice do jogador atual (para múltiplos jogadores)
+    // Daqui em diante cada ataque do turno pode ser desfeito
+    // e as visões do mapa acompanham cada baixa e conquista
+    if (criarHistorico(&HistoricoTurno, &jogo) != 0 || criarVistas(&VistasMapa, &jogo) != 0) {
+        printf("Erro na alocação de memória para o mapa.\n");
+        return encerrarPrograma(&jogo, mapa, 1);
+    }
 
     do {
+        // Entrada esgotada: sai pela limpeza normal, com status de erro
+        if (FimDaEntrada) break;
+
+        // O computador joga o turno inteiro sem passar pelo menu
+        if (Jogadores[indiceJogador].politica != &politicaHumana) {
+            int ataques = jogarTurnoComputador(&jogo, indiceJogador);
+            if (anunciarVencedor(&jogo, indiceJogador)) break;
+
+            // Só computadores na mesa e uma rodada inteira sem ataques: a partida travou
+            turnosSemAtaque = (ataques == 0) ? turnosSemAtaque + 1 : 0;
+            if (turnosSemAtaque >= numJogadores) {
+                printf("Nenhum jogador atacou em uma rodada inteira. Partida encerrada sem vencedor.\n");
+                break;
+            }
+            indiceJogador = (indiceJogador + 1) % numJogadores;
+            limparHistorico(&HistoricoTurno);
+            gravarComando("fim\n");
+            continue;
+        }
+
         // Exibe o menu principal
         exibirMenuPrincipal(indiceJogador);
 
         // Solicita a escolha do jogador
         printf("Escolha uma opcao: ");
         scanf("%d", &opcao);
-        limparBufferEntrada();
+        if (limparBufferEntrada()) break;
 
         switch (opcao) {
             case 1:
                 // Inicia a fase de ataque
-                // Exibe o mapa atual
-                mostrarMapa(Pais, MAX_TERRITORIOS);
+                // Exibe o que mudou no mapa desde o último desenho
+                mostrarMapa(&jogo, 0);
 
                 // Define os países envolvidos
-                struct Territorio *paisAtaque;
-                struct Territorio *paisDefesa;
+                int paisAtaque;
+                int paisDefesa;
 
-                definirAtaqueDefesa(&paisAtaque, &paisDefesa, Jogadores[indiceJogador].cor);
+                if (!Jogadores[indiceJogador].politica->escolherAtaque(&jogo, &Jogadores[indiceJogador], &paisAtaque, &paisDefesa)) {
+                    printf("Ataque cancelado.\n");
+                    break;
+                }
 
-                // Chama a função de ataque
-                atacar(paisAtaque, paisDefesa, &Jogadores[indiceJogador], Missoes);
+                // Chama a função de ataque; o resultado vira uma versão que pode ser desfeita
+                atacar(&jogo, paisAtaque, paisDefesa, &Jogadores[indiceJogador]);
+                marcarVersao(&HistoricoTurno);
 
-                // Verifica se a missão foi cumprida
-                if (Jogadores[indiceJogador].missaoCumprida) {
-                    printf("Parabéns! Você cumpriu sua missão e venceu o jogo!\n");
-                    visualizarMissao(Jogadores, indiceJogador, Missoes);
+                // Verifica se alguma missão foi cumprida
+                if (anunciarVencedor(&jogo, indiceJogador)) {
                     opcao = 0; // Sai do jogo
                 }
                 break;
 
             case 2:
                 // Mostra o mapa atual
-                mostrarMapa(Pais, MAX_TERRITORIOS);
+                mostrarMapa(&jogo, 1);
                 break;
 
             case 3:
                 // Visualiza o jogador sobre o status da missão
-                visualizarMissao(Jogadores, indiceJogador, Missoes);
+                visualizarMissao(&jogo, indiceJogador, Missoes);
                 break;
 
             case 4:
                 // Termina o ataque
                 printf("Ataque terminado.\n");
                 indiceJogador = (indiceJogador + 1) % numJogadores; // Passa para o próximo jogador
+                turnosSemAtaque = 0;
+                limparHistorico(&HistoricoTurno); // Só o turno da vez pode ser desfeito
+                gravarComando("fim\n");
+                break;
+
+            case 5:
+                // Salva a partida para retomar depois com --resume
+                salvarPartidaDigitada(&jogo, indiceJogador);
+                break;
+
+            case 6:
+                // Volta ao estado antes do último ataque do turno
+                if (desfazerVersao(&HistoricoTurno) != 0) {
+                    printf("Nenhum ataque a desfazer neste turno.\n");
+                } else {
+                    printf("Ataque desfeito.\n");
+                    gravarComando("desfazer\n");
+                    mostrarMapa(&jogo, 0);
+                }
+                break;
+
+            case 7:
+                // Refaz o último ataque desfeito (com o mesmo resultado dos dados)
+                if (refazerVersao(&HistoricoTurno) != 0) {
+                    printf("Nenhum ataque desfeito a refazer.\n");
+                } else {
+                    printf("Ataque refeito.\n");
+                    gravarComando("refazer\n");
+                    mostrarMapa(&jogo, 0);
+                }
+                break;
+
+            case 8:
+                // Lista os territórios de uma visão ordenada, uma página por vez
+                consultarVistas(&jogo);
                 break;
 
             case 0:
@@ -227,51 +591,37 @@ int main() {
 
     } while (opcao != 0); // Continua até o jogador escolher sair
 
-    // 3. Limpeza:
-    // - Ao final do jogo, libera a memória alocada para o mapa para evitar vazamentos de memória.
-    liberarMemoria();
-
-    printf("Programa encerrado.\n");
-
-    return 0;
+    // 3. Limpeza (a mesma dos erros depois do contexto do computador)
+    // Uma entrada que acabou antes do fim da partida (pipe ou repetição cortada) não é sucesso
+    return encerrarPrograma(&jogo, mapa, FimDaEntrada ? 1 : 0);
 }
 
 // ---------------------------------
 // --- Implementação das Funções ---
 // ---------------------------------
-/**
- * @brief Função para alocar memória para os jogadores
- * @note Aloca dinamicamente a memória para o vetor de jogadores usando calloc
- * @return Ponteiro para o array de jogadores alocado
- */
-struct Jogador *alocarMemoriaJogadores() {
-    // Aloca dinamicamente a memória para o vetor de jogadores usando calloc
-    struct Jogador *ptr = (struct Jogador *) calloc(MAX_JOGADORES, sizeof(struct Jogador));
-    // Retorna o ponteiro para a memória alocada ou NULL em caso de falha
-    return ptr;
-}
-
 /**
  * @brief Função para cadastrar os jogadores
- * @note Preenche os dados iniciais de cada jogador (cor do exército, missão secreta, número de territórios).
- * @note Esta função modifica o vetor de jogadores passado por referência (ponteiro).
- * @param Jogadores Ponteiro para o vetor de jogadores a ser preenchido
+ * @note Lê a cor do exército de cada jogador e sorteia as missões secretas.
+ * @note Esta função modifica o vetor de jogadores da partida.
+ * @param jogo Partida cujos jogadores serão cadastrados
  * @param Missoes Ponteiro para o vetor de missões disponíveis
  * @param totalMissoes Número total de missões disponíveis
  * @param numJogadores Ponteiro para o número de jogadores a ser definido
  */
-void cadastroJogadores(struct Jogador **Jogadores, const struct Missao *Missoes, int totalMissoes, int *numJogadores){
-    // Define o número total de cores
-    int totalCores = sizeof(cores) / sizeof(cores[0]);
-    int coresDisponiveis[MAX_JOGADORES > 6 ? MAX_JOGADORES : 6];
-    for (int i = 0; i < totalCores; i++) coresDisponiveis[i] = 1; // 1 = disponível
+void cadastroJogadores(struct Jogo *jogo, const struct Missao *Missoes, int totalMissoes, int *numJogadores){
+    METRICA_INICIO(inicio);
+    struct Jogador *Jogadores = jogo->jogadores;
+
+    // Conjunto de bits das cores ainda disponíveis (todas as cores da partida)
+    uint64_t coresDisponiveis[(MAX_CORES + 63) / 64] = {0};
+    for (int c = 0; c < jogo->numCores; c++) coresDisponiveis[c >> 6] |= 1ULL << (c & 63);
 
-    // Pergunta o número de jogadores antes de alocar
+    // Pergunta o número de jogadores antes de alocar (um por cor)
     do {
-        printf("Digite o número de jogadores (1 a %d): ", MAX_JOGADORES);
+        printf("Digite o número de jogadores (1 a %d): ", jogo->numCores);
         scanf("%d", numJogadores);
-        limparBufferEntrada();
-    } while (*numJogadores < 1 || *numJogadores > MAX_JOGADORES);
+        if (limparBufferEntrada()) return;
+    } while (*numJogadores < 1 || *numJogadores > jogo->numCores);
 
     // Entrada dos dados de cada jogador
     printf("+-------------------------------+\n");
@@ -281,214 +631,199 @@ void cadastroJogadores(struct Jogador **Jogadores, const struct Missao *Missoes,
     for(int i=0; i < *numJogadores; i++){
         printf("\n--- Jogador no. %d ---\n", i + 1);
         printf("Cores disponíveis          : ");
-        // if (coresDisponiveis[0]) printf("%s", cores[0]);
-        for (int c = 0; c < totalCores; c++) {
-            if (coresDisponiveis[c]) printf("%s ", cores[c]);
+        for (int w = 0; w < (jogo->numCores + 63) / 64; w++) {
+            for (uint64_t bits = coresDisponiveis[w]; bits != 0; bits &= bits - 1) printf("%s ", cores[w * 64 + __builtin_ctzll(bits)]);
         }
         printf("\nEntre com a cor do exército: ");
+        char nomeEscolhido[10];
         int corValida = 0;
         do {
-            scanf("%s", (*Jogadores)[i].cor);
-            limparBufferEntrada();
-            for (int c = 0; c < totalCores; c++) {
-                if (coresDisponiveis[c] && strcmp((*Jogadores)[i].cor, cores[c]) == 0) {
-                    coresDisponiveis[c] = 0;
-                    corValida = 1;
-                    break;
-                }
+            scanf("%9s", nomeEscolhido);
+            if (limparBufferEntrada()) return;
+            // O nome só é usado aqui; dentro do jogo a cor é o seu identificador
+            int c = buscarCorPorNome(nomeEscolhido);
+            if (c != SEM_COR && c < jogo->numCores && ((coresDisponiveis[c >> 6] >> (c & 63)) & 1)) {
+                coresDisponiveis[c >> 6] &= ~(1ULL << (c & 63));
+                definirCorJogador(jogo, i, c);
+                corValida = 1;
             }
             if (!corValida) printf("Cor inválida ou já escolhida. Escolha novamente: ");
         } while (!corValida);
-    }
 
-    // Define as missões disponíveis
-    int missoesDisponiveis[MAX_MISSOES - 1];
-    for (int j = 0; j < totalMissoes - 1; j++) {
-        missoesDisponiveis[j] = 1; // 1 = disponível, 0 = não disponível
+        // Cada jogador decide pelo teclado ou é controlado pelo computador (MCTS)
+        char controle = 'h';
+        printf("Jogador controlado por (h)umano ou (c)omputador? ");
+        scanf(" %c", &controle);
+        if (limparBufferEntrada()) return;
+        Jogadores[i].politica = (controle == 'c' || controle == 'C') ? &politicaMcts : &politicaHumana;
     }
 
-    int missaoOriginal; // Variável para armazenar a missão original do jogador
-
     // Define a missão secreta de cada jogador
-    for (int i = 0; i < *numJogadores; i++) {
-        // Sorteia uma missão aleatória para o jogador
-        int missaoSorteada = rand() % totalMissoes;
-
-        // Guarda a missão sorteada original
-        missaoOriginal = missaoSorteada;
-
-        // Verifica se a missão já foi atribuída a outro jogador
-        if (!missoesDisponiveis[missaoSorteada]) {
-            // Se a missão já foi atribuída, sorteia uma nova
-            do {
-                missaoSorteada = rand() % totalMissoes;
-            } while (!missoesDisponiveis[missaoSorteada]);
-        } else {
-            // Marca a missão como não disponível
-            missoesDisponiveis[missaoSorteada] = 0;
-        }
-
-        // Verificar o tipo de missão e atribuir corretamente
-        // Caso a missão seja de destruir um exército inimigo (0 a 5), verifica se o exército existe e não é da mesma cor do jogador
-        if (missaoSorteada >= 0 && missaoSorteada <= totalCores - 1) {
-            // Varre os jogadores para verificar se a cor sorteada já está em uso
-            // Caso não esteja, atribui a missão de conquistar 5 territórios
-            for (int j = 0; j < MAX_JOGADORES; j++) {
-                // Compara a cor do jogador com a cor da missão
-                if (strcmp((*Jogadores)[j].cor, Missoes[missaoSorteada].cor) == 0){
-                    // Se a cor do próprio jogador for igual à cor da missão
-                    if (j == i){
-                        // Disponibiliza a missão novamente
-                        missoesDisponiveis[missaoSorteada] = 1;
-                        missaoSorteada = totalMissoes - 1; // Atribui a missão de conquistar 5 territórios
-                    }
-                    break;
-                } else if (j == MAX_JOGADORES - 1){
-                    // A cor da missão não pertence a nenhum jogador
-                    missaoSorteada = totalMissoes - 1; // Atribui a missão de conquistar 5 territórios
-                    break;
-                }
-            }
-        }
+    jogo->numJogadores = *numJogadores;
+    sortearMissoes(jogo, Missoes, totalMissoes);
 
-        // Atribui a missão sorteada ao jogador
-        (*Jogadores)[i].missao = Missoes[missaoSorteada].codigo;
-        (*Jogadores)[i].missaoCumprida = 0; // Inicializa como não cumprida
+    gravarComando("jogadores");
+    for (int i = 0; i < *numJogadores; i++) gravarComando(" %s", nomeCor(Jogadores[i].cor));
+    gravarComando("\n");
+    METRICA_FIM(METRICA_CADASTRO_JOGADORES, inicio);
+}
 
-        // Inicializa o número de territórios conquistados
-        (*Jogadores)[i].territorios = 0;
+/**
+ * @brief Função para saber se um território pode atacar
+ * @param jogo Partida em andamento
+ * @param t Território candidato a atacante
+ * @return 1 se t tem 2 tropas ou mais e algum vizinho de outra cor, 0 caso contrário
+ */
+int podeAtacarDe(const struct Jogo *jogo, int t) {
+    const struct Mapa *mapa = jogo->mapa;
+    if (jogo->tropas[t] < 2) return 0;
+    for (int k = mapa->inicioVizinhos[t]; k < mapa->inicioVizinhos[t + 1]; k++) {
+        if (jogo->dono[mapa->vizinhos[k]] != jogo->dono[t]) return 1;
     }
-
+    return 0;
 }
 
 /**
  * @brief Função para definir o nome dos países ataque e defesa
+ * @note Só aceita um atacante que possa atacar (podeAtacarDe). Digitar 0 no
+ *       atacante cancela o ataque; no defensor, volta à escolha do atacante.
+ * @param jogo Partida em andamento
  * @param paisAtaque Ponteiro para o ponteiro do país atacante
  * @param paisDefesa Ponteiro para o ponteiro do país defensor
  * @param corJogador Cor do jogador atual (para validação)
+ * @return 1 se o ataque foi definido, 0 se foi cancelado ou nenhum território pode atacar
  */
-void definirAtaqueDefesa(struct Territorio **paisAtaque, struct Territorio **paisDefesa, const char *corJogador) {
+int definirAtaqueDefesa(struct Jogo *jogo, int *paisAtaque, int *paisDefesa, int corJogador) {
     // Definir nomes dos países de ataque e defesa
     char nomePaisAtaque[30];
     char nomePaisDefesa[30];
+    const struct Mapa *mapa = jogo->mapa;
 
-    // Solicita os territórios de origem
-    do {
-        printf("Digite o nome do país atacante da cor %s: ", corJogador);
-        scanf("%s", nomePaisAtaque);
-        limparBufferEntrada();
-        *paisAtaque = buscarTerritorioPorNome(nomePaisAtaque);
-    } while (strcmp(nomePaisAtaque, "") == 0 || *paisAtaque == NULL || strcmp((*paisAtaque)->cor, corJogador) != 0);
+    // Sem nenhum atacante possível as perguntas nunca terminariam
+    int atacantes = 0;
+    for (int t = 0; t < jogo->numTerritorios && atacantes == 0; t++) {
+        if (jogo->dono[t] == corJogador && podeAtacarDe(jogo, t)) atacantes++;
+    }
+    if (atacantes == 0) {
+        printf("Nenhum território da cor %s pode atacar (são necessárias 2 tropas e um vizinho inimigo).\n", nomeCor(corJogador));
+        return 0;
+    }
 
-    // Solicita o território a ser atacado
     do {
-        printf("Digite o nome do território defensor: ");
-        scanf("%s", nomePaisDefesa);
-        limparBufferEntrada();
-        *paisDefesa = buscarTerritorioPorNome(nomePaisDefesa);
-    } while (strcmp(nomePaisDefesa, "") == 0 || *paisDefesa == NULL || strcmp((*paisDefesa)->cor, corJogador) == 0);
+        // Solicita os territórios de origem
+        do {
+            printf("Digite o nome do país atacante da cor %s (0 para cancelar): ", nomeCor(corJogador));
+            scanf("%29s", nomePaisAtaque);
+            if (limparBufferEntrada() || strcmp(nomePaisAtaque, "0") == 0) return 0;
+            *paisAtaque = buscarTerritorioDigitado(jogo, nomePaisAtaque);
+            if (*paisAtaque >= 0 && jogo->dono[*paisAtaque] == corJogador && !podeAtacarDe(jogo, *paisAtaque)) {
+                printf("%s precisa de ao menos 2 tropas e de um vizinho de outra cor para atacar.\n", nomeTerritorio(mapa, *paisAtaque));
+                *paisAtaque = -1;
+            }
+        } while (strcmp(nomePaisAtaque, "") == 0 || *paisAtaque < 0 || jogo->dono[*paisAtaque] != corJogador);
+
+        // Mostra os vizinhos do atacante: só eles podem ser atacados
+        printf("Vizinhos de %s:", nomeTerritorio(mapa, *paisAtaque));
+        for (int k = mapa->inicioVizinhos[*paisAtaque]; k < mapa->inicioVizinhos[*paisAtaque + 1]; k++) {
+            int vizinho = mapa->vizinhos[k];
+            printf(" %s (%s)", nomeTerritorio(mapa, vizinho), nomeCor(jogo->dono[vizinho]));
+        }
+        printf("\n");
+
+        // Solicita o território a ser atacado
+        do {
+            printf("Digite o nome do território defensor (0 para trocar o atacante): ");
+            scanf("%29s", nomePaisDefesa);
+            if (limparBufferEntrada()) return 0;
+            if (strcmp(nomePaisDefesa, "0") == 0) {
+                *paisDefesa = -1;
+                break;
+            }
+            *paisDefesa = buscarTerritorioDigitado(jogo, nomePaisDefesa);
+            if (*paisDefesa >= 0 && !fazFronteira(mapa, *paisAtaque, *paisDefesa)) {
+                printf("%s não faz fronteira com %s.\n", nomeTerritorio(mapa, *paisDefesa), nomeTerritorio(mapa, *paisAtaque));
+                *paisDefesa = -1;
+            }
+        } while (strcmp(nomePaisDefesa, "") == 0 || *paisDefesa < 0 || jogo->dono[*paisDefesa] == corJogador);
+    } while (*paisDefesa < 0);
+    return 1;
 }
 
 /**
- * @brief Função para retornar o pais pelo nome
- * @param nome Nome do país a ser buscado
- * @return Ponteiro para o território encontrado ou NULL se não encontrado
+ * @brief Função para mostrar a sequência de conquistas mais provável para a missão
+ * @note O plano vem do planejador (planejador.h): a cada ataque só é refeito
+ *       se algum território que ele considerou mudou.
+ * @param jogo Partida em andamento
+ * @param indiceJogador Jogador da vez
  */
-struct Territorio *buscarTerritorioPorNome(const char *nome) {
-    for (int i = 0; i < MAX_TERRITORIOS; i++) {
-        if (strcmp(Pais[i].nome, nome) == 0) {
-            return &Pais[i];
-        }
+void mostrarPlano(const struct Jogo *jogo, int indiceJogador) {
+    const struct Plano *plano = planejarAtaque(&PlanejadorAtaque, jogo, indiceJogador);
+    if (plano == NULL || plano->numPassos == 0) return;
+
+    printf("Plano sugerido para a missão (%s, chance de %.1f%%):\n",
+           plano->completo ? "cumpre o alvo" : "aproxima do alvo", plano->chance * 100.0);
+    for (int i = 0; i < plano->numPassos; i++) {
+        const struct PassoPlano *passo = &plano->passos[i];
+        printf("  %d. %s (%.0f tropas) -> %s (%s, %d tropas): %.1f%%\n", i + 1,
+               nomeTerritorio(jogo->mapa, passo->ataque), passo->tropas,
+               nomeTerritorio(jogo->mapa, passo->defesa), nomeCor(jogo->dono[passo->defesa]),
+               jogo->tropas[passo->defesa], passo->chance * 100.0);
     }
-    return NULL;
 }
 
 /**
- * @brief Função para alocar dinamicamente o mapa do mundo
- * @return Ponteiro para o array de territórios alocado
+ * @brief Função para mostrar uma página de uma visão ordenada do mapa
+ * @note Pergunta a visão (maiores exércitos, territórios de uma cor ou
+ *       fronteiras ameaçadas de uma cor), a cor e a página. A página sai
+ *       dos índices mantidos a cada ataque, sem varrer o mapa.
+ * @param jogo Partida em andamento
  */
-struct Territorio *alocarMemoriaMapa() {
-    // Aloca dinamicamente a memória para o vetor de territórios usando calloc
-    struct Territorio *ptr = (struct Territorio *) calloc(MAX_TERRITORIOS, sizeof(struct Territorio));
-    // Retorna o ponteiro para a memória alocada ou NULL em caso de falha
-    return ptr;
+void consultarVistas(const struct Jogo *jogo) {
+    int tipo = 0;
+    printf("1 - Maiores exércitos\n");
+    printf("2 - Territórios de uma cor\n");
+    printf("3 - Fronteiras ameaçadas de uma cor\n");
+    printf("Escolha a visão: ");
+    scanf("%d", &tipo);
+    if (limparBufferEntrada()) return;
+    if (tipo < 1 || tipo > TOTAL_VISTAS) {
+        printf("Visão inválida.\n");
+        return;
+    }
+
+    int cor = SEM_COR;
+    if (tipo - 1 != VISTA_TROPAS) {
+        char nomeDigitado[30];
+        printf("Digite a cor: ");
+        scanf("%29s", nomeDigitado);
+        if (limparBufferEntrada()) return;
+        cor = buscarCorPorNome(nomeDigitado);
+        if (cor == SEM_COR || cor >= jogo->numCores) {
+            printf("Cor inválida: %s\n", nomeDigitado);
+            return;
+        }
+    }
+
+    int pagina = 1;
+    int paginas = (totalVista(&VistasMapa, tipo - 1, cor) + VISTA_PAGINA - 1) / VISTA_PAGINA;
+    printf("Página (1 a %d): ", paginas > 0 ? paginas : 1);
+    scanf("%d", &pagina);
+    if (limparBufferEntrada()) return;
+    mostrarVista(&VistasMapa, tipo - 1, cor, pagina);
 }
 
 /**
  * @brief Função para cadastrar os territórios do jogo
- * @note Preenche os dados iniciais de cada território no mapa (nome, cor do exército, número de tropas).
- * @note Esta função modifica o mapa passado por referência (ponteiro).
- * @param Pais Ponteiro para o vetor de territórios a ser preenchido
- * @param Jogadores Ponteiro para o vetor de jogadores (para sorteio das cores)
- * @param totalJogadores Número total de jogadores (para sorteio das cores)
+ * @note Pergunta se os territórios devem ser sorteados entre os jogadores.
+ * @note Esta função modifica o mapa da partida.
+ * @param jogo Partida cujo mapa será preenchido
  */
-void cadastroTerritorios(struct Territorio **Pais, struct Jogador **Jogadores, int totalJogadores){
-    // Definição da função para cadastro dos territórios
-
-    // Nomes e tropas fixos dos países
-    const char *nomesPaises[MAX_TERRITORIOS] = {"America", "Brasil", "Chile", "Peru", "Argelia"};
-    int tropasIniciais[MAX_TERRITORIOS] = {4, 8, 3, 9, 15};
-
-    // Cria vetor de índices dos países
-    int indices[MAX_TERRITORIOS];
-    for (int i = 0; i < MAX_TERRITORIOS; i++) indices[i] = i;
-    // Embaralha os índices (Fisher-Yates)
-    for (int i = MAX_TERRITORIOS - 1; i > 0; i--) {
-        int j = rand() % (i + 1);
-        int tmp = indices[i];
-        indices[i] = indices[j];
-        indices[j] = tmp;
-    }
-
+void cadastroTerritorios(struct Jogo *jogo){
     // Entrada dos dados de cada território
     printf("+-------------------------------+\n");
-    printf("|   CADASTRO DOS %d TERRITÓRIOS  |\n", MAX_TERRITORIOS);
+    printf("|   CADASTRO DOS %d TERRITÓRIOS  |\n", jogo->numTerritorios);
     printf("+-------------------------------+\n");
 
-    // for(int i=0; i < MAX_TERRITORIOS; i++){
-    //     printf("\n--- Território no. %d ---\n", i + 1);
-    //     printf("Entre com o nome do território            : ");
-    //     scanf("%s", Pais[i].nome);
-    //     limparBufferEntrada();
-    //     printf("Entre com a cor do território             : ");
-    //     scanf("%s", Pais[i].cor);
-    //     limparBufferEntrada();
-            // Sorteia a cor do exército entre as cores disponíveis
-    //     int corSorteada = rand() % totalJogadores;
-    //     strcpy(Pais[i].cor, Jogadores[corSorteada].cor);
-    //     printf("Cor sorteada do exército do território   : %s\n", Pais[i].cor);
-    //     printf("Entre com o número de tropas do território: ");
-    //     scanf("%d", &Pais[i].tropas);
-    //     limparBufferEntrada();
-    //     // printf("\n\n");
-    // }
-
-    // strcpy(Pais[0].nome, "America");
-    // int corSorteada = rand() % totalJogadores;
-    // strcpy(Pais[0].cor, Jogadores[corSorteada].cor);
-    // strcpy(Pais[0].cor, "Branco");
-    // Pais[0].tropas = 4;
-    // strcpy(Pais[1].nome, "Brasil");
-    // int corSorteada = rand() % totalJogadores;
-    // strcpy(Pais[1].cor, Jogadores[corSorteada].cor);
-    // strcpy(Pais[1].cor, "Preto");
-    // Pais[1].tropas = 8;
-    // strcpy(Pais[2].nome, "Chile");
-    // int corSorteada = rand() % totalJogadores;
-    // strcpy(Pais[2].cor, Jogadores[corSorteada].cor);
-    // strcpy(Pais[2].cor, "Branco");
-    // Pais[2].tropas = 3;
-    // strcpy(Pais[3].nome, "Peru");
-    // int corSorteada = rand() % totalJogadores;
-    // strcpy(Pais[3].cor, Jogadores[corSorteada].cor);
-    // strcpy(Pais[3].cor, "Preto");
-    // Pais[3].tropas = 9;
-    // strcpy(Pais[4].nome, "Argelia");
-    // int corSorteada = rand() % totalJogadores;
-    // strcpy(Pais[4].cor, Jogadores[corSorteada].cor);
-    // strcpy(Pais[4].cor, "Branco");
-    // Pais[4].tropas = 15;
-
     printf("===========================================\n");
     printf("= Distribuição das tropas pelos jogadores =\n");
     printf("===========================================\n");
@@ -496,36 +831,88 @@ void cadastroTerritorios(struct Territorio **Pais, struct Jogador **Jogadores, i
     char opcao = 'n';
     printf("\nDeseja distribuir, por sorteio, os territórios entre os jogadores? (s/n): ");
     scanf(" %c", &opcao);
-    limparBufferEntrada();
+    if (limparBufferEntrada()) return;
 
     if (opcao == 's' || opcao == 'S'){
         printf("Os territórios serão distribuídos aleatoriamente entre os jogadores.\n");
         // Distribui países embaralhados entre jogadores
-        for (int i = 0; i < MAX_TERRITORIOS; i++) {
-            int idx = indices[i];
-            int jogadorIdx = i % totalJogadores;
-            strcpy((*Pais)[idx].nome, nomesPaises[idx]);
-            strcpy((*Pais)[idx].cor, (*Jogadores)[jogadorIdx].cor);
-            (*Pais)[idx].tropas = tropasIniciais[idx];
-            // Incrementando o número de territórios do jogador
-            (*Jogadores)[jogadorIdx].territorios++;
-        }
+        distribuirTerritorios(jogo);
+        gravarComando("distribuir\n");
     } else {
         printf("Os territórios serão cadastrados manualmente.\n");
     }
 
     printf("\nCadastro dos territórios concluído!\n");
 
-    mostrarMapa(*Pais, MAX_TERRITORIOS);
+    mostrarMapa(jogo, 1);
+}
+
+/**
+ * @brief Função para achar o território digitado pelo jogador
+ * @note Tenta o nome exato, depois sem diferenciar maiúsculas e por fim um
+ *       prefixo que identifique um único território ("arg" -> "Argelia").
+ *       Se o prefixo for ambíguo, lista algumas opções.
+ * @param jogo Partida em andamento
+ * @param nome Texto digitado
+ * @return Índice do território ou -1 se não houver um único candidato
+ */
+int buscarTerritorioDigitado(const struct Jogo *jogo, const char *nome) {
+    const struct Mapa *mapa = jogo->mapa;
+    int t = buscarTerritorioPorNome(jogo, nome);
+    if (t < 0) t = buscarNomeSemCaixa(mapa, nome);
+    if (t >= 0) return t;
+
+    int primeiro;
+    int encontrados = buscarPrefixoNoMapa(mapa, nome, &primeiro);
+    if (encontrados == 1) return mapa->ordemNomes[primeiro];
+    if (encontrados > 1) {
+        const int mostrar = 10;
+        printf("\"%s\" corresponde a %d territórios:", nome, encontrados);
+        for (int k = 0; k < encontrados && k < mostrar; k++) {
+            printf(" %s", nomeTerritorio(mapa, mapa->ordemNomes[primeiro + k]));
+        }
+        printf("%s\n", encontrados > mostrar ? " ..." : "");
+    }
+    return -1;
+}
+
+/**
+ * @brief Função para encerrar a partida interativa
+ * @note Limpeza única do fim de main e dos erros depois de iniciarContextoMcts:
+ *       relata a busca do computador, se ele jogou, e libera a partida, a
+ *       tabela de batalhas e o mapa.
+ * @param jogo Partida interativa
+ * @param mapa Mapa da partida
+ * @param status Status de saída do programa
+ * @return status
+ */
+int encerrarPrograma(struct Jogo *jogo, struct Mapa *mapa, int status) {
+    // Velocidade da busca do computador (simulações/s), se ele jogou
+    relatarMcts(&ContextoIA);
+
+    // Libera a memória alocada para o mapa para evitar vazamentos de memória
+    liberarMemoria(jogo);
+    liberarTabelaBatalhas();
+    liberarMapa(mapa);
+
+    printf("Programa encerrado.\n");
+    return status;
 }
 
 /**
  * @brief Libera a memória previamente alocada para o mapa usando free.
  * @note Evita vazamentos de memória.
+ * @param jogo Partida interativa (territórios, jogadores e posse)
  */
-void liberarMemoria(){
-    free(Pais);
-    free(Jogadores);
+void liberarMemoria(struct Jogo *jogo){
+    liberarHistorico(&HistoricoTurno);
+    liberarVistas(&VistasMapa);
+    liberarJogo(jogo);
+    liberarTela(&TelaMapa);
+    liberarPlanejador(&PlanejadorAtaque);
+    fecharDiario(NULL);
+    if (Gravacao != NULL) fclose(Gravacao);
+    Gravacao = NULL;
     printf("Memória liberada com sucesso.\n");
 }
 
@@ -542,217 +929,246 @@ void exibirMenuPrincipal(int indiceJogador){
     printf("2 - Ver Mapa\n");
     printf("3 - Verificar Missão\n");
     printf("4 - Terminar ataque\n");
+    printf("5 - Salvar partida\n");
+    printf("6 - Desfazer ataque\n");
+    printf("7 - Refazer ataque\n");
+    printf("8 - Consultar o mapa\n");
 
     printf("0 - Sair\n\n");
 }
 
-/**
-* @brief Executa a lógica de uma batalha entre dois territórios.
-* @note Realiza validações, rola os dados, compara os resultados e atualiza o número de tropas.
-* @note Se um território for conquistado, atualiza seu dono e move uma tropa.
-* @note implemente void atacar(Territorio* atacante, Territorio* defensor) que utilize rand() para simular um dado de ataque (1 a 6) para cada lado.
-* @param ataque Ponteiro para o território atacante
-* @param defesa Ponteiro para o território defensor
-* @param Jogador Ponteiro para o jogador atual (para verificar missão)
-* @param Missoes Ponteiro para o vetor de missões (para verificar missão)
-*/
-void atacar(struct Territorio* ataque, struct Territorio* defesa, struct Jogador *Jogador, const struct Missao *Missoes){
-    // Loop de ataque
-    printf("\n--- Início do Ataque ---\n");
-    printf("Território Atacante: %s (Cor: %s, Tropas: %d)\n", ataque->nome, ataque->cor, ataque->tropas);
-    printf("Território Defensor : %s (Cor: %s, Tropas: %d)\n", defesa->nome, defesa->cor, defesa->tropas);
-    char continuar = 's';
-    int* dadosAtaque = NULL;
-    int* dadosDefesa = NULL;
-    do {
-        // Verifica se o território atacante possui tropas suficientes para atacar
-        if (ataque->tropas < 2) {
-            printf("Ataque não possui tropas suficientes para o ataque.\n");
-            return;
-        }
+// --- Gravação do roteiro (--record) ---
+// atacar() avisa cada rodada e cada movimento, seja qual for a política de
+// cada lado: cada rodada vira um ataque de 1 rodada com os dados dos dois lados.
 
-        // Verifica se o território de ataque é o mesmo que o de defesa
-        if (strcmp(ataque->cor, defesa->cor) == 0) {
-            printf("Não é possível atacar países de mesma cor.\n");
-            return;
-        }
+static void gravarRodada(const struct Jogo *jogo, int ataque, int defesa, int numDadosAtaque, int numDadosDefesa) {
+    gravarComando("ataque %s %s %d %d 1\n", nomeTerritorio(jogo->mapa, ataque), nomeTerritorio(jogo->mapa, defesa),
+                  numDadosAtaque, numDadosDefesa);
+}
 
-        // Pergunta quantos dados o atacante quer rolar (1 ao máximo de trocas - 1)
-        int maxDadosAtaque = (ataque->tropas > 3) ? 3 : ataque->tropas - 1;
-        int numDadosAtaque;
+static void gravarMovimento(const struct Jogo *jogo, int ataque, int defesa, int tropas) {
+    (void) jogo; (void) ataque; (void) defesa;
+    gravarComando("mover %d\n", tropas);
+}
 
-        // Entra num loop até o usuário entrar um número válido de dados
-        do {
-            printf ("\nQuantos dados para o ataque? (1 a %d): ", maxDadosAtaque);
-            scanf ("%d", &numDadosAtaque);
-            limparBufferEntrada();
-        } while (numDadosAtaque < 1 || numDadosAtaque > maxDadosAtaque);
-
-        // Rolagem aleatório dos dados do atacante (1 a 6)
-        dadosAtaque = (int*) malloc(numDadosAtaque * sizeof(int));
-        for (int i = 0; i < numDadosAtaque; i++) {
-            dadosAtaque[i] = (rand() % 6) + 1;
-        }
+const struct GravadorAtaque gravadorRoteiro = {gravarRodada, gravarMovimento};
 
-        // Define o número máximo de dados da defesaa (número de tropas a 3)
-        int maxDadosDefesa = (defesa->tropas > 3) ? 3 : defesa->tropas;
-        int numDadosDefesa;
+// --- Política humana ---
+// Cada decisão do motor de jogo vira uma pergunta no terminal.
 
-        // Entra num loop até o usuário entrar um número válido de dados
-        do {
-            printf ("Quantos dados para a defesa? (1 a %d): ", maxDadosDefesa);
-            scanf ("%d", &numDadosDefesa);
-            limparBufferEntrada();
-        } while (numDadosDefesa < 1 || numDadosDefesa > maxDadosDefesa);
-
-        // Rolagem aleatório dos dados da defesa (1 a 6)
-        dadosDefesa = (int*) malloc(numDadosDefesa * sizeof(int));
-        for (int i = 0; i < numDadosDefesa; i++) {
-            dadosDefesa[i] = (rand() % 6) + 1;
-        }
-
-        // Ordena os dados em ordem decrescente (bubble sort)
-        ordenarDados(dadosAtaque, numDadosAtaque);
-        ordenarDados(dadosDefesa, numDadosDefesa);
-
-        printf("\nAtacante: %d tropas, Defesa: %d tropas\n", ataque->tropas, defesa->tropas);
-        printf("Atacante dados: ");
-        for (int i = 0; i < numDadosAtaque; i++) {
-            printf("%d ", dadosAtaque[i]);
-        }
-        printf("\nDefesa dados  : ");
-        for (int i = 0; i < numDadosDefesa; i++) {
-            printf("%d ", dadosDefesa[i]);
-        }
-        printf("\n");
+/**
+ * @brief Pergunta ao jogador os países de ataque e defesa.
+ * @return 1 com o ataque escolhido, 0 se o jogador cancelou ou não pode atacar
+ *         (o jogador humano termina o turno pelo menu)
+ */
+static int humanaEscolherAtaque(struct Jogo *jogo, struct Jogador *jogador,
+                                int *ataque, int *defesa) {
+    mostrarPlano(jogo, (int) (jogador - jogo->jogadores));
+    return definirAtaqueDefesa(jogo, ataque, defesa, jogador->cor);
+}
 
-        // Compara os dados do atacante e do defensor
-        int comparacoes = (numDadosAtaque < numDadosDefesa) ? numDadosAtaque : numDadosDefesa;
-        for (int i = 0; i < comparacoes; i++) {
-            if (dadosAtaque[i] > dadosDefesa[i]) {
-                defesa->tropas--;
-                printf("Defensor perde 1 tropa! Tropas restantes: %d\n", defesa->tropas);
-            } else {
-                ataque->tropas--;
-                printf("Atacante perde 1 tropa! Tropas restantes: %d\n", ataque->tropas);
-            }
-        }
+/**
+ * @brief Pergunta quantos dados o atacante quer rolar.
+ */
+static int humanaDadosAtaque(struct Jogo *jogo, int ataque, int defesa, int maxDados) {
+    (void) jogo; (void) ataque; (void) defesa;
+    int numDados = 0;
+    printf ("\nQuantos dados para o ataque? (1 a %d): ", maxDados);
+    scanf ("%d", &numDados);
+    if (limparBufferEntrada()) numDados = maxDados; // Sem entrada, a rodada termina com o máximo de dados
+    return numDados;
+}
 
-        if (ataque->tropas > 1 && defesa->tropas > 0){
-            // Pergunta se quer continuar o ataque
-            printf("\nContinuar o ataque? (s/n): ");
-            scanf(" %c", &continuar);
-            limparBufferEntrada();
-        } else {
-            continuar = 'n'; // Força a saída do loop se não houver tropas suficientes
-        }
-    } while ((continuar == 's' || continuar == 'S'));
+/**
+ * @brief Pergunta quantos dados o defensor quer rolar.
+ */
+static int humanaDadosDefesa(struct Jogo *jogo, int ataque, int defesa, int maxDados) {
+    (void) jogo; (void) ataque; (void) defesa;
+    int numDados = 0;
+    printf ("Quantos dados para a defesa? (1 a %d): ", maxDados);
+    scanf ("%d", &numDados);
+    if (limparBufferEntrada()) numDados = maxDados;
+    return numDados;
+}
 
-    // Verifica o vencedor
-    if (defesa->tropas == 0) {
-        printf("\nTerritório %s conquistado!\n", defesa->nome);
-        // Atualiza o dono do território conquistado
-        strcpy(defesa->cor, ataque->cor);
+/**
+ * @brief Pergunta se o atacante quer continuar o ataque.
+ */
+static int humanaContinuar(struct Jogo *jogo, int ataque, int defesa) {
+    (void) jogo; (void) ataque; (void) defesa;
+    char continuar = 'n';
+    printf("\nContinuar o ataque? (s/n): ");
+    scanf(" %c", &continuar);
+    if (limparBufferEntrada()) return 0;
+    return continuar == 's' || continuar == 'S';
+}
 
-        // Incrementa o número de territórios do jogador atacante
-        Jogador->territorios++;
+/**
+ * @brief Pergunta quantas tropas mover para o território conquistado.
+ */
+static int humanaTropasMover(struct Jogo *jogo, int ataque, int defesa, int maxTropas) {
+    (void) jogo; (void) ataque; (void) defesa;
+    int tropasMover = 0;
+    printf("Quantas tropas mover para o território conquistado? (1 a %d): ", (maxTropas > 3 ? 3 : maxTropas));
+    scanf("%d", &tropasMover);
+    if (limparBufferEntrada()) tropasMover = 1; // Sem entrada, move o mínimo
+    return tropasMover;
+}
 
-        // Verificar se a missão do jogador foi cumprida
-        int totalCores = sizeof(cores) / sizeof(cores[0]);
+const struct Politica politicaHumana = {
+    "humana", 0, humanaEscolherAtaque, humanaDadosAtaque, humanaDadosDefesa, humanaContinuar, humanaTropasMover
+};
 
-        if (Jogador->missao >= 0 && Jogador->missao <= totalCores - 1) {
-            // Missão de destruir um exército inimigo
-            const char *corInimiga = Missoes[Jogador->missao].descricao + 17; // Pula "Destruir o exército "
-            if (strcmp(defesa->cor, corInimiga) == 0) {
-                Jogador->missaoCumprida = 1; // Missão cumprida
-            }
-        } else {
-            // Missão de conquistar um número específico de territórios
-            int territoriosNecessarios = Jogador->missao - 3; // Missão 6 -> 3, Missão 7 -> 4, Missão 8 -> 5
+/**
+ * @brief Função para visualizar a missão do jogador
+ * @param jogo Partida do jogador cuja missão será visualizada
+ * @param missoes Ponteiro para o array de missões disponíveis
+ * @param indiceJogador Índice do jogador (para exibição)
+ */
+void visualizarMissao(const struct Jogo *jogo, int indiceJogador, const struct Missao *missoes) {
+    const struct Jogador *jogador = jogo->jogadores;
+    printf("\n--- Missão do Jogador %d---\n", indiceJogador + 1);
+    printf("Cor do Exército: %s\n", nomeCor(jogador[indiceJogador].cor));
+    printf("Territórios    : %d\n", jogo->territoriosCor[jogador[indiceJogador].cor]);
+    printf("Conquistas     : %d\n", jogador[indiceJogador].conquistas);
+    printf("Missão         : %s\n", missoes[jogador[indiceJogador].missao].descricao);
+    printf("Status         : %s\n", jogador[indiceJogador].missaoCumprida ? "Cumprida" : "Não Cumprida");
+}
 
-            if (Jogador->territorios >= territoriosNecessarios) {
-                Jogador->missaoCumprida = 1; // Missão cumprida
-            }
-        }
+/**
+ * @brief Função para anunciar o vencedor da partida
+ * @note O vencedor pode não ser o jogador da vez: a destruição de um exército
+ *       cumpre a missão de quem o caçava.
+ * @param jogo Partida em andamento
+ * @param indiceJogador Índice do jogador da vez
+ * @return 1 se alguém cumpriu a missão, 0 caso contrário
+ */
+int anunciarVencedor(const struct Jogo *jogo, int indiceJogador) {
+    if (jogo->vencedor < 0) return 0;
 
-        if (!Jogador->missaoCumprida) {
-            // Pergunta quantas tropas o ataque quer mover (1 a número de tropas - 1)
-            int tropasMover;
-
-            // Cria um loop até o número de troas for correto
-            do {
-                printf("Quantas tropas mover para o território conquistado? (1 a %d): ", (ataque->tropas - 1 > 3 ? 3 : ataque->tropas - 1));
-                scanf("%d", &tropasMover);
-                limparBufferEntrada();
-            } while (tropasMover < 1 || tropasMover >= ataque->tropas);
-
-            // Move as tropas
-            ataque->tropas -= tropasMover;
-            defesa->tropas += tropasMover;
-            printf("%d tropas movidas para o território %s.\n", tropasMover, defesa->nome);
-        }
+    if (jogo->vencedor == indiceJogador && jogo->jogadores[indiceJogador].politica == &politicaHumana) {
+        printf("Parabéns! Você cumpriu sua missão e venceu o jogo!\n");
     } else {
-        printf("Ataque falhou! Território %s permanece com %d tropas.\n", defesa->nome, defesa->tropas);
+        printf("O jogador %d cumpriu sua missão e venceu o jogo!\n", jogo->vencedor + 1);
     }
+    visualizarMissao(jogo, jogo->vencedor, Missoes);
+    return 1;
+}
 
-    // Libera a memória alocada para os dados
-    if (dadosAtaque) free(dadosAtaque);
-    if (dadosDefesa) free(dadosDefesa);
+/**
+ * @brief Função para salvar a partida no arquivo digitado pelo jogador
+ * @note A partida continua normalmente; o arquivo é retomado com --resume.
+ * @param jogo Partida em andamento
+ * @param indiceJogador Jogador da vez (gravado no arquivo)
+ */
+void salvarPartidaDigitada(const struct Jogo *jogo, int indiceJogador) {
+    char caminho[256];
+    printf("Nome do arquivo para salvar a partida: ");
+    scanf("%255s", caminho);
+    if (limparBufferEntrada()) return;
+
+    double inicio = relogioSegundos();
+    if (salvarPartida(jogo, indiceJogador, caminho) == 0) {
+        printf("Partida salva em %s (%.3f ms). Retome com: --resume %s\n", caminho,
+               (relogioSegundos() - inicio) * 1000.0, caminho);
+        gravarComando("salvar %s\n", caminho);
+    }
 }
 
 /**
- * @brief Função auxiliar para ordenar um array de inteiros em ordem decrescente usando o algoritmo Bubble Sort.
- * @param dados Ponteiro para o array de inteiros a ser ordenado.
- * @param n Número de elementos no array.
+ * @brief Função para jogar o turno de um jogador controlado pelo computador
+ * @note O computador ataca enquanto a busca escolher um ataque (até
+ *       SIM_MAX_ATAQUES_TURNO). As rodadas e o movimento na conquista são
+ *       gravados por atacar() (gravadorRoteiro), como os do jogador humano.
+ * @param jogo Partida em andamento
+ * @param indiceJogador Índice do jogador da vez
+ * @return Número de ataques feitos no turno
  */
-void ordenarDados(int* dados, int n) {
-    for (int i = 0; i < n - 1; i++) {
-        for (int j = 0; j < n - i - 1; j++) {
-            if (dados[j] < dados[j + 1]) {
-                int temp = dados[j];
-                dados[j] = dados[j + 1];
-                dados[j + 1] = temp;
-            }
-        }
+int jogarTurnoComputador(struct Jogo *jogo, int indiceJogador) {
+    struct Jogador *jogador = &jogo->jogadores[indiceJogador];
+    int ataques = 0;
+    int paisAtaque;
+    int paisDefesa;
+
+    printf("\n--- Vez do computador: jogador %d (%s) ---\n", indiceJogador + 1, nomeCor(jogador->cor));
+    while (ataques < SIM_MAX_ATAQUES_TURNO && jogo->vencedor < 0 &&
+           jogador->politica->escolherAtaque(jogo, jogador, &paisAtaque, &paisDefesa)) {
+        atacar(jogo, paisAtaque, paisDefesa, jogador);
+        ataques++;
     }
+    printf("Computador terminou o turno com %d ataque(s).\n", ataques);
+    mostrarMapa(jogo, 0);
+    return ataques;
 }
 
 /**
- * @brief Função para visualizar a missão do jogador
- * @param jogador Ponteiro para o jogador cuja missão será visualizada
- * @param missoes Ponteiro para o array de missões disponíveis
- * @param indiceJogador Índice do jogador (para exibição)
+ * @brief Função para gravar um comando no roteiro da partida
+ * @note Não faz nada se a partida não estiver sendo gravada (--record).
+ * @param formato Formato do printf seguido dos valores
  */
-void visualizarMissao(struct Jogador *jogador, int indiceJogador, const struct Missao *missoes) {
-    printf("\n--- Missão do Jogador %d---\n", indiceJogador + 1);
-    printf("Cor do Exército: %s\n", jogador[indiceJogador].cor);
-    printf("Territórios    : %d\n", jogador[indiceJogador].territorios);
-    printf("Missão         : %s\n", missoes[jogador[indiceJogador].missao].descricao);
-    printf("Status         : %s\n", jogador[indiceJogador].missaoCumprida ? "Cumprida" : "Não Cumprida");
+void gravarComando(const char *formato, ...) {
+    if (Gravacao == NULL) return;
+    va_list argumentos;
+    va_start(argumentos, formato);
+    vfprintf(Gravacao, formato, argumentos);
+    va_end(argumentos);
+    fflush(Gravacao); // A gravação vale até o último comando mesmo se o jogo for interrompido
 }
 
 /**
  * @brief Função para limpar o buffer de entrada
  * @note Evita problemas com entradas de dados
+ * @note No fim da entrada (pipe ou arquivo esgotado) marca FimDaEntrada em vez
+ *       de repetir a mesma pergunta para sempre: quem perguntou desiste ou usa
+ *       uma resposta padrão e o jogo sai pela limpeza normal de main.
+ * @return 1 se a entrada acabou, 0 caso contrário
  */
-void limparBufferEntrada(){
+int limparBufferEntrada(){
     int c;
+    METRICA_CONTAR(METRICA_PERGUNTAS);
     while((c = getchar()) != '\n' && c != EOF);
+    if (c == EOF && !FimDaEntrada) {
+        printf("\nFim da entrada.\n");
+        FimDaEntrada = 1;
+    }
+    return FimDaEntrada;
 }
 
 /**
  * @brief Função para listar o mapa atual com os territórios, suas cores e número de tropas.
- * @param mapa Ponteiro para o array de territórios (const para evitar modificação acidental).
- * @param totalTerritorios Número total de territórios no mapa.
+ * @note O quadro é montado e enviado de uma vez pela tela (ver tela.h).
+ * @param jogo Partida a listar (const para evitar modificação acidental).
+ * @param completo 1 - todos os territórios, 0 - só os que mudaram desde o último desenho
+ */
+void mostrarMapa(const struct Jogo *jogo, int completo) {
+    METRICA_INICIO(inicio);
+    desenharMapa(&TelaMapa, jogo, completo);
+    METRICA_FIM(METRICA_DESENHOS, inicio);
+}
+
+/**
+ * @brief Função para carregar o mapa da partida
+ * @note Sem arquivo, usa o mapa clássico. Com arquivo, informa o tempo de
+ *       leitura e a memória residente do processo depois da carga.
+ * @param caminho Arquivo de mapa ou NULL para o mapa clássico
+ * @return Ponteiro para o mapa ou NULL em caso de erro (a mensagem já foi impressa)
  */
-void mostrarMapa(const struct Territorio* mapa, int totalTerritorios) {
-    printf("\n+-----------------------------------------+\n");
-    printf("|               MAPA ATUAL               |\n");
-    printf("+-----------------------------------------+\n");
-    printf("| %-15s | %-10s | %-8s |\n", "Território", "Cor", "Tropas");
-    printf("+-----------------------------------------+\n");
-    for (int i = 0; i < totalTerritorios; i++) {
-        printf("| %-13s | %-10s | %-7d |\n", mapa[i].nome, mapa[i].cor, mapa[i].tropas);
+struct Mapa *prepararMapa(const char *caminho) {
+    if (caminho == NULL) {
+        struct Mapa *mapa = criarMapaClassico();
+        if (mapa == NULL) printf("Erro na alocação de memória para o mapa.\n");
+        return mapa;
     }
-    printf("+-----------------------------------------+\n");
+
+    double inicio = relogioSegundos();
+    struct Mapa *mapa = carregarMapa(caminho);
+    double duracao = relogioSegundos() - inicio;
+    if (mapa == NULL) return NULL;
+
+    long residente = memoriaResidenteKB(0);
+    long pico = memoriaResidenteKB(1);
+    printf("Mapa %s: %d territórios, %d continentes, %ld fronteiras\n",
+           caminho, mapa->numTerritorios, mapa->numContinentes, mapa->numFronteiras);
+    printf("Carregado em %.1f ms | memória residente: %ld KB (pico %ld KB)\n\n", duracao * 1000.0, residente, pico);
+    return mapa;
 }